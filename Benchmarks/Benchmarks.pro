@@ -0,0 +1,17 @@
+TEMPLATE = app
+
+TARGET = geltanBenchmarks
+
+QT += network testlib
+QT -= gui
+
+CONFIG += c++11 testcase
+
+SOURCES += \
+    jsonbackendbenchmark.cpp
+
+RESOURCES += \
+    benchmarks.qrc
+
+LIBS += -L$$OUT_PWD/../Geltan -lgeltan
+INCLUDEPATH += $$PWD/../
@@ -0,0 +1,130 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Benchmarks/jsonbackendbenchmark.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include <Geltan/PP/ppjsonbackend.h>
+#include <Geltan/PP/ppjsondocument.h>
+#include <Geltan/PP/Objects/paymentlist.h>
+
+Q_DECLARE_METATYPE(const Geltan::PP::PPJsonBackend*)
+
+using namespace Geltan;
+using namespace PP;
+
+/*
+ * Compares the JSON backends on a page of a Payments::List reply.
+ *
+ * The default page is data/paymentlist.json, an anonymized reply of GET /v1/payments/payment
+ * in the compact wire format PayPal sends, with sales, an authorization with its capture, an
+ * order, a refund and a created payment. Set GELTAN_BENCHMARK_PAGE to the path of a captured
+ * reply to run the benchmark on your own data.
+ */
+class JsonBackendBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void parse_data();
+    void parse();
+    void load_data();
+    void load();
+
+private:
+    void addBackends();
+
+    QByteArray m_page;
+    int m_count = 0;
+    QJsonBackend m_qjson;
+    OnDemandJsonBackend m_onDemand;
+};
+
+
+void JsonBackendBenchmark::initTestCase()
+{
+    QString path = QString::fromLocal8Bit(qgetenv("GELTAN_BENCHMARK_PAGE"));
+    if (path.isEmpty()) {
+        path = QStringLiteral(":/data/paymentlist.json");
+    }
+
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(file.errorString()));
+    m_page = file.readAll();
+
+    QString error;
+    const PPJsonDocument doc = m_qjson.parse(m_page, &error);
+    QVERIFY2(!doc.isNull(), qPrintable(error));
+    QVERIFY2(!m_onDemand.parse(m_page, &error).isNull(), qPrintable(error));
+
+    m_count = doc.root().value(QLatin1String("payments")).count();
+    QVERIFY(m_count > 0);
+}
+
+
+void JsonBackendBenchmark::addBackends()
+{
+    QTest::addColumn<const PPJsonBackend*>("backend");
+
+    QTest::newRow("QJsonBackend") << static_cast<const PPJsonBackend*>(&m_qjson);
+    QTest::newRow("OnDemandJsonBackend") << static_cast<const PPJsonBackend*>(&m_onDemand);
+}
+
+
+void JsonBackendBenchmark::parse_data()
+{
+    addBackends();
+}
+
+
+void JsonBackendBenchmark::parse()
+{
+    QFETCH(const PPJsonBackend*, backend);
+
+    QBENCHMARK {
+        const PPJsonDocument doc = backend->parse(m_page);
+        QVERIFY(doc.isObject());
+    }
+}
+
+
+void JsonBackendBenchmark::load_data()
+{
+    addBackends();
+}
+
+
+void JsonBackendBenchmark::load()
+{
+    QFETCH(const PPJsonBackend*, backend);
+
+    PaymentList list;
+
+    QBENCHMARK {
+        const PPJsonDocument doc = backend->parse(m_page);
+        list.loadFromJson(doc.root());
+    }
+
+    QCOMPARE(list.rowCount(), m_count);
+    QCOMPARE(list.count(), m_count);
+}
+
+QTEST_GUILESS_MAIN(JsonBackendBenchmark)
+
+#include "jsonbackendbenchmark.moc"
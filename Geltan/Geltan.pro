@@ -1,4 +1,4 @@
-QT       += network
+QT       += network sql concurrent
 
 QT       -= gui
 
@@ -96,6 +96,9 @@ HEADERS += geltan_global.h \
     PP/Payments/create.h \
     PP/Payments/create_p.h \
     PP/ppenumsmap.h \
+    PP/pptokenhash_p.h \
+    PP/ppjsonfields_p.h \
+    PP/pploadscope_p.h \
     PP/Payments/execute.h \
     PP/Payments/execute_p.h \
     PP/Objects/payee.h \
@@ -107,7 +110,60 @@ HEADERS += geltan_global.h \
     PP/pplistbase.h \
     PP/pplistbase_p.h \
     PP/Payments/get.h \
-    PP/Payments/get_p.h
+    PP/Payments/get_p.h \
+    PP/Values/ppvaluesbase_p.h \
+    PP/Values/addressvalue.h \
+    PP/Values/addressvalue_p.h \
+    PP/Values/detailsvalue.h \
+    PP/Values/detailsvalue_p.h \
+    PP/Values/paymentamountvalue.h \
+    PP/Values/paymentamountvalue_p.h \
+    PP/Values/itemvalue.h \
+    PP/Values/itemvalue_p.h \
+    PP/Values/linkvalue.h \
+    PP/Values/linkvalue_p.h \
+    PP/Values/payervalue.h \
+    PP/Values/payervalue_p.h \
+    PP/Values/relatedresourcevalue.h \
+    PP/Values/relatedresourcevalue_p.h \
+    PP/Values/transactionvalue.h \
+    PP/Values/transactionvalue_p.h \
+    PP/Values/paymentvalue.h \
+    PP/Values/paymentvalue_p.h \
+    PP/Payments/shardedlist.h \
+    PP/Payments/shardedlist_p.h \
+    PP/Payments/export.h \
+    PP/Payments/export_p.h \
+    PP/Store/paymentstore.h \
+    PP/Store/paymentstore_p.h \
+    PP/Payments/sync.h \
+    PP/Payments/sync_p.h \
+    PP/Objects/paymentfiltermodel.h \
+    PP/Objects/paymentfiltermodel_p.h \
+    PP/Values/paymentcolumns.h \
+    PP/Values/paymentcolumns_p.h \
+    PP/Store/paymentarchive.h \
+    PP/Store/paymentarchive_p.h \
+    PP/Store/paymentarchivemodel.h \
+    PP/Store/paymentarchivemodel_p.h \
+    PP/Values/money.h \
+    PP/ppjsonwriter.h \
+    PP/Payments/paymenttemplate.h \
+    PP/Payments/paymenttemplate_p.h \
+    PP/Payments/update.h \
+    PP/Payments/update_p.h \
+    PP/ppstringpool.h \
+    PP/pptimestamp.h \
+    PP/ppjsonbackend.h \
+    PP/Values/ppvaluefields_p.h \
+    PP/Values/paymentsnapshot.h \
+    PP/Payments/paymentvalidator.h \
+    PP/ppjsonvalue.h \
+    PP/ppjsondocument.h \
+    PP/ppjsondocument_p.h \
+    PP/ppjsonparser_p.h \
+    PP/Values/fundinginstrumentvalue.h \
+    PP/Values/fundinginstrumentvalue_p.h
 
 SOURCES += \
     component.cpp \
@@ -149,4 +205,34 @@ SOURCES += \
     PP/Payments/list.cpp \
     PP/Objects/paymentlist.cpp \
     PP/pplistbase.cpp \
-    PP/Payments/get.cpp
+    PP/Payments/get.cpp \
+    PP/Values/addressvalue.cpp \
+    PP/Values/detailsvalue.cpp \
+    PP/Values/paymentamountvalue.cpp \
+    PP/Values/itemvalue.cpp \
+    PP/Values/linkvalue.cpp \
+    PP/Values/payervalue.cpp \
+    PP/Values/relatedresourcevalue.cpp \
+    PP/Values/transactionvalue.cpp \
+    PP/Values/paymentvalue.cpp \
+    PP/Payments/shardedlist.cpp \
+    PP/Payments/export.cpp \
+    PP/Store/paymentstore.cpp \
+    PP/Payments/sync.cpp \
+    PP/Objects/paymentfiltermodel.cpp \
+    PP/Values/paymentcolumns.cpp \
+    PP/Store/paymentarchive.cpp \
+    PP/Store/paymentarchivemodel.cpp \
+    PP/Values/money.cpp \
+    PP/ppjsonwriter.cpp \
+    PP/Payments/paymenttemplate.cpp \
+    PP/Payments/update.cpp \
+    PP/ppstringpool.cpp \
+    PP/pptimestamp.cpp \
+    PP/ppjsonbackend.cpp \
+    PP/Values/paymentsnapshot.cpp \
+    PP/Payments/paymentvalidator.cpp \
+    PP/ppjsonvalue.cpp \
+    PP/ppjsondocument.cpp \
+    PP/ppjsonparser.cpp \
+    PP/Values/fundinginstrumentvalue.cpp
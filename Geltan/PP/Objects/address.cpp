@@ -20,7 +20,11 @@
  */
 
 #include "address_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
+#include <Geltan/PP/Values/addressvalue.h>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -50,6 +54,13 @@ Address::Address(const QJsonObject &json, QObject *parent) :
 }
 
 
+Address::Address(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new AddressPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 
 Address::~Address()
 {
@@ -246,6 +257,37 @@ QVariantMap Address::toVariant()
 
 
 
+void Address::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(Address);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("line1"), line1().simplified(), 100);
+    d->writeString(writer, QLatin1String("line2"), line2().simplified(), 100);
+    d->writeString(writer, QLatin1String("city"), city().simplified(), 50);
+    d->writeString(writer, QLatin1String("country_code"), countryCode().simplified(), 2);
+    d->writeString(writer, QLatin1String("postal_code"), postalCode().simplified(), 20);
+
+    if (countryCode().compare(QLatin1String("us"), Qt::CaseInsensitive) == 0) {
+        d->writeString(writer, QLatin1String("state"), state().simplified(), 2);
+    } else {
+        d->writeString(writer, QLatin1String("state"), state().simplified(), 100);
+    }
+
+    d->writePhoneNumber(writer, QLatin1String("phone"), phone());
+
+    if (status() == CONFIRMED) {
+        writer->writeString(QLatin1String("status"), QStringLiteral("CONFIRMED"));
+    }
+
+    d->writeString(writer, QLatin1String("type"), type().simplified());
+
+    writer->endObject();
+}
+
+
+
 QJsonObject Address::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -260,33 +302,78 @@ void Address::loadFromJson(const QJsonDocument &json)
 
 
 void Address::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+namespace {
+
+// keep in the same order as addressFields
+enum AddressField {
+    AddressFieldCity,
+    AddressFieldCountryCode,
+    AddressFieldLine1,
+    AddressFieldLine2,
+    AddressFieldNormalizationStatus,
+    AddressFieldPhone,
+    AddressFieldPostalCode,
+    AddressFieldState,
+    AddressFieldStatus,
+    AddressFieldType,
+    AddressFieldCount
+};
+
+constexpr PPJsonField addressFields[] = {
+    PPJsonField("city"),
+    PPJsonField("country_code"),
+    PPJsonField("line1"),
+    PPJsonField("line2"),
+    PPJsonField("normalization_status"),
+    PPJsonField("phone"),
+    PPJsonField("postal_code"),
+    PPJsonField("state"),
+    PPJsonField("status"),
+    PPJsonField("type")
+};
+
+Q_STATIC_ASSERT(sizeof(addressFields) / sizeof(PPJsonField) == AddressFieldCount);
+
+}
+
+
+void Address::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<AddressFieldCount> f(json, addressFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(Address);
 
-    setLine1(json.value(QStringLiteral("line1")).toString());
+    setLine1(f[AddressFieldLine1].toString());
 
-    setLine2(json.value(QStringLiteral("line2")).toString());
+    setLine2(f[AddressFieldLine2].toString());
 
-    setCity(json.value(QStringLiteral("city")).toString());
+    setCity(f[AddressFieldCity].toString());
 
-    setCountryCode(json.value(QStringLiteral("country_code")).toString());
+    setCountryCode(PPStringPool::intern(f[AddressFieldCountryCode].toString()));
 
-    setPostalCode(json.value(QStringLiteral("postal_code")).toString());
+    setPostalCode(f[AddressFieldPostalCode].toString());
 
-    const QString stateString = json.value(QStringLiteral("state")).toString();
+    const QString stateString = f[AddressFieldState].toString();
     if (QString::compare(stateString, QStringLiteral("Empty"), Qt::CaseInsensitive) == 0) {
         setState(QString());
     } else {
         setState(stateString);
     }
 
-    setPhone(json.value(QStringLiteral("phone")).toString());
+    setPhone(f[AddressFieldPhone].toString());
 
-    const QString ns = json.value(QStringLiteral("normalization_status")).toString();
+    const QString ns = f[AddressFieldNormalizationStatus].toString();
     if (ns == QLatin1String("UNNORMALIZED_USER_PREFERRED")) {
         d->setNormalizationStatus(UNNORMALIZED_USER_PREFERRED);
     } else if (ns == QLatin1String("NORMALIZED")) {
@@ -297,7 +384,7 @@ void Address::loadFromJson(const QJsonObject &json)
         d->setNormalizationStatus(UNKNOWN);
     }
 
-    const QString ss = json.value(QStringLiteral("status")).toString();
+    const QString ss = f[AddressFieldStatus].toString();
     if (ss == QLatin1String("CONFIRMED")) {
         setStatus(CONFIRMED);
     } else if (ss == QLatin1String("UNCONFIRMED")) {
@@ -306,5 +393,25 @@ void Address::loadFromJson(const QJsonObject &json)
         setStatus(NO_STATUS);
     }
 
-    setType(json.value(QStringLiteral("type")).toString());
+    setType(PPStringPool::intern(f[AddressFieldType].toString()));
+}
+
+
+
+AddressValue Address::toValue() const
+{
+    AddressValue v;
+
+    v.setLine1(line1());
+    v.setLine2(line2());
+    v.setCity(city());
+    v.setCountryCode(countryCode());
+    v.setPostalCode(postalCode());
+    v.setState(state());
+    v.setPhone(phone());
+    v.setNormalizationStatus(normalizationStatus());
+    v.setStatus(status());
+    v.setType(type());
+
+    return v;
 }
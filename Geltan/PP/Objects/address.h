@@ -26,11 +26,14 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class AddressPrivate;
+class PPJsonWriter;
+class AddressValue;
 
 /*!
  * \brief Contains basic address data.
@@ -185,6 +188,11 @@ public:
      */
     Address(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Address object from a value of a PPJsonDocument.
+     */
+    Address(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Address object.
      */
@@ -248,6 +256,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -265,6 +281,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Address object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared AddressValue containing the address data, including the read only members.
+     */
+    AddressValue toValue() const;
+
 
 Q_SIGNALS:
     void line1Changed(const QString &line1);
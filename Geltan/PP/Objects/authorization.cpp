@@ -20,12 +20,15 @@
  */
 
 #include "authorization_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/paymentamount.h>
 #include <Geltan/PP/Objects/fmfdetails.h>
 #include <Geltan/PP/Objects/link.h>
 #include <Geltan/PP/ppenumsmap.h>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <Geltan/PP/pptimestamp.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -54,6 +57,13 @@ Authorization::Authorization(const QJsonObject &json, QObject *parent) :
 }
 
 
+Authorization::Authorization(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new AuthorizationPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 Authorization::~Authorization()
 {
 }
@@ -234,20 +244,73 @@ void Authorization::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Authorization::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as authorizationFields
+enum AuthorizationField {
+    AuthorizationFieldAmount,
+    AuthorizationFieldCreateTime,
+    AuthorizationFieldFmfDetails,
+    AuthorizationFieldId,
+    AuthorizationFieldLinks,
+    AuthorizationFieldParentPayment,
+    AuthorizationFieldPaymentMode,
+    AuthorizationFieldProtectionEligibility,
+    AuthorizationFieldProtectionEligibilityType,
+    AuthorizationFieldReasonCode,
+    AuthorizationFieldReceiptId,
+    AuthorizationFieldReferenceId,
+    AuthorizationFieldState,
+    AuthorizationFieldUpdateTime,
+    AuthorizationFieldValidUntil,
+    AuthorizationFieldCount
+};
+
+constexpr PPJsonField authorizationFields[] = {
+    PPJsonField("amount"),
+    PPJsonField("create_time"),
+    PPJsonField("fmf_details"),
+    PPJsonField("id"),
+    PPJsonField("links"),
+    PPJsonField("parent_payment"),
+    PPJsonField("payment_mode"),
+    PPJsonField("protection_eligibility"),
+    PPJsonField("protection_eligibility_type"),
+    PPJsonField("reason_code"),
+    PPJsonField("receipt_id"),
+    PPJsonField("reference_id"),
+    PPJsonField("state"),
+    PPJsonField("update_time"),
+    PPJsonField("valid_until")
+};
+
+Q_STATIC_ASSERT(sizeof(authorizationFields) / sizeof(PPJsonField) == AuthorizationFieldCount);
+
+}
+
+
+void Authorization::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(Authorization);
+    const PPJsonFields<AuthorizationFieldCount> f(json, authorizationFields);
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    Q_D(Authorization);
 
-    d->setId(json.value(QStringLiteral("id")).toString());
+    d->setId(f[AuthorizationFieldId].toString());
 
-    const QJsonObject ao = json.value(QStringLiteral("amount")).toObject();
+    const PPJsonValue ao = f[AuthorizationFieldAmount].toObject();
     PaymentAmount *oldAo = amount();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -261,28 +324,28 @@ void Authorization::loadFromJson(const QJsonObject &json)
     }
 
 
-    d->setPaymentMode(em->paymentModeTypeTokenToEnum(json.value(QStringLiteral("payment_mode")).toString()));
+    d->setPaymentMode(PPEnumsMap::paymentModeTypeTokenToEnum(f[AuthorizationFieldPaymentMode].toString()));
 
-    d->setState(em->stateTypeTokenToEnum(json.value(QStringLiteral("state")).toString()));
+    d->setState(PPEnumsMap::stateTypeTokenToEnum(f[AuthorizationFieldState].toString()));
 
-    d->setReasonCode(em->reasonCodeTokenToEnum(json.value(QStringLiteral("reason_code")).toString()));
+    d->setReasonCode(PPEnumsMap::reasonCodeTokenToEnum(f[AuthorizationFieldReasonCode].toString()));
 
-    d->setProtectionEligibility(em->protectionEligibilityTokenToEnum(json.value(QStringLiteral("protection_eligibility")).toString()));
+    d->setProtectionEligibility(PPEnumsMap::protectionEligibilityTokenToEnum(f[AuthorizationFieldProtectionEligibility].toString()));
 
-    const QString pets = json.value(QStringLiteral("protection_eligibility_type")).toString();
+    const QString pets = f[AuthorizationFieldProtectionEligibilityType].toString();
     if (!pets.isEmpty()) {
         QList<Geltan::PP::PayPal::ProtectionEligibilityType> petList;
         const QStringList petsList = pets.split(QChar(','));
         petList.reserve(petsList.size());
         for (const QString &pet : petsList) {
-            petList.append(em->protectionEligibilityTypeTokenToEnum(pet));
+            petList.append(PPEnumsMap::protectionEligibilityTypeTokenToEnum(pet));
         }
         d->setProtectionEligibilityType(petList);
     } else {
         d->setProtectionEligibilityType(QList<Geltan::PP::PayPal::ProtectionEligibilityType>());
     }
 
-    const QJsonObject fmfo = json.value(QStringLiteral("fmf_details")).toObject();
+    const PPJsonValue fmfo = f[AuthorizationFieldFmfDetails].toObject();
     FMFDetails *oldFmf = fmfDetails();
     if (!fmfo.isEmpty()) {
         if (oldFmf) {
@@ -295,39 +358,39 @@ void Authorization::loadFromJson(const QJsonObject &json)
         delete oldFmf;
     }
 
-    d->setParentPayment(json.value(QStringLiteral("parent_payment")).toString());
+    d->setParentPayment(f[AuthorizationFieldParentPayment].toString());
 
-    const QString vu = json.value(QStringLiteral("valid_until")).toString();
+    const QString vu = f[AuthorizationFieldValidUntil].toString();
     if (!vu.isEmpty()) {
-        d->setValidUntil(QDateTime::fromString(vu, Qt::ISODate));
+        d->setValidUntil(PPTimestamp::toDateTime(vu));
     } else {
         d->setValidUntil(QDateTime());
     }
 
-    const QString ct = json.value(QStringLiteral("create_time")).toString();
+    const QString ct = f[AuthorizationFieldCreateTime].toString();
     if (!ct.isEmpty()) {
-        d->setCreateTime(QDateTime::fromString(ct, Qt::ISODate));
+        d->setCreateTime(PPTimestamp::toDateTime(ct));
     } else {
         d->setCreateTime(QDateTime());
     }
 
-    const QString ut = json.value(QStringLiteral("update_time")).toString();
+    const QString ut = f[AuthorizationFieldUpdateTime].toString();
     if (!ut.isEmpty()) {
-        d->setUpdateTime(QDateTime::fromString(ut, Qt::ISODate));
+        d->setUpdateTime(PPTimestamp::toDateTime(ut));
     } else {
         d->setUpdateTime(QDateTime());
     }
 
-    d->setReferenceId(json.value(QStringLiteral("reference_id")).toString());
+    d->setReferenceId(f[AuthorizationFieldReferenceId].toString());
 
-    d->setReceiptId(json.value(QStringLiteral("receipt_id")).toString());
+    d->setReceiptId(f[AuthorizationFieldReceiptId].toString());
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
+    const PPJsonValue la = f[AuthorizationFieldLinks].toArray();
     d->clearLinks();
     Q_EMIT linksChanged(links());
     if (!la.isEmpty()) {
         QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
+        PPJsonValue::const_iterator i = la.constBegin();
         while (i != la.constEnd()) {
             linksToAdd.append(new Link(i->toObject()));
             ++i;
@@ -28,6 +28,7 @@
 #include <QJsonObject>
 #include <QUrl>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/ppenums.h>
 
 namespace Geltan {
@@ -243,6 +244,11 @@ public:
      */
     Authorization(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Authorization object from a value of a PPJsonDocument.
+     */
+    Authorization(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Authorization object.
      */
@@ -308,6 +314,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Authorization object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 Q_SIGNALS:
     void idChanged(const QString &id);
     void amountChanged(PaymentAmount *amount);
@@ -20,6 +20,7 @@
  */
 
 #include "billinginstrument_p.h"
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #include <Geltan/PP/Objects/installmentdescription.h>
 #ifdef QT_DEBUG
@@ -50,6 +51,13 @@ BillingInstrument::BillingInstrument(const QJsonObject &json, QObject *parent) :
 }
 
 
+BillingInstrument::BillingInstrument(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new BillingInstrumentPrivate)
+{
+    loadFromJson(json);
+}
+
+
 BillingInstrument::~BillingInstrument()
 {
 
@@ -106,6 +114,22 @@ QVariantMap BillingInstrument::toVariant()
 
 
 
+void BillingInstrument::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(BillingInstrument);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("billing_agreement_id"), billingAgreementId());
+    if (selectedInstallmentOption()) {
+        selectedInstallmentOption()->writeJson(writer, QLatin1String("selected_installment_option"));
+    }
+
+    writer->endObject();
+}
+
+
+
 QJsonObject BillingInstrument::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -119,16 +143,24 @@ void BillingInstrument::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void BillingInstrument::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+void BillingInstrument::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setBillingAgreementId(json.value(QStringLiteral("billing_agreement_id")).toString());
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    setBillingAgreementId(json.value(QLatin1String("billing_agreement_id")).toString());
 
-    const QJsonObject sio = json.value(QStringLiteral("selected_installment_option")).toObject();
+    const PPJsonValue sio = json.value(QLatin1String("selected_installment_option")).toObject();
     InstallmentDescription *oldSio = selectedInstallmentOption();
     if (!sio.isEmpty()) {
         if (oldSio) {
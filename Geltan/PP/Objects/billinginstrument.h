@@ -26,12 +26,14 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class InstallmentDescription;
 class BillingInstrumentPrivate;
+class PPJsonWriter;
 
 /*!
  * \brief Contains information about a billing instrument.
@@ -85,6 +87,11 @@ public:
      */
     BillingInstrument(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new BillingInstrument object from a value of a PPJsonDocument.
+     */
+    BillingInstrument(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the BillingInstrument object.
      */
@@ -106,6 +113,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -123,6 +138,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the BillingInstrument object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void billingAgreementIdChanged(const QString &billingAgreementId);
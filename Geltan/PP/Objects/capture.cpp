@@ -20,11 +20,14 @@
  */
 
 #include "capture_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/paymentamount.h>
 #include <Geltan/PP/Objects/currency.h>
 #include <Geltan/PP/Objects/link.h>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <Geltan/PP/pptimestamp.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -53,6 +56,13 @@ Capture::Capture(const QJsonObject &json, QObject *parent) :
 }
 
 
+Capture::Capture(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new CapturePrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 
 Capture::~Capture()
 {
@@ -217,20 +227,65 @@ void Capture::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Capture::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as captureFields
+enum CaptureField {
+    CaptureFieldAmount,
+    CaptureFieldCreateTime,
+    CaptureFieldId,
+    CaptureFieldInvoiceNumber,
+    CaptureFieldIsFinalCapture,
+    CaptureFieldLinks,
+    CaptureFieldParentPayment,
+    CaptureFieldReasonCode,
+    CaptureFieldState,
+    CaptureFieldTransactionFee,
+    CaptureFieldUpdateTime,
+    CaptureFieldCount
+};
+
+constexpr PPJsonField captureFields[] = {
+    PPJsonField("amount"),
+    PPJsonField("create_time"),
+    PPJsonField("id"),
+    PPJsonField("invoice_number"),
+    PPJsonField("is_final_capture"),
+    PPJsonField("links"),
+    PPJsonField("parent_payment"),
+    PPJsonField("reason_code"),
+    PPJsonField("state"),
+    PPJsonField("transaction_fee"),
+    PPJsonField("update_time")
+};
+
+Q_STATIC_ASSERT(sizeof(captureFields) / sizeof(PPJsonField) == CaptureFieldCount);
+
+}
+
+
+void Capture::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(Capture);
+    const PPJsonFields<CaptureFieldCount> f(json, captureFields);
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    Q_D(Capture);
 
-    d->setId(json.value(QStringLiteral("id")).toString());
+    d->setId(f[CaptureFieldId].toString());
 
-    const QJsonObject ao = json.value(QStringLiteral("amount")).toObject();
+    const PPJsonValue ao = f[CaptureFieldAmount].toObject();
     PaymentAmount *oldAo = amount();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -243,17 +298,18 @@ void Capture::loadFromJson(const QJsonObject &json)
         delete oldAo;
     }
 
-    setIsFinalCapture(json.value(QStringLiteral("is_final_capture")).toString() == QLatin1String("true"));
+    const PPJsonValue ifc = f[CaptureFieldIsFinalCapture];
+    setIsFinalCapture(ifc.isBool() ? ifc.toBool() : (ifc.toString() == QLatin1String("true")));
 
-    d->setState(em->stateTypeTokenToEnum(json.value(QStringLiteral("state")).toString()));
+    d->setState(PPEnumsMap::stateTypeTokenToEnum(f[CaptureFieldState].toString()));
 
-    d->setReasonCode(em->reasonCodeTokenToEnum(json.value(QStringLiteral("reason_code")).toString()));
+    d->setReasonCode(PPEnumsMap::reasonCodeTokenToEnum(f[CaptureFieldReasonCode].toString()));
 
-    d->setParentPayment(json.value(QStringLiteral("parent_payment")).toString());
+    d->setParentPayment(f[CaptureFieldParentPayment].toString());
 
-    setInvoiceNumber(json.value(QStringLiteral("invoice_number")).toString());
+    setInvoiceNumber(f[CaptureFieldInvoiceNumber].toString());
 
-    const QJsonObject tf = json.value(QStringLiteral("transaction_fee")).toObject();
+    const PPJsonValue tf = f[CaptureFieldTransactionFee].toObject();
     Currency *oldTf = transactionFee();
     if (!tf.isEmpty()) {
         if (oldTf) {
@@ -266,26 +322,26 @@ void Capture::loadFromJson(const QJsonObject &json)
         delete oldTf;
     }
 
-    const QString ct = json.value(QStringLiteral("create_time")).toString();
+    const QString ct = f[CaptureFieldCreateTime].toString();
     if (!ct.isEmpty()) {
-        d->setCreateTime(QDateTime::fromString(ct, Qt::ISODate));
+        d->setCreateTime(PPTimestamp::toDateTime(ct));
     } else {
         d->setCreateTime(QDateTime());
     }
 
-    const QString ut = json.value(QStringLiteral("update_time")).toString();
+    const QString ut = f[CaptureFieldUpdateTime].toString();
     if (!ut.isEmpty()) {
-        d->setUpdateTime(QDateTime::fromString(ut, Qt::ISODate));
+        d->setUpdateTime(PPTimestamp::toDateTime(ut));
     } else {
         d->setUpdateTime(QDateTime());
     }
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
+    const PPJsonValue la = f[CaptureFieldLinks].toArray();
     d->clearLinks();
     Q_EMIT linksChanged(links());
     if (!la.isEmpty()) {
         QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
+        PPJsonValue::const_iterator i = la.constBegin();
         while (i != la.constEnd()) {
             linksToAdd.append(new Link(i->toObject(), this));
             ++i;
@@ -28,6 +28,7 @@
 #include <QJsonObject>
 #include <QUrl>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/ppenums.h>
 
 namespace Geltan {
@@ -215,6 +216,11 @@ public:
      */
     Capture(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Capture object from a value of a PPJsonDocument.
+     */
+    Capture(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Capture object.
      */
@@ -277,6 +283,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Capture object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void idChanged(const QString &id);
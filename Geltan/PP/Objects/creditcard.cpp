@@ -20,9 +20,12 @@
  */
 
 #include "creditcard_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <Geltan/PP/ppenumsmap.h>
+#include <Geltan/PP/pptimestamp.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -51,6 +54,13 @@ CreditCard::CreditCard(const QJsonObject &json, QObject *parent) :
 }
 
 
+CreditCard::CreditCard(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new CreditCardPrivate)
+{
+    loadFromJson(json);
+}
+
+
 CreditCard::~CreditCard()
 {
 
@@ -300,9 +310,7 @@ QVariantMap CreditCard::toVariant()
 
     d->addStringToVariantMap(&map, QStringLiteral("number"), number());
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
-
-    d->addStringToVariantMap(&map, QStringLiteral("type"), em->creditCardTypeEnumToToken(type()));
+    d->addStringToVariantMap(&map, QStringLiteral("type"), PPEnumsMap::creditCardTypeEnumToToken(type()));
     map.insert(QStringLiteral("expire_month"), expireMonth());
     map.insert(QStringLiteral("expire_year"), expireYear());
     d->addStringToVariantMap(&map, QStringLiteral("cvv2"), cvv2(), 4);
@@ -318,6 +326,29 @@ QVariantMap CreditCard::toVariant()
 
 
 
+void CreditCard::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(CreditCard);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("number"), number());
+    d->writeString(writer, QLatin1String("type"), PPEnumsMap::creditCardTypeEnumToToken(type()));
+    writer->writeInt(QLatin1String("expire_month"), expireMonth());
+    writer->writeInt(QLatin1String("expire_year"), expireYear());
+    d->writeString(writer, QLatin1String("cvv2"), cvv2(), 4);
+    d->writeString(writer, QLatin1String("first_name"), firstName());
+    d->writeString(writer, QLatin1String("last_name"), lastName());
+    if (billingAddress()) {
+        billingAddress()->writeJson(writer, QLatin1String("billing_address"));
+    }
+    d->writeString(writer, QLatin1String("external_customer_id"), externalCustomerId(), 256);
+
+    writer->endObject();
+}
+
+
+
 QJsonObject CreditCard::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -332,30 +363,77 @@ void CreditCard::loadFromJson(const QJsonDocument &json)
 
 
 void CreditCard::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+namespace {
+
+// keep in the same order as creditCardFields
+enum CreditCardField {
+    CreditCardFieldBillingAddress,
+    CreditCardFieldCvv2,
+    CreditCardFieldExpireMonth,
+    CreditCardFieldExpireYear,
+    CreditCardFieldExternalCustomerId,
+    CreditCardFieldFirstName,
+    CreditCardFieldLastName,
+    CreditCardFieldLinks,
+    CreditCardFieldNumber,
+    CreditCardFieldState,
+    CreditCardFieldType,
+    CreditCardFieldValidUntil,
+    CreditCardFieldCount
+};
+
+constexpr PPJsonField creditCardFields[] = {
+    PPJsonField("billing_address"),
+    PPJsonField("cvv2"),
+    PPJsonField("expire_month"),
+    PPJsonField("expire_year"),
+    PPJsonField("external_customer_id"),
+    PPJsonField("first_name"),
+    PPJsonField("last_name"),
+    PPJsonField("links"),
+    PPJsonField("number"),
+    PPJsonField("state"),
+    PPJsonField("type"),
+    PPJsonField("valid_until")
+};
+
+Q_STATIC_ASSERT(sizeof(creditCardFields) / sizeof(PPJsonField) == CreditCardFieldCount);
+
+}
+
+
+void CreditCard::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(CreditCard);
+    const PPJsonFields<CreditCardFieldCount> f(json, creditCardFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    Q_D(CreditCard);
 
-    setNumber(json.value(QStringLiteral("number")).toString());
+    setNumber(f[CreditCardFieldNumber].toString());
 
-    setType(em->creditCardTypeTokenToEnum(json.value(QStringLiteral("type")).toString()));
+    setType(PPEnumsMap::creditCardTypeTokenToEnum(f[CreditCardFieldType].toString()));
 
-    setExpireMonth(json.value(QStringLiteral("expire_month")).toString().toUInt());
+    setExpireMonth(f[CreditCardFieldExpireMonth].toString().toUInt());
 
-    setExpireYear(json.value(QStringLiteral("expire_year")).toString().toUInt());
+    setExpireYear(f[CreditCardFieldExpireYear].toString().toUInt());
 
-    setCvv2(json.value(QStringLiteral("cvv2")).toString());
+    setCvv2(f[CreditCardFieldCvv2].toString());
 
-    setFirstName(json.value(QStringLiteral("first_name")).toString());
+    setFirstName(f[CreditCardFieldFirstName].toString());
 
-    setLastName(json.value(QStringLiteral("last_name")).toString());
+    setLastName(f[CreditCardFieldLastName].toString());
 
-    const QJsonObject bao = json.value(QStringLiteral("billing_address")).toObject();
+    const PPJsonValue bao = f[CreditCardFieldBillingAddress].toObject();
     Address *oldBillingAddress = billingAddress();
     if (!bao.isEmpty()) {
         if (oldBillingAddress) {
@@ -369,9 +447,9 @@ void CreditCard::loadFromJson(const QJsonObject &json)
     }
 
 
-    setExternalCustomerId(json.value(QStringLiteral("external_customer_id")).toString());
+    setExternalCustomerId(f[CreditCardFieldExternalCustomerId].toString());
 
-    const QString sState = json.value(QStringLiteral("state")).toString();
+    const QString sState = f[CreditCardFieldState].toString();
     if (sState == QLatin1String("ok")) {
         setState(Ok);
     } else if (sState == QLatin1String("expired")) {
@@ -380,19 +458,19 @@ void CreditCard::loadFromJson(const QJsonObject &json)
         setState(NoState);
     }
 
-    const QString sValidUntil = json.value(QStringLiteral("valid_until")).toString();
+    const QString sValidUntil = f[CreditCardFieldValidUntil].toString();
     if (!sValidUntil.isEmpty()) {
-        setValidUntil(QDateTime::fromString(sValidUntil, Qt::ISODate));
+        setValidUntil(PPTimestamp::toDateTime(sValidUntil));
     } else {
         setValidUntil(QDateTime());
     }
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
+    const PPJsonValue la = f[CreditCardFieldLinks].toArray();
     d->clearLinks();
     Q_EMIT linksChanged(links());
     if (!la.isEmpty()) {
         QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
+        PPJsonValue::const_iterator i = la.constBegin();
         while (i != la.constEnd()) {
             linksToAdd.append(new Link(i->toObject()));
             ++i;
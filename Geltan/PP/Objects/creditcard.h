@@ -28,6 +28,7 @@
 #include <QJsonObject>
 #include <QUrl>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/ppenums.h>
 
 namespace Geltan {
@@ -36,6 +37,7 @@ namespace PP {
 class Address;
 class Link;
 class CreditCardPrivate;
+class PPJsonWriter;
 
 /*!
  * \brief Contains information about a credit card.
@@ -206,6 +208,11 @@ public:
      */
     CreditCard(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new CreditCard object from a value of a PPJsonDocument.
+     */
+    CreditCard(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the CreditCard object.
      */
@@ -284,6 +291,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -301,6 +316,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the CreditCard object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void numberChanged(const QString &number);
@@ -20,7 +20,9 @@
  */
 
 #include "currency_p.h"
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -49,6 +51,13 @@ Currency::Currency(const QJsonObject &json, QObject *parent) :
 }
 
 
+Currency::Currency(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new CurrencyPrivate)
+{
+    loadFromJson(json);
+}
+
+
 Currency::~Currency()
 {
 
@@ -74,15 +83,23 @@ void Currency::setCurrency(const QString &nCurrency)
 
 
 
-float Currency::value() const { Q_D(const Currency); return d->value; }
+float Currency::value() const { Q_D(const Currency); return d->value.toFloat(); }
 
 void Currency::setValue(float nValue)
 {
-    Q_D(Currency); 
+    setValueMoney(Money::fromDouble(nValue));
+}
+
+
+Money Currency::valueMoney() const { Q_D(const Currency); return d->value; }
+
+void Currency::setValueMoney(const Money &nValue)
+{
+    Q_D(Currency);
     if (nValue != d->value) {
         d->value = nValue;
 #ifdef QT_DEBUG
-        qDebug() << "Changed value to" << d->value;
+        qDebug() << "Changed value to" << d->value.toString();
 #endif
         Q_EMIT valueChanged(value());
     }
@@ -97,12 +114,26 @@ QVariantMap Currency::toVariant()
     QVariantMap map;
 
     d->addStringToVariantMap(&map, QStringLiteral("currency"), currency(), 3);
-    d->addFloatToVariantMap(&map, QStringLiteral("value"), value());
+    d->addMoneyToVariantMap(&map, QStringLiteral("value"), d->value, currency());
 
     return map;
 }
 
 
+
+void Currency::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(Currency);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("currency"), currency(), 3);
+    d->writeMoney(writer, QLatin1String("value"), d->value, currency());
+
+    writer->endObject();
+}
+
+
 QJsonObject Currency::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -117,12 +148,20 @@ void Currency::loadFromJson(const QJsonDocument &json)
 
 
 void Currency::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+void Currency::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setCurrency(json.value(QStringLiteral("currency")).toString());
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    setCurrency(PPStringPool::intern(json.value(QLatin1String("currency")).toString()));
 
-    setValue(json.value(QStringLiteral("value")).toString().toFloat());
+    setValueMoney(Money::fromJson(json.value(QLatin1String("value"))));
 }
@@ -26,11 +26,14 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
 
 namespace Geltan {
 namespace PP {
 
 class CurrencyPrivate;
+class PPJsonWriter;
 
 /*!
  * \brief Base object for all financial value related fields (balance, payment due, etc.)
@@ -80,6 +83,11 @@ public:
      */
     Currency(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Currency object from a value of a PPJsonDocument.
+     */
+    Currency(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Currency object.
      */
@@ -88,10 +96,12 @@ public:
 
     QString currency() const;
     float value() const;
+    Money valueMoney() const;
 
 
     void setCurrency(const QString &nCurrency);
     void setValue(float nValue);
+    void setValueMoney(const Money &nValue);
 
 
     /*!
@@ -101,6 +111,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -118,6 +136,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Currency object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 Q_SIGNALS:
     void currencyChanged(const QString &currency);
     void valueChanged(float value);
@@ -32,13 +32,13 @@ class CurrencyPrivate : public PPObjectsBasePrivate
 {
 public:
     CurrencyPrivate() :
-        value(0.0)
+        value()
     {}
 
     ~CurrencyPrivate() {}
 
     QString currency;
-    float value;
+    Money value;
 };
 
 }
@@ -20,8 +20,10 @@
  */
 
 #include "details_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
-#include <QtMath>
+#include <Geltan/PP/Values/detailsvalue.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -50,18 +52,25 @@ Details::Details(const QJsonObject &json, QObject *parent) :
 }
 
 
+Details::Details(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new DetailsPrivate)
+{
+    loadFromJson(json);
+}
+
+
 
 Details::Details(float subtotal, float shipping, float tax, float handlingFee, float shippingDiscount, float insurance, float giftWrap, QObject *parent) :
     QObject(parent), d_ptr(new DetailsPrivate)
 {
     Q_D(Details);
-    d->subtotal = subtotal;
-    d->shipping = shipping;
-    d->tax = tax;
-    d->handlingFee = handlingFee;
-    d->shippingDiscount = shippingDiscount;
-    d->insurance = insurance;
-    d->giftWrap = giftWrap;
+    d->subtotal = Money::fromDouble(subtotal);
+    d->shipping = Money::fromDouble(shipping);
+    d->tax = Money::fromDouble(tax);
+    d->handlingFee = Money::fromDouble(handlingFee);
+    d->shippingDiscount = Money::fromDouble(shippingDiscount);
+    d->insurance = Money::fromDouble(insurance);
+    d->giftWrap = Money::fromDouble(giftWrap);
 }
 
 
@@ -71,15 +80,23 @@ Details::~Details()
 }
 
 
-float Details::subtotal() const { Q_D(const Details); return d->subtotal; }
+float Details::subtotal() const { Q_D(const Details); return d->subtotal.toFloat(); }
 
 void Details::setSubtotal(float nSubtotal)
 {
-    Q_D(Details); 
+    setSubtotalMoney(Money::fromDouble(nSubtotal));
+}
+
+
+Money Details::subtotalMoney() const { Q_D(const Details); return d->subtotal; }
+
+void Details::setSubtotalMoney(const Money &nSubtotal)
+{
+    Q_D(Details);
     if (nSubtotal != d->subtotal) {
         d->subtotal = nSubtotal;
 #ifdef QT_DEBUG
-        qDebug() << "Changed subtotal to" << d->subtotal;
+        qDebug() << "Changed subtotal to" << d->subtotal.toString();
 #endif
         Q_EMIT subtotalChanged(subtotal());
     }
@@ -88,15 +105,23 @@ void Details::setSubtotal(float nSubtotal)
 
 
 
-float Details::shipping() const { Q_D(const Details); return d->shipping; }
+float Details::shipping() const { Q_D(const Details); return d->shipping.toFloat(); }
 
 void Details::setShipping(float nShipping)
 {
-    Q_D(Details); 
+    setShippingMoney(Money::fromDouble(nShipping));
+}
+
+
+Money Details::shippingMoney() const { Q_D(const Details); return d->shipping; }
+
+void Details::setShippingMoney(const Money &nShipping)
+{
+    Q_D(Details);
     if (nShipping != d->shipping) {
         d->shipping = nShipping;
 #ifdef QT_DEBUG
-        qDebug() << "Changed shipping to" << d->shipping;
+        qDebug() << "Changed shipping to" << d->shipping.toString();
 #endif
         Q_EMIT shippingChanged(shipping());
     }
@@ -105,15 +130,23 @@ void Details::setShipping(float nShipping)
 
 
 
-float Details::tax() const { Q_D(const Details); return d->tax; }
+float Details::tax() const { Q_D(const Details); return d->tax.toFloat(); }
 
 void Details::setTax(float nTax)
 {
-    Q_D(Details); 
+    setTaxMoney(Money::fromDouble(nTax));
+}
+
+
+Money Details::taxMoney() const { Q_D(const Details); return d->tax; }
+
+void Details::setTaxMoney(const Money &nTax)
+{
+    Q_D(Details);
     if (nTax != d->tax) {
         d->tax = nTax;
 #ifdef QT_DEBUG
-        qDebug() << "Changed tax to" << d->tax;
+        qDebug() << "Changed tax to" << d->tax.toString();
 #endif
         Q_EMIT taxChanged(tax());
     }
@@ -122,15 +155,23 @@ void Details::setTax(float nTax)
 
 
 
-float Details::handlingFee() const { Q_D(const Details); return d->handlingFee; }
+float Details::handlingFee() const { Q_D(const Details); return d->handlingFee.toFloat(); }
 
 void Details::setHandlingFee(float nHandlingFee)
 {
-    Q_D(Details); 
+    setHandlingFeeMoney(Money::fromDouble(nHandlingFee));
+}
+
+
+Money Details::handlingFeeMoney() const { Q_D(const Details); return d->handlingFee; }
+
+void Details::setHandlingFeeMoney(const Money &nHandlingFee)
+{
+    Q_D(Details);
     if (nHandlingFee != d->handlingFee) {
         d->handlingFee = nHandlingFee;
 #ifdef QT_DEBUG
-        qDebug() << "Changed handlingFee to" << d->handlingFee;
+        qDebug() << "Changed handlingFee to" << d->handlingFee.toString();
 #endif
         Q_EMIT handlingFeeChanged(handlingFee());
     }
@@ -139,15 +180,23 @@ void Details::setHandlingFee(float nHandlingFee)
 
 
 
-float Details::shippingDiscount() const { Q_D(const Details); return d->shippingDiscount; }
+float Details::shippingDiscount() const { Q_D(const Details); return d->shippingDiscount.toFloat(); }
 
 void Details::setShippingDiscount(float nShippingDiscount)
 {
-    Q_D(Details); 
+    setShippingDiscountMoney(Money::fromDouble(nShippingDiscount));
+}
+
+
+Money Details::shippingDiscountMoney() const { Q_D(const Details); return d->shippingDiscount; }
+
+void Details::setShippingDiscountMoney(const Money &nShippingDiscount)
+{
+    Q_D(Details);
     if (nShippingDiscount != d->shippingDiscount) {
         d->shippingDiscount = nShippingDiscount;
 #ifdef QT_DEBUG
-        qDebug() << "Changed shippingDiscount to" << d->shippingDiscount;
+        qDebug() << "Changed shippingDiscount to" << d->shippingDiscount.toString();
 #endif
         Q_EMIT shippingDiscountChanged(shippingDiscount());
     }
@@ -156,15 +205,23 @@ void Details::setShippingDiscount(float nShippingDiscount)
 
 
 
-float Details::insurance() const { Q_D(const Details); return d->insurance; }
+float Details::insurance() const { Q_D(const Details); return d->insurance.toFloat(); }
 
 void Details::setInsurance(float nInsurance)
 {
-    Q_D(Details); 
+    setInsuranceMoney(Money::fromDouble(nInsurance));
+}
+
+
+Money Details::insuranceMoney() const { Q_D(const Details); return d->insurance; }
+
+void Details::setInsuranceMoney(const Money &nInsurance)
+{
+    Q_D(Details);
     if (nInsurance != d->insurance) {
         d->insurance = nInsurance;
 #ifdef QT_DEBUG
-        qDebug() << "Changed insurance to" << d->insurance;
+        qDebug() << "Changed insurance to" << d->insurance.toString();
 #endif
         Q_EMIT insuranceChanged(insurance());
     }
@@ -173,15 +230,23 @@ void Details::setInsurance(float nInsurance)
 
 
 
-float Details::giftWrap() const { Q_D(const Details); return d->giftWrap; }
+float Details::giftWrap() const { Q_D(const Details); return d->giftWrap.toFloat(); }
 
 void Details::setGiftWrap(float nGiftWrap)
 {
-    Q_D(Details); 
+    setGiftWrapMoney(Money::fromDouble(nGiftWrap));
+}
+
+
+Money Details::giftWrapMoney() const { Q_D(const Details); return d->giftWrap; }
+
+void Details::setGiftWrapMoney(const Money &nGiftWrap)
+{
+    Q_D(Details);
     if (nGiftWrap != d->giftWrap) {
         d->giftWrap = nGiftWrap;
 #ifdef QT_DEBUG
-        qDebug() << "Changed giftWrap to" << d->giftWrap;
+        qDebug() << "Changed giftWrap to" << d->giftWrap.toString();
 #endif
         Q_EMIT giftWrapChanged(giftWrap());
     }
@@ -195,28 +260,37 @@ QVariantMap Details::toVariant(const QString &currency)
 
     QVariantMap map;
 
-    if (QStringList({QStringLiteral("HUF"), QStringLiteral("JPY"), QStringLiteral("TWD")}).contains(currency)) {
-        d->addIntToVariantMap(&map, QStringLiteral("subtotal"), qFloor(subtotal()));
-        d->addIntToVariantMap(&map, QStringLiteral("shipping"), qFloor(shipping()));
-        d->addIntToVariantMap(&map, QStringLiteral("tax"), qFloor(tax()));
-        d->addIntToVariantMap(&map, QStringLiteral("handling_fee"), qFloor(handlingFee()));
-        d->addIntToVariantMap(&map, QStringLiteral("shipping_discount"), qFloor(shippingDiscount()));
-        d->addIntToVariantMap(&map, QStringLiteral("insurance"), qFloor(insurance()));
-        d->addIntToVariantMap(&map, QStringLiteral("gift_wrap"), qFloor(giftWrap()));
-    } else {
-        d->addFloatToVariantMap(&map, QStringLiteral("subtotal"), subtotal());
-        d->addFloatToVariantMap(&map, QStringLiteral("shipping"), shipping());
-        d->addFloatToVariantMap(&map, QStringLiteral("tax"), tax());
-        d->addFloatToVariantMap(&map, QStringLiteral("handling_fee"), handlingFee());
-        d->addFloatToVariantMap(&map, QStringLiteral("shipping_discount"), shippingDiscount());
-        d->addFloatToVariantMap(&map, QStringLiteral("insurance"), insurance());
-        d->addFloatToVariantMap(&map, QStringLiteral("gift_wrap"), giftWrap());
-    }
+    d->addMoneyToVariantMap(&map, QStringLiteral("subtotal"), d->subtotal, currency);
+    d->addMoneyToVariantMap(&map, QStringLiteral("shipping"), d->shipping, currency);
+    d->addMoneyToVariantMap(&map, QStringLiteral("tax"), d->tax, currency);
+    d->addMoneyToVariantMap(&map, QStringLiteral("handling_fee"), d->handlingFee, currency);
+    d->addMoneyToVariantMap(&map, QStringLiteral("shipping_discount"), d->shippingDiscount, currency);
+    d->addMoneyToVariantMap(&map, QStringLiteral("insurance"), d->insurance, currency);
+    d->addMoneyToVariantMap(&map, QStringLiteral("gift_wrap"), d->giftWrap, currency);
 
     return map;
 }
 
 
+
+void Details::writeJson(PPJsonWriter *writer, const QString &currency, QLatin1String name)
+{
+    Q_D(Details);
+
+    writer->beginObject(name);
+
+    d->writeMoney(writer, QLatin1String("subtotal"), d->subtotal, currency);
+    d->writeMoney(writer, QLatin1String("shipping"), d->shipping, currency);
+    d->writeMoney(writer, QLatin1String("tax"), d->tax, currency);
+    d->writeMoney(writer, QLatin1String("handling_fee"), d->handlingFee, currency);
+    d->writeMoney(writer, QLatin1String("shipping_discount"), d->shippingDiscount, currency);
+    d->writeMoney(writer, QLatin1String("insurance"), d->insurance, currency);
+    d->writeMoney(writer, QLatin1String("gift_wrap"), d->giftWrap, currency);
+
+    writer->endObject();
+}
+
+
 QJsonObject Details::toJsonObject(const QString &currency)
 {
     return QJsonObject::fromVariantMap(this->toVariant(currency));
@@ -231,24 +305,82 @@ void Details::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Details::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as detailsFields
+enum DetailsField {
+    DetailsFieldGiftWrap,
+    DetailsFieldHandlingFee,
+    DetailsFieldInsurance,
+    DetailsFieldShipping,
+    DetailsFieldShippingDiscount,
+    DetailsFieldSubtotal,
+    DetailsFieldTax,
+    DetailsFieldCount
+};
+
+constexpr PPJsonField detailsFields[] = {
+    PPJsonField("gift_wrap"),
+    PPJsonField("handling_fee"),
+    PPJsonField("insurance"),
+    PPJsonField("shipping"),
+    PPJsonField("shipping_discount"),
+    PPJsonField("subtotal"),
+    PPJsonField("tax")
+};
+
+Q_STATIC_ASSERT(sizeof(detailsFields) / sizeof(PPJsonField) == DetailsFieldCount);
+
+}
+
+
+void Details::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setSubtotal(json.value(QStringLiteral("subtotal")).toString().toFloat());
+    const PPJsonFields<DetailsFieldCount> f(json, detailsFields);
 
-    setShipping(json.value(QStringLiteral("shipping")).toString().toFloat());
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    setTax(json.value(QStringLiteral("tax")).toString().toFloat());
+    setSubtotalMoney(Money::fromJson(f[DetailsFieldSubtotal]));
 
-    setHandlingFee(json.value(QStringLiteral("handling_fee")).toString().toFloat());
+    setShippingMoney(Money::fromJson(f[DetailsFieldShipping]));
+
+    setTaxMoney(Money::fromJson(f[DetailsFieldTax]));
+
+    setHandlingFeeMoney(Money::fromJson(f[DetailsFieldHandlingFee]));
+
+    setShippingDiscountMoney(Money::fromJson(f[DetailsFieldShippingDiscount]));
+
+    setInsuranceMoney(Money::fromJson(f[DetailsFieldInsurance]));
+
+    setGiftWrapMoney(Money::fromJson(f[DetailsFieldGiftWrap]));
+}
+
+
+
+DetailsValue Details::toValue() const
+{
+    Q_D(const Details);
 
-    setShippingDiscount(json.value(QStringLiteral("shipping_discount")).toString().toFloat());
+    DetailsValue v;
 
-    setInsurance(json.value(QStringLiteral("insurance")).toString().toFloat());
+    v.setSubtotalMoney(d->subtotal);
+    v.setShippingMoney(d->shipping);
+    v.setTaxMoney(d->tax);
+    v.setHandlingFeeMoney(d->handlingFee);
+    v.setShippingDiscountMoney(d->shippingDiscount);
+    v.setInsuranceMoney(d->insurance);
+    v.setGiftWrapMoney(d->giftWrap);
 
-    setGiftWrap(json.value(QStringLiteral("gift_wrap")).toString().toFloat());
+    return v;
 }
@@ -26,11 +26,15 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
 
 namespace Geltan {
 namespace PP {
 
 class DetailsPrivate;
+class PPJsonWriter;
+class DetailsValue;
 
 /*!
  * \brief Contains details about a price / amount.
@@ -137,6 +141,11 @@ public:
      */
     Details(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Details object from a value of a PPJsonDocument.
+     */
+    Details(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Constructs a new Details object from the given arguments.
      */
@@ -148,20 +157,34 @@ public:
     ~Details();
 
     float subtotal() const;
+    Money subtotalMoney() const;
     float shipping() const;
+    Money shippingMoney() const;
     float tax() const;
+    Money taxMoney() const;
     float handlingFee() const;
+    Money handlingFeeMoney() const;
     float shippingDiscount() const;
+    Money shippingDiscountMoney() const;
     float insurance() const;
+    Money insuranceMoney() const;
     float giftWrap() const;
+    Money giftWrapMoney() const;
 
     void setSubtotal(float nSubtotal);
+    void setSubtotalMoney(const Money &nSubtotal);
     void setShipping(float nShipping);
+    void setShippingMoney(const Money &nShipping);
     void setTax(float nTax);
+    void setTaxMoney(const Money &nTax);
     void setHandlingFee(float nHandlingFee);
+    void setHandlingFeeMoney(const Money &nHandlingFee);
     void setShippingDiscount(float nShippingDiscount);
+    void setShippingDiscountMoney(const Money &nShippingDiscount);
     void setInsurance(float nInsurance);
+    void setInsuranceMoney(const Money &nInsurance);
     void setGiftWrap(float nGiftWrap);
+    void setGiftWrapMoney(const Money &nGiftWrap);
 
     /*!
      * \brief Returns a QVariantMap containing the object's data members.
@@ -171,6 +194,14 @@ public:
      */
     QVariantMap toVariant(const QString &currency);
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, const QString &currency, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -189,6 +220,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Details object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared DetailsValue containing the details data, including the read only members.
+     */
+    DetailsValue toValue() const;
+
 
 Q_SIGNALS:
     void subtotalChanged(float subtotal);
@@ -32,24 +32,24 @@ class DetailsPrivate : public PPObjectsBasePrivate
 {
 public:
     DetailsPrivate() :
-        subtotal(0.0),
-        shipping(0.0),
-        tax(0.0),
-        handlingFee(0.0),
-        shippingDiscount(0.0),
-        insurance(0.0),
-        giftWrap(0.0)
+        subtotal(),
+        shipping(),
+        tax(),
+        handlingFee(),
+        shippingDiscount(),
+        insurance(),
+        giftWrap()
     {}
 
     ~DetailsPrivate() {}
 
-    float subtotal;
-    float shipping;
-    float tax;
-    float handlingFee;
-    float shippingDiscount;
-    float insurance;
-    float giftWrap;
+    Money subtotal;
+    Money shipping;
+    Money tax;
+    Money handlingFee;
+    Money shippingDiscount;
+    Money insurance;
+    Money giftWrap;
 };
 
 }
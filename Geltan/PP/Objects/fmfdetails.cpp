@@ -21,6 +21,8 @@
 
 
 #include "fmfdetails_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #include <QJsonObject>
 #ifdef QT_DEBUG
@@ -51,6 +53,13 @@ FMFDetails::FMFDetails(const QJsonObject &json, QObject *parent) :
 }
 
 
+FMFDetails::FMFDetails(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new FMFDetailsPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 FMFDetails::~FMFDetails()
 {
 }
@@ -75,17 +84,50 @@ void FMFDetails::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void FMFDetails::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as fMFDetailsFields
+enum FMFDetailsField {
+    FMFDetailsFieldDescription,
+    FMFDetailsFieldFilterId,
+    FMFDetailsFieldFilterType,
+    FMFDetailsFieldName,
+    FMFDetailsFieldCount
+};
+
+constexpr PPJsonField fMFDetailsFields[] = {
+    PPJsonField("description"),
+    PPJsonField("filter_id"),
+    PPJsonField("filter_type"),
+    PPJsonField("name")
+};
+
+Q_STATIC_ASSERT(sizeof(fMFDetailsFields) / sizeof(PPJsonField) == FMFDetailsFieldCount);
+
+}
+
+
+void FMFDetails::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<FMFDetailsFieldCount> f(json, fMFDetailsFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(FMFDetails);
 
-    d->setFilterType(json.value(QStringLiteral("filter_type")).toString());
-    d->setFilterId(json.value(QStringLiteral("filter_id")).toString());
-    d->setName(json.value(QStringLiteral("name")).toString());
-    d->setDescription(json.value(QStringLiteral("description")).toString());
+    d->setFilterType(f[FMFDetailsFieldFilterType].toString());
+    d->setFilterId(f[FMFDetailsFieldFilterId].toString());
+    d->setName(f[FMFDetailsFieldName].toString());
+    d->setDescription(f[FMFDetailsFieldDescription].toString());
 }
@@ -25,6 +25,7 @@
 
 #include <QObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
@@ -101,6 +102,11 @@ public:
      */
     FMFDetails(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new FMFDetails object from a value of a PPJsonDocument.
+     */
+    FMFDetails(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the FMFDetails object.
      */
@@ -167,6 +173,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the FMFDetails object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void filterTypeChanged(FilterType filterType);
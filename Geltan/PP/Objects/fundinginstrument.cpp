@@ -20,9 +20,15 @@
  */
 
 #include "fundinginstrument_p.h"
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/creditcard.h>
 #include <Geltan/PP/Objects/tokenizedcreditcard.h>
 #include <Geltan/PP/Objects/billinginstrument.h>
+#include <Geltan/PP/Objects/installmentdescription.h>
+#include <Geltan/PP/Objects/address.h>
+#include <Geltan/PP/Objects/link.h>
+#include <Geltan/PP/Objects/currency.h>
+#include <Geltan/PP/Values/fundinginstrumentvalue.h>
 #include <QJsonDocument>
 #ifdef QT_DEBUG
 #include <QtDebug>
@@ -53,6 +59,13 @@ FundingInstrument::FundingInstrument(const QJsonObject &json, QObject *parent) :
 }
 
 
+FundingInstrument::FundingInstrument(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new FundingInstrumentPrivate)
+{
+    loadFromJson(json);
+}
+
+
 
 FundingInstrument::~FundingInstrument()
 {
@@ -133,6 +146,27 @@ QVariantMap FundingInstrument::toVariant()
 }
 
 
+
+void FundingInstrument::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    writer->beginObject(name);
+
+    if (creditCard()) {
+        creditCard()->writeJson(writer, QLatin1String("credit_card"));
+    }
+
+    if (creditCardToken()) {
+        creditCardToken()->writeJson(writer, QLatin1String("credit_card_token"));
+    }
+
+    if (billing()) {
+        billing()->writeJson(writer, QLatin1String("billing"));
+    }
+
+    writer->endObject();
+}
+
+
 QJsonObject FundingInstrument::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -145,15 +179,23 @@ void FundingInstrument::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void FundingInstrument::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+void FundingInstrument::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
 
-    const QJsonObject cco = json.value(QStringLiteral("credit_card")).toObject();
+    const PPJsonValue cco = json.value(QLatin1String("credit_card")).toObject();
     CreditCard *oldCreditCard = creditCard();
     if (!cco.isEmpty()) {
         if (oldCreditCard) {
@@ -167,7 +209,7 @@ void FundingInstrument::loadFromJson(const QJsonObject &json)
     }
 
 
-    const QJsonObject ccto = json.value(QStringLiteral("credit_card_token")).toObject();
+    const PPJsonValue ccto = json.value(QLatin1String("credit_card_token")).toObject();
     TokenizedCreditCard *oldCreditCardToken = creditCardToken();
     if (!ccto.isEmpty()) {
         if (oldCreditCardToken) {
@@ -181,7 +223,7 @@ void FundingInstrument::loadFromJson(const QJsonObject &json)
     }
 
 
-    const QJsonObject bo = json.value(QStringLiteral("billing")).toObject();
+    const PPJsonValue bo = json.value(QLatin1String("billing")).toObject();
     BillingInstrument *oldBilling = billing();
     if (!bo.isEmpty()) {
         if (oldBilling) {
@@ -194,3 +236,71 @@ void FundingInstrument::loadFromJson(const QJsonObject &json)
         delete oldBilling;
     }
 }
+
+
+
+static PaymentAmountValue fundingInstrumentCurrencyToValue(const Currency *c)
+{
+    PaymentAmountValue pav;
+    if (c) {
+        pav.setCurrency(c->currency());
+        pav.setTotalMoney(c->valueMoney());
+    }
+    return pav;
+}
+
+
+
+FundingInstrumentValue FundingInstrument::toValue() const
+{
+    FundingInstrumentValue v;
+
+    if (creditCard()) {
+        const CreditCard *cc = creditCard();
+        v.setType(FundingInstrumentValue::Card);
+        v.setNumber(cc->number());
+        v.setCardType(cc->type());
+        v.setExpireMonth(cc->expireMonth());
+        v.setExpireYear(cc->expireYear());
+        v.setCvv2(cc->cvv2());
+        v.setFirstName(cc->firstName());
+        v.setLastName(cc->lastName());
+        if (cc->billingAddress()) {
+            v.setBillingAddress(cc->billingAddress()->toValue());
+        }
+        v.setExternalCustomerId(cc->externalCustomerId());
+        v.setState(cc->state());
+        v.setValidUntil(cc->validUntil());
+        const QList<Link*> ls = cc->links();
+        if (!ls.isEmpty()) {
+            QList<LinkValue> lvs;
+            lvs.reserve(ls.size());
+            for (const Link *l : ls) {
+                lvs.append(l->toValue());
+            }
+            v.setLinks(lvs);
+        }
+    } else if (creditCardToken()) {
+        const TokenizedCreditCard *cct = creditCardToken();
+        v.setType(FundingInstrumentValue::CardToken);
+        v.setCreditCardId(cct->creditCardId());
+        v.setPayerId(cct->payerId());
+        v.setLast4(cct->last4());
+        v.setCardType(cct->type());
+        v.setExpireMonth(cct->expireMonth());
+        v.setExpireYear(cct->expireYear());
+    } else if (billing()) {
+        const BillingInstrument *b = billing();
+        v.setType(FundingInstrumentValue::Billing);
+        v.setBillingAgreementId(b->billingAgreementId());
+        const InstallmentDescription *id = b->selectedInstallmentOption();
+        if (id) {
+            v.setInstallmentTerm(id->term());
+            v.setInstallmentMonthlyPayment(fundingInstrumentCurrencyToValue(id->monthlyPayment()));
+            v.setInstallmentDiscountAmount(fundingInstrumentCurrencyToValue(id->discountAmount()));
+            v.setInstallmentDiscountPercentage(id->discountPercentage());
+        }
+    }
+
+    return v;
+}
@@ -26,14 +26,17 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class FundingInstrumentPrivate;
+class PPJsonWriter;
 class CreditCard;
 class TokenizedCreditCard;
 class BillingInstrument;
+class FundingInstrumentValue;
 
 /*!
  * \brief A resource representing a Payer's funding instrument.
@@ -105,6 +108,11 @@ public:
      */
     FundingInstrument(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new FundingInstrument object from a value of a PPJsonDocument.
+     */
+    FundingInstrument(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the FundingInstrument object.
      */
@@ -125,6 +133,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -142,6 +158,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the FundingInstrument object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared FundingInstrumentValue containing the funding instrument data, including the read only members.
+     */
+    FundingInstrumentValue toValue() const;
+
 Q_SIGNALS:
     void creditCardChanged(CreditCard *creditCard);
     void creditCardTokenChanged(TokenizedCreditCard *creditCardToken);
@@ -20,6 +20,8 @@
  */
 
 #include "installmentdescription_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/currency.h>
 #include <QJsonDocument>
 #ifdef QT_DEBUG
@@ -50,6 +52,13 @@ InstallmentDescription::InstallmentDescription(const QJsonObject &json, QObject
 }
 
 
+InstallmentDescription::InstallmentDescription(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new InstallmentDescriptionPrivate)
+{
+    loadFromJson(json);
+}
+
+
 InstallmentDescription::~InstallmentDescription()
 {
 }
@@ -142,6 +151,26 @@ QVariantMap InstallmentDescription::toVariant()
 }
 
 
+
+void InstallmentDescription::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(InstallmentDescription);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("term"), QString::number(term()));
+    if (monthlyPayment()) {
+        monthlyPayment()->writeJson(writer, QLatin1String("monthly_payment"));
+    }
+    if (discountAmount()) {
+        discountAmount()->writeJson(writer, QLatin1String("discount_amount"));
+    }
+    d->writeString(writer, QLatin1String("discount_percentag"), QString::number(discountPercentage()));
+
+    writer->endObject();
+}
+
+
 QJsonObject InstallmentDescription::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -155,16 +184,49 @@ void InstallmentDescription::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void InstallmentDescription::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as installmentDescriptionFields
+enum InstallmentDescriptionField {
+    InstallmentDescriptionFieldDiscountAmount,
+    InstallmentDescriptionFieldDiscountPercentag,
+    InstallmentDescriptionFieldMonthlyPayment,
+    InstallmentDescriptionFieldTerm,
+    InstallmentDescriptionFieldCount
+};
+
+constexpr PPJsonField installmentDescriptionFields[] = {
+    PPJsonField("discount_amount"),
+    PPJsonField("discount_percentag"),
+    PPJsonField("monthly_payment"),
+    PPJsonField("term")
+};
+
+Q_STATIC_ASSERT(sizeof(installmentDescriptionFields) / sizeof(PPJsonField) == InstallmentDescriptionFieldCount);
+
+}
+
+
+void InstallmentDescription::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setTerm(json.value(QStringLiteral("term")).toString().toInt());
+    const PPJsonFields<InstallmentDescriptionFieldCount> f(json, installmentDescriptionFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    setTerm(f[InstallmentDescriptionFieldTerm].toString().toInt());
 
-    const QJsonObject mpo = json.value(QStringLiteral("monthly_payment")).toObject();
+    const PPJsonValue mpo = f[InstallmentDescriptionFieldMonthlyPayment].toObject();
     Currency *oldMpo = monthlyPayment();
     if (!mpo.isEmpty()) {
         if (oldMpo) {
@@ -177,7 +239,7 @@ void InstallmentDescription::loadFromJson(const QJsonObject &json)
         delete oldMpo;
     }
 
-    const QJsonObject dao = json.value(QStringLiteral("discount_amount")).toObject();
+    const PPJsonValue dao = f[InstallmentDescriptionFieldDiscountAmount].toObject();
     Currency *oldDao = discountAmount();
     if (!dao.isEmpty()) {
         if (oldDao) {
@@ -190,5 +252,5 @@ void InstallmentDescription::loadFromJson(const QJsonObject &json)
         delete oldDao;
     }
 
-    setDiscountPercentage(json.value(QStringLiteral("discount_percentag")).toString().toDouble());
+    setDiscountPercentage(f[InstallmentDescriptionFieldDiscountPercentag].toString().toDouble());
 }
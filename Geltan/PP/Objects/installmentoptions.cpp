@@ -20,6 +20,8 @@
  */
 
 #include "installmentoptions_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/installmentdescription.h>
 #include <Geltan/PP/ppenumsmap.h>
 #include <QJsonDocument>
@@ -53,6 +55,13 @@ InstallmentOptions::InstallmentOptions(const QJsonObject &json, QObject *parent)
 }
 
 
+InstallmentOptions::InstallmentOptions(const PPJsonValue &json, QObject *parent) :
+    QAbstractListModel(parent), d_ptr(new InstallmentOptionsPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 InstallmentOptions::~InstallmentOptions()
 {
 
@@ -186,34 +195,68 @@ void InstallmentOptions::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void InstallmentOptions::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as installmentOptionsFields
+enum InstallmentOptionsField {
+    InstallmentOptionsFieldInstallmentId,
+    InstallmentOptionsFieldInstallmentOptions,
+    InstallmentOptionsFieldIssuer,
+    InstallmentOptionsFieldNetwork,
+    InstallmentOptionsFieldCount
+};
+
+constexpr PPJsonField installmentOptionsFields[] = {
+    PPJsonField("installment_id"),
+    PPJsonField("installment_options"),
+    PPJsonField("issuer"),
+    PPJsonField("network")
+};
+
+Q_STATIC_ASSERT(sizeof(installmentOptionsFields) / sizeof(PPJsonField) == InstallmentOptionsFieldCount);
+
+}
+
+
+void InstallmentOptions::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<InstallmentOptionsFieldCount> f(json, installmentOptionsFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(InstallmentOptions);
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    setInstallmentId(f[InstallmentOptionsFieldInstallmentId].toString());
 
-    setInstallmentId(json.value(QStringLiteral("installment_id")).toString());
+    setNetwork(PPEnumsMap::creditCardTypeTokenToEnum(f[InstallmentOptionsFieldNetwork].toString()));
 
-    setNetwork(em->creditCardTypeTokenToEnum(json.value(QStringLiteral("network")).toString()));
+    setIssuer(f[InstallmentOptionsFieldIssuer].toString());
 
-    setIssuer(json.value(QStringLiteral("issuer")).toString());
+    const PPJsonValue ios = f[InstallmentOptionsFieldInstallmentOptions].toArray();
+    {
+        const PPLoadScope::Unblocked unblocked(&scope);
+        d->clear();
+        if (!ios.isEmpty()) {
+            beginInsertRows(QModelIndex(), 0, ios.count() - 1);
 
-    const QJsonArray ios = json.value(QStringLiteral("installment_options")).toArray();
-    d->clear();
-    if (!ios.isEmpty()) {
-        beginInsertRows(QModelIndex(), 0, ios.count() - 1);
+            PPJsonValue::const_iterator i = ios.constBegin();
+            while (i != ios.constEnd()) {
+                d->installmentOptions.append(new InstallmentDescription(i->toObject(), this));
+                ++i;
+            }
 
-        QJsonArray::const_iterator i = ios.constBegin();
-        while (i != ios.constEnd()) {
-            d->installmentOptions.append(new InstallmentDescription(i->toObject(), this));
-            ++i;
+            endInsertRows();
         }
-
-        endInsertRows();
     }
 }
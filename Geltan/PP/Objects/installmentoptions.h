@@ -26,6 +26,7 @@
 #include <QAbstractListModel>
 #include <Geltan/PP/ppenums.h>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
@@ -105,6 +106,11 @@ public:
      */
     InstallmentOptions(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new InstallmentOptions object from a value of a PPJsonDocument.
+     */
+    InstallmentOptions(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the InstallmentOptions object.
      */
@@ -164,6 +170,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the InstallmentOptions object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void installmentIdChanged(const QString &installmentId);
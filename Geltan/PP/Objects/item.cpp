@@ -20,8 +20,11 @@
  */
 
 #include "item_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
-#include <QtMath>
+#include <Geltan/PP/Values/itemvalue.h>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -57,6 +60,13 @@ Item::Item(const QJsonObject &json, QObject *parent) :
 }
 
 
+Item::Item(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new ItemPrivate)
+{
+    loadFromJson(json);
+}
+
+
 Item::~Item()
 {
 
@@ -131,15 +141,23 @@ void Item::setQuantity(int nQuantity)
 
 
 
-float Item::price() const { Q_D(const Item); return d->price; }
+float Item::price() const { Q_D(const Item); return d->price.toFloat(); }
 
 void Item::setPrice(float nPrice)
 {
-    Q_D(Item); 
+    setPriceMoney(Money::fromDouble(nPrice));
+}
+
+
+Money Item::priceMoney() const { Q_D(const Item); return d->price; }
+
+void Item::setPriceMoney(const Money &nPrice)
+{
+    Q_D(Item);
     if (nPrice != d->price) {
         d->price = nPrice;
 #ifdef QT_DEBUG
-        qDebug() << "Changed price to" << d->price;
+        qDebug() << "Changed price to" << d->price.toString();
 #endif
         Q_EMIT priceChanged(price());
     }
@@ -165,15 +183,23 @@ void Item::setCurrency(const QString &nCurrency)
 
 
 
-float Item::tax() const { Q_D(const Item); return d->tax; }
+float Item::tax() const { Q_D(const Item); return d->tax.toFloat(); }
 
 void Item::setTax(float nTax)
 {
-    Q_D(Item); 
+    setTaxMoney(Money::fromDouble(nTax));
+}
+
+
+Money Item::taxMoney() const { Q_D(const Item); return d->tax; }
+
+void Item::setTaxMoney(const Money &nTax)
+{
+    Q_D(Item);
     if (nTax != d->tax) {
         d->tax = nTax;
 #ifdef QT_DEBUG
-        qDebug() << "Changed tax to" << d->tax;
+        qDebug() << "Changed tax to" << d->tax.toString();
 #endif
         Q_EMIT taxChanged(tax());
     }
@@ -209,13 +235,9 @@ QVariantMap Item::toVariant()
     d->addStringToVariantMap(&map, QStringLiteral("name"), name(), 127);
     d->addStringToVariantMap(&map, QStringLiteral("description"), description(), 127);
     d->addStringToVariantMap(&map, QStringLiteral("quantity"), QString::number(quantity()));
-    if (QStringList({QStringLiteral("HUF"), QStringLiteral("JPY"), QStringLiteral("TWD")}).contains(currency())) {
-        d->addStringToVariantMap(&map, QStringLiteral("price"), QString::number(qFloor(price())), 10);
-    } else {
-        d->addStringToVariantMap(&map, QStringLiteral("price"), QString::number(price(), 'f', 2), 10);
-    }
+    d->addMoneyToVariantMap(&map, QStringLiteral("price"), d->price, currency());
     d->addStringToVariantMap(&map, QStringLiteral("currency"), currency(), 3);
-    d->addStringToVariantMap(&map, QStringLiteral("tax"), QString::number(tax(), 'f', 2));
+    d->addMoneyToVariantMap(&map, QStringLiteral("tax"), d->tax, currency());
     d->addStringToVariantMap(&map, QStringLiteral("url"), url().toString());
 
     return map;
@@ -223,6 +245,26 @@ QVariantMap Item::toVariant()
 
 
 
+void Item::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(Item);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("sku"), sku(), 127);
+    d->writeString(writer, QLatin1String("name"), d->name, 127);
+    d->writeString(writer, QLatin1String("description"), description(), 127);
+    d->writeString(writer, QLatin1String("quantity"), QString::number(quantity()));
+    d->writeMoney(writer, QLatin1String("price"), d->price, currency());
+    d->writeString(writer, QLatin1String("currency"), currency(), 3);
+    d->writeMoney(writer, QLatin1String("tax"), d->tax, currency());
+    d->writeString(writer, QLatin1String("url"), url().toString());
+
+    writer->endObject();
+}
+
+
+
 QJsonObject Item::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -236,31 +278,90 @@ void Item::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Item::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as itemFields
+enum ItemField {
+    ItemFieldCurrency,
+    ItemFieldDescription,
+    ItemFieldName,
+    ItemFieldPrice,
+    ItemFieldQuantity,
+    ItemFieldSku,
+    ItemFieldTax,
+    ItemFieldUrl,
+    ItemFieldCount
+};
+
+constexpr PPJsonField itemFields[] = {
+    PPJsonField("currency"),
+    PPJsonField("description"),
+    PPJsonField("name"),
+    PPJsonField("price"),
+    PPJsonField("quantity"),
+    PPJsonField("sku"),
+    PPJsonField("tax"),
+    PPJsonField("url")
+};
+
+Q_STATIC_ASSERT(sizeof(itemFields) / sizeof(PPJsonField) == ItemFieldCount);
+
+}
+
+
+void Item::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setSku(json.value(QStringLiteral("sku")).toString());
+    const PPJsonFields<ItemFieldCount> f(json, itemFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    setName(json.value(QStringLiteral("name")).toString());
+    setSku(f[ItemFieldSku].toString());
 
-    setDescription(json.value(QStringLiteral("description")).toString());
+    setName(f[ItemFieldName].toString());
 
-    setQuantity(json.value(QStringLiteral("quantity")).toInt());
+    setDescription(f[ItemFieldDescription].toString());
 
-    setPrice(json.value(QStringLiteral("price")).toString().toFloat());
+    setQuantity(f[ItemFieldQuantity].toInt());
 
-    setCurrency(json.value(QStringLiteral("currency")).toString());
+    setPriceMoney(Money::fromJson(f[ItemFieldPrice]));
 
-    setTax(json.value(QStringLiteral("tax")).toString().toFloat());
+    setCurrency(PPStringPool::intern(f[ItemFieldCurrency].toString()));
 
-    const QString sUrl = json.value(QStringLiteral("url")).toString();
+    setTaxMoney(Money::fromJson(f[ItemFieldTax]));
+
+    const QString sUrl = f[ItemFieldUrl].toString();
     if (!sUrl.isEmpty()) {
         setUrl(QUrl(sUrl));
     } else {
         setUrl(QUrl());
     }
 }
+
+
+
+ItemValue Item::toValue() const
+{
+    ItemValue v;
+
+    v.setSku(sku());
+    v.setName(name());
+    v.setDescription(description());
+    v.setQuantity(quantity());
+    v.setPriceMoney(priceMoney());
+    v.setCurrency(currency());
+    v.setTaxMoney(taxMoney());
+    v.setUrl(url());
+
+    return v;
+}
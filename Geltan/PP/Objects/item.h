@@ -27,12 +27,16 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
 
 namespace Geltan {
 namespace PP {
 
 
 class ItemPrivate;
+class PPJsonWriter;
+class ItemValue;
 
 /*!
  * \brief Contains information about a single item.
@@ -165,6 +169,11 @@ public:
      */
     Item(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Item object from a value of a PPJsonDocument.
+     */
+    Item(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Item object.
      */
@@ -175,8 +184,10 @@ public:
     QString description() const;
     int quantity() const;
     float price() const;
+    Money priceMoney() const;
     QString currency() const;
     float tax() const;
+    Money taxMoney() const;
     QUrl url() const;
 
 
@@ -185,8 +196,10 @@ public:
     void setDescription(const QString &nDescription);
     void setQuantity(int nQuantity);
     void setPrice(float nPrice);
+    void setPriceMoney(const Money &nPrice);
     void setCurrency(const QString &nCurrency);
     void setTax(float nTax);
+    void setTaxMoney(const Money &nTax);
     void setUrl(const QUrl &nUrl);
 
 
@@ -197,6 +210,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -214,6 +235,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Item object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared ItemValue containing the item data, including the read only members.
+     */
+    ItemValue toValue() const;
+
 
 Q_SIGNALS:
     void skuChanged(const QString &sku);
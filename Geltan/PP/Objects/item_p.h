@@ -34,8 +34,8 @@ class ItemPrivate : public PPObjectsBasePrivate
 public:
     ItemPrivate() :
         quantity(0),
-        price(0.0),
-        tax(0.0)
+        price(),
+        tax()
     {}
 
     ItemPrivate(ItemPrivate *other) {
@@ -55,9 +55,9 @@ public:
     QString name;
     QString description;
     int quantity;
-    float price;
+    Money price;
     QString currency;
-    float tax;
+    Money tax;
     QUrl url;
 };
 
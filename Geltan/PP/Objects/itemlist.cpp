@@ -20,6 +20,8 @@
  */
 
 #include "itemlist_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/item.h>
 #include <Geltan/PP/Objects/shippingaddress.h>
 #include <QJsonDocument>
@@ -53,6 +55,13 @@ ItemList::ItemList(const QJsonObject &json, QObject *parent) :
 }
 
 
+ItemList::ItemList(const PPJsonValue &json, QObject *parent) :
+    QAbstractListModel(parent), d_ptr(new ItemListPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 
 ItemList::~ItemList()
 {
@@ -304,6 +313,32 @@ QVariantMap ItemList::toVariant()
 
 
 
+void ItemList::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(ItemList);
+
+    writer->beginObject(name);
+
+    if (!items().isEmpty()) {
+        writer->beginArray(QLatin1String("items"));
+        const auto its = items();
+        for (Item *it : its) {
+            it->writeJson(writer);
+        }
+        writer->endArray();
+    }
+
+    if (shippingAddress()) {
+        shippingAddress()->writeJson(writer, QLatin1String("shipping_address"));
+    }
+    d->writeString(writer, QLatin1String("shipping_method"), shippingMethod());
+    d->writePhoneNumber(writer, QLatin1String("shipping_phone_number"), shippingPhoneNumber());
+
+    writer->endObject();
+}
+
+
+
 QJsonObject ItemList::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -317,28 +352,55 @@ void ItemList::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void ItemList::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as itemListFields
+enum ItemListField {
+    ItemListFieldItems,
+    ItemListFieldShippingAddress,
+    ItemListFieldShippingMethod,
+    ItemListFieldShippingPhoneNumber,
+    ItemListFieldCount
+};
+
+constexpr PPJsonField itemListFields[] = {
+    PPJsonField("items"),
+    PPJsonField("shipping_address"),
+    PPJsonField("shipping_method"),
+    PPJsonField("shipping_phone_number")
+};
+
+Q_STATIC_ASSERT(sizeof(itemListFields) / sizeof(PPJsonField) == ItemListFieldCount);
+
+}
+
+
+void ItemList::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<ItemListFieldCount> f(json, itemListFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(ItemList);
 
-    const QJsonArray is = json.value(QStringLiteral("items")).toArray();
-    d->clear();
-    if (!is.isEmpty()) {
-        beginInsertRows(QModelIndex(), 0, is.count() - 1);
-        QJsonArray::const_iterator i = is.constBegin();
-        while (i != is.constEnd()) {
-            d->items.append(new Item(i->toObject(), this));
-            ++i;
-        }
-        endInsertRows();
+    const PPJsonValue is = f[ItemListFieldItems].toArray();
+    {
+        const PPLoadScope::Unblocked unblocked(&scope);
+        d->reloadItems(is);
     }
 
-    const QJsonObject sao = json.value(QStringLiteral("shipping_address")).toObject();
+    const PPJsonValue sao = f[ItemListFieldShippingAddress].toObject();
     ShippingAddress *oldSao = shippingAddress();
     if (!sao.isEmpty()) {
         if (oldSao) {
@@ -351,7 +413,7 @@ void ItemList::loadFromJson(const QJsonObject &json)
         delete oldSao;
     }
 
-    setShippingMethod(json.value(QStringLiteral("shipping_method")).toString());
+    setShippingMethod(f[ItemListFieldShippingMethod].toString());
 
-    setShippingPhoneNumber(json.value(QStringLiteral("shipping_phone_number")).toString());
+    setShippingPhoneNumber(f[ItemListFieldShippingPhoneNumber].toString());
 }
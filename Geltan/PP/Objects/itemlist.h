@@ -27,6 +27,7 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
@@ -34,6 +35,7 @@ namespace PP {
 
 
 class ItemListPrivate;
+class PPJsonWriter;
 class ShippingAddress;
 class Item;
 
@@ -121,6 +123,11 @@ public:
      */
     ItemList(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new ItemList object from a value of a PPJsonDocument.
+     */
+    ItemList(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the ItemList object.
      */
@@ -216,6 +223,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -233,6 +248,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the ItemList object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 Q_SIGNALS:
     void itemsChanged(const QList<Item*> &items);
     void shippingAddressChanged(ShippingAddress *shippingAddress);
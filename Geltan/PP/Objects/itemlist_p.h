@@ -23,6 +23,7 @@
 #define ITEMLIST_P_H
 
 #include "itemlist.h"
+#include "item.h"
 #include "ppobjectsbase_p.h"
 
 namespace Geltan {
@@ -53,6 +54,45 @@ public:
         }
     }
 
+    /*!
+     * \internal
+     * \brief Reconciles the items with the data in \a is.
+     *
+     * Items are matched by position. Existing Item objects are reloaded in place, only surplus
+     * rows are removed and only missing rows are created. As the only role returns the Item
+     * object itself, reloaded rows do not need a dataChanged() signal.
+     */
+    void reloadItems(const PPJsonValue &is)
+    {
+        Q_Q(ItemList);
+
+        const int isCount = is.count();
+        const int reused = qMin(items.count(), isCount);
+
+        PPJsonValue::const_iterator it = is.constBegin();
+        for (int i = 0; i < reused; ++i, ++it) {
+            items.at(i)->loadFromJson(it->toObject());
+        }
+
+        if (reused < items.count()) {
+            q->beginRemoveRows(QModelIndex(), reused, items.count() - 1);
+            const QList<Item*> surplus = items.mid(reused);
+            items.erase(items.begin() + reused, items.end());
+            qDeleteAll(surplus);
+            q->endRemoveRows();
+        }
+
+        if (reused < isCount) {
+            q->beginInsertRows(QModelIndex(), reused, isCount - 1);
+            items.reserve(isCount);
+            while (it != is.constEnd()) {
+                items.append(new Item(it->toObject(), q));
+                ++it;
+            }
+            q->endInsertRows();
+        }
+    }
+
     ItemList * const q_ptr;
     Q_DECLARE_PUBLIC(ItemList)
     QList<Item*> items;
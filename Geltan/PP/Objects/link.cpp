@@ -20,7 +20,10 @@
  */
 
 #include "link_p.h"
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
+#include <Geltan/PP/Values/linkvalue.h>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -50,6 +53,13 @@ Link::Link(const QJsonObject &json, QObject *parent) :
 }
 
 
+Link::Link(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new LinkPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 
 Link::~Link()
 {
@@ -73,14 +83,35 @@ void Link::loadFromJson(const QJsonDocument &json)
 
 
 void Link::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+void Link::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(Link);
 
-    d->setHref(QUrl(json.value(QStringLiteral("href")).toString()));
-    d->setRel(json.value(QStringLiteral("rel")).toString());
-    d->setMethod(json.value(QStringLiteral("method")).toString());
+    d->setHref(QUrl(json.value(QLatin1String("href")).toString()));
+    d->setRel(PPStringPool::intern(json.value(QLatin1String("rel")).toString()));
+    d->setMethod(PPStringPool::intern(json.value(QLatin1String("method")).toString()));
+}
+
+
+
+LinkValue Link::toValue() const
+{
+    LinkValue v;
+
+    v.setHref(href());
+    v.setRel(rel());
+    v.setMethod(method());
+
+    return v;
 }
@@ -27,11 +27,13 @@
 #include <QJsonObject>
 #include <QUrl>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class LinkPrivate;
+class LinkValue;
 
 /*!
  * \brief Contains information about a PayPal <a href="https://en.wikipedia.org/wiki/HATEOAS">HATEOAS</a> API link.
@@ -95,6 +97,11 @@ public:
      */
     Link(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Link object from a value of a PPJsonDocument.
+     */
+    Link(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Link object.
      */
@@ -131,6 +138,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Link object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared LinkValue containing the link data, including the read only members.
+     */
+    LinkValue toValue() const;
+
 
 Q_SIGNALS:
     void hrefChanged(const QUrl &href);
@@ -20,6 +20,8 @@
  */
 
 #include "order_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/paymentamount.h>
 #include <Geltan/PP/Objects/fmfdetails.h>
 #include <Geltan/PP/Objects/link.h>
@@ -27,6 +29,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <Geltan/PP/pptimestamp.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -56,6 +59,13 @@ Order::Order(const QJsonObject &json, QObject *parent) :
 }
 
 
+Order::Order(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new OrderPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 Order::~Order()
 {
 }
@@ -200,20 +210,69 @@ void Order::loadFromJson(const QJsonDocument &json)
 
 
 void Order::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+namespace {
+
+// keep in the same order as orderFields
+enum OrderField {
+    OrderFieldAmount,
+    OrderFieldCreateTime,
+    OrderFieldFmfDetails,
+    OrderFieldId,
+    OrderFieldLinks,
+    OrderFieldParentPayment,
+    OrderFieldPaymentMode,
+    OrderFieldProtectionEligibility,
+    OrderFieldProtectionEligibilityType,
+    OrderFieldReasonCode,
+    OrderFieldReferenceId,
+    OrderFieldState,
+    OrderFieldUpdateTime,
+    OrderFieldCount
+};
+
+constexpr PPJsonField orderFields[] = {
+    PPJsonField("amount"),
+    PPJsonField("create_time"),
+    PPJsonField("fmf_details"),
+    PPJsonField("id"),
+    PPJsonField("links"),
+    PPJsonField("parent_payment"),
+    PPJsonField("payment_mode"),
+    PPJsonField("protection_eligibility"),
+    PPJsonField("protection_eligibility_type"),
+    PPJsonField("reason_code"),
+    PPJsonField("reference_id"),
+    PPJsonField("state"),
+    PPJsonField("update_time")
+};
+
+Q_STATIC_ASSERT(sizeof(orderFields) / sizeof(PPJsonField) == OrderFieldCount);
+
+}
+
+
+void Order::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(Order);
+    const PPJsonFields<OrderFieldCount> f(json, orderFields);
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    Q_D(Order);
 
-    d->setId(json.value(QStringLiteral("id")).toString());
+    d->setId(f[OrderFieldId].toString());
 
-    d->setReferenceId(json.value(QStringLiteral("reference_id")).toString());
+    d->setReferenceId(f[OrderFieldReferenceId].toString());
 
-    const QJsonObject ao = json.value(QStringLiteral("amount")).toObject();
+    const PPJsonValue ao = f[OrderFieldAmount].toObject();
     PaymentAmount *oldAo = amount();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -227,30 +286,30 @@ void Order::loadFromJson(const QJsonObject &json)
     }
 
 
-    d->setPaymentMode(em->paymentModeTypeTokenToEnum(json.value(QStringLiteral("payment_mode")).toString()));
+    d->setPaymentMode(PPEnumsMap::paymentModeTypeTokenToEnum(f[OrderFieldPaymentMode].toString()));
 
-    d->setState(em->stateTypeTokenToEnum(json.value(QStringLiteral("state")).toString()));
+    d->setState(PPEnumsMap::stateTypeTokenToEnum(f[OrderFieldState].toString()));
 
-    d->setReasonCode(em->reasonCodeTokenToEnum(json.value(QStringLiteral("reason_code")).toString()));
+    d->setReasonCode(PPEnumsMap::reasonCodeTokenToEnum(f[OrderFieldReasonCode].toString()));
 
-    d->setProtectionEligibility(em->protectionEligibilityTokenToEnum(json.value(QStringLiteral("protection_eligibility")).toString()));
+    d->setProtectionEligibility(PPEnumsMap::protectionEligibilityTokenToEnum(f[OrderFieldProtectionEligibility].toString()));
 
-    const QString pets = json.value(QStringLiteral("protection_eligibility_type")).toString();
+    const QString pets = f[OrderFieldProtectionEligibilityType].toString();
     if (!pets.isEmpty()) {
         QList<Geltan::PP::PayPal::ProtectionEligibilityType> petList;
         const QStringList petsList = pets.split(QChar(','));
         petList.reserve(petsList.size());
         for (const QString &pet : petsList) {
-            petList.append(em->protectionEligibilityTypeTokenToEnum(pet));
+            petList.append(PPEnumsMap::protectionEligibilityTypeTokenToEnum(pet));
         }
         d->setProtectionEligibilityType(petList);
     } else {
         d->setProtectionEligibilityType(QList<Geltan::PP::PayPal::ProtectionEligibilityType>());
     }
 
-    d->setParentPayment(json.value(QStringLiteral("parent_payment")).toString());
+    d->setParentPayment(f[OrderFieldParentPayment].toString());
 
-    const QJsonObject fmfo = json.value(QStringLiteral("fmf_details")).toObject();
+    const PPJsonValue fmfo = f[OrderFieldFmfDetails].toObject();
     FMFDetails *oldFmf = fmfDetails();
     if (!fmfo.isEmpty()) {
         if (oldFmf) {
@@ -263,26 +322,26 @@ void Order::loadFromJson(const QJsonObject &json)
         delete oldFmf;
     }
 
-    const QString ct = json.value(QStringLiteral("create_time")).toString();
+    const QString ct = f[OrderFieldCreateTime].toString();
     if (!ct.isEmpty()) {
-        d->setCreateTime(QDateTime::fromString(ct, Qt::ISODate));
+        d->setCreateTime(PPTimestamp::toDateTime(ct));
     } else {
         d->setCreateTime(QDateTime());
     }
 
-    const QString ut = json.value(QStringLiteral("update_time")).toString();
+    const QString ut = f[OrderFieldUpdateTime].toString();
     if (!ut.isEmpty()) {
-        d->setUpdateTime(QDateTime::fromString(ut, Qt::ISODate));
+        d->setUpdateTime(PPTimestamp::toDateTime(ut));
     } else {
         d->setUpdateTime(QDateTime());
     }
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
+    const PPJsonValue la = f[OrderFieldLinks].toArray();
     d->clearLinks();
     Q_EMIT linksChanged(links());
     if (!la.isEmpty()) {
         QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
+        PPJsonValue::const_iterator i = la.constBegin();
         while (i != la.constEnd()) {
             linksToAdd.append(new Link(i->toObject()));
             ++i;
@@ -26,6 +26,7 @@
 #include <QDateTime>
 #include <QUrl>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/ppenums.h>
 
 namespace Geltan {
@@ -223,6 +224,11 @@ public:
      */
     Order(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Order object from a value of a PPJsonDocument.
+     */
+    Order(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Order object.
      */
@@ -270,6 +276,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Order object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void idChanged(const QString &id);
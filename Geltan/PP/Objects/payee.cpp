@@ -20,6 +20,7 @@
  */
 
 #include "payee_p.h"
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #ifdef QT_DEBUG
 #include <QtDebug>
@@ -58,6 +59,13 @@ Payee::Payee(const QJsonObject &json, QObject *parent) :
 }
 
 
+Payee::Payee(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new PayeePrivate)
+{
+    loadFromJson(json);
+}
+
+
 Payee::~Payee()
 {
 }
@@ -102,13 +110,21 @@ void Payee::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Payee::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+void Payee::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setEmail(json.value(QStringLiteral("email")).toString());
-    setMerchantId(json.value(QStringLiteral("merchant_id")).toString());
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    setEmail(json.value(QLatin1String("email")).toString());
+    setMerchantId(json.value(QLatin1String("merchant_id")).toString());
 }
@@ -20,12 +20,16 @@
  */
 
 #include "payer_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/payerinfo.h>
 #include <Geltan/PP/Objects/fundinginstrument.h>
+#include <Geltan/PP/Objects/address.h>
 #include <Geltan/PP/ppenumsmap.h>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <Geltan/PP/Values/payervalue.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -54,6 +58,13 @@ Payer::Payer(const QJsonObject &json, QObject *parent) :
 }
 
 
+Payer::Payer(const PPJsonValue &json, QObject *parent) :
+    QAbstractListModel(parent), d_ptr(new PayerPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 
 Payer::~Payer()
 {
@@ -276,9 +287,7 @@ QVariantMap Payer::toVariant()
 
     QVariantMap map;
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
-
-    d->addStringToVariantMap(&map, QStringLiteral("payment_method"), em->paymentMethodEnumToToken(paymentMethod()));
+    d->addStringToVariantMap(&map, QStringLiteral("payment_method"), PPEnumsMap::paymentMethodEnumToToken(paymentMethod()));
 
     if (!fundingInstruments().isEmpty()) {
         QVariantList list;
@@ -312,6 +321,43 @@ QVariantMap Payer::toVariant()
 }
 
 
+
+void Payer::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(Payer);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("payment_method"), PPEnumsMap::paymentMethodEnumToToken(paymentMethod()));
+
+    if (!fundingInstruments().isEmpty()) {
+        writer->beginArray(QLatin1String("funding_instruments"));
+        const auto fundingis = fundingInstruments();
+        for (FundingInstrument *fi : fundingis) {
+            fi->writeJson(writer);
+        }
+        writer->endArray();
+    }
+
+    switch(externalSelectedFundingInstrumentType()) {
+    case Credit:
+        writer->writeString(QLatin1String("external_selected_funding_instrument_type"), QStringLiteral("CREDIT"));
+        break;
+    case PayUponInvoice:
+        writer->writeString(QLatin1String("external_selected_funding_instrument_type"), QStringLiteral("PAY_UPON_INVOICE"));
+        break;
+    default:
+        break;
+    }
+
+    if (payerInfo()) {
+        payerInfo()->writeJson(writer, QLatin1String("payer_info"));
+    }
+
+    writer->endObject();
+}
+
+
 QJsonObject Payer::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -325,20 +371,53 @@ void Payer::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Payer::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as payerFields
+enum PayerField {
+    PayerFieldExternalSelectedFundingInstrumentType,
+    PayerFieldFundingInstruments,
+    PayerFieldPayerInfo,
+    PayerFieldPaymentMethod,
+    PayerFieldStatus,
+    PayerFieldCount
+};
+
+constexpr PPJsonField payerFields[] = {
+    PPJsonField("external_selected_funding_instrument_type"),
+    PPJsonField("funding_instruments"),
+    PPJsonField("payer_info"),
+    PPJsonField("payment_method"),
+    PPJsonField("status")
+};
+
+Q_STATIC_ASSERT(sizeof(payerFields) / sizeof(PPJsonField) == PayerFieldCount);
+
+}
+
+
+void Payer::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(Payer);
+    const PPJsonFields<PayerFieldCount> f(json, payerFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    Q_D(Payer);
 
-    setPaymentMethod(em->paymentMethodTokenToEnum(json.value(QStringLiteral("payment_method")).toString()));
+    setPaymentMethod(PPEnumsMap::paymentMethodTokenToEnum(f[PayerFieldPaymentMethod].toString()));
 
-    const QString sStatus = json.value(QStringLiteral("status")).toString();
+    const QString sStatus = f[PayerFieldStatus].toString();
     if (sStatus == QLatin1String("VERIFIED")) {
         setStatus(Verified);
     } else if (sStatus == QLatin1String("UNVERIFIED")) {
@@ -347,19 +426,22 @@ void Payer::loadFromJson(const QJsonObject &json)
         setStatus(NoStatus);
     }
 
-    const QJsonArray fis = json.value(QStringLiteral("funding_instruments")).toArray();
-    d->clearFundingInstruments();
-    if (!fis.isEmpty()) {
-        beginInsertRows(QModelIndex(), 0, fis.count() - 1);
-        QJsonArray::const_iterator i = fis.constBegin();
-        while (i != fis.constEnd()) {
-            d->fundingInstruments.append(new FundingInstrument(i->toObject(), this));
-            ++i;
+    const PPJsonValue fis = f[PayerFieldFundingInstruments].toArray();
+    {
+        const PPLoadScope::Unblocked unblocked(&scope);
+        d->clearFundingInstruments();
+        if (!fis.isEmpty()) {
+            beginInsertRows(QModelIndex(), 0, fis.count() - 1);
+            PPJsonValue::const_iterator i = fis.constBegin();
+            while (i != fis.constEnd()) {
+                d->fundingInstruments.append(new FundingInstrument(i->toObject(), this));
+                ++i;
+            }
+            endInsertRows();
         }
-        endInsertRows();
     }
 
-    const QString sExtFis = json.value(QStringLiteral("external_selected_funding_instrument_type")).toString();
+    const QString sExtFis = f[PayerFieldExternalSelectedFundingInstrumentType].toString();
     if (sExtFis == QLatin1String("CREDIT")) {
         setExternalSelectedFundingInstrumentType(Credit);
     } else if (sExtFis == QLatin1String("PAY_UPON_INVOICE")) {
@@ -368,7 +450,7 @@ void Payer::loadFromJson(const QJsonObject &json)
         setExternalSelectedFundingInstrumentType(NoFundingInstrumentType);
     }
 
-    const QJsonObject pio = json.value(QStringLiteral("payer_info")).toObject();
+    const PPJsonValue pio = f[PayerFieldPayerInfo].toObject();
     PayerInfo *oldPio = payerInfo();
     if (!pio.isEmpty()) {
         if (oldPio) {
@@ -381,3 +463,48 @@ void Payer::loadFromJson(const QJsonObject &json)
         delete oldPio;
     }
 }
+
+
+
+PayerValue Payer::toValue() const
+{
+    PayerValue v;
+
+    v.setPaymentMethod(paymentMethod());
+    v.setStatus(status());
+    v.setExternalSelectedFundingInstrumentType(externalSelectedFundingInstrumentType());
+
+    const QList<FundingInstrument*> fis = fundingInstruments();
+    if (!fis.isEmpty()) {
+        QList<FundingInstrumentValue> fivs;
+        fivs.reserve(fis.size());
+        for (const FundingInstrument *fi : fis) {
+            fivs.append(fi->toValue());
+        }
+        v.setFundingInstruments(fivs);
+    }
+
+    const PayerInfo *pi = payerInfo();
+    if (pi) {
+        v.setEmail(pi->email());
+        v.setSalutation(pi->salutation());
+        v.setFirstName(pi->firstName());
+        v.setMiddleName(pi->middleName());
+        v.setLastName(pi->lastName());
+        v.setSuffix(pi->suffix());
+        v.setPayerId(pi->payerId());
+        v.setPhone(pi->phone());
+        v.setCountryCode(pi->countryCode());
+        if (pi->billingAddress()) {
+            v.setBillingAddress(pi->billingAddress()->toValue());
+        }
+        v.setExternalRememberMeId(pi->externalRememberMeId());
+        v.setBuyerAccountNumber(pi->buyerAccountNumber());
+        v.setPhoneType(pi->phoneType());
+        v.setBirthDate(pi->birthDate());
+        v.setTaxId(pi->taxId());
+        v.setTaxIdType(pi->taxIdType());
+    }
+
+    return v;
+}
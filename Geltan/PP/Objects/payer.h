@@ -28,6 +28,7 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/ppenums.h>
 
 namespace Geltan {
@@ -35,6 +36,8 @@ namespace PP {
 
 class PayerInfo;
 class PayerPrivate;
+class PPJsonWriter;
+class PayerValue;
 class FundingInstrument;
 
 /*!
@@ -129,6 +132,11 @@ public:
      */
     Payer(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Payer object from a value of a PPJsonDocument.
+     */
+    Payer(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Destroys the Payer object.
      */
@@ -235,6 +243,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -252,6 +268,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Payer object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared PayerValue containing the payer data, including the read only members.
+     */
+    PayerValue toValue() const;
+
 
 Q_SIGNALS:
     void paymentMethodChanged(PayPal::PaymentMethod paymentMethod);
@@ -20,8 +20,11 @@
  */
 
 #include "payerinfo_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/shippingaddress.h>
 #include <QJsonDocument>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -50,6 +53,13 @@ PayerInfo::PayerInfo(const QJsonObject &json, QObject *parent) :
 }
 
 
+PayerInfo::PayerInfo(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new PayerInfoPrivate)
+{
+    loadFromJson(json);
+}
+
+
 PayerInfo::~PayerInfo()
 {
 
@@ -385,45 +395,155 @@ QVariantMap PayerInfo::toVariant()
 
 
 
+void PayerInfo::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(PayerInfo);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("email"), email(), 127);
+    d->writeString(writer, QLatin1String("external_remember_me_id"), externalRememberMeId());
+    d->writeString(writer, QLatin1String("buyer_account_number"), buyerAccountNumber());
+    d->writePhoneNumber(writer, QLatin1String("phone"), phone());
+
+    switch(phoneType()) {
+    case Home:
+        writer->writeString(QLatin1String("phone_type"), QStringLiteral("HOME"));
+        break;
+    case Work:
+        writer->writeString(QLatin1String("phone_type"), QStringLiteral("WORK"));
+        break;
+    case Mobile:
+        writer->writeString(QLatin1String("phone_type"), QStringLiteral("MOBILE"));
+        break;
+    case Other:
+        writer->writeString(QLatin1String("phone_type"), QStringLiteral("OTHER"));
+        break;
+    default:
+        break;
+    }
+
+    d->writeString(writer, QLatin1String("birth_date"), birthDate().toString(QStringLiteral("yyyy-MM-dd")));
+    d->writeString(writer, QLatin1String("tax_id"), taxId(), 14);
+
+    switch(taxIdType()) {
+    case BR_CPF:
+        writer->writeString(QLatin1String("tax_id_type"), QStringLiteral("BR_CPF"));
+        break;
+    case BR_CNPJ:
+        writer->writeString(QLatin1String("tax_id_type"), QStringLiteral("BR_CNPJ"));
+        break;
+    default:
+        break;
+    }
+
+    d->writeString(writer, QLatin1String("country_code"), countryCode(), 2);
+
+    if (billingAddress()) {
+        billingAddress()->writeJson(writer, QLatin1String("billing_address"));
+    }
+
+    writer->endObject();
+}
+
+
+
 void PayerInfo::loadFromJson(const QJsonDocument &json)
 {
     loadFromJson(json.object());
 }
 
 
-
 void PayerInfo::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as payerInfoFields
+enum PayerInfoField {
+    PayerInfoFieldBillingAddress,
+    PayerInfoFieldBirthDate,
+    PayerInfoFieldBuyerAccountNumber,
+    PayerInfoFieldCountryCode,
+    PayerInfoFieldEmail,
+    PayerInfoFieldExternalRememberMeId,
+    PayerInfoFieldFirstName,
+    PayerInfoFieldLastName,
+    PayerInfoFieldMiddleName,
+    PayerInfoFieldPayerId,
+    PayerInfoFieldPhone,
+    PayerInfoFieldPhoneType,
+    PayerInfoFieldSalutation,
+    PayerInfoFieldSuffix,
+    PayerInfoFieldTaxId,
+    PayerInfoFieldTaxIdType,
+    PayerInfoFieldCount
+};
+
+constexpr PPJsonField payerInfoFields[] = {
+    PPJsonField("billing_address"),
+    PPJsonField("birth_date"),
+    PPJsonField("buyer_account_number"),
+    PPJsonField("country_code"),
+    PPJsonField("email"),
+    PPJsonField("external_remember_me_id"),
+    PPJsonField("first_name"),
+    PPJsonField("last_name"),
+    PPJsonField("middle_name"),
+    PPJsonField("payer_id"),
+    PPJsonField("phone"),
+    PPJsonField("phone_type"),
+    PPJsonField("salutation"),
+    PPJsonField("suffix"),
+    PPJsonField("tax_id"),
+    PPJsonField("tax_id_type")
+};
+
+Q_STATIC_ASSERT(sizeof(payerInfoFields) / sizeof(PPJsonField) == PayerInfoFieldCount);
+
+}
+
+
+void PayerInfo::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setEmail(json.value(QStringLiteral("email")).toString());
+    const PPJsonFields<PayerInfoFieldCount> f(json, payerInfoFields);
 
-    setExternalRememberMeId(json.value(QStringLiteral("external_remember_me_id")).toString());
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    setBuyerAccountNumber(json.value(QStringLiteral("buyer_account_number")).toString());
+    setEmail(f[PayerInfoFieldEmail].toString());
 
-    setSalutation(json.value(QStringLiteral("salutation")).toString());
+    setExternalRememberMeId(f[PayerInfoFieldExternalRememberMeId].toString());
 
-    setFirstName(json.value(QStringLiteral("first_name")).toString());
+    setBuyerAccountNumber(f[PayerInfoFieldBuyerAccountNumber].toString());
 
-    setMiddleName(json.value(QStringLiteral("middle_name")).toString());
+    setSalutation(f[PayerInfoFieldSalutation].toString());
 
-    setLastName(json.value(QStringLiteral("last_name")).toString());
+    setFirstName(f[PayerInfoFieldFirstName].toString());
 
-    setSuffix(json.value(QStringLiteral("suffix")).toString());
+    setMiddleName(f[PayerInfoFieldMiddleName].toString());
 
-    setPayerId(json.value(QStringLiteral("payer_id")).toString());
+    setLastName(f[PayerInfoFieldLastName].toString());
 
-    setPhone(json.value(QStringLiteral("phone")).toString());
+    setSuffix(f[PayerInfoFieldSuffix].toString());
 
-    const QString pt = json.value(QStringLiteral("phone_type")).toString();
+    setPayerId(f[PayerInfoFieldPayerId].toString());
+
+    setPhone(f[PayerInfoFieldPhone].toString());
+
+    const QString pt = f[PayerInfoFieldPhoneType].toString();
     if (pt == QLatin1String("HOME")) {
         setPhoneType(Home);
     } else if (pt == QLatin1String("WORK")) {
         setPhoneType(Work);
-    } else if (pt == QLatin1String("Mobile")) {
+    } else if (pt == QLatin1String("MOBILE") || pt == QLatin1String("Mobile")) {
         setPhoneType(Mobile);
     } else if (pt == QLatin1String("OTHER")) {
         setPhoneType(Other);
@@ -431,9 +551,11 @@ void PayerInfo::loadFromJson(const QJsonObject &json)
         setPhoneType(NoPhoneType);
     }
 
-    setTaxId(json.value(QStringLiteral("tax_id")).toString());
+    setBirthDate(QDate::fromString(f[PayerInfoFieldBirthDate].toString(), QStringLiteral("yyyy-MM-dd")));
+
+    setTaxId(f[PayerInfoFieldTaxId].toString());
 
-    const QString tit = json.value(QStringLiteral("tax_id_type")).toString();
+    const QString tit = f[PayerInfoFieldTaxIdType].toString();
     if (tit == QLatin1String("BR_CPF")) {
         setTaxIdType(BR_CPF);
     } else if (tit == QLatin1String("BR_CNPJ")) {
@@ -442,9 +564,9 @@ void PayerInfo::loadFromJson(const QJsonObject &json)
         setTaxIdType(NoTaxIdType);
     }
 
-    setCountryCode(json.value(QStringLiteral("country_code")).toString());
+    setCountryCode(PPStringPool::intern(f[PayerInfoFieldCountryCode].toString()));
 
-    const QJsonObject bao = json.value(QStringLiteral("billing_address")).toObject();
+    const PPJsonValue bao = f[PayerInfoFieldBillingAddress].toObject();
     Address *oldBao = billingAddress();
     if (!bao.isEmpty()) {
         if (oldBao) {
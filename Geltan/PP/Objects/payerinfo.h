@@ -27,11 +27,13 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class PayerInfoPrivate;
+class PPJsonWriter;
 class Address;
 class ShippingAddress;
 
@@ -244,6 +246,11 @@ public:
      */
     PayerInfo(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new PayerInfo object from a value of a PPJsonDocument.
+     */
+    PayerInfo(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the PayerInfo object.
      */
@@ -341,6 +348,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -358,6 +373,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the PayerInfo object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void emailChanged(const QString &email);
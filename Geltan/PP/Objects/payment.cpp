@@ -20,12 +20,22 @@
  */
 
 #include "payment_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/payer.h>
 #include <Geltan/PP/Objects/transaction.h>
 #include <Geltan/PP/Objects/redirecturls.h>
 #include <Geltan/PP/Objects/link.h>
 #include <Geltan/PP/Objects/paymentamount.h>
+#include <Geltan/PP/Objects/itemlist.h>
+#include <Geltan/PP/Objects/item.h>
+#include <Geltan/PP/Objects/shippingaddress.h>
+#include <Geltan/PP/ppenumsmap.h>
 #include <QJsonArray>
+#include <QStringList>
+#include <Geltan/PP/Values/paymentvalue.h>
+#include <Geltan/PP/Values/paymentsnapshot.h>
+#include <Geltan/PP/pptimestamp.h>
 
 #ifdef QT_DEBUG
 #include <QtDebug>
@@ -57,6 +67,21 @@ Payment::Payment(const QJsonObject &json, QObject *parent) :
 }
 
 
+Payment::Payment(const PPJsonValue &json, QObject *parent) :
+    QAbstractListModel(parent), d_ptr(new PaymentPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
+
+Payment::Payment(const PaymentValue &value, QObject *parent) :
+    QAbstractListModel(parent), d_ptr(new PaymentPrivate(this))
+{
+    loadFromValue(value);
+}
+
+
 
 Payment::~Payment()
 {
@@ -334,22 +359,7 @@ QVariantMap Payment::toVariant()
 
     QVariantMap map;
 
-    QString it; // intent
-    switch(intent()) {
-    case Sale:
-        it = QStringLiteral("sale");
-        break;
-    case Authorize:
-        it = QStringLiteral("authorize");
-        break;
-    case Order:
-        it = QStringLiteral("order");
-        break;
-    default:
-        break;
-    }
-
-    d->addStringToVariantMap(&map, QStringLiteral("intent"), it);
+    d->addStringToVariantMap(&map, QStringLiteral("intent"), PPEnumsMap::paymentIntentEnumToToken(intent()));
 
     if (payer()) {
         d->addMapToVariantMap(&map, QStringLiteral("payer"), payer()->toVariant());
@@ -376,6 +386,39 @@ QVariantMap Payment::toVariant()
 
 
 
+void Payment::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(Payment);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("intent"), PPEnumsMap::paymentIntentEnumToToken(intent()));
+
+    if (payer()) {
+        payer()->writeJson(writer, QLatin1String("payer"));
+    }
+
+    if (!transactions().isEmpty()) {
+        writer->beginArray(QLatin1String("transactions"));
+        const auto trs = transactions();
+        for (Transaction *t : trs) {
+            t->writeJson(writer);
+        }
+        writer->endArray();
+    }
+
+    d->writeString(writer, QLatin1String("experience_profile_id"), experienceProfileId());
+    d->writeString(writer, QLatin1String("note_to_payer"), noteToPayer(), 165);
+
+    if (redirectUrls()) {
+        redirectUrls()->writeJson(writer, QLatin1String("redirect_urls"));
+    }
+
+    writer->endObject();
+}
+
+
+
 QJsonObject Payment::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -606,29 +649,69 @@ void Payment::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Payment::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as paymentFields
+enum PaymentField {
+    PaymentFieldCreateTime,
+    PaymentFieldExperienceProfileId,
+    PaymentFieldFailureReason,
+    PaymentFieldId,
+    PaymentFieldIntent,
+    PaymentFieldLinks,
+    PaymentFieldNoteToPayer,
+    PaymentFieldPayer,
+    PaymentFieldRedirectUrls,
+    PaymentFieldState,
+    PaymentFieldTransactions,
+    PaymentFieldUpdateTime,
+    PaymentFieldCount
+};
+
+constexpr PPJsonField paymentFields[] = {
+    PPJsonField("create_time"),
+    PPJsonField("experience_profile_id"),
+    PPJsonField("failure_reason"),
+    PPJsonField("id"),
+    PPJsonField("intent"),
+    PPJsonField("links"),
+    PPJsonField("note_to_payer"),
+    PPJsonField("payer"),
+    PPJsonField("redirect_urls"),
+    PPJsonField("state"),
+    PPJsonField("transactions"),
+    PPJsonField("update_time")
+};
+
+Q_STATIC_ASSERT(sizeof(paymentFields) / sizeof(PPJsonField) == PaymentFieldCount);
+
+}
+
+
+void Payment::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<PaymentFieldCount> f(json, paymentFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(Payment);
 
-    setId(json.value(QStringLiteral("id")).toString(id()));
+    setId(f[PaymentFieldId].toString(id()));
 
-    const QString sIntent = json.value(QStringLiteral("intent")).toString();
-    if (QString::compare(sIntent, QStringLiteral("sale"), Qt::CaseInsensitive)) {
-        setIntent(Sale);
-    } else if (QString::compare(sIntent, QStringLiteral("authorize"), Qt::CaseInsensitive)) {
-        setIntent(Authorize);
-    } else if (QString::compare(sIntent, QStringLiteral("order"), Qt::CaseInsensitive)) {
-        setIntent(Order);
-    } else {
-        setIntent(NoIntent);
-    }
+    setIntent(PPEnumsMap::paymentIntentTokenToEnum(f[PaymentFieldIntent].toString()));
 
-    const QJsonObject po = json.value(QStringLiteral("payer")).toObject();
+    const PPJsonValue po = f[PaymentFieldPayer].toObject();
     Payer *oldPo = payer();
     if (!po.isEmpty()) {
         if (oldPo) {
@@ -641,34 +724,19 @@ void Payment::loadFromJson(const QJsonObject &json)
         delete oldPo;
     }
 
-    const QJsonArray ts = json.value(QStringLiteral("transactions")).toArray();
-    d->clearTransactions();
-    if (!ts.isEmpty()) {
-        beginInsertRows(QModelIndex(), 0, ts.count() - 1);
-        QJsonArray::const_iterator i = ts.constBegin();
-        while (i != ts.constEnd()) {
-            d->transactions.append(new Transaction(i->toObject(), this));
-            ++i;
-        }
-        endInsertRows();
+    const PPJsonValue ts = f[PaymentFieldTransactions].toArray();
+    {
+        const PPLoadScope::Unblocked unblocked(&scope);
+        d->reloadTransactions(ts);
     }
 
-    const QString sState = json.value(QStringLiteral("state")).toString();
-    if (QString::compare(sState, QStringLiteral("created"), Qt::CaseInsensitive)) {
-        setState(Created);
-    } else if (QString::compare(sState, QStringLiteral("approved"), Qt::CaseInsensitive)) {
-        setState(Approved);
-    } else if (QString::compare(sState, QStringLiteral("failed"), Qt::CaseInsensitive)) {
-        setState(Failed);
-    } else{
-        setState(NoState);
-    }
+    setState(PPEnumsMap::paymentStateTokenToEnum(f[PaymentFieldState].toString()));
 
-    setExperienceProfileId(json.value(QStringLiteral("experience_profile_id")).toString(experienceProfileId()));
+    setExperienceProfileId(f[PaymentFieldExperienceProfileId].toString(experienceProfileId()));
 
-    setNoteToPayer(json.value(QStringLiteral("note_to_payer")).toString(noteToPayer()));
+    setNoteToPayer(f[PaymentFieldNoteToPayer].toString(noteToPayer()));
 
-    const QJsonObject rus = json.value(QStringLiteral("redirect_urls")).toObject();
+    const PPJsonValue rus = f[PaymentFieldRedirectUrls].toObject();
     RedirectUrls *oldRus = redirectUrls();
     if (!rus.isEmpty()) {
         if (oldRus) {
@@ -681,47 +749,301 @@ void Payment::loadFromJson(const QJsonObject &json)
         delete oldRus;
     }
 
-    const QString sfr = json.value(QStringLiteral("failure_reason")).toString();
-    if (QString::compare(sfr, QStringLiteral("UNABLE_TO_COMPLETE_TRANSACTION"), Qt::CaseInsensitive)) {
-        setFailureReason(UnableToCompleteTransaction);
-    } else if (QString::compare(sfr, QStringLiteral("INVALID_PAYMENT_METHOD"), Qt::CaseInsensitive)) {
-        setFailureReason(InvalidPaymentMethod);
-    } else if (QString::compare(sfr, QStringLiteral("PAYER_CANNOT_PAY"), Qt::CaseInsensitive)) {
-        setFailureReason(PayerCannotPay);
-    } else if (QString::compare(sfr, QStringLiteral("CANNOT_PAY_THIS_PAYEE"), Qt::CaseInsensitive)) {
-        setFailureReason(CannotPayThisPayee);
-    } else if (QString::compare(sfr, QStringLiteral("REDIRECT_REQUIRED"), Qt::CaseInsensitive)) {
-        setFailureReason(RedirectRequired);
-    } else if (QString::compare(sfr, QStringLiteral("PAYEE_FILTER_RESTRICTIONS"), Qt::CaseInsensitive)) {
-        setFailureReason(PayeeFilterRestrictions);
-    } else {
-        setFailureReason(NoFailureReason);
-    }
+    setFailureReason(PPEnumsMap::paymentFailureReasonTokenToEnum(f[PaymentFieldFailureReason].toString()));
 
-    const QString sCreateTime = json.value(QStringLiteral("create_time")).toString();
+    const QString sCreateTime = f[PaymentFieldCreateTime].toString();
     if (!sCreateTime.isEmpty()) {
-        setCreateTime(QDateTime::fromString(sCreateTime, Qt::ISODate));
+        setCreateTime(PPTimestamp::toDateTime(sCreateTime));
     } else {
         setCreateTime(QDateTime());
     }
 
-    const QString sUpdateTime = json.value(QStringLiteral("update_time")).toString();
+    const QString sUpdateTime = f[PaymentFieldUpdateTime].toString();
     if (!sUpdateTime.isEmpty()) {
-        setUpdateTime(QDateTime::fromString(sUpdateTime, Qt::ISODate));
+        setUpdateTime(PPTimestamp::toDateTime(sUpdateTime));
     } else {
         setUpdateTime(QDateTime());
     }
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
-    d->clearLinks();
-    if (!la.isEmpty()) {
-        QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
-        while (i != la.constEnd()) {
-            linksToAdd.append(new Link(i->toObject()));
+    d->reloadLinks(f[PaymentFieldLinks].toArray());
+
+    // the snapshot for the modification tracking is only created when it is needed
+    d->loadedJson = PaymentPrivate::patchableJson(json);
+    d->snapshotValid = false;
+
+    const PPLoadScope::Unblocked unblocked(&scope);
+    Q_EMIT loaded();
+}
+
+
+
+PaymentValue Payment::toValue() const
+{
+    PaymentValue v;
+
+    v.setId(id());
+    v.setIntent(intent());
+
+    if (payer()) {
+        v.setPayer(payer()->toValue());
+    }
+
+    const QList<Transaction*> trs = transactions();
+    if (!trs.isEmpty()) {
+        QList<TransactionValue> tvs;
+        tvs.reserve(trs.size());
+        for (const Transaction *t : trs) {
+            tvs.append(t->toValue());
+        }
+        v.setTransactions(tvs);
+    }
+
+    v.setState(state());
+    v.setExperienceProfileId(experienceProfileId());
+    v.setNoteToPayer(noteToPayer());
+
+    if (redirectUrls()) {
+        v.setReturnUrl(redirectUrls()->returnUrl());
+        v.setCancelUrl(redirectUrls()->cancelUrl());
+    }
+
+    v.setFailureReason(failureReason());
+    v.setCreateTime(createTime());
+    v.setUpdateTime(updateTime());
+
+    const QList<Link*> ls = links();
+    if (!ls.isEmpty()) {
+        QList<LinkValue> lvs;
+        lvs.reserve(ls.size());
+        for (const Link *l : ls) {
+            lvs.append(l->toValue());
+        }
+        v.setLinks(lvs);
+    }
+
+    return v;
+}
+
+
+
+void Payment::loadFromValue(const PaymentValue &value)
+{
+    loadFromJson(value.toJsonObject());
+}
+
+
+
+QByteArray Payment::toSnapshot() const
+{
+    return PaymentSnapshot::write(QList<PaymentValue>({toValue()}));
+}
+
+
+
+bool Payment::loadFromSnapshot(const QByteArray &snapshot)
+{
+    bool ok = false;
+    const QList<PaymentValue> ps = PaymentSnapshot::read(snapshot, nullptr, &ok);
+    if (!ok || ps.isEmpty()) {
+        return false;
+    }
+
+    loadFromValue(ps.first());
+
+    return true;
+}
+
+
+
+
+QByteArray PaymentPrivate::patchableJson(const PPJsonValue &json)
+{
+    static const char * const transactionKeys[] = {"amount", "description", "custom", "invoice_number", "soft_descriptor"};
+
+    QByteArray p;
+    p.append('{');
+
+    const PPJsonValue note = json.value(QLatin1String("note_to_payer"));
+    if (!note.isUndefined()) {
+        p.append("\"note_to_payer\":").append(note.toJson());
+    }
+
+    const PPJsonValue ts = json.value(QLatin1String("transactions")).toArray();
+    if (!ts.isEmpty()) {
+        if (p.size() > 1) {
+            p.append(',');
+        }
+        p.append("\"transactions\":[");
+        PPJsonValue::const_iterator i = ts.constBegin();
+        while (i != ts.constEnd()) {
+            if (p.at(p.size() - 1) != '[') {
+                p.append(',');
+            }
+            // keep the positions, the patch paths use the transaction index
+            p.append('{');
+            for (const char *key : transactionKeys) {
+                const PPJsonValue v = i->value(QLatin1String(key));
+                if (!v.isUndefined()) {
+                    if (p.at(p.size() - 1) != '{') {
+                        p.append(',');
+                    }
+                    p.append('"').append(key).append("\":").append(v.toJson());
+                }
+            }
+            const PPJsonValue il = i->value(QLatin1String("item_list")).toObject();
+            if (!il.isEmpty()) {
+                if (p.at(p.size() - 1) != '{') {
+                    p.append(',');
+                }
+                p.append("\"item_list\":{");
+                const PPJsonValue items = il.value(QLatin1String("items"));
+                if (!items.isUndefined()) {
+                    p.append("\"items\":").append(items.toJson());
+                }
+                const PPJsonValue sa = il.value(QLatin1String("shipping_address"));
+                if (!sa.isUndefined()) {
+                    if (!items.isUndefined()) {
+                        p.append(',');
+                    }
+                    p.append("\"shipping_address\":").append(sa.toJson());
+                }
+                p.append('}');
+            }
+            p.append('}');
             ++i;
         }
-        setLinks(linksToAdd);
+        p.append(']');
+    }
+
+    p.append('}');
+
+    return p;
+}
+
+
+
+QMap<QString, QJsonValue> PaymentPrivate::patchableValues(const Payment *payment)
+{
+    QMap<QString, QJsonValue> v;
+
+    if (!payment->noteToPayer().isEmpty()) {
+        v.insert(QStringLiteral("/note_to_payer"), payment->noteToPayer().left(165));
+    }
+
+    const QList<Transaction*> trs = payment->transactions();
+    for (int i = 0; i < trs.size(); ++i) {
+        Transaction *t = trs.at(i);
+        const QString base = QLatin1String("/transactions/") + QString::number(i) + QLatin1Char('/');
+
+        if (t->amount()) {
+            const QJsonObject a = t->amount()->toJsonObject();
+            if (!a.isEmpty()) {
+                v.insert(base + QLatin1String("amount"), a);
+            }
+        }
+
+        if (!t->description().isEmpty()) {
+            v.insert(base + QLatin1String("description"), t->description().left(127));
+        }
+        if (!t->custom().isEmpty()) {
+            v.insert(base + QLatin1String("custom"), t->custom().left(127));
+        }
+        if (!t->invoiceNumber().isEmpty()) {
+            v.insert(base + QLatin1String("invoice_number"), t->invoiceNumber().left(127));
+        }
+        if (!t->softDescriptor().isEmpty()) {
+            v.insert(base + QLatin1String("soft_descriptor"), t->softDescriptor().left(22));
+        }
+
+        if (t->itemList()) {
+            const QList<Item*> its = t->itemList()->items();
+            if (!its.isEmpty()) {
+                QJsonArray items;
+                for (Item *it : its) {
+                    items.append(it->toJsonObject());
+                }
+                v.insert(base + QLatin1String("item_list/items"), items);
+            }
+
+            if (t->itemList()->shippingAddress()) {
+                const QJsonObject sa = t->itemList()->shippingAddress()->toJsonObject();
+                if (!sa.isEmpty()) {
+                    v.insert(base + QLatin1String("item_list/shipping_address"), sa);
+                }
+            }
+        }
+    }
+
+    return v;
+}
+
+
+
+bool Payment::isModified() const
+{
+    Q_D(const Payment);
+    return d->snapshot() != PaymentPrivate::patchableValues(this);
+}
+
+
+
+QJsonArray Payment::jsonPatch() const
+{
+    Q_D(const Payment);
+
+    const QMap<QString, QJsonValue> &old = d->snapshot();
+    const QMap<QString, QJsonValue> cur = PaymentPrivate::patchableValues(this);
+
+    QJsonArray patch;
+
+    for (auto it = cur.constBegin(); it != cur.constEnd(); ++it) {
+        const auto o = old.constFind(it.key());
+        if (o == old.constEnd() || o.value() != it.value()) {
+            QJsonObject op;
+            op.insert(QStringLiteral("op"), (o == old.constEnd()) ? QStringLiteral("add") : QStringLiteral("replace"));
+            op.insert(QStringLiteral("path"), it.key());
+            op.insert(QStringLiteral("value"), it.value());
+            patch.append(op);
+        }
+    }
+
+    for (auto it = old.constBegin(); it != old.constEnd(); ++it) {
+        if (!cur.contains(it.key())) {
+            QJsonObject op;
+            op.insert(QStringLiteral("op"), QStringLiteral("remove"));
+            op.insert(QStringLiteral("path"), it.key());
+            patch.append(op);
+        }
     }
 
+    return patch;
+}
+
+
+
+void Payment::commitPatch(const QJsonArray &patch)
+{
+    Q_D(Payment);
+
+    d->snapshot();
+
+    for (const QJsonValue &v : patch) {
+        const QJsonObject op = v.toObject();
+        const QString path = op.value(QStringLiteral("path")).toString();
+        if (op.value(QStringLiteral("op")).toString() == QLatin1String("remove")) {
+            d->snapshotValues.remove(path);
+        } else {
+            d->snapshotValues.insert(path, op.value(QStringLiteral("value")));
+        }
+    }
+}
+
+
+
+void Payment::resetModified()
+{
+    Q_D(Payment);
+    d->snapshotValues = PaymentPrivate::patchableValues(this);
+    d->loadedJson = QByteArray();
+    d->snapshotValid = true;
 }
@@ -26,15 +26,19 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QJsonArray>
 #include <QAbstractListModel>
 #include <QDateTime>
 #include <QUrl>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class PaymentPrivate;
+class PPJsonWriter;
+class PaymentValue;
 class Payer;
 class Transaction;
 class RedirectUrls;
@@ -202,6 +206,16 @@ public:
      */
     Payment(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Payment object from a value of a PPJsonDocument.
+     */
+    Payment(const PPJsonValue &json, QObject *parent = nullptr);
+
+    /*!
+     * \brief Constructs a new Payment object from an implicitly shared PaymentValue.
+     */
+    Payment(const PaymentValue &value, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Payment object.
      */
@@ -428,6 +442,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -459,6 +481,70 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Payment object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared PaymentValue containing the payment data, including the read only members.
+     */
+    PaymentValue toValue() const;
+
+    /*!
+     * \brief Returns true if members that can be changed by a payment update differ from the data loaded last.
+     *
+     * \sa jsonPatch(), Payments::Update
+     */
+    bool isModified() const;
+
+    /*!
+     * \brief Returns the JSON Patch operations that turn the data loaded last into the current data.
+     *
+     * Only the members PayPal accepts in a payment update are taken into account: the note to the payer
+     * and the amount, description, custom field, invoice number, soft descriptor, items and shipping address
+     * of the transactions. Amounts, item lists and shipping addresses are replaced as a whole. The operations
+     * are sorted by path. Returns an empty array if nothing has been modified.
+     *
+     * The loaded data is only parsed again when this or isModified() is called for the first time after
+     * loading, so loading stays as fast as without modification tracking.
+     */
+    QJsonArray jsonPatch() const;
+
+    /*!
+     * \brief Marks the members changed by the operations in \a patch as not modified anymore.
+     *
+     * Call this after \a patch has been applied successfully. Members changed since jsonPatch() has
+     * been called stay modified.
+     */
+    void commitPatch(const QJsonArray &patch);
+
+    /*!
+     * \brief Marks all members as not modified.
+     */
+    void resetModified();
+
+    /*!
+     * \brief Loads the data of the implicitly shared \a value into the Payment object.
+     */
+    void loadFromValue(const PaymentValue &value);
+
+    /*!
+     * \brief Returns a binary snapshot of the complete payment data, including the read only members.
+     *
+     * \sa PaymentSnapshot
+     */
+    QByteArray toSnapshot() const;
+
+    /*!
+     * \brief Loads the payment data from the binary \a snapshot created by toSnapshot().
+     *
+     * Returns false and leaves the payment unchanged if \a snapshot is not valid or does not contain a payment.
+     */
+    bool loadFromSnapshot(const QByteArray &snapshot);
+
 
 Q_SIGNALS:
     void idChanged(const QString &id);
@@ -474,6 +560,14 @@ Q_SIGNALS:
     void updateTimeChanged(const QDateTime &updateTime);
     void linksChanged(const QList<Link*> &links);
 
+    /*!
+     * \brief This signal will be emitted when new data has been loaded by loadFromJson().
+     *
+     * Child objects like the payer or the related resources are reloaded in place, so their
+     * changes are not always reported by the change signals of the Payment properties.
+     */
+    void loaded();
+
 protected:
     const QScopedPointer<PaymentPrivate> d_ptr;
 
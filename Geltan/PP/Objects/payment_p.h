@@ -23,7 +23,13 @@
 #define PAYMENT_P_H
 
 #include "payment.h"
+#include "transaction.h"
+#include "paymentamount.h"
+#include "link.h"
 #include "ppobjectsbase_p.h"
+#include "../ppjsondocument.h"
+#include <QJsonArray>
+#include <QMap>
 
 namespace Geltan {
 namespace PP {
@@ -37,7 +43,8 @@ public:
         payer(nullptr),
         state(Payment::NoState),
         redirectUrls(nullptr),
-        failureReason(Payment::NoFailureReason)
+        failureReason(Payment::NoFailureReason),
+        snapshotValid(true)
     {}
 
     ~PaymentPrivate() {}
@@ -68,6 +75,121 @@ public:
 
     }
 
+    /*!
+     * \internal
+     * \brief Reconciles the transactions with the data in \a ts.
+     *
+     * Transactions are matched by position. Existing Transaction objects are reloaded in place,
+     * only surplus rows are removed and only missing rows are created. dataChanged() is emitted
+     * for reused rows whose role data changed.
+     */
+    void reloadTransactions(const PPJsonValue &ts)
+    {
+        Q_Q(Payment);
+
+        const int tsCount = ts.count();
+        const int reused = qMin(transactions.count(), tsCount);
+
+        PPJsonValue::const_iterator it = ts.constBegin();
+        for (int i = 0; i < reused; ++i, ++it) {
+            Transaction *t = transactions.at(i);
+            // the amount object is reloaded in place, so its values have to be compared, not the pointer
+            const PaymentAmount *oldAmount = t->amount();
+            const Money oldTotal = oldAmount ? oldAmount->totalMoney() : Money();
+            const QString oldCurrency = oldAmount ? oldAmount->currency() : QString();
+            const QString oldDescription = t->description();
+            t->loadFromJson(it->toObject());
+            const PaymentAmount *newAmount = t->amount();
+            if (newAmount != oldAmount
+                    || (newAmount && (newAmount->totalMoney() != oldTotal || newAmount->currency() != oldCurrency))
+                    || t->description() != oldDescription) {
+                const QModelIndex idx = q->index(i);
+                Q_EMIT q->dataChanged(idx, idx);
+            }
+        }
+
+        if (reused < transactions.count()) {
+            q->beginRemoveRows(QModelIndex(), reused, transactions.count() - 1);
+            const QList<Transaction*> surplus = transactions.mid(reused);
+            transactions.erase(transactions.begin() + reused, transactions.end());
+            qDeleteAll(surplus);
+            q->endRemoveRows();
+        }
+
+        if (reused < tsCount) {
+            q->beginInsertRows(QModelIndex(), reused, tsCount - 1);
+            transactions.reserve(tsCount);
+            while (it != ts.constEnd()) {
+                transactions.append(new Transaction(it->toObject(), q));
+                ++it;
+            }
+            q->endInsertRows();
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Reconciles the links with the data in \a la.
+     *
+     * If the number of links did not change, the existing Link objects are reloaded in place.
+     */
+    void reloadLinks(const PPJsonValue &la)
+    {
+        if (!links.isEmpty() && links.count() == la.count()) {
+            PPJsonValue::const_iterator it = la.constBegin();
+            for (int i = 0; i < links.count(); ++i, ++it) {
+                links.at(i)->loadFromJson(it->toObject());
+            }
+            return;
+        }
+
+        Q_Q(Payment);
+
+        clearLinks();
+        if (!la.isEmpty()) {
+            QList<Link*> linksToAdd;
+            linksToAdd.reserve(la.count());
+            PPJsonValue::const_iterator i = la.constBegin();
+            while (i != la.constEnd()) {
+                linksToAdd.append(new Link(i->toObject()));
+                ++i;
+            }
+            q->setLinks(linksToAdd);
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Returns the members a payment update can change, keyed by their JSON Pointer.
+     */
+    static QMap<QString, QJsonValue> patchableValues(const Payment *payment);
+
+    /*!
+     * \internal
+     * \brief Returns the compact JSON of the members of \a json a payment update can change.
+     *
+     * A PPJsonValue keeps the complete document it has been taken from alive, so only a copy of
+     * the patchable members is kept for the modification tracking.
+     */
+    static QByteArray patchableJson(const PPJsonValue &json);
+
+    /*!
+     * \internal
+     * \brief Returns the patchable values of the data loaded last, parsing them on first use.
+     */
+    const QMap<QString, QJsonValue> &snapshot() const
+    {
+        if (!snapshotValid) {
+            const PPJsonDocument doc = PPJsonDocument::fromJson(loadedJson);
+            Payment loaded;
+            loaded.loadFromJson(doc.root());
+            snapshotValues = patchableValues(&loaded);
+            loadedJson = QByteArray();
+            snapshotValid = true;
+        }
+        return snapshotValues;
+    }
+
     Payment * const q_ptr;
     Q_DECLARE_PUBLIC(Payment)
     QString id;
@@ -82,6 +204,9 @@ public:
     QDateTime createTime;
     QDateTime updateTime;
     QList<Link*> links;
+    mutable QByteArray loadedJson;
+    mutable QMap<QString, QJsonValue> snapshotValues;
+    mutable bool snapshotValid;
 };
 
 }
@@ -20,8 +20,10 @@
  */
 
 #include "paymentamount_p.h"
-#include <QtMath>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
+#include <Geltan/PP/Values/paymentamountvalue.h>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -40,7 +42,7 @@ PaymentAmount::PaymentAmount(float total, const QString &currency, QObject *pare
     QObject(parent), d_ptr(new PaymentAmountPrivate(this))
 {
     Q_D(PaymentAmount);
-    d->total = total;
+    d->total = Money::fromDouble(total);
     d->currency = currency;
     d->checkValidity();
 }
@@ -61,6 +63,13 @@ PaymentAmount::PaymentAmount(const QJsonObject &json, QObject *parent) :
 }
 
 
+PaymentAmount::PaymentAmount(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new PaymentAmountPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 PaymentAmount::~PaymentAmount()
 {
 
@@ -85,15 +94,23 @@ void PaymentAmount::setCurrency(const QString &nCurrency)
 
 
 
-float PaymentAmount::total() const { Q_D(const PaymentAmount); return d->total; }
+float PaymentAmount::total() const { Q_D(const PaymentAmount); return d->total.toFloat(); }
 
 void PaymentAmount::setTotal(float nTotal)
 {
-    Q_D(PaymentAmount); 
+    setTotalMoney(Money::fromDouble(nTotal));
+}
+
+
+Money PaymentAmount::totalMoney() const { Q_D(const PaymentAmount); return d->total; }
+
+void PaymentAmount::setTotalMoney(const Money &nTotal)
+{
+    Q_D(PaymentAmount);
     if (nTotal != d->total) {
         d->total = nTotal;
 #ifdef QT_DEBUG
-        qDebug() << "Changed total to" << d->total;
+        qDebug() << "Changed total to" << d->total.toString();
 #endif
         Q_EMIT totalChanged(total());
         d->checkValidity();
@@ -324,11 +341,7 @@ QVariantMap PaymentAmount::toVariant()
     QVariantMap map;
 
     d->addStringToVariantMap(&map, QStringLiteral("currency"), currency(), 3);
-    if (QStringList({QStringLiteral("HUF"), QStringLiteral("JPY"), QStringLiteral("TWD")}).contains(currency())) {
-        d->addIntToVariantMap(&map, QStringLiteral("total"), qFloor(total()));
-    } else {
-        d->addFloatToVariantMap(&map, QStringLiteral("total"), total());
-    }
+    d->addMoneyToVariantMap(&map, QStringLiteral("total"), d->total, currency());
 
     if (details()) {
         d->addMapToVariantMap(&map, QStringLiteral("details"), details()->toVariant(currency()));
@@ -339,6 +352,24 @@ QVariantMap PaymentAmount::toVariant()
 
 
 
+void PaymentAmount::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(PaymentAmount);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("currency"), currency(), 3);
+    d->writeMoney(writer, QLatin1String("total"), d->total, currency());
+
+    if (details()) {
+        details()->writeJson(writer, currency(), QLatin1String("details"));
+    }
+
+    writer->endObject();
+}
+
+
+
 QJsonObject PaymentAmount::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -353,18 +384,26 @@ void PaymentAmount::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void PaymentAmount::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+void PaymentAmount::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    setCurrency(json.value(QStringLiteral("currency")).toString());
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    setTotal(json.value(QStringLiteral("total")).toString().toFloat());
+    setCurrency(PPStringPool::intern(json.value(QLatin1String("currency")).toString()));
 
-    const QJsonObject deo = json.value(QStringLiteral("details")).toObject();
+    setTotalMoney(Money::fromJson(json.value(QLatin1String("total"))));
+
+    const PPJsonValue deo = json.value(QLatin1String("details")).toObject();
     Details *oldDeo = details();
     if (!deo.isEmpty()) {
         if (oldDeo) {
@@ -377,3 +416,19 @@ void PaymentAmount::loadFromJson(const QJsonObject &json)
         delete oldDeo;
     }
 }
+
+
+
+PaymentAmountValue PaymentAmount::toValue() const
+{
+    PaymentAmountValue v;
+
+    v.setCurrency(currency());
+    v.setTotalMoney(totalMoney());
+
+    if (details()) {
+        v.setDetails(details()->toValue());
+    }
+
+    return v;
+}
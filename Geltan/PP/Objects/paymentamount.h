@@ -26,11 +26,15 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
 
 namespace Geltan {
 namespace PP {
 
 class PaymentAmountPrivate;
+class PPJsonWriter;
+class PaymentAmountValue;
 class Details;
 
 /*!
@@ -229,6 +233,11 @@ public:
      */
     PaymentAmount(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new PaymentAmount object from a value of a PPJsonDocument.
+     */
+    PaymentAmount(const PPJsonValue &json, QObject *parent = nullptr);
+
 
     /*!
      * \brief Deconstructs the PaymentAmount object.
@@ -238,6 +247,7 @@ public:
 
     QString currency() const;
     float total() const;
+    Money totalMoney() const;
     Details *details() const;
     float subtotal() const;
     float shipping() const;
@@ -250,6 +260,7 @@ public:
 
     void setCurrency(const QString &nCurrency);
     void setTotal(float nTotal);
+    void setTotalMoney(const Money &nTotal);
     void setDetails(Details *nDetails);
     void setSubtotal(float nSubtotal);
     void setShipping(float nShipping);
@@ -267,6 +278,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -285,6 +304,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the PaymentAmount object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared PaymentAmountValue containing the amount data, including the read only members.
+     */
+    PaymentAmountValue toValue() const;
+
 
 Q_SIGNALS:
     void currencyChanged(const QString &currency);
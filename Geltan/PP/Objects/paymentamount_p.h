@@ -38,7 +38,7 @@ class PaymentAmountPrivate : public PPObjectsBasePrivate
 public:
     PaymentAmountPrivate(PaymentAmount *parent) :
         q_ptr(parent),
-        total(0.0),
+        total(),
         details(nullptr),
         valid(false)
     {
@@ -51,20 +51,14 @@ public:
     {
         bool _v = true;
 
-        if (total == 0.0f || currency.length() != 3) {
+        if (total.isZero() || currency.length() != 3) {
             _v = false;
         }
 
         if (details && _v) {
-            float calcTotal = details->subtotal();
-            calcTotal += details->tax();
-            calcTotal += details->shipping();
-            calcTotal += details->insurance();
-            calcTotal += details->handlingFee();
-            calcTotal += details->shippingDiscount();
-            calcTotal += details->giftWrap();
-
-            if ((calcTotal > 0.0f) && (total != calcTotal)) {
+            const Money calcTotal = detailsTotal();
+
+            if (calcTotal.isPositive() && (total != calcTotal)) {
                 _v = false;
             }
         }
@@ -76,25 +70,35 @@ public:
         }
     }
 
+    /*!
+     * \internal
+     * \brief Returns the exact sum of all details amounts.
+     */
+    Money detailsTotal() const
+    {
+        Money sum = details->subtotalMoney();
+        sum += details->taxMoney();
+        sum += details->shippingMoney();
+        sum += details->insuranceMoney();
+        sum += details->handlingFeeMoney();
+        sum += details->shippingDiscountMoney();
+        sum += details->giftWrapMoney();
+        return sum;
+    }
+
     void updateTotal()
     {
         if (details) {
             Q_Q(PaymentAmount);
 
-            float calcTotal = details->subtotal();
-            calcTotal += details->tax();
-            calcTotal += details->shipping();
-            calcTotal += details->insurance();
-            calcTotal += details->handlingFee();
-            calcTotal += details->shippingDiscount();
-            calcTotal += details->giftWrap();
+            const Money calcTotal = detailsTotal();
 
             if (total != calcTotal) {
                 total = calcTotal;
-                Q_EMIT q->totalChanged(total);
+                Q_EMIT q->totalChanged(total.toFloat());
             }
 
-            if (total == 0.0f || currency.length() != 3) {
+            if (total.isZero() || currency.length() != 3) {
                 bool _v = false;
                 if (valid != _v) {
                     valid = _v;
@@ -107,7 +111,7 @@ public:
     PaymentAmount * const q_ptr;
     Q_DECLARE_PUBLIC(PaymentAmount)
     QString currency;
-    float total;
+    Money total;
     Details *details;
     bool valid;
 };
@@ -0,0 +1,247 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Objects/paymentfiltermodel.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentfiltermodel_p.h"
+#include "paymentlist_p.h"
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+
+PaymentFilterModel::PaymentFilterModel(QObject *parent) : QSortFilterProxyModel(parent), d_ptr(new PaymentFilterModelPrivate(this))
+{
+
+}
+
+
+
+PaymentFilterModel::~PaymentFilterModel()
+{
+
+}
+
+
+
+
+void PaymentFilterModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    Q_D(PaymentFilterModel);
+
+    PaymentList *list = qobject_cast<PaymentList*>(sourceModel);
+    const bool listChanged = (list != d->paymentList);
+
+    d->paymentList = list;
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+
+    if (listChanged) {
+        Q_EMIT paymentListChanged(paymentList());
+    }
+}
+
+
+
+
+Payment *PaymentFilterModel::at(int row) const
+{
+    Q_D(const PaymentFilterModel);
+
+    if (!d->paymentList) {
+        return nullptr;
+    }
+
+    const QModelIndex idx = index(row, 0);
+    if (!idx.isValid()) {
+        return nullptr;
+    }
+
+    return d->paymentList->at(mapToSource(idx).row());
+}
+
+
+
+
+bool PaymentFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    Q_D(const PaymentFilterModel);
+
+    if (!d->paymentList) {
+        return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    }
+
+    const PaymentListPrivate *ld = d->paymentList->d_func();
+
+    if (sourceRow < 0 || sourceRow >= ld->payments.count()) {
+        return false;
+    }
+
+    const Payment *p = ld->payments.at(sourceRow);
+
+    if (!d->resourceIdFilter.isEmpty() && (ld->resourceIdIndex.value(d->resourceIdFilter) != p)) {
+        return false;
+    }
+
+    const auto it = ld->indexedKeys.constFind(p);
+    if (it == ld->indexedKeys.cend()) {
+        return false;
+    }
+
+    const PaymentIndexKeys &k = it.value();
+
+    if ((d->stateFilter != Payment::NoState) && (k.state != static_cast<int>(d->stateFilter))) {
+        return false;
+    }
+
+    if ((d->intentFilter != Payment::NoIntent) && (k.intent != static_cast<int>(d->intentFilter))) {
+        return false;
+    }
+
+    if (!d->payerEmailKey.isEmpty() && (k.payerEmail != d->payerEmailKey)) {
+        return false;
+    }
+
+    return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+}
+
+
+
+
+bool PaymentFilterModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+{
+    Q_D(const PaymentFilterModel);
+
+    if (!d->paymentList) {
+        return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+    }
+
+    const Payment *l = d->paymentList->at(sourceLeft.row());
+    const Payment *r = d->paymentList->at(sourceRight.row());
+
+    if (!l || !r) {
+        return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+    }
+
+    switch (sortRole()) {
+    case PaymentList::Id:
+        return l->id() < r->id();
+    case PaymentList::CreateTime:
+        return l->createTime() < r->createTime();
+    case PaymentList::UpdateTime:
+        return l->updateTime() < r->updateTime();
+    case PaymentList::State:
+        return l->state() < r->state();
+    case PaymentList::Intent:
+        return l->intent() < r->intent();
+    default:
+        return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+    }
+}
+
+
+
+
+PaymentList *PaymentFilterModel::paymentList() const { Q_D(const PaymentFilterModel); return d->paymentList.data(); }
+
+void PaymentFilterModel::setPaymentList(PaymentList *nPaymentList)
+{
+    Q_D(PaymentFilterModel);
+    if (nPaymentList != d->paymentList) {
+#ifdef QT_DEBUG
+        qDebug() << "Changed paymentList to" << nPaymentList;
+#endif
+        setSourceModel(nPaymentList);
+    }
+}
+
+
+
+
+Payment::State PaymentFilterModel::stateFilter() const { Q_D(const PaymentFilterModel); return d->stateFilter; }
+
+void PaymentFilterModel::setStateFilter(Payment::State nStateFilter)
+{
+    Q_D(PaymentFilterModel);
+    if (nStateFilter != d->stateFilter) {
+        d->stateFilter = nStateFilter;
+#ifdef QT_DEBUG
+        qDebug() << "Changed stateFilter to" << d->stateFilter;
+#endif
+        invalidateFilter();
+        Q_EMIT stateFilterChanged(stateFilter());
+    }
+}
+
+
+
+
+Payment::Intent PaymentFilterModel::intentFilter() const { Q_D(const PaymentFilterModel); return d->intentFilter; }
+
+void PaymentFilterModel::setIntentFilter(Payment::Intent nIntentFilter)
+{
+    Q_D(PaymentFilterModel);
+    if (nIntentFilter != d->intentFilter) {
+        d->intentFilter = nIntentFilter;
+#ifdef QT_DEBUG
+        qDebug() << "Changed intentFilter to" << d->intentFilter;
+#endif
+        invalidateFilter();
+        Q_EMIT intentFilterChanged(intentFilter());
+    }
+}
+
+
+
+
+QString PaymentFilterModel::payerEmailFilter() const { Q_D(const PaymentFilterModel); return d->payerEmailFilter; }
+
+void PaymentFilterModel::setPayerEmailFilter(const QString &nPayerEmailFilter)
+{
+    Q_D(PaymentFilterModel);
+    if (nPayerEmailFilter != d->payerEmailFilter) {
+        d->payerEmailFilter = nPayerEmailFilter;
+        d->payerEmailKey = nPayerEmailFilter.toLower();
+#ifdef QT_DEBUG
+        qDebug() << "Changed payerEmailFilter to" << d->payerEmailFilter;
+#endif
+        invalidateFilter();
+        Q_EMIT payerEmailFilterChanged(payerEmailFilter());
+    }
+}
+
+
+
+
+QString PaymentFilterModel::resourceIdFilter() const { Q_D(const PaymentFilterModel); return d->resourceIdFilter; }
+
+void PaymentFilterModel::setResourceIdFilter(const QString &nResourceIdFilter)
+{
+    Q_D(PaymentFilterModel);
+    if (nResourceIdFilter != d->resourceIdFilter) {
+        d->resourceIdFilter = nResourceIdFilter;
+#ifdef QT_DEBUG
+        qDebug() << "Changed resourceIdFilter to" << d->resourceIdFilter;
+#endif
+        invalidateFilter();
+        Q_EMIT resourceIdFilterChanged(resourceIdFilter());
+    }
+}
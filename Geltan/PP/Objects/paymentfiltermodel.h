@@ -0,0 +1,169 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Objects/paymentfiltermodel.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTFILTERMODEL_H
+#define PAYMENTFILTERMODEL_H
+
+#include <QSortFilterProxyModel>
+#include "payment.h"
+#include "../../geltan_global.h"
+
+namespace Geltan {
+namespace PP {
+
+class PaymentFilterModelPrivate;
+class PaymentList;
+
+/*!
+ * \brief Filters and sorts a PaymentList without going through QVariant roles.
+ *
+ * Filtering uses the values the PaymentList has indexed for every payment, so checking a row is a
+ * single hash lookup and does not need to walk through the payer and transaction objects. Sorting by
+ * the PaymentList::Id, PaymentList::CreateTime, PaymentList::UpdateTime, PaymentList::State and
+ * PaymentList::Intent roles compares the Payment objects directly. Other sort roles fall back to
+ * QSortFilterProxyModel::lessThan().
+ *
+ * All filters are combined, an empty or \a No value disables a filter.
+ *
+ * \code{.cpp}
+ * Geltan::PP::PaymentFilterModel *approved = new Geltan::PP::PaymentFilterModel(this);
+ * approved->setPaymentList(paymentList);
+ * approved->setStateFilter(Geltan::PP::Payment::Approved);
+ * approved->setSortRole(Geltan::PP::PaymentList::UpdateTime);
+ * approved->sort(0, Qt::DescendingOrder);
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Objects/paymentfiltermodel.h>
+ */
+class GELTANSHARED_EXPORT PaymentFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+    /*!
+     * \brief The PaymentList that should be filtered.
+     *
+     * Setting it sets the source model. The filter model does not take ownership of the list.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>PaymentList*</TD><TD>paymentList() const</TD></TR><TR><TD>void</TD><TD>setPaymentList(PaymentList *nPaymentList)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>paymentListChanged(PaymentList *paymentList)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::PaymentList *paymentList READ paymentList WRITE setPaymentList NOTIFY paymentListChanged)
+    /*!
+     * \brief Only accept payments with this state. Payment::NoState disables the filter.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Payment::State</TD><TD>stateFilter() const</TD></TR><TR><TD>void</TD><TD>setStateFilter(Payment::State nStateFilter)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>stateFilterChanged(Payment::State stateFilter)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::Payment::State stateFilter READ stateFilter WRITE setStateFilter NOTIFY stateFilterChanged)
+    /*!
+     * \brief Only accept payments with this intent. Payment::NoIntent disables the filter.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Payment::Intent</TD><TD>intentFilter() const</TD></TR><TR><TD>void</TD><TD>setIntentFilter(Payment::Intent nIntentFilter)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>intentFilterChanged(Payment::Intent intentFilter)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::Payment::Intent intentFilter READ intentFilter WRITE setIntentFilter NOTIFY intentFilterChanged)
+    /*!
+     * \brief Only accept payments of the payer with this email address, compared case insensitive.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>payerEmailFilter() const</TD></TR><TR><TD>void</TD><TD>setPayerEmailFilter(const QString &nPayerEmailFilter)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>payerEmailFilterChanged(const QString &payerEmailFilter)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString payerEmailFilter READ payerEmailFilter WRITE setPayerEmailFilter NOTIFY payerEmailFilterChanged)
+    /*!
+     * \brief Only accept the payment that has a related resource like a sale with this ID.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>resourceIdFilter() const</TD></TR><TR><TD>void</TD><TD>setResourceIdFilter(const QString &nResourceIdFilter)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>resourceIdFilterChanged(const QString &resourceIdFilter)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString resourceIdFilter READ resourceIdFilter WRITE setResourceIdFilter NOTIFY resourceIdFilterChanged)
+public:
+    /*!
+     * \brief Constructs a new PaymentFilterModel.
+     */
+    explicit PaymentFilterModel(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the PaymentFilterModel.
+     */
+    ~PaymentFilterModel();
+
+    /*!
+     * \brief Reimplemented from QSortFilterProxyModel.
+     *
+     * If the \a sourceModel is a PaymentList, it will also be set as \link PaymentFilterModel::paymentList paymentList \endlink.
+     */
+    void setSourceModel(QAbstractItemModel *sourceModel) Q_DECL_OVERRIDE;
+
+    /*!
+     * \brief Returns the Payment at the \a row of the filtered model or a \c nullptr if \a row is out of range.
+     */
+    Q_INVOKABLE Geltan::PP::Payment *at(int row) const;
+
+    PaymentList *paymentList() const;
+    Payment::State stateFilter() const;
+    Payment::Intent intentFilter() const;
+    QString payerEmailFilter() const;
+    QString resourceIdFilter() const;
+
+    void setPaymentList(PaymentList *nPaymentList);
+    void setStateFilter(Payment::State nStateFilter);
+    void setIntentFilter(Payment::Intent nIntentFilter);
+    void setPayerEmailFilter(const QString &nPayerEmailFilter);
+    void setResourceIdFilter(const QString &nResourceIdFilter);
+
+Q_SIGNALS:
+    void paymentListChanged(PaymentList *paymentList);
+    void stateFilterChanged(Payment::State stateFilter);
+    void intentFilterChanged(Payment::Intent intentFilter);
+    void payerEmailFilterChanged(const QString &payerEmailFilter);
+    void resourceIdFilterChanged(const QString &resourceIdFilter);
+
+protected:
+    /*!
+     * \brief Reimplemented from QSortFilterProxyModel.
+     */
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const Q_DECL_OVERRIDE;
+    /*!
+     * \brief Reimplemented from QSortFilterProxyModel.
+     */
+    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const Q_DECL_OVERRIDE;
+
+    const QScopedPointer<PaymentFilterModelPrivate> d_ptr;
+
+private:
+    Q_DISABLE_COPY(PaymentFilterModel)
+    Q_DECLARE_PRIVATE(PaymentFilterModel)
+
+};
+
+}
+}
+
+#endif // PAYMENTFILTERMODEL_H
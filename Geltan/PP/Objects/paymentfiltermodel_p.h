@@ -0,0 +1,56 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Objects/paymentfiltermodel_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTFILTERMODEL_P_H
+#define PAYMENTFILTERMODEL_P_H
+
+#include "paymentfiltermodel.h"
+#include "paymentlist.h"
+#include <QPointer>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentFilterModelPrivate
+{
+public:
+    PaymentFilterModelPrivate(PaymentFilterModel *parent) :
+        q_ptr(parent),
+        stateFilter(Payment::NoState),
+        intentFilter(Payment::NoIntent)
+    {}
+
+    ~PaymentFilterModelPrivate() {}
+
+    PaymentFilterModel * const q_ptr;
+    Q_DECLARE_PUBLIC(PaymentFilterModel)
+    QPointer<PaymentList> paymentList;
+    Payment::State stateFilter;
+    Payment::Intent intentFilter;
+    QString payerEmailFilter;
+    QString payerEmailKey;
+    QString resourceIdFilter;
+};
+
+}
+}
+
+#endif // PAYMENTFILTERMODEL_P_H
@@ -21,9 +21,19 @@
 
 #include "paymentlist_p.h"
 #include "payer.h"
+#include "payerinfo.h"
+#include "transaction.h"
+#include "related.h"
+#include "sale.h"
+#include "authorization.h"
+#include "order.h"
+#include "capture.h"
+#include "refund.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <Geltan/PP/Values/paymentvalue.h>
+#include <Geltan/PP/Values/paymentsnapshot.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -51,9 +61,19 @@ PaymentList::PaymentList(const QJsonObject &json, QObject *parent) : QAbstractLi
 
 
 
-PaymentList::~PaymentList()
+PaymentList::PaymentList(const PPJsonValue &json, QObject *parent) : QAbstractListModel(parent), d_ptr(new PaymentListPrivate(this))
 {
+    loadFromJson(json);
+}
+
 
+
+PaymentList::~PaymentList()
+{
+    Q_D(PaymentList);
+    if (d->listOperation && d->listOperation->paymentList() == this) {
+        d->listOperation->setPaymentList(nullptr);
+    }
 }
 
 
@@ -103,6 +123,8 @@ QVariant PaymentList::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
+    d->prefetch(index.row());
+
     Payment *p = d->payments.at(index.row());
 
     switch (role) {
@@ -129,6 +151,115 @@ QVariant PaymentList::data(const QModelIndex &index, int role) const
 
 
 
+Payment *PaymentList::at(int row) const
+{
+    Q_D(const PaymentList);
+    return ((row >= 0) && (row < d->payments.count())) ? d->payments.at(row) : nullptr;
+}
+
+
+int PaymentList::rowOf(Payment *payment) const
+{
+    Q_D(const PaymentList);
+    return d->rows.value(payment, -1);
+}
+
+
+Payment *PaymentList::findById(const QString &id) const
+{
+    Q_D(const PaymentList);
+    return d->idIndex.value(id);
+}
+
+
+Payment *PaymentList::findByResourceId(const QString &resourceId) const
+{
+    Q_D(const PaymentList);
+    return d->resourceIdIndex.value(resourceId);
+}
+
+
+QList<Payment*> PaymentList::findByState(Payment::State state) const
+{
+    Q_D(const PaymentList);
+    return d->sortedValues(d->stateIndex, static_cast<int>(state));
+}
+
+
+QList<Payment*> PaymentList::findByIntent(Payment::Intent intent) const
+{
+    Q_D(const PaymentList);
+    return d->sortedValues(d->intentIndex, static_cast<int>(intent));
+}
+
+
+QList<Payment*> PaymentList::findByPayerEmail(const QString &email) const
+{
+    Q_D(const PaymentList);
+    return d->sortedValues(d->payerEmailIndex, email.toLower());
+}
+
+
+
+
+
+bool PaymentList::canFetchMore(const QModelIndex &parent) const
+{
+    Q_D(const PaymentList);
+
+    if (parent.isValid() || !d->listOperation || d->listOperation->inOperation()) {
+        return false;
+    }
+
+    return !d->fetchFailed && (!d->loaded || !d->nextId.isEmpty());
+}
+
+
+void PaymentList::fetchMore(const QModelIndex &parent)
+{
+    Q_D(PaymentList);
+
+    d->prefetchQueued = false;
+
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    Payments::List *op = d->listOperation.data();
+
+    if (d->pageSize > 0) {
+        op->setCount(d->pageSize);
+    }
+
+    op->setAppend(d->loaded);
+
+    // the first range uses the settings of the operation, the following ones only the cursor
+    op->requestPage(d->loaded ? d->nextId : QString());
+}
+
+
+
+Error *PaymentList::fetchError() const
+{
+    Q_D(const PaymentList);
+    return (d->fetchFailed && d->listOperation) ? d->listOperation->error() : nullptr;
+}
+
+
+
+void PaymentList::reset()
+{
+    Q_D(PaymentList);
+
+    d->clear();
+    d->loaded = false;
+    d->setFetchFailed(false);
+}
+
+
+
+
+
 QList<Payment*> PaymentList::payments() const { Q_D(const PaymentList); return d->payments; }
 
 void PaymentList::setPayments(const QList<Payment*> &nPayments)
@@ -136,6 +267,7 @@ void PaymentList::setPayments(const QList<Payment*> &nPayments)
     Q_D(PaymentList);
     if (nPayments != d->payments) {
         d->payments = nPayments;
+        d->rebuildIndex();
 #ifdef QT_DEBUG
         qDebug() << "Changed payments to" << d->payments;
 #endif
@@ -183,6 +315,71 @@ void PaymentList::setNextId(const QString &nNextId)
 
 
 
+Payments::List *PaymentList::listOperation() const { Q_D(const PaymentList); return d->listOperation.data(); }
+
+void PaymentList::setListOperation(Payments::List *nListOperation)
+{
+    Q_D(PaymentList);
+    if (nListOperation != d->listOperation) {
+        if (d->listOperation && d->listOperation->paymentList() == this) {
+            d->listOperation->setPaymentList(nullptr);
+        }
+        disconnect(d->failedConnection);
+        d->setFetchFailed(false);
+        d->listOperation = nListOperation;
+        if (d->listOperation) {
+            d->listOperation->setPaymentList(this);
+            d->failedConnection = connect(d->listOperation.data(), &Payments::List::failed, this, [d] () { d->setFetchFailed(true); });
+        }
+#ifdef QT_DEBUG
+        qDebug() << "Changed listOperation to" << d->listOperation;
+#endif
+        Q_EMIT listOperationChanged(listOperation());
+    }
+}
+
+
+
+
+int PaymentList::pageSize() const { Q_D(const PaymentList); return d->pageSize; }
+
+void PaymentList::setPageSize(int nPageSize)
+{
+    Q_D(PaymentList);
+    if (nPageSize != d->pageSize) {
+        d->pageSize = nPageSize;
+#ifdef QT_DEBUG
+        qDebug() << "Changed pageSize to" << d->pageSize;
+#endif
+        Q_EMIT pageSizeChanged(pageSize());
+    }
+}
+
+
+
+
+int PaymentList::prefetchDistance() const { Q_D(const PaymentList); return d->prefetchDistance; }
+
+bool PaymentList::fetchFailed() const { Q_D(const PaymentList); return d->fetchFailed; }
+
+void PaymentList::setPrefetchDistance(int nPrefetchDistance)
+{
+    Q_D(PaymentList);
+    if (nPrefetchDistance != d->prefetchDistance) {
+        d->prefetchDistance = nPrefetchDistance;
+#ifdef QT_DEBUG
+        qDebug() << "Changed prefetchDistance to" << d->prefetchDistance;
+#endif
+        Q_EMIT prefetchDistanceChanged(prefetchDistance());
+    }
+}
+
+
+
+
+
+
+
 void PaymentList::loadFromJson(const QJsonDocument &json, bool append)
 {
     loadFromJson(json.object(), append);
@@ -192,28 +389,98 @@ void PaymentList::loadFromJson(const QJsonDocument &json, bool append)
 
 void PaymentList::loadFromJson(const QJsonObject &json, bool append)
 {
-    Q_D(PaymentList);
+    loadFromJson(PPJsonValue(json), append);
+}
+
 
-    if (!append) {
-        d->clear();
-    }
+
+void PaymentList::loadFromJson(const PPJsonValue &json, bool append)
+{
+    Q_D(PaymentList);
 
     if (json.isEmpty()) {
+        if (!append) {
+            d->clear();
+        }
         setCount(0);
         setNextId(QString());
+        d->loaded = true;
+        d->setFetchFailed(false);
         return;
     }
 
-    const QJsonArray ps = json.value(QStringLiteral("payments")).toArray();
+    const PPJsonValue ps = json.value(QLatin1String("payments")).toArray();
+
+    if (!append) {
+
+        // Reuse the existing Payment objects for the new page instead of deleting all of them
+        // and allocating a complete new object tree. Only missing rows are created and surplus
+        // rows are released together in a single step.
+
+        const int oldCount = d->payments.count();
+        const int newCount = ps.count();
+        const int reused = qMin(oldCount, newCount);
+
+        PPJsonValue::const_iterator it = ps.constBegin();
+        for (int i = 0; i < reused; ++i, ++it) {
+            Payment *p = d->payments.at(i);
+            d->removeFromIndex(p);
+            const PPJsonValue o = it->toObject();
+            if (o.isEmpty()) {
+                // loadFromJson() ignores empty objects, so the row would keep the data of the old payment
+                Payment *e = new Payment(this);
+                d->payments[i] = e;
+                delete p;
+                p = e;
+            } else {
+                p->loadFromJson(o);
+                // loadFromJson() keeps these members if they are missing, a reused row must not
+                // show the values of the payment it contained before
+                if (!o.value(QLatin1String("id")).isString()) {
+                    p->setId(QString());
+                }
+                if (!o.value(QLatin1String("experience_profile_id")).isString()) {
+                    p->setExperienceProfileId(QString());
+                }
+                if (!o.value(QLatin1String("note_to_payer")).isString()) {
+                    p->setNoteToPayer(QString());
+                }
+            }
+            d->addToIndex(p, i);
+        }
+
+        if (reused > 0) {
+            Q_EMIT dataChanged(index(0), index(reused - 1));
+        }
+
+        if (newCount > oldCount) {
+
+            d->payments.reserve(newCount);
+
+            beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+
+            for (int i = oldCount; i < newCount; ++i, ++it) {
+                Payment *p = new Payment(it->toObject(), this);
+                d->payments.append(p);
+                d->addToIndex(p, i);
+            }
+
+            endInsertRows();
 
-    if (!ps.isEmpty()) {
+        } else if (newCount < oldCount) {
+            d->removeSurplus(newCount);
+        }
+
+    } else if (!ps.isEmpty()) {
 
-        d->payments.reserve(ps.size());
+        d->payments.reserve(d->payments.count() + ps.count());
 
-        beginInsertRows(QModelIndex(), rowCount(), ps.count() - 1);
+        beginInsertRows(QModelIndex(), rowCount(), rowCount() + ps.count() - 1);
 
-        for (const QJsonValue &p : ps) {
-            d->payments.append(new Payment(p.toObject(), this));
+        for (const PPJsonValue &v : ps) {
+            Payment *p = new Payment(v.toObject(), this);
+            d->addToIndex(p, d->payments.count());
+            d->payments.append(p);
         }
 
         endInsertRows();
@@ -221,7 +488,200 @@ void PaymentList::loadFromJson(const QJsonObject &json, bool append)
 
     Q_EMIT paymentsChanged(payments());
 
-    setCount(json.value(QStringLiteral("count")).toInt());
+    setCount(json.value(QLatin1String("count")).toInt());
+
+    setNextId(json.value(QLatin1String("next_id")).toString());
+
+    d->loaded = true;
+    d->setFetchFailed(false);
+}
+
+
+
+QByteArray PaymentList::toSnapshot() const
+{
+    Q_D(const PaymentList);
+
+    QList<PaymentValue> values;
+    values.reserve(d->payments.count());
+    for (const Payment *p : d->payments) {
+        values.append(p->toValue());
+    }
+
+    return PaymentSnapshot::write(values, nextId());
+}
+
+
+
+bool PaymentList::loadFromSnapshot(const QByteArray &snapshot, bool append)
+{
+    bool ok = false;
+    QString nid;
+    const QList<PaymentValue> values = PaymentSnapshot::read(snapshot, &nid, &ok);
+    if (!ok) {
+        return false;
+    }
+
+    // the snapshot is converted into the structure of a list reply, so the model update is the same as for loaded pages
+    QJsonArray ps;
+    for (const PaymentValue &v : values) {
+        ps.append(v.toJsonObject());
+    }
+
+    QJsonObject json;
+    json.insert(QStringLiteral("payments"), ps);
+    json.insert(QStringLiteral("count"), ps.count());
+    json.insert(QStringLiteral("next_id"), nid);
+
+    loadFromJson(json, append);
+
+    return true;
+}
+
+
+
+
 
-    setNextId(json.value(QStringLiteral("next_id")).toString());
+PaymentIndexKeys PaymentListPrivate::indexKeys(const Payment *payment)
+{
+    PaymentIndexKeys k;
+    k.id = payment->id();
+    k.state = static_cast<int>(payment->state());
+    k.intent = static_cast<int>(payment->intent());
+
+    if (payment->payer() && payment->payer()->payerInfo()) {
+        k.payerEmail = payment->payer()->payerInfo()->email().toLower();
+    }
+
+    const QList<Transaction*> ts = payment->transactions();
+    for (const Transaction *t : ts) {
+        const QList<Related*> rs = t->relatedResources();
+        for (const Related *r : rs) {
+            if (r->sale() && !r->sale()->id().isEmpty()) {
+                k.resourceIds.append(r->sale()->id());
+            }
+            if (r->authorization() && !r->authorization()->id().isEmpty()) {
+                k.resourceIds.append(r->authorization()->id());
+            }
+            if (r->order() && !r->order()->id().isEmpty()) {
+                k.resourceIds.append(r->order()->id());
+            }
+            if (r->capture() && !r->capture()->id().isEmpty()) {
+                k.resourceIds.append(r->capture()->id());
+            }
+            if (r->refund() && !r->refund()->id().isEmpty()) {
+                k.resourceIds.append(r->refund()->id());
+            }
+        }
+    }
+
+    return k;
+}
+
+
+
+void PaymentListPrivate::addToIndex(Payment *payment, int row)
+{
+    Q_Q(PaymentList);
+
+    const PaymentIndexKeys k = indexKeys(payment);
+
+    if (!k.id.isEmpty()) {
+        idIndex.insert(k.id, payment);
+    }
+    stateIndex.insert(k.state, payment);
+    intentIndex.insert(k.intent, payment);
+    if (!k.payerEmail.isEmpty()) {
+        payerEmailIndex.insert(k.payerEmail, payment);
+    }
+    for (const QString &rid : k.resourceIds) {
+        resourceIdIndex.insert(rid, payment);
+    }
+
+    indexedKeys.insert(payment, k);
+    rows.insert(payment, row);
+
+    auto update = [this, payment]() { updateIndex(payment); };
+    QObject::connect(payment, &Payment::idChanged, q, update);
+    QObject::connect(payment, &Payment::stateChanged, q, update);
+    QObject::connect(payment, &Payment::intentChanged, q, update);
+    QObject::connect(payment, &Payment::payerChanged, q, update);
+    QObject::connect(payment, &Payment::transactionsChanged, q, update);
+    QObject::connect(payment, &Payment::loaded, q, update);
+}
+
+
+
+void PaymentListPrivate::removeFromIndex(Payment *payment)
+{
+    Q_Q(PaymentList);
+
+    const auto it = indexedKeys.constFind(payment);
+    if (it == indexedKeys.cend()) {
+        return;
+    }
+
+    const PaymentIndexKeys &k = it.value();
+
+    if (idIndex.value(k.id) == payment) {
+        idIndex.remove(k.id);
+    }
+    stateIndex.remove(k.state, payment);
+    intentIndex.remove(k.intent, payment);
+    payerEmailIndex.remove(k.payerEmail, payment);
+    for (const QString &rid : k.resourceIds) {
+        if (resourceIdIndex.value(rid) == payment) {
+            resourceIdIndex.remove(rid);
+        }
+    }
+
+    indexedKeys.erase(it);
+    rows.remove(payment);
+
+    QObject::disconnect(payment, nullptr, q, nullptr);
+}
+
+
+
+void PaymentListPrivate::updateIndex(Payment *payment)
+{
+    const int row = rows.value(payment, -1);
+    if (row < 0) {
+        return;
+    }
+
+    removeFromIndex(payment);
+    addToIndex(payment, row);
+}
+
+
+
+void PaymentListPrivate::clearIndex()
+{
+    Q_Q(PaymentList);
+
+    for (Payment *p : payments) {
+        QObject::disconnect(p, nullptr, q, nullptr);
+    }
+
+    idIndex.clear();
+    stateIndex.clear();
+    intentIndex.clear();
+    payerEmailIndex.clear();
+    resourceIdIndex.clear();
+    indexedKeys.clear();
+    rows.clear();
+}
+
+
+
+void PaymentListPrivate::rebuildIndex()
+{
+    // payments that are not part of the new list anymore might already be deleted, so only
+    // the current ones are disconnected, stale connections are ignored by updateIndex()
+    clearIndex();
+
+    for (int i = 0; i < payments.count(); ++i) {
+        addToIndex(payments.at(i), i);
+    }
 }
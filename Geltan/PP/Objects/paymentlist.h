@@ -30,13 +30,40 @@ class QJsonDocument;
 class QJsonObject;
 
 namespace Geltan {
+
+class Error;
+
 namespace PP {
 
 class PaymentListPrivate;
 
+namespace Payments {
+class List;
+}
+
 /*!
  * \brief Model containing a list of Payment objects.
  *
+ * If a Payments::List operation is attached via the \link PaymentList::listOperation listOperation \endlink
+ * property, the model implements canFetchMore() and fetchMore() and requests further pages from the API
+ * on its own when a view scrolls near the end of the currently loaded payments. Only the pages that
+ * are really needed will be requested and parsed.
+ *
+ * \code{.cpp}
+ * Geltan::PP::Payments::List *op = new Geltan::PP::Payments::List(this);
+ * op->setToken(token);
+ * Geltan::PP::PaymentList *model = new Geltan::PP::PaymentList(this);
+ * model->setPageSize(25);
+ * model->setListOperation(op);
+ * view->setModel(model);
+ * \endcode
+ *
+ * The list maintains hash indexes over the payment ID, the state, the intent, the payer email and the
+ * IDs of the related resources like sales or refunds. The indexes are updated incrementally when rows
+ * are inserted, reloaded or removed and when the ID, state, intent, payer or transactions of a payment
+ * change or a payment loads new data, so the find methods like findById() do not have to scan the list.
+ * Use PaymentFilterModel to get filtered and sorted views based on these indexes.
+ *
  * \headerfile "" <Geltan/PP/Objects/paymentlist.h>
  */
 class GELTANSHARED_EXPORT PaymentList : public QAbstractListModel
@@ -71,6 +98,60 @@ class GELTANSHARED_EXPORT PaymentList : public QAbstractListModel
      * <TABLE><TR><TD>void</TD><TD>nextIdChanged(const QString &nextId)</TD></TR></TABLE>
      */
     Q_PROPERTY(QString nextId READ nextId NOTIFY nextIdChanged)
+    /*!
+     * \brief The list operation used to fetch further pages.
+     *
+     * If set, the model attaches itself to the operation and uses it in fetchMore() to request
+     * the next range of results starting at the \link PaymentList::nextId nextId \endlink. The
+     * operation's filter and sort settings are used for every request. Its startId and startIndex
+     * are only used for the first range, the following ranges are addressed by the nextId without
+     * changing them. The append property will be managed by the model. The model does not take
+     * ownership of the operation.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Payments::List*</TD><TD>listOperation() const</TD></TR><TR><TD>void</TD><TD>setListOperation(Payments::List *nListOperation)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>listOperationChanged(Payments::List *listOperation)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::Payments::List *listOperation READ listOperation WRITE setListOperation NOTIFY listOperationChanged)
+    /*!
+     * \brief Number of payments to request per page when fetching more data.
+     *
+     * If set to \a 0, the count of the \link PaymentList::listOperation listOperation \endlink will
+     * be used. The default is \a 0.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>pageSize() const</TD></TR><TR><TD>void</TD><TD>setPageSize(int nPageSize)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>pageSizeChanged(int pageSize)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+    /*!
+     * \brief Number of rows before the end of the model at which the next page will be prefetched.
+     *
+     * When the data of one of the last \a prefetchDistance rows is requested, the next page will be
+     * requested asynchronously, before the view reaches the end of the model. Set it to \a 0 to only
+     * fetch more data when the view calls fetchMore(). The default is \a 5.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>prefetchDistance() const</TD></TR><TR><TD>void</TD><TD>setPrefetchDistance(int nPrefetchDistance)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>prefetchDistanceChanged(int prefetchDistance)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int prefetchDistance READ prefetchDistance WRITE setPrefetchDistance NOTIFY prefetchDistanceChanged)
+    /*!
+     * \brief Returns true if the last request for a page of payments failed.
+     *
+     * While this is true, canFetchMore() returns false, so views do not request the failing page again
+     * and again. The error is available from fetchError(). A successful call of the
+     * \link PaymentList::listOperation listOperation \endlink, loading new data or reset() clears it.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>fetchFailed() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>fetchFailedChanged(bool fetchFailed)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool fetchFailed READ fetchFailed NOTIFY fetchFailedChanged)
 public:
     /*!
      * \brief Constructs a new PaymentList model.
@@ -87,6 +168,11 @@ public:
      */
     PaymentList(const QJsonObject &json, QObject * parent = nullptr);
 
+    /*!
+     * \brief Constructs a new PaymentList model from a value of a PPJsonDocument.
+     */
+    PaymentList(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the PaymentList model.
      */
@@ -123,16 +209,90 @@ public:
      * \brief Reimplemented from QAbstractItemModel.
      */
     QVariant data(const QModelIndex &index, int role) const Q_DECL_OVERRIDE;
+    /*!
+     * \brief Reimplemented from QAbstractItemModel.
+     *
+     * Returns true if a \link PaymentList::listOperation listOperation \endlink is set, it is not
+     * currently in operation and either no page has been loaded yet or the last page returned
+     * a \link PaymentList::nextId nextId \endlink. After a failed request it returns false until
+     * \link PaymentList::fetchFailed fetchFailed \endlink has been cleared.
+     */
+    bool canFetchMore(const QModelIndex &parent) const Q_DECL_OVERRIDE;
+    /*!
+     * \brief Reimplemented from QAbstractItemModel.
+     *
+     * Requests the next page of payments via the \link PaymentList::listOperation listOperation \endlink.
+     * The returned payments will be appended to the model.
+     */
+    void fetchMore(const QModelIndex &parent) Q_DECL_OVERRIDE;
+
+    /*!
+     * \brief Returns the error of the failed page request or a \c nullptr if fetchFailed() is false.
+     */
+    Q_INVOKABLE Geltan::Error *fetchError() const;
+
+    /*!
+     * \brief Removes all payments and clears the fetch error, the next fetchMore() requests the first page again.
+     */
+    Q_INVOKABLE void reset();
+
+    /*!
+     * \brief Returns the Payment at \a row or a \c nullptr if \a row is out of range.
+     *
+     * Other than payments() this does not copy the list.
+     */
+    Q_INVOKABLE Geltan::PP::Payment *at(int row) const;
+
+    /*!
+     * \brief Returns the row of the \a payment or \a -1 if it is not part of the list.
+     */
+    Q_INVOKABLE int rowOf(Geltan::PP::Payment *payment) const;
+
+    /*!
+     * \brief Returns the Payment with the \a id or a \c nullptr if there is no such payment in the list.
+     */
+    Q_INVOKABLE Geltan::PP::Payment *findById(const QString &id) const;
+
+    /*!
+     * \brief Returns the Payment a related resource like a sale, authorization, order, capture or refund belongs to.
+     *
+     * Returns a \c nullptr if no payment in the list has a related resource with \a resourceId.
+     */
+    Q_INVOKABLE Geltan::PP::Payment *findByResourceId(const QString &resourceId) const;
+
+    /*!
+     * \brief Returns all payments with the \a state in the order of the list.
+     */
+    QList<Payment*> findByState(Payment::State state) const;
+
+    /*!
+     * \brief Returns all payments with the \a intent in the order of the list.
+     */
+    QList<Payment*> findByIntent(Payment::Intent intent) const;
+
+    /*!
+     * \brief Returns all payments of the payer with the \a email in the order of the list.
+     *
+     * The email address is compared case insensitive.
+     */
+    QList<Payment*> findByPayerEmail(const QString &email) const;
 
 
 
     QList<Payment*> payments() const;
     int count() const;
     QString nextId() const;
+    Payments::List *listOperation() const;
+    int pageSize() const;
+    int prefetchDistance() const;
+    bool fetchFailed() const;
 
     void setPayments(const QList<Payment*> &nPayments);
     void setCount(int nCount);
     void setNextId(const QString &nNextId);
+    void setListOperation(Payments::List *nListOperation);
+    void setPageSize(int nPageSize);
+    void setPrefetchDistance(int nPrefetchDistance);
 
     /*!
      * \brief Loads data from a QJsonDocument into the Transaction object.
@@ -147,13 +307,47 @@ public:
      *
      * If \c append is set to true, the loaded Payment items will be appended
      * to the model list, otherwise the current content will be replaced.
+     *
+     * When replacing the content, the already existing Payment objects will be reused for
+     * the new data, so pointers to them stay valid as long as the new page has at least
+     * as many payments as the old one.
      */
     void loadFromJson(const QJsonObject &json, bool append = false);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the PaymentList model.
+     * \overload
+     *
+     * Values from an on-demand index are read directly from the reply data, the payments are
+     * loaded without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json, bool append = false);
+
+    /*!
+     * \brief Returns a binary snapshot of all payments in the list and the \link PaymentList::nextId nextId \endlink.
+     *
+     * Other than the JSON data, the snapshot contains the complete payment data including the read only members.
+     *
+     * \sa PaymentSnapshot
+     */
+    QByteArray toSnapshot() const;
+
+    /*!
+     * \brief Loads the payments from the binary \a snapshot created by toSnapshot().
+     *
+     * Works like loadFromJson() regarding \a append and the reuse of existing Payment objects.
+     * Returns false and leaves the list unchanged if \a snapshot is not valid.
+     */
+    bool loadFromSnapshot(const QByteArray &snapshot, bool append = false);
+
 Q_SIGNALS:
     void paymentsChanged(const QList<Payment*> &payments);
     void countChanged(int count);
     void nextIdChanged(const QString &nextId);
+    void listOperationChanged(Payments::List *listOperation);
+    void pageSizeChanged(int pageSize);
+    void prefetchDistanceChanged(int prefetchDistance);
+    void fetchFailedChanged(bool fetchFailed);
 
 
 protected:
@@ -162,6 +356,7 @@ protected:
 private:
     Q_DISABLE_COPY(PaymentList)
     Q_DECLARE_PRIVATE(PaymentList)
+    friend class PaymentFilterModel;
 
 };
 
@@ -24,16 +24,42 @@
 
 #include "paymentlist.h"
 #include "payment.h"
+#include "../Payments/list.h"
+#include <QPointer>
+#include <QHash>
+#include <QMultiHash>
+#include <QStringList>
+#include <algorithm>
 
 namespace Geltan {
 namespace PP {
 
+/*!
+ * \internal
+ * \brief The values a Payment has been indexed with.
+ *
+ * They are kept to remove the Payment from the indexes after its data has been changed.
+ */
+struct PaymentIndexKeys
+{
+    QString id;
+    int state;
+    int intent;
+    QString payerEmail;
+    QStringList resourceIds;
+};
+
 class PaymentListPrivate
 {
 public:
     PaymentListPrivate(PaymentList *parent) :
         q_ptr(parent),
-        count(0)
+        count(0),
+        pageSize(0),
+        prefetchDistance(5),
+        loaded(false),
+        fetchFailed(false),
+        prefetchQueued(false)
     {}
 
     ~PaymentListPrivate() {}
@@ -46,6 +72,7 @@ public:
 
             q->beginRemoveRows(QModelIndex(), 0, payments.count() - 1);
 
+            clearIndex();
             qDeleteAll(payments);
             payments.clear();
 
@@ -58,11 +85,133 @@ public:
         Q_EMIT q->nextIdChanged(nextId);
     }
 
+    /*!
+     * \internal
+     * \brief Removes and deletes all payments starting at row \a from.
+     */
+    void removeSurplus(int from)
+    {
+        Q_Q(PaymentList);
+
+        if (from < payments.count()) {
+
+            q->beginRemoveRows(QModelIndex(), from, payments.count() - 1);
+
+            const QList<Payment*> surplus = payments.mid(from);
+            payments.erase(payments.begin() + from, payments.end());
+            for (Payment *p : surplus) {
+                removeFromIndex(p);
+            }
+            qDeleteAll(surplus);
+
+            q->endRemoveRows();
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Sets the fetch error state and emits fetchFailedChanged() if it changed.
+     */
+    void setFetchFailed(bool failed)
+    {
+        if (failed != fetchFailed) {
+            fetchFailed = failed;
+            Q_Q(PaymentList);
+            Q_EMIT q->fetchFailedChanged(fetchFailed);
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Queues a call to fetchMore() if the data of \a row is inside the prefetch distance.
+     *
+     * This is called from the const data() method, so the request is queued to not change the
+     * model while the view is reading it.
+     */
+    void prefetch(int row) const
+    {
+        if (prefetchQueued || prefetchDistance <= 0 || row < (payments.count() - prefetchDistance)) {
+            return;
+        }
+
+        if (q_ptr->canFetchMore(QModelIndex())) {
+            prefetchQueued = true;
+            QMetaObject::invokeMethod(q_ptr, "fetchMore", Qt::QueuedConnection, Q_ARG(QModelIndex, QModelIndex()));
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Reads the values the \a payment will be indexed with.
+     */
+    static PaymentIndexKeys indexKeys(const Payment *payment);
+
+    /*!
+     * \internal
+     * \brief Adds the \a payment at \a row to all indexes.
+     *
+     * The list connects to the change signals of the payment to update the indexes when
+     * the payment is changed from outside of the model.
+     */
+    void addToIndex(Payment *payment, int row);
+
+    /*!
+     * \internal
+     * \brief Removes the \a payment from all indexes.
+     */
+    void removeFromIndex(Payment *payment);
+
+    /*!
+     * \internal
+     * \brief Updates the index entries of a payment that has been changed.
+     */
+    void updateIndex(Payment *payment);
+
+    /*!
+     * \internal
+     * \brief Clears all indexes.
+     */
+    void clearIndex();
+
+    /*!
+     * \internal
+     * \brief Rebuilds all indexes from the current list of payments.
+     */
+    void rebuildIndex();
+
+    /*!
+     * \internal
+     * \brief Returns the payments of a multi value index sorted by their rows.
+     */
+    template<typename Key>
+    QList<Payment*> sortedValues(const QMultiHash<Key, Payment*> &index, const Key &key) const
+    {
+        QList<Payment*> lst = index.values(key);
+        std::sort(lst.begin(), lst.end(), [this](Payment *a, Payment *b) {
+            return rows.value(a) < rows.value(b);
+        });
+        return lst;
+    }
+
     PaymentList * const q_ptr;
     Q_DECLARE_PUBLIC(PaymentList)
     QList<Payment*> payments;
     int count;
     QString nextId;
+    QPointer<Payments::List> listOperation;
+    int pageSize;
+    int prefetchDistance;
+    bool loaded;
+    bool fetchFailed;
+    mutable bool prefetchQueued;
+    QMetaObject::Connection failedConnection;
+    QHash<QString, Payment*> idIndex;
+    QMultiHash<int, Payment*> stateIndex;
+    QMultiHash<int, Payment*> intentIndex;
+    QMultiHash<QString, Payment*> payerEmailIndex;
+    QHash<QString, Payment*> resourceIdIndex;
+    QHash<const Payment*, PaymentIndexKeys> indexedKeys;
+    QHash<const Payment*, int> rows;
 };
 
 
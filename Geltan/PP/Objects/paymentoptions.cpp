@@ -20,6 +20,7 @@
  */
 
 #include "paymentoptions_p.h"
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #ifdef QT_DEBUG
 #include <QtDebug>
@@ -49,6 +50,13 @@ PaymentOptions::PaymentOptions(const QJsonObject &json, QObject *parent) :
 }
 
 
+PaymentOptions::PaymentOptions(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new PaymentOptionsPrivate)
+{
+    loadFromJson(json);
+}
+
+
 
 PaymentOptions::~PaymentOptions()
 {
@@ -101,6 +109,29 @@ QVariantMap PaymentOptions::toVariant()
 
 
 
+void PaymentOptions::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    writer->beginObject(name);
+
+    switch(allowedPaymentMethod()) {
+    case Unrestricted:
+        writer->writeString(QLatin1String("allowed_payment_method"), QStringLiteral("UNRESTRICTED"));
+        break;
+    case InstantFundingSource:
+        writer->writeString(QLatin1String("allowed_payment_method"), QStringLiteral("INSTANT_FUNDING_SOURCE"));
+        break;
+    case ImmediatePay:
+        writer->writeString(QLatin1String("allowed_payment_method"), QStringLiteral("IMMEDIATE_PAY"));
+        break;
+    default:
+        break;
+    }
+
+    writer->endObject();
+}
+
+
+
 
 QJsonObject PaymentOptions::toJsonObject()
 {
@@ -115,14 +146,22 @@ void PaymentOptions::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void PaymentOptions::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+void PaymentOptions::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    const QString apm = json.value(QStringLiteral("allowed_payment_method")).toString();
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    const QString apm = json.value(QLatin1String("allowed_payment_method")).toString();
     if (apm == QLatin1String("UNRESTRICTED")) {
         setAllowedPaymentMethod(Unrestricted);
     } else if (apm == QLatin1String("INSTANT_FUNDING_SOURCE")) {
@@ -26,11 +26,13 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class PaymentOptionsPrivate;
+class PPJsonWriter;
 
 /*!
  * \brief Contains information about allowed payment options.
@@ -69,6 +71,11 @@ public:
      */
     PaymentOptions(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new PaymentOptions object from a value of a PPJsonDocument.
+     */
+    PaymentOptions(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the PaymentOptions object.
      */
@@ -100,6 +107,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -117,6 +132,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the PaymentOptions object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void allowedPaymentMethodChanged(AllowedPaymentMethodType allowedPaymentMethod);
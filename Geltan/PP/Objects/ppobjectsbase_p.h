@@ -26,6 +26,8 @@
 #include <QVariantMap>
 #include <QVariantList>
 #include <QRegularExpression>
+#include <Geltan/PP/Values/money.h>
+#include <Geltan/PP/ppjsonwriter.h>
 
 namespace Geltan {
 namespace PP {
@@ -56,18 +58,14 @@ public:
         map->insert(key, checkString(value, maxLength));
     }
 
-    void addFloatToVariantMap(QVariantMap *map, const QString &key, float value, int maxLength = 10, int maxDecPlaces = 2) {
-        if (!map || key.isEmpty() || value == 0.0f) {
+    void addMoneyToVariantMap(QVariantMap *map, const QString &key, const Money &value, const QString &currency, int maxLength = 10) {
+        if (!map || key.isEmpty() || value.isZero()) {
             return;
         }
 
-        if (maxDecPlaces > -1) {
-            QString n = QString::number(value, 'f', maxDecPlaces);
-            if (n.size() <= maxLength) {
-                map->insert(key, n.toDouble());
-            }
-        } else {
-            map->insert(key, value);
+        const QString n = value.toString(Money::currencyDecimals(currency));
+        if (n.size() <= maxLength) {
+            map->insert(key, n);
         }
     }
 
@@ -126,6 +124,39 @@ public:
     }
 
 
+    void writeString(PPJsonWriter *writer, QLatin1String name, const QString &value, int maxLength = 0) {
+        if (!writer || value.isEmpty()) {
+            return;
+        }
+
+        writer->writeString(name, (maxLength > 0) ? value.left(maxLength) : value);
+    }
+
+
+    void writeMoney(PPJsonWriter *writer, QLatin1String name, const Money &value, const QString &currency, int maxLength = 10) {
+        if (!writer || value.isZero()) {
+            return;
+        }
+
+        const QString n = value.toString(Money::currencyDecimals(currency));
+        if (n.size() <= maxLength) {
+            writer->writeString(name, n);
+        }
+    }
+
+
+    void writePhoneNumber(PPJsonWriter *writer, QLatin1String name, const QString &number) {
+        if (!writer || number.isEmpty()) {
+            return;
+        }
+
+        QString n = number.simplified();
+        n.remove(QRegularExpression(QStringLiteral("[^0-9+\\s]")));
+
+        writer->writeString(name, n);
+    }
+
+
 };
 
 }
@@ -20,6 +20,8 @@
  */
 
 #include "processorresponse_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #include <QJsonObject>
 #ifdef QT_DEBUG
@@ -51,6 +53,13 @@ ProcessorResponse::ProcessorResponse(const QJsonObject &json, QObject *parent) :
 }
 
 
+ProcessorResponse::ProcessorResponse(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new ProcessorResponsePrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 ProcessorResponse::~ProcessorResponse()
 {
 }
@@ -81,23 +90,60 @@ void ProcessorResponse::loadFromJson(const QJsonDocument &json)
 
 
 void ProcessorResponse::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+namespace {
+
+// keep in the same order as processorResponseFields
+enum ProcessorResponseField {
+    ProcessorResponseFieldAdviceCode,
+    ProcessorResponseFieldAvsCode,
+    ProcessorResponseFieldCvvCode,
+    ProcessorResponseFieldEciSubmitted,
+    ProcessorResponseFieldResponseCode,
+    ProcessorResponseFieldVpas,
+    ProcessorResponseFieldCount
+};
+
+constexpr PPJsonField processorResponseFields[] = {
+    PPJsonField("advice_code"),
+    PPJsonField("avs_code"),
+    PPJsonField("cvv_code"),
+    PPJsonField("eci_submitted"),
+    PPJsonField("response_code"),
+    PPJsonField("vpas")
+};
+
+Q_STATIC_ASSERT(sizeof(processorResponseFields) / sizeof(PPJsonField) == ProcessorResponseFieldCount);
+
+}
+
+
+void ProcessorResponse::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<ProcessorResponseFieldCount> f(json, processorResponseFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(ProcessorResponse);
 
-    d->setResponseCode(json.value(QStringLiteral("response_code")).toString());
+    d->setResponseCode(f[ProcessorResponseFieldResponseCode].toString());
 
-    d->setAvsCode(json.value(QStringLiteral("avs_code")).toString());
+    d->setAvsCode(f[ProcessorResponseFieldAvsCode].toString());
 
-    d->setCvvCode(json.value(QStringLiteral("cvv_code")).toString());
+    d->setCvvCode(f[ProcessorResponseFieldCvvCode].toString());
 
-    d->setAdviceCode(json.value(QStringLiteral("advice_code")).toString());
+    d->setAdviceCode(f[ProcessorResponseFieldAdviceCode].toString());
 
-    d->setEciSubmitted(json.value(QStringLiteral("eci_submitted")).toString());
+    d->setEciSubmitted(f[ProcessorResponseFieldEciSubmitted].toString());
 
-    d->setVpas(json.value(QStringLiteral("vpas")).toString());
+    d->setVpas(f[ProcessorResponseFieldVpas].toString());
 }
 
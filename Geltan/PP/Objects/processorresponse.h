@@ -24,6 +24,7 @@
 
 #include <QObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
@@ -128,6 +129,11 @@ public:
      */
     ProcessorResponse(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new ProcessorResponse object from a value of a PPJsonDocument.
+     */
+    ProcessorResponse(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the ProcessorResponse object.
      */
@@ -171,6 +177,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the ProcessorResponse object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void responseCodeChanged(const QString &responseCode);
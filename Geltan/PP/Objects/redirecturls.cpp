@@ -20,6 +20,8 @@
  */
 
 #include "redirecturls_p.h"
+#include <Geltan/PP/pploadscope_p.h>
+#include <Geltan/PP/ppjsonwriter.h>
 #include <QJsonDocument>
 #ifdef QT_DEBUG
 #include <QtDebug>
@@ -67,6 +69,13 @@ RedirectUrls::RedirectUrls(const QJsonObject &json, QObject *parent) :
 }
 
 
+RedirectUrls::RedirectUrls(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new RedirectUrlsPrivate)
+{
+    loadFromJson(json);
+}
+
+
 
 RedirectUrls::~RedirectUrls()
 {
@@ -124,6 +133,23 @@ QVariantMap RedirectUrls::toVariant() const
 
 
 
+void RedirectUrls::writeJson(PPJsonWriter *writer, QLatin1String name) const
+{
+    writer->beginObject(name);
+
+    if (returnUrl().isValid()) {
+        writer->writeString(QLatin1String("return_url"), returnUrl().toString());
+    }
+
+    if (cancelUrl().isValid()) {
+        writer->writeString(QLatin1String("cancel_url"), cancelUrl().toString());
+    }
+
+    writer->endObject();
+}
+
+
+
 QJsonObject RedirectUrls::toJsonObject() const
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -144,21 +170,29 @@ void RedirectUrls::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void RedirectUrls::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+void RedirectUrls::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    const QString ru = json.value(QStringLiteral("return_url")).toString();
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    const QString ru = json.value(QLatin1String("return_url")).toString();
     if (!ru.isEmpty()) {
         setReturnUrl(QUrl(ru));
     } else {
         setReturnUrl(QUrl());
     }
 
-    const QString cu = json.value(QStringLiteral("cancel_url")).toString();
+    const QString cu = json.value(QLatin1String("cancel_url")).toString();
     if (!cu.isEmpty()) {
         setReturnUrl(QUrl(cu));
     } else {
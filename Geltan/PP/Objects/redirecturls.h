@@ -27,11 +27,13 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class RedirectUrlsPrivate;
+class PPJsonWriter;
 
 /*!
  * \brief Set of redirect URLs you provide only for PayPal-based payments.
@@ -86,6 +88,11 @@ public:
      */
     RedirectUrls(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new RedirectUrls object from a value of a PPJsonDocument.
+     */
+    RedirectUrls(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the RedirectUrls object.
      */
@@ -104,6 +111,14 @@ public:
      */
     QVariantMap toVariant() const;
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String()) const;
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -127,6 +142,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the RedirectUrls object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void returnUrlChanged(const QUrl &returnUrl);
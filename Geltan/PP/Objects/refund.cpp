@@ -20,11 +20,14 @@
  */
 
 #include "refund_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/paymentamount.h>
 #include <Geltan/PP/Objects/link.h>
 #include <Geltan/PP/ppenumsmap.h>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <Geltan/PP/pptimestamp.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -55,6 +58,13 @@ Refund::Refund(const QJsonObject &json, QObject *parent) :
 }
 
 
+Refund::Refund(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new RefundPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 
 
 Refund::~Refund()
@@ -253,20 +263,69 @@ void Refund::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void Refund::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as refundFields
+enum RefundField {
+    RefundFieldAmount,
+    RefundFieldCaptureId,
+    RefundFieldCreateTime,
+    RefundFieldDescription,
+    RefundFieldId,
+    RefundFieldInvoiceNumber,
+    RefundFieldLinks,
+    RefundFieldParentPayment,
+    RefundFieldReason,
+    RefundFieldReasonCode,
+    RefundFieldSaleId,
+    RefundFieldState,
+    RefundFieldUpdateTime,
+    RefundFieldCount
+};
+
+constexpr PPJsonField refundFields[] = {
+    PPJsonField("amount"),
+    PPJsonField("capture_id"),
+    PPJsonField("create_time"),
+    PPJsonField("description"),
+    PPJsonField("id"),
+    PPJsonField("invoice_number"),
+    PPJsonField("links"),
+    PPJsonField("parent_payment"),
+    PPJsonField("reason"),
+    PPJsonField("reason_code"),
+    PPJsonField("sale_id"),
+    PPJsonField("state"),
+    PPJsonField("update_time")
+};
+
+Q_STATIC_ASSERT(sizeof(refundFields) / sizeof(PPJsonField) == RefundFieldCount);
+
+}
+
+
+void Refund::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(Refund);
+    const PPJsonFields<RefundFieldCount> f(json, refundFields);
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    d->setId(json.value(QStringLiteral("id")).toString());
+    Q_D(Refund);
 
-    const QJsonObject ao = json.value(QStringLiteral("amount")).toObject();
+    d->setId(f[RefundFieldId].toString());
+
+    const PPJsonValue ao = f[RefundFieldAmount].toObject();
     PaymentAmount *oldAo = amount();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -280,40 +339,42 @@ void Refund::loadFromJson(const QJsonObject &json)
     }
 
 
-    d->setState(em->stateTypeTokenToEnum(json.value(QStringLiteral("state")).toString()));
+    d->setState(PPEnumsMap::stateTypeTokenToEnum(f[RefundFieldState].toString()));
+
+    setReason(f[RefundFieldReason].toString());
 
-    setReason(json.value(QStringLiteral("reason")).toString());
+    setInvoiceNumber(f[RefundFieldInvoiceNumber].toString());
 
-    d->setSaleId(json.value(QStringLiteral("sale_id")).toString());
+    d->setSaleId(f[RefundFieldSaleId].toString());
 
-    d->setCaptureId(json.value(QStringLiteral("capture_id")).toString());
+    d->setCaptureId(f[RefundFieldCaptureId].toString());
 
-    d->setParentPayment(json.value(QStringLiteral("parent_payment")).toString());
+    d->setParentPayment(f[RefundFieldParentPayment].toString());
 
-    setDescription(json.value(QStringLiteral("description")).toString());
+    setDescription(f[RefundFieldDescription].toString());
 
-    const QString ct = json.value(QStringLiteral("create_time")).toString();
+    const QString ct = f[RefundFieldCreateTime].toString();
     if (!ct.isEmpty()) {
-        d->setCreateTime(QDateTime::fromString(ct, Qt::ISODate));
+        d->setCreateTime(PPTimestamp::toDateTime(ct));
     } else {
         d->setCreateTime(QDateTime());
     }
 
-    const QString ut = json.value(QStringLiteral("update_time")).toString();
+    const QString ut = f[RefundFieldUpdateTime].toString();
     if (!ut.isEmpty()) {
-        d->setUpdateTime(QDateTime::fromString(ut, Qt::ISODate));
+        d->setUpdateTime(PPTimestamp::toDateTime(ut));
     } else {
         d->setUpdateTime(QDateTime());
     }
 
-    d->setReasonCode(em->reasonCodeTokenToEnum(json.value(QStringLiteral("reason_code")).toString()));
+    d->setReasonCode(PPEnumsMap::reasonCodeTokenToEnum(f[RefundFieldReasonCode].toString()));
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
+    const PPJsonValue la = f[RefundFieldLinks].toArray();
     d->clearLinks();
     Q_EMIT linksChanged(links());
     if (!la.isEmpty()) {
         QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
+        PPJsonValue::const_iterator i = la.constBegin();
         while (i != la.constEnd()) {
             linksToAdd.append(new Link(i->toObject()));
             ++i;
@@ -20,12 +20,20 @@
  */
 
 #include "related_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/sale.h>
 #include <Geltan/PP/Objects/authorization.h>
 #include <Geltan/PP/Objects/order.h>
 #include <Geltan/PP/Objects/capture.h>
 #include <Geltan/PP/Objects/refund.h>
+#include <Geltan/PP/Objects/link.h>
+#include <Geltan/PP/Objects/paymentamount.h>
+#include <Geltan/PP/Objects/currency.h>
+#include <Geltan/PP/Objects/fmfdetails.h>
+#include <Geltan/PP/Objects/processorresponse.h>
 #include <QJsonDocument>
+#include <Geltan/PP/Values/relatedresourcevalue.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -56,6 +64,13 @@ Related::Related(const QJsonObject &json, QObject *parent) :
 }
 
 
+Related::Related(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new RelatedPrivate)
+{
+    loadFromJson(json);
+}
+
+
 
 Related::~Related()
 {
@@ -184,12 +199,47 @@ void Related::loadFromJson(const QJsonDocument &json)
 
 
 void Related::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+namespace {
+
+// keep in the same order as relatedFields
+enum RelatedField {
+    RelatedFieldAuthorization,
+    RelatedFieldCapture,
+    RelatedFieldOrder,
+    RelatedFieldRefund,
+    RelatedFieldSale,
+    RelatedFieldCount
+};
+
+constexpr PPJsonField relatedFields[] = {
+    PPJsonField("authorization"),
+    PPJsonField("capture"),
+    PPJsonField("order"),
+    PPJsonField("refund"),
+    PPJsonField("sale")
+};
+
+Q_STATIC_ASSERT(sizeof(relatedFields) / sizeof(PPJsonField) == RelatedFieldCount);
+
+}
+
+
+void Related::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    const QJsonObject so = json.value(QStringLiteral("sale")).toObject();
+    const PPJsonFields<RelatedFieldCount> f(json, relatedFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    const PPJsonValue so = f[RelatedFieldSale].toObject();
     Sale *oldSo = sale();
     if (!so.isEmpty()) {
         if (oldSo) {
@@ -203,7 +253,7 @@ void Related::loadFromJson(const QJsonObject &json)
     }
 
 
-    const QJsonObject ao = json.value(QStringLiteral("authorization")).toObject();
+    const PPJsonValue ao = f[RelatedFieldAuthorization].toObject();
     Authorization *oldAo = authorization();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -217,7 +267,7 @@ void Related::loadFromJson(const QJsonObject &json)
     }
 
 
-    const QJsonObject oo = json.value(QStringLiteral("order")).toObject();
+    const PPJsonValue oo = f[RelatedFieldOrder].toObject();
     Order *oldOo = order();
     if (!oo.isEmpty()) {
         if (oldOo) {
@@ -231,7 +281,7 @@ void Related::loadFromJson(const QJsonObject &json)
     }
 
 
-    const QJsonObject co = json.value(QStringLiteral("capture")).toObject();
+    const PPJsonValue co = f[RelatedFieldCapture].toObject();
     Capture *oldCo = capture();
     if (!co.isEmpty()) {
         if (oldCo) {
@@ -245,7 +295,7 @@ void Related::loadFromJson(const QJsonObject &json)
     }
 
 
-    const QJsonObject ro = json.value(QStringLiteral("refund")).toObject();
+    const PPJsonValue ro = f[RelatedFieldRefund].toObject();
     Refund *oldRo = refund();
     if (!ro.isEmpty()) {
         if (oldRo) {
@@ -258,3 +308,155 @@ void Related::loadFromJson(const QJsonObject &json)
         delete oldRo;
     }
 }
+
+
+
+static QList<LinkValue> relatedLinksToValues(const QList<Link*> &links)
+{
+    QList<LinkValue> lvs;
+    lvs.reserve(links.size());
+    for (const Link *l : links) {
+        lvs.append(l->toValue());
+    }
+    return lvs;
+}
+
+
+static PaymentAmountValue relatedCurrencyToValue(const Currency *c)
+{
+    PaymentAmountValue pav;
+    if (c) {
+        pav.setCurrency(c->currency());
+        pav.setTotalMoney(c->valueMoney());
+    }
+    return pav;
+}
+
+
+static void relatedFmfDetailsToValue(RelatedResourceValue *v, const FMFDetails *fmf)
+{
+    if (fmf) {
+        v->setFmfFilterType(fmf->filterType());
+        v->setFmfFilterId(fmf->filterId());
+        v->setFmfName(fmf->name());
+        v->setFmfDescription(fmf->description());
+    }
+}
+
+
+
+RelatedResourceValue Related::toValue() const
+{
+    RelatedResourceValue v;
+
+    if (sale()) {
+        const Sale *s = sale();
+        v.setType(RelatedResourceValue::Sale);
+        v.setId(s->id());
+        v.setPurchaseUnitReferenceId(s->purchaseUnitReferenceId());
+        if (s->amount()) {
+            v.setAmount(s->amount()->toValue());
+        }
+        v.setPaymentMode(s->paymentMode());
+        v.setState(s->state());
+        v.setReasonCode(s->reasonCode());
+        v.setProtectionEligibility(s->protectionEligibility());
+        v.setProtectionEligibilityType(s->protectionEligibilityType());
+        v.setClearingTime(s->clearingTime());
+        v.setPaymentHoldStatus(s->paymentHoldStatus());
+        v.setPaymentHoldReasons(s->paymentHoldReasons());
+        v.setTransactionFee(relatedCurrencyToValue(s->transactionFee()));
+        v.setReceivableAmount(relatedCurrencyToValue(s->receivableAmount()));
+        v.setExchangeRate(s->exchangeRate());
+        relatedFmfDetailsToValue(&v, s->fmfDetails());
+        v.setReceiptId(s->receiptId());
+        v.setParentPayment(s->parentPayment());
+        if (s->processorResponse()) {
+            const ProcessorResponse *pr = s->processorResponse();
+            v.setProcessorResponseCode(pr->responseCode());
+            v.setProcessorAvsCode(pr->avsCode());
+            v.setProcessorCvvCode(pr->cvvCode());
+            v.setProcessorAdviceCode(pr->adviceCode());
+            v.setProcessorEciSubmitted(pr->eciSubmitted());
+            v.setProcessorVpas(pr->vpas());
+        }
+        v.setBillingAgreementId(s->billingAgreementId());
+        v.setCreateTime(s->createTime());
+        v.setUpdateTime(s->updateTime());
+        v.setLinks(relatedLinksToValues(s->links()));
+    } else if (authorization()) {
+        const Authorization *a = authorization();
+        v.setType(RelatedResourceValue::Authorization);
+        v.setId(a->id());
+        if (a->amount()) {
+            v.setAmount(a->amount()->toValue());
+        }
+        v.setPaymentMode(a->paymentMode());
+        v.setState(a->state());
+        v.setReasonCode(a->reasonCode());
+        v.setProtectionEligibility(a->protectionEligibility());
+        v.setProtectionEligibilityType(a->protectionEligibilityType());
+        relatedFmfDetailsToValue(&v, a->fmfDetails());
+        v.setParentPayment(a->parentPayment());
+        v.setValidUntil(a->validUntil());
+        v.setCreateTime(a->createTime());
+        v.setUpdateTime(a->updateTime());
+        v.setReferenceId(a->referenceId());
+        v.setReceiptId(a->receiptId());
+        v.setLinks(relatedLinksToValues(a->links()));
+    } else if (order()) {
+        const Order *o = order();
+        v.setType(RelatedResourceValue::Order);
+        v.setId(o->id());
+        v.setReferenceId(o->referenceId());
+        if (o->amount()) {
+            v.setAmount(o->amount()->toValue());
+        }
+        v.setPaymentMode(o->paymentMode());
+        v.setState(o->state());
+        v.setReasonCode(o->reasonCode());
+        v.setProtectionEligibility(o->protectionEligibility());
+        v.setProtectionEligibilityType(o->protectionEligibilityType());
+        v.setParentPayment(o->parentPayment());
+        relatedFmfDetailsToValue(&v, o->fmfDetails());
+        v.setCreateTime(o->createTime());
+        v.setUpdateTime(o->updateTime());
+        v.setLinks(relatedLinksToValues(o->links()));
+    } else if (capture()) {
+        const Capture *c = capture();
+        v.setType(RelatedResourceValue::Capture);
+        v.setId(c->id());
+        if (c->amount()) {
+            v.setAmount(c->amount()->toValue());
+        }
+        v.setIsFinalCapture(c->isFinalCapture());
+        v.setState(c->state());
+        v.setReasonCode(c->reasonCode());
+        v.setParentPayment(c->parentPayment());
+        v.setInvoiceNumber(c->invoiceNumber());
+        v.setTransactionFee(relatedCurrencyToValue(c->transactionFee()));
+        v.setCreateTime(c->createTime());
+        v.setUpdateTime(c->updateTime());
+        v.setLinks(relatedLinksToValues(c->links()));
+    } else if (refund()) {
+        const Refund *r = refund();
+        v.setType(RelatedResourceValue::Refund);
+        v.setId(r->id());
+        if (r->amount()) {
+            v.setAmount(r->amount()->toValue());
+        }
+        v.setState(r->state());
+        v.setReason(r->reason());
+        v.setInvoiceNumber(r->invoiceNumber());
+        v.setSaleId(r->saleId());
+        v.setCaptureId(r->captureId());
+        v.setParentPayment(r->parentPayment());
+        v.setDescription(r->description());
+        v.setCreateTime(r->createTime());
+        v.setUpdateTime(r->updateTime());
+        v.setReasonCode(r->reasonCode());
+        v.setLinks(relatedLinksToValues(r->links()));
+    }
+
+    return v;
+}
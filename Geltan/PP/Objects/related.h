@@ -26,11 +26,13 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class RelatedPrivate;
+class RelatedResourceValue;
 class Sale;
 class Authorization;
 class Order;
@@ -120,6 +122,11 @@ public:
      */
     Related(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Related object from a value of a PPJsonDocument.
+     */
+    Related(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Related object.
      */
@@ -162,6 +169,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Related object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared RelatedResourceValue containing the related resource data, including the read only members.
+     */
+    RelatedResourceValue toValue() const;
+
 
 Q_SIGNALS:
     void saleChanged(Sale *sale);
@@ -20,6 +20,8 @@
  */
 
 #include "sale_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/ppenums.h>
 #include <Geltan/PP/Objects/paymentamount.h>
 #include <Geltan/PP/Objects/currency.h>
@@ -28,6 +30,7 @@
 #include <Geltan/PP/Objects/link.h>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <Geltan/PP/pptimestamp.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -58,6 +61,13 @@ Sale::Sale(const QJsonObject &json, QObject *parent) :
 }
 
 
+Sale::Sale(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new SalePrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 Sale::~Sale()
 {
 }
@@ -254,23 +264,90 @@ void Sale::loadFromJson(const QJsonDocument &json)
 }
 
 
+void Sale::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
 
 
-void Sale::loadFromJson(const QJsonObject &json)
+
+
+namespace {
+
+// keep in the same order as saleFields
+enum SaleField {
+    SaleFieldAmount,
+    SaleFieldBillingAgreementId,
+    SaleFieldClearingTime,
+    SaleFieldCreateTime,
+    SaleFieldExchangeRate,
+    SaleFieldFmfDetails,
+    SaleFieldId,
+    SaleFieldLinks,
+    SaleFieldParentPayment,
+    SaleFieldPaymentHoldReasons,
+    SaleFieldPaymentHoldStatus,
+    SaleFieldPaymentMode,
+    SaleFieldProcessorResponse,
+    SaleFieldProtectionEligibility,
+    SaleFieldProtectionEligibilityType,
+    SaleFieldPurchaseUnitReferenceId,
+    SaleFieldReasonCode,
+    SaleFieldReceiptId,
+    SaleFieldReceivableAmount,
+    SaleFieldState,
+    SaleFieldTransactionFee,
+    SaleFieldUpdateTime,
+    SaleFieldCount
+};
+
+constexpr PPJsonField saleFields[] = {
+    PPJsonField("amount"),
+    PPJsonField("billing_agreement_id"),
+    PPJsonField("clearing_time"),
+    PPJsonField("create_time"),
+    PPJsonField("exchange_rate"),
+    PPJsonField("fmf_details"),
+    PPJsonField("id"),
+    PPJsonField("links"),
+    PPJsonField("parent_payment"),
+    PPJsonField("payment_hold_reasons"),
+    PPJsonField("payment_hold_status"),
+    PPJsonField("payment_mode"),
+    PPJsonField("processor_response"),
+    PPJsonField("protection_eligibility"),
+    PPJsonField("protection_eligibility_type"),
+    PPJsonField("purchase_unit_reference_id"),
+    PPJsonField("reason_code"),
+    PPJsonField("receipt_id"),
+    PPJsonField("receivable_amount"),
+    PPJsonField("state"),
+    PPJsonField("transaction_fee"),
+    PPJsonField("update_time")
+};
+
+Q_STATIC_ASSERT(sizeof(saleFields) / sizeof(PPJsonField) == SaleFieldCount);
+
+}
+
+
+void Sale::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(Sale);
+    const PPJsonFields<SaleFieldCount> f(json, saleFields);
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
+    Q_D(Sale);
 
-    d->setId(json.value(QStringLiteral("id")).toString());
+    d->setId(f[SaleFieldId].toString());
 
-    d->setPurchaseUnitReferenceId(json.value(QStringLiteral("purchase_unit_reference_id")).toString());
+    d->setPurchaseUnitReferenceId(f[SaleFieldPurchaseUnitReferenceId].toString());
 
-    const QJsonObject ao = json.value(QStringLiteral("amount")).toObject();
+    const PPJsonValue ao = f[SaleFieldAmount].toObject();
     PaymentAmount *oldAo = amount();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -284,45 +361,45 @@ void Sale::loadFromJson(const QJsonObject &json)
     }
 
 
-    d->setPaymentMode(em->paymentModeTypeTokenToEnum(json.value(QStringLiteral("payment_mode")).toString()));
+    d->setPaymentMode(PPEnumsMap::paymentModeTypeTokenToEnum(f[SaleFieldPaymentMode].toString()));
 
-    d->setState(em->stateTypeTokenToEnum(json.value(QStringLiteral("state")).toString()));
+    d->setState(PPEnumsMap::stateTypeTokenToEnum(f[SaleFieldState].toString()));
 
-    d->setReasonCode(em->reasonCodeTokenToEnum(json.value(QStringLiteral("reason_code")).toString()));
+    d->setReasonCode(PPEnumsMap::reasonCodeTokenToEnum(f[SaleFieldReasonCode].toString()));
 
-    d->setProtectionEligibility(em->protectionEligibilityTokenToEnum(json.value(QStringLiteral("protection_eligibility")).toString()));
+    d->setProtectionEligibility(PPEnumsMap::protectionEligibilityTokenToEnum(f[SaleFieldProtectionEligibility].toString()));
 
-    const QString pets = json.value(QStringLiteral("protection_eligibility_type")).toString();
+    const QString pets = f[SaleFieldProtectionEligibilityType].toString();
     if (!pets.isEmpty()) {
         QList<Geltan::PP::PayPal::ProtectionEligibilityType> petList;
         const QStringList petsList = pets.split(QChar(','));
         petList.reserve(petsList.size());
         for (const QString &pet : petsList) {
-            petList.append(em->protectionEligibilityTypeTokenToEnum(pet));
+            petList.append(PPEnumsMap::protectionEligibilityTypeTokenToEnum(pet));
         }
         d->setProtectionEligibilityType(petList);
     } else {
         d->setProtectionEligibilityType(QList<Geltan::PP::PayPal::ProtectionEligibilityType>());
     }
 
-    const QString scs = json.value(QStringLiteral("clearing_time")).toString();
+    const QString scs = f[SaleFieldClearingTime].toString();
     if (!scs.isEmpty()) {
-        d->setClearingTime(QDateTime::fromString(scs, Qt::ISODate));
+        d->setClearingTime(PPTimestamp::toDateTime(scs));
     } else {
         d->setClearingTime(QDateTime());
     }
 
-    const QString phs = json.value(QStringLiteral("payment_hold_status")).toString();
+    const QString phs = f[SaleFieldPaymentHoldStatus].toString();
     if (phs == QLatin1String("HELD")) {
         d->setPaymentHoldStatus(HELD);
     } else {
         d->setPaymentHoldStatus(NO_PAYMENT_HOLD_STATUS);
     }
 
-    const QJsonArray phrs = json.value(QStringLiteral("payment_hold_reasons")).toArray();
+    const PPJsonValue phrs = f[SaleFieldPaymentHoldReasons].toArray();
     if (!phrs.isEmpty()) {
         QStringList phrList;
-        QJsonArray::const_iterator i = phrs.constBegin();
+        PPJsonValue::const_iterator i = phrs.constBegin();
         while (i != phrs.constEnd()) {
             phrList.append(i->toString());
             ++i;
@@ -332,7 +409,7 @@ void Sale::loadFromJson(const QJsonObject &json)
         d->setPaymentHoldReasons(QStringList());
     }
 
-    const QJsonObject tf = json.value(QStringLiteral("transaction_fee")).toObject();
+    const PPJsonValue tf = f[SaleFieldTransactionFee].toObject();
     Currency *oldTf = transactionFee();
     if (!tf.isEmpty()) {
         if (oldTf) {
@@ -345,7 +422,7 @@ void Sale::loadFromJson(const QJsonObject &json)
         delete oldTf;
     }
 
-    const QJsonObject ra = json.value(QStringLiteral("receivable_amount")).toObject();
+    const PPJsonValue ra = f[SaleFieldReceivableAmount].toObject();
     Currency *oldRa = receivableAmount();
     if (!ra.isEmpty()) {
         if (oldRa) {
@@ -358,9 +435,9 @@ void Sale::loadFromJson(const QJsonObject &json)
         delete oldRa;
     }
 
-    d->setExchangeRate(json.value(QStringLiteral("exchange_rate")).toString().toFloat());
+    d->setExchangeRate(f[SaleFieldExchangeRate].toString().toFloat());
 
-    const QJsonObject fmfo = json.value(QStringLiteral("fmf_details")).toObject();
+    const PPJsonValue fmfo = f[SaleFieldFmfDetails].toObject();
     FMFDetails *oldFmf = fmfDetails();
     if (!fmfo.isEmpty()) {
         if (oldFmf) {
@@ -373,11 +450,11 @@ void Sale::loadFromJson(const QJsonObject &json)
         delete oldFmf;
     }
 
-    d->setReceiptId(json.value(QStringLiteral("receipt_id")).toString());
+    d->setReceiptId(f[SaleFieldReceiptId].toString());
 
-    d->setParentPayment(json.value(QStringLiteral("parent_payment")).toString());
+    d->setParentPayment(f[SaleFieldParentPayment].toString());
 
-    const QJsonObject pro = json.value(QStringLiteral("processor_response")).toObject();
+    const PPJsonValue pro = f[SaleFieldProcessorResponse].toObject();
     ProcessorResponse *oldPro = processorResponse();
     if (!pro.isEmpty()) {
         if (oldPro) {
@@ -391,28 +468,28 @@ void Sale::loadFromJson(const QJsonObject &json)
     }
 
 
-    d->setBillingAgreementId(json.value(QStringLiteral("billing_agreement_id")).toString());
+    d->setBillingAgreementId(f[SaleFieldBillingAgreementId].toString());
 
-    const QString ct = json.value(QStringLiteral("create_time")).toString();
+    const QString ct = f[SaleFieldCreateTime].toString();
     if (!ct.isEmpty()) {
-        d->setCreateTime(QDateTime::fromString(ct, Qt::ISODate));
+        d->setCreateTime(PPTimestamp::toDateTime(ct));
     } else {
         d->setCreateTime(QDateTime());
     }
 
-    const QString ut = json.value(QStringLiteral("update_time")).toString();
+    const QString ut = f[SaleFieldUpdateTime].toString();
     if (!ut.isEmpty()) {
-        d->setUpdateTime(QDateTime::fromString(ut, Qt::ISODate));
+        d->setUpdateTime(PPTimestamp::toDateTime(ut));
     } else {
         d->setUpdateTime(QDateTime());
     }
 
-    const QJsonArray la = json.value(QStringLiteral("links")).toArray();
+    const PPJsonValue la = f[SaleFieldLinks].toArray();
     d->clearLinks();
     Q_EMIT linksChanged(links());
     if (!la.isEmpty()) {
         QList<Link*> linksToAdd;
-        QJsonArray::const_iterator i = la.constBegin();
+        PPJsonValue::const_iterator i = la.constBegin();
         while (i != la.constEnd()) {
             linksToAdd.append(new Link(i->toObject()));
             ++i;
@@ -20,7 +20,11 @@
  */
 
 #include "shippingaddress_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
+#include <Geltan/PP/Values/addressvalue.h>
+#include <Geltan/PP/ppstringpool.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -49,6 +53,13 @@ ShippingAddress::ShippingAddress(const QJsonObject &json, QObject *parent) :
 }
 
 
+ShippingAddress::ShippingAddress(const PPJsonValue &json, QObject *parent) :
+    Address(parent), d_ptr(new ShippingAddressPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 ShippingAddress::~ShippingAddress()
 {
 
@@ -108,6 +119,39 @@ QVariantMap ShippingAddress::toVariant()
 
 
 
+void ShippingAddress::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(ShippingAddress);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("line1"), line1(), 100);
+    d->writeString(writer, QLatin1String("line2"), line2(), 100);
+    d->writeString(writer, QLatin1String("city"), city(), 50);
+    d->writeString(writer, QLatin1String("country_code"), countryCode(), 2);
+    d->writeString(writer, QLatin1String("postal_code"), postalCode(), 20);
+    d->writeString(writer, QLatin1String("state"), state(), 100);
+    d->writePhoneNumber(writer, QLatin1String("phone"), phone());
+
+    switch (status()) {
+    case CONFIRMED:
+        writer->writeString(QLatin1String("status"), QStringLiteral("CONFIRMED"));
+        break;
+    case UNCONFIRMED:
+        writer->writeString(QLatin1String("status"), QStringLiteral("UNCONFIRMED"));
+        break;
+    default:
+        break;
+    }
+
+    d->writeString(writer, QLatin1String("typew"), type());
+    d->writeString(writer, QLatin1String("recipient_name"), recipientName(), 127);
+
+    writer->endObject();
+}
+
+
+
 QJsonObject ShippingAddress::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -121,35 +165,82 @@ void ShippingAddress::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void ShippingAddress::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as shippingAddressFields
+enum ShippingAddressField {
+    ShippingAddressFieldCity,
+    ShippingAddressFieldCountryCode,
+    ShippingAddressFieldLine1,
+    ShippingAddressFieldLine2,
+    ShippingAddressFieldNormalizationStatus,
+    ShippingAddressFieldPhone,
+    ShippingAddressFieldPostalCode,
+    ShippingAddressFieldRecipientName,
+    ShippingAddressFieldState,
+    ShippingAddressFieldStatus,
+    ShippingAddressFieldType,
+    ShippingAddressFieldCount
+};
+
+constexpr PPJsonField shippingAddressFields[] = {
+    PPJsonField("city"),
+    PPJsonField("country_code"),
+    PPJsonField("line1"),
+    PPJsonField("line2"),
+    PPJsonField("normalization_status"),
+    PPJsonField("phone"),
+    PPJsonField("postal_code"),
+    PPJsonField("recipient_name"),
+    PPJsonField("state"),
+    PPJsonField("status"),
+    PPJsonField("type")
+};
+
+Q_STATIC_ASSERT(sizeof(shippingAddressFields) / sizeof(PPJsonField) == ShippingAddressFieldCount);
+
+}
+
+
+void ShippingAddress::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<ShippingAddressFieldCount> f(json, shippingAddressFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(ShippingAddress);
 
-    setLine1(json.value(QStringLiteral("line1")).toString());
+    setLine1(f[ShippingAddressFieldLine1].toString());
 
-    setLine2(json.value(QStringLiteral("line2")).toString());
+    setLine2(f[ShippingAddressFieldLine2].toString());
 
-    setCity(json.value(QStringLiteral("city")).toString());
+    setCity(f[ShippingAddressFieldCity].toString());
 
-    setCountryCode(json.value(QStringLiteral("country_code")).toString());
+    setCountryCode(PPStringPool::intern(f[ShippingAddressFieldCountryCode].toString()));
 
-    setPostalCode(json.value(QStringLiteral("postal_code")).toString());
+    setPostalCode(f[ShippingAddressFieldPostalCode].toString());
 
-    const QString stateString = json.value(QStringLiteral("state")).toString();
+    const QString stateString = f[ShippingAddressFieldState].toString();
     if (QString::compare(stateString, QStringLiteral("Empty"), Qt::CaseInsensitive) == 0) {
         setState(QString());
     } else {
         setState(stateString);
     }
 
-    setPhone(json.value(QStringLiteral("phone")).toString());
+    setPhone(f[ShippingAddressFieldPhone].toString());
 
-    const QString ns = json.value(QStringLiteral("normalization_status")).toString();
+    const QString ns = f[ShippingAddressFieldNormalizationStatus].toString();
     if (ns == QLatin1String("UNNORMALIZED_USER_PREFERRED")) {
         d->setNormalizationStatus(UNNORMALIZED_USER_PREFERRED);
     } else if (ns == QLatin1String("NORMALIZED")) {
@@ -160,7 +251,7 @@ void ShippingAddress::loadFromJson(const QJsonObject &json)
         d->setNormalizationStatus(UNKNOWN);
     }
 
-    const QString ss = json.value(QStringLiteral("status")).toString();
+    const QString ss = f[ShippingAddressFieldStatus].toString();
     if (ss == QLatin1String("CONFIRMED")) {
         setStatus(CONFIRMED);
     } else if (ss == QLatin1String("UNCONFIRMED")) {
@@ -169,7 +260,16 @@ void ShippingAddress::loadFromJson(const QJsonObject &json)
         setStatus(NO_STATUS);
     }
 
-    setType(json.value(QStringLiteral("type")).toString());
+    setType(PPStringPool::intern(f[ShippingAddressFieldType].toString()));
 
-    setRecipientName(json.value(QStringLiteral("recipient_name")).toString());
+    setRecipientName(f[ShippingAddressFieldRecipientName].toString());
+}
+
+
+
+AddressValue ShippingAddress::toValue() const
+{
+    AddressValue v = Address::toValue();
+    v.setRecipientName(recipientName());
+    return v;
 }
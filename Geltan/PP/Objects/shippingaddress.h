@@ -26,12 +26,14 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/Objects/address.h>
 
 namespace Geltan {
 namespace PP {
 
 class ShippingAddressPrivate;
+class PPJsonWriter;
 
 
 /*!
@@ -69,6 +71,11 @@ public:
      */
     ShippingAddress(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new ShippingAddress object from a value of a PPJsonDocument.
+     */
+    ShippingAddress(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the ShippingAddress object.
      */
@@ -86,6 +93,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -103,6 +118,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the ShippingAddress object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared AddressValue containing the shipping address data, including the read only members.
+     */
+    AddressValue toValue() const;
+
 
 Q_SIGNALS:
     void recipientNameChanged(const QString &recipientName);
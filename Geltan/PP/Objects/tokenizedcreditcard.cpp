@@ -20,6 +20,8 @@
  */
 
 #include "tokenizedcreditcard_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <QJsonDocument>
 #include <Geltan/PP/ppenumsmap.h>
 #ifdef QT_DEBUG
@@ -50,6 +52,13 @@ TokenizedCreditCard::TokenizedCreditCard(const QJsonObject &json, QObject *paren
 }
 
 
+TokenizedCreditCard::TokenizedCreditCard(const PPJsonValue &json, QObject *parent) :
+    QObject(parent), d_ptr(new TokenizedCreditCardPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 TokenizedCreditCard::~TokenizedCreditCard()
 {
 
@@ -132,6 +141,20 @@ QVariantMap TokenizedCreditCard::toVariant()
 
 
 
+void TokenizedCreditCard::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(TokenizedCreditCard);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("credit_card_id"), creditCardId());
+    d->writeString(writer, QLatin1String("payer_id"), payerId());
+
+    writer->endObject();
+}
+
+
+
 QJsonObject TokenizedCreditCard::toJsonObject()
 {
     return QJsonObject::fromVariantMap(this->toVariant());
@@ -145,26 +168,61 @@ void TokenizedCreditCard::loadFromJson(const QJsonDocument &json)
 }
 
 
-
 void TokenizedCreditCard::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+
+namespace {
+
+// keep in the same order as tokenizedCreditCardFields
+enum TokenizedCreditCardField {
+    TokenizedCreditCardFieldCreditCardId,
+    TokenizedCreditCardFieldExpireMonth,
+    TokenizedCreditCardFieldExpireYear,
+    TokenizedCreditCardFieldLast4,
+    TokenizedCreditCardFieldPayerId,
+    TokenizedCreditCardFieldType,
+    TokenizedCreditCardFieldCount
+};
+
+constexpr PPJsonField tokenizedCreditCardFields[] = {
+    PPJsonField("credit_card_id"),
+    PPJsonField("expire_month"),
+    PPJsonField("expire_year"),
+    PPJsonField("last4"),
+    PPJsonField("payer_id"),
+    PPJsonField("type")
+};
+
+Q_STATIC_ASSERT(sizeof(tokenizedCreditCardFields) / sizeof(PPJsonField) == TokenizedCreditCardFieldCount);
+
+}
+
+
+void TokenizedCreditCard::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
-    Q_D(TokenizedCreditCard);
+    const PPJsonFields<TokenizedCreditCardFieldCount> f(json, tokenizedCreditCardFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
 
-    QScopedPointer<const PPEnumsMap> em(new PPEnumsMap);
+    Q_D(TokenizedCreditCard);
 
-    setCreditCardId(json.value(QStringLiteral("credit_card_id")).toString());
+    setCreditCardId(f[TokenizedCreditCardFieldCreditCardId].toString());
 
-    setPayerId(json.value(QStringLiteral("payer_id")).toString());
+    setPayerId(f[TokenizedCreditCardFieldPayerId].toString());
 
-    d->setLast4(json.value(QStringLiteral("last4")).toString());
+    d->setLast4(f[TokenizedCreditCardFieldLast4].toString());
 
-    d->setType(em->creditCardTypeTokenToEnum(json.value(QStringLiteral("type")).toString()));
+    d->setType(PPEnumsMap::creditCardTypeTokenToEnum(f[TokenizedCreditCardFieldType].toString()));
 
-    d->setExpireMonth(json.value(QStringLiteral("expire_month")).toString().toUInt());
+    d->setExpireMonth(f[TokenizedCreditCardFieldExpireMonth].toString().toUInt());
 
-    d->setExpireYear(json.value(QStringLiteral("expire_year")).toString().toUInt());
+    d->setExpireYear(f[TokenizedCreditCardFieldExpireYear].toString().toUInt());
 }
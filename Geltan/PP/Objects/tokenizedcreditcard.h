@@ -26,12 +26,14 @@
 #include <QVariantMap>
 #include <QJsonObject>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 #include <Geltan/PP/ppenums.h>
 
 namespace Geltan {
 namespace PP {
 
 class TokenizedCreditCardPrivate;
+class PPJsonWriter;
 
 /*!
  * \brief Contains information about a tokenized credit card.
@@ -131,6 +133,11 @@ public:
      */
     TokenizedCreditCard(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new TokenizedCreditCard object from a value of a PPJsonDocument.
+     */
+    TokenizedCreditCard(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the TokenizedCreditCard object.
      */
@@ -156,6 +163,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -173,6 +188,13 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the TokenizedCreditCard object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
 
 Q_SIGNALS:
     void creditCardIdChanged(const QString &creditCardId);
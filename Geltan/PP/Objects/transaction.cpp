@@ -20,6 +20,8 @@
  */
 
 #include "transaction_p.h"
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/pploadscope_p.h>
 #include <Geltan/PP/Objects/related.h>
 #include <Geltan/PP/Objects/sale.h>
 #include <Geltan/PP/Objects/authorization.h>
@@ -32,8 +34,10 @@
 #include <Geltan/PP/Objects/item.h>
 #include <Geltan/PP/Objects/details.h>
 #include <Geltan/PP/Objects/payee.h>
+#include <Geltan/PP/Objects/shippingaddress.h>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <Geltan/PP/Values/transactionvalue.h>
 #ifdef QT_DEBUG
 #include <QtDebug>
 #endif
@@ -62,6 +66,13 @@ Transaction::Transaction(const QJsonObject &json, QObject *parent) :
 }
 
 
+Transaction::Transaction(const PPJsonValue &json, QObject *parent) :
+    QAbstractListModel(parent), d_ptr(new TransactionPrivate(this))
+{
+    loadFromJson(json);
+}
+
+
 Transaction::~Transaction()
 {
 }
@@ -432,6 +443,35 @@ QVariantMap Transaction::toVariant()
 
 
 
+void Transaction::writeJson(PPJsonWriter *writer, QLatin1String name)
+{
+    Q_D(Transaction);
+
+    writer->beginObject(name);
+
+    d->writeString(writer, QLatin1String("reference_id"), referenceId(), 256);
+    if (amount()) {
+        amount()->writeJson(writer, QLatin1String("amount"));
+    }
+    d->writeString(writer, QLatin1String("description"), description(), 127);
+    d->writeString(writer, QLatin1String("note_to_payee"), noteToPayee(), 255);
+    d->writeString(writer, QLatin1String("custom"), custom(), 127);
+    d->writeString(writer, QLatin1String("invoice_number"), invoiceNumber(), 127);
+    d->writeString(writer, QLatin1String("soft_descriptor"), softDescriptor(), 22);
+    if (paymentOptions()) {
+        paymentOptions()->writeJson(writer, QLatin1String("payment_options"));
+    }
+    if (itemList()) {
+        itemList()->writeJson(writer, QLatin1String("item_list"));
+    }
+    d->writeString(writer, QLatin1String("notify_url"), notifyUrl().toString(), 2048);
+    d->writeString(writer, QLatin1String("order_url"), orderUrl().toString(), 2048);
+
+    writer->endObject();
+}
+
+
+
 
 QJsonObject Transaction::toJsonObject()
 {
@@ -447,16 +487,67 @@ void Transaction::loadFromJson(const QJsonDocument &json)
 
 
 void Transaction::loadFromJson(const QJsonObject &json)
+{
+    loadFromJson(PPJsonValue(json));
+}
+
+
+namespace {
+
+// keep in the same order as transactionFields
+enum TransactionField {
+    TransactionFieldAmount,
+    TransactionFieldCustom,
+    TransactionFieldDescription,
+    TransactionFieldInvoiceNumber,
+    TransactionFieldItemList,
+    TransactionFieldNoteToPayee,
+    TransactionFieldNotifyUrl,
+    TransactionFieldOrderUrl,
+    TransactionFieldPayee,
+    TransactionFieldPaymentOptions,
+    TransactionFieldReferenceId,
+    TransactionFieldRelatedResources,
+    TransactionFieldSoftDescriptor,
+    TransactionFieldCount
+};
+
+constexpr PPJsonField transactionFields[] = {
+    PPJsonField("amount"),
+    PPJsonField("custom"),
+    PPJsonField("description"),
+    PPJsonField("invoice_number"),
+    PPJsonField("item_list"),
+    PPJsonField("note_to_payee"),
+    PPJsonField("notify_url"),
+    PPJsonField("order_url"),
+    PPJsonField("payee"),
+    PPJsonField("payment_options"),
+    PPJsonField("reference_id"),
+    PPJsonField("related_resources"),
+    PPJsonField("soft_descriptor")
+};
+
+Q_STATIC_ASSERT(sizeof(transactionFields) / sizeof(PPJsonField) == TransactionFieldCount);
+
+}
+
+
+void Transaction::loadFromJson(const PPJsonValue &json)
 {
     if (json.isEmpty()) {
         return;
     }
 
+    const PPJsonFields<TransactionFieldCount> f(json, transactionFields);
+
+    PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+
     Q_D(Transaction);
 
-    setReferenceId(json.value(QStringLiteral("reference_id")).toString());
+    setReferenceId(f[TransactionFieldReferenceId].toString());
 
-    const QJsonObject ao = json.value(QStringLiteral("amount")).toObject();
+    const PPJsonValue ao = f[TransactionFieldAmount].toObject();
     PaymentAmount *oldAo = amount();
     if (!ao.isEmpty()) {
         if (oldAo) {
@@ -469,17 +560,17 @@ void Transaction::loadFromJson(const QJsonObject &json)
         delete oldAo;
     }
 
-    setDescription(json.value(QStringLiteral("description")).toString());
+    setDescription(f[TransactionFieldDescription].toString());
 
-    setNoteToPayee(json.value(QStringLiteral("note_to_payee")).toString());
+    setNoteToPayee(f[TransactionFieldNoteToPayee].toString());
 
-    setCustom(json.value(QStringLiteral("custom")).toString());
+    setCustom(f[TransactionFieldCustom].toString());
 
-    setInvoiceNumber(json.value(QStringLiteral("invoice_number")).toString());
+    setInvoiceNumber(f[TransactionFieldInvoiceNumber].toString());
 
-    setSoftDescriptor(json.value(QStringLiteral("soft_descriptor")).toString());
+    setSoftDescriptor(f[TransactionFieldSoftDescriptor].toString());
 
-    const QJsonObject poo = json.value(QStringLiteral("payment_options")).toObject();
+    const PPJsonValue poo = f[TransactionFieldPaymentOptions].toObject();
     PaymentOptions *oldPoo = paymentOptions();
     if (!poo.isEmpty()) {
         if (oldPoo) {
@@ -492,7 +583,7 @@ void Transaction::loadFromJson(const QJsonObject &json)
         delete oldPoo;
     }
 
-    const QJsonObject ilo = json.value(QStringLiteral("item_list")).toObject();
+    const PPJsonValue ilo = f[TransactionFieldItemList].toObject();
     ItemList *oldIlo = itemList();
     if (!ilo.isEmpty()) {
         if (oldIlo) {
@@ -505,24 +596,18 @@ void Transaction::loadFromJson(const QJsonObject &json)
         delete oldIlo;
     }
 
-    setNotifyUrl(QUrl(json.value(QStringLiteral("notify_url")).toString()));
+    setNotifyUrl(QUrl(f[TransactionFieldNotifyUrl].toString()));
 
-    setOrderUrl(QUrl(json.value(QStringLiteral("order_url")).toString()));
+    setOrderUrl(QUrl(f[TransactionFieldOrderUrl].toString()));
 
-    const QJsonArray rs = json.value(QStringLiteral("related_resources")).toArray();
-    d->clear();
-    if (!rs.isEmpty()) {
-        beginInsertRows(QModelIndex(), 0, rs.count() - 1);
-        QJsonArray::const_iterator i = rs.constBegin();
-        while (i != rs.constEnd()) {
-            d->relatedResources.append(new Related(i->toObject(), this));
-            ++i;
-        }
-        endInsertRows();
+    const PPJsonValue rs = f[TransactionFieldRelatedResources].toArray();
+    {
+        const PPLoadScope::Unblocked unblocked(&scope);
+        d->reloadRelatedResources(rs);
     }
     Q_EMIT relatedResourcesChanged(relatedResources());
 
-    const QJsonObject pyo = json.value(QStringLiteral("payee")).toObject();
+    const PPJsonValue pyo = f[TransactionFieldPayee].toObject();
     Payee *oldPyo = payee();
     if (!pyo.isEmpty()) {
         if (oldPyo) {
@@ -535,3 +620,64 @@ void Transaction::loadFromJson(const QJsonObject &json)
         delete oldPyo;
     }
 }
+
+
+
+TransactionValue Transaction::toValue() const
+{
+    TransactionValue v;
+
+    v.setReferenceId(referenceId());
+
+    if (amount()) {
+        v.setAmount(amount()->toValue());
+    }
+
+    v.setDescription(description());
+    v.setNoteToPayee(noteToPayee());
+    v.setCustom(custom());
+    v.setInvoiceNumber(invoiceNumber());
+    v.setSoftDescriptor(softDescriptor());
+
+    const ItemList *il = itemList();
+    if (il) {
+        const QList<Item*> is = il->items();
+        if (!is.isEmpty()) {
+            QList<ItemValue> ivs;
+            ivs.reserve(is.size());
+            for (const Item *i : is) {
+                ivs.append(i->toValue());
+            }
+            v.setItems(ivs);
+        }
+        if (il->shippingAddress()) {
+            v.setShippingAddress(il->shippingAddress()->toValue());
+        }
+        v.setShippingMethod(il->shippingMethod());
+        v.setShippingPhoneNumber(il->shippingPhoneNumber());
+    }
+
+    v.setNotifyUrl(notifyUrl());
+    v.setOrderUrl(orderUrl());
+
+    const QList<Related*> rs = relatedResources();
+    if (!rs.isEmpty()) {
+        QList<RelatedResourceValue> rvs;
+        rvs.reserve(rs.size());
+        for (const Related *r : rs) {
+            rvs.append(r->toValue());
+        }
+        v.setRelatedResources(rvs);
+    }
+
+    if (payee()) {
+        v.setPayeeEmail(payee()->email());
+        v.setPayeeMerchantId(payee()->merchantId());
+    }
+
+    if (paymentOptions()) {
+        v.setAllowedPaymentMethod(paymentOptions()->allowedPaymentMethod());
+    }
+
+    return v;
+}
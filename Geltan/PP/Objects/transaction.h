@@ -26,11 +26,14 @@
 #include <QUrl>
 #include <QAbstractListModel>
 #include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
 
 namespace Geltan {
 namespace PP {
 
 class TransactionPrivate;
+class PPJsonWriter;
+class TransactionValue;
 class Item;
 class PaymentAmount;
 class PaymentOptions;
@@ -213,6 +216,11 @@ public:
      */
     Transaction(const QJsonObject &json, QObject *parent = nullptr);
 
+    /*!
+     * \brief Constructs a new Transaction object from a value of a PPJsonDocument.
+     */
+    Transaction(const PPJsonValue &json, QObject *parent = nullptr);
+
     /*!
      * \brief Deconstructs the Transaction object.
      */
@@ -319,6 +327,14 @@ public:
      */
     QVariantMap toVariant();
 
+    /*!
+     * \brief Writes the object's data members as JSON object into \a writer.
+     *
+     * Writes the same content as toVariant() without building a QVariantMap. If \a name is not null,
+     * the object will be written as member \a name of the current object.
+     */
+    void writeJson(PPJsonWriter *writer, QLatin1String name = QLatin1String());
+
     /*!
      * \brief Returns a QJsonObject containing the object's data members.
      *
@@ -336,6 +352,18 @@ public:
      */
     void loadFromJson(const QJsonObject &json);
 
+    /*!
+     * \brief Loads data from a value of a PPJsonDocument into the Transaction object.
+     *
+     * Values from an on-demand index are read directly from the reply data, without creating a QJsonObject.
+     */
+    void loadFromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns an implicitly shared TransactionValue containing the transaction data, including the read only members.
+     */
+    TransactionValue toValue() const;
+
 
 
 Q_SIGNALS:
@@ -23,6 +23,12 @@
 #define TRANSACTION_P_H
 
 #include "transaction.h"
+#include "related.h"
+#include "sale.h"
+#include "authorization.h"
+#include "order.h"
+#include "capture.h"
+#include "refund.h"
 #include "ppobjectsbase_p.h"
 
 namespace Geltan {
@@ -58,6 +64,98 @@ public:
         }
     }
 
+    /*!
+     * \internal
+     * \brief Returns the ID of the resource contained in \a r.
+     */
+    static QString relatedId(const Related *r)
+    {
+        if (r->sale()) {
+            return r->sale()->id();
+        } else if (r->authorization()) {
+            return r->authorization()->id();
+        } else if (r->order()) {
+            return r->order()->id();
+        } else if (r->capture()) {
+            return r->capture()->id();
+        } else if (r->refund()) {
+            return r->refund()->id();
+        } else {
+            return QString();
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Returns the ID of the resource contained in the related resource JSON object \a json.
+     */
+    static QString relatedId(const PPJsonValue &json)
+    {
+        PPJsonValue::const_iterator i = json.constBegin();
+        if (i != json.constEnd()) {
+            return i->value(QLatin1String("id")).toString();
+        } else {
+            return QString();
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Reconciles the related resources with the data in \a rs.
+     *
+     * Related resources are matched by the ID of the contained resource. The leading resources
+     * whose IDs match are reloaded in place, the rest of the old rows is removed and the rest of
+     * the new data is inserted. As new resources like refunds are appended by the API, a refresh
+     * usually only reloads the existing rows and inserts the new ones.
+     */
+    void reloadRelatedResources(const PPJsonValue &rs)
+    {
+        Q_Q(Transaction);
+
+        const int rsCount = rs.count();
+        const int common = qMin(relatedResources.count(), rsCount);
+        int reused = 0;
+
+        PPJsonValue::const_iterator it = rs.constBegin();
+        while (reused < common) {
+            const PPJsonValue o = it->toObject();
+            Related *r = relatedResources.at(reused);
+            if (relatedId(r) != relatedId(o)) {
+                break;
+            }
+            const void *oldSale = r->sale();
+            const void *oldAuthorization = r->authorization();
+            const void *oldOrder = r->order();
+            const void *oldCapture = r->capture();
+            const void *oldRefund = r->refund();
+            r->loadFromJson(o);
+            if (r->sale() != oldSale || r->authorization() != oldAuthorization || r->order() != oldOrder || r->capture() != oldCapture || r->refund() != oldRefund) {
+                const QModelIndex idx = q->index(reused);
+                Q_EMIT q->dataChanged(idx, idx);
+            }
+            ++reused;
+            ++it;
+        }
+
+        if (reused < relatedResources.count()) {
+            q->beginRemoveRows(QModelIndex(), reused, relatedResources.count() - 1);
+            const QList<Related*> surplus = relatedResources.mid(reused);
+            relatedResources.erase(relatedResources.begin() + reused, relatedResources.end());
+            qDeleteAll(surplus);
+            q->endRemoveRows();
+        }
+
+        if (reused < rsCount) {
+            q->beginInsertRows(QModelIndex(), reused, rsCount - 1);
+            relatedResources.reserve(rsCount);
+            while (it != rs.constEnd()) {
+                relatedResources.append(new Related(it->toObject(), q));
+                ++it;
+            }
+            q->endInsertRows();
+        }
+    }
+
     Transaction * const q_ptr;
     Q_DECLARE_PUBLIC(Transaction)
     QString referenceId;
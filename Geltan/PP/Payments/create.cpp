@@ -21,12 +21,8 @@
 
 #include "create_p.h"
 #include <Geltan/PP/Objects/payer.h>
-#include <Geltan/PP/Objects/redirecturls.h>
-#include <Geltan/PP/Objects/transaction.h>
-#include <Geltan/PP/Objects/itemlist.h>
-#include <Geltan/PP/Objects/item.h>
-#include <Geltan/PP/Objects/paymentamount.h>
-#include <Geltan/PP/Objects/details.h>
+#include <Geltan/PP/ppjsonwriter.h>
+#include "paymentvalidator.h"
 #include <QJsonObject>
 #include <QJsonArray>
 
@@ -36,8 +32,6 @@ using namespace Payments;
 
 Create::Create(QObject *parent) : PPBase(*new CreatePrivate, parent)
 {
-    Q_D(Create);
-    d->payment = nullptr;
     setApiPath(QStringLiteral("/v1/payments/payment"));
     setNetworkOperation(QNetworkAccessManager::PostOperation);
     setExpectedType(PPBase::Object);
@@ -54,6 +48,8 @@ Create::Create(CreatePrivate &dd, QObject *parent) : PPBase(dd, parent)
 
 void Create::call()
 {
+    Q_D(Create);
+
     if (!payment()) {
         setError(new Error(Error::InputError, tr("No valid payment data available."), Error::Critical, QString(), this));
         return;
@@ -63,7 +59,34 @@ void Create::call()
     setInOperation(true);
     setAuthentication();
 
-    setPayload(payment()->toJson());
+    d->fromTemplate = false;
+
+    PPJsonWriter writer;
+    payment()->writeJson(&writer);
+    setPayload(writer.data());
+
+    sendRequest();
+}
+
+
+
+void Create::call(const PaymentTemplate &paymentTemplate, const PaymentTemplate::Values &values)
+{
+    Q_D(Create);
+
+    QString err;
+    if (!paymentTemplate.check(values, &err)) {
+        setError(new Error(Error::InputError, err, Error::Critical, QString(), this));
+        return;
+    }
+
+    setError(nullptr);
+    setInOperation(true);
+    setAuthentication();
+
+    d->fromTemplate = true;
+
+    setPayload(paymentTemplate.render(values));
 
     sendRequest();
 }
@@ -72,10 +95,18 @@ void Create::call()
 
 void Create::successCallBack()
 {
-    if (payment()) {
-        payment()->loadFromJson(jsonResult());
+    Q_D(Create);
+
+    if (d->fromTemplate) {
+        // the current payment is often the skeleton of the template, it must not be overwritten
+        Payment *oldResult = (d->templateResult && d->templateResult == payment()) ? d->templateResult.data() : nullptr;
+        d->templateResult = new Payment(jsonData().root(), this);
+        setPayment(d->templateResult);
+        delete oldResult;
+    } else if (payment()) {
+        payment()->loadFromJson(jsonData().root());
     } else {
-        setPayment(new Payment(jsonResult(), this));
+        setPayment(new Payment(jsonData().root(), this));
     }
 
     setInOperation(false);
@@ -96,7 +127,7 @@ bool Create::checkInput()
 {
     Q_D(Create);
 
-    if (!d->payment) {
+    if (!d->fromTemplate && !d->payment) {
         setError(new Error(Error::InputError, tr("No valid payment data available."), Error::Critical, QString(), this));
         return false;
     }
@@ -111,144 +142,17 @@ bool Create::checkInput()
         return false;
     }
 
-    if (d->payment->intent() == Payment::NoIntent) {
-        setError(new Error(Error::InputError, tr("No valid payment intent set."), Error::Critical, QString(), this));
-        return false;
-    }
-
-    if (!d->payment->payer()) {
-        setError(new Error(Error::InputError, tr("No valid Payer object available on the Payment object."), Error::Critical, QString(), this));
-        return false;
+    // templates are validated when compiled and filled
+    if (d->fromTemplate) {
+        return true;
     }
 
-    const QList<Transaction*> trs = d->payment->transactions();
-    if (trs.isEmpty()) {
-        setError(new Error(Error::InputError, tr("You have to specify at least one transaction with total amount, currency and description."), Error::Critical, QString(), this));
+    const PaymentValidator::Issues issues = PaymentValidator::validate(d->payment, true);
+    if (!issues.isEmpty()) {
+        setError(new Error(Error::InputError, issues.first().message, Error::Critical, QString(), this));
         return false;
     }
 
-    if ((d->payment->intent() == Payment::Sale) && (d->payment->payer()->paymentMethod() == PayPal::PayPalWallet)) {
-
-        if (!d->payment->redirectUrls()) {
-            setError(new Error(Error::InputError, tr("In order to accept a PayPal payment, you have to provide valid redirect URLs."), Error::Critical, QString(), this));
-            return false;
-        }
-
-        if (!d->payment->redirectUrls()->isValid()) {
-            setError(new Error(Error::InputError, tr("In order to accept a PayPal payment, you have to provide valid redirect URLs."), Error::Critical, QString(), this));
-            return false;
-        }
-
-        for (Transaction *t : trs) {
-            if (!t->referenceId().isEmpty()) {
-                setError(new Error(Error::InputError, tr("Reference ID is not allowed when accepting PayPal payments."), Error::Critical, QString(), this));
-                return false;
-            }
-        }
-
-    }
-
-    if ((d->payment->intent() == Payment::Sale) && (d->payment->payer()->paymentMethod() == PayPal::CreditCard)) {
-
-        if (!d->payment->payer()->fundingInstruments().isEmpty()) {
-            setError(new Error(Error::InputError, tr("No valid credit card data available."), Error::Critical, QString(), this));
-            return false;
-        }
-
-    }
-
-    for (Transaction *t : trs) {
-
-        if (!t->amount()) {
-            setError(new Error(Error::InputError, tr("You have to specify the amount of the transaction."), Error::Critical, QString(), this));
-            return false;
-        }
-
-        if (!t->amount()->valid()) {
-            setError(new Error(Error::InputError, tr("The amount data is not valid. Maybe data is missing or the values do not sum up as expected."), Error::Critical, QString(), this));
-            return false;
-        }
-
-        if (t->amount()->details()) {
-            if (d->payment->payer()->paymentMethod() != PayPal::PayPalWallet) {
-                Details *det = t->amount()->details();
-                if (det->handlingFee() > 0.0f) {
-                    setError(new Error(Error::InputError, tr("Handling fees are only supported if the payment method is set to PayPal."), Error::Critical, QString(), this));
-                    return false;
-                }
-
-                if (det->shippingDiscount() > 0.0f) {
-                    setError(new Error(Error::InputError, tr("Shipping discount is only supported if the payment method is set to PayPal."), Error::Critical, QString(), this));
-                    return false;
-                }
-
-                if (det->insurance() > 0.0f) {
-                    setError(new Error(Error::InputError, tr("Insurance is only supported if the payment method is set to PayPal."), Error::Critical, QString(), this));
-                    return false;
-                }
-            }
-        }
-
-        if (t->itemList() && !t->itemList()->items().isEmpty()) {
-            const QList<Item*> its = t->itemList()->items();
-
-            if (!its.isEmpty()) {
-                float ilTotal = 0.0f; // total of all item price values
-                float ilTax = 0.0f; // total of all item tax values
-
-                for (Item *it : its) {
-
-                    if (it->quantity() < 1) {
-                        setError(new Error(Error::InputError, tr("Item quantity has to be more than one."), Error::Critical, QString(), this));
-                        return false;
-                    }
-
-                    if (it->currency() != t->amount()->currency()) {
-                        setError(new Error(Error::InputError, tr("Item currency codes should be the same as the transaction currency code in all buckets."), Error::Critical, QString(), this));
-                        return false;
-                    }
-
-                    if (d->payment->payer()->paymentMethod() != PayPal::PayPalWallet) {
-                        if (!it->description().isEmpty()) {
-                            setError(new Error(Error::InputError, tr("Item description is only allowed if the payment method is set to PayPal."), Error::Critical, QString(), this));
-                            return false;
-                        }
-
-                        if (it->tax() > 0.0f) {
-                            setError(new Error(Error::InputError, tr("Per item tax is only supported if the payment method is set to PayPal."), Error::Critical, QString(), this));
-                            return false;
-                        }
-                    }
-
-                    ilTotal += (it->price() * it->quantity());
-                    ilTax += (it->tax() * it->quantity());
-                }
-
-
-                if (!t->amount()->details() && ilTotal != t->amount()->total()) {
-                    setError(new Error(Error::InputError, tr("The sum of all item prices in a transaction has to be the same as the total amount of the transaction."), Error::Critical, QString(), this));
-                    return false;
-                }
-
-                if (t->amount()->details()) {
-                    if (t->amount()->details()->subtotal() > 0.0f) {
-                        if (ilTotal != t->amount()->details()->subtotal()) {
-                            setError(new Error(Error::InputError, tr("The sum of all item prices in a transaction has to be the same as the subtotal amount of the transaction."), Error::Critical, QString(), this));
-                            return false;
-                        }
-                    }
-
-                    if (t->amount()->details()->tax() > 0.0f) {
-                        if (ilTax != t->amount()->details()->tax()) {
-                            setError(new Error(Error::InputError, tr("The sum of all item tax values in a transaction has to be the same as the tax amount of the transaction."), Error::Critical, QString(), this));
-                            return false;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
     return true;
 }
 
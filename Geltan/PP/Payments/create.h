@@ -25,6 +25,7 @@
 #include <QObject>
 #include <Geltan/geltan_global.h>
 #include <Geltan/PP/ppbase.h>
+#include <Geltan/PP/Payments/paymenttemplate.h>
 
 namespace Geltan {
 namespace PP {
@@ -69,6 +70,18 @@ public:
      */
     Q_INVOKABLE void call();
 
+    /*!
+     * \brief Invokes the API call with the payload rendered from \a paymentTemplate and \a values.
+     *
+     * The \link Create::payment payment \endlink property is not used for the request. If the request was
+     * successful, a new Payment object will be created from the response and set as
+     * \link Create::payment payment \endlink, so the skeleton the template has been compiled from is not
+     * overwritten. The Payment created for the previous template request will be deleted.
+     *
+     * \sa PaymentTemplate
+     */
+    void call(const PaymentTemplate &paymentTemplate, const PaymentTemplate::Values &values);
+
     Payment *payment() const;
     void setPayment(Payment *nPayment);
 
@@ -25,6 +25,7 @@
 #include "create.h"
 #include "../ppbase_p.h"
 #include "../Objects/payment.h"
+#include <QPointer>
 
 namespace Geltan {
 namespace PP {
@@ -32,7 +33,14 @@ namespace Payments {
 
 class CreatePrivate : public PPBasePrivate {
 public:
+    CreatePrivate() :
+        payment(nullptr),
+        fromTemplate(false)
+    {}
+
     Payment *payment;
+    QPointer<Payment> templateResult;   // payment created for the last result of a template request
+    bool fromTemplate;
 };
 
 }
@@ -20,12 +20,10 @@
  */
 
 #include "execute_p.h"
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QUrl>
 #include <QUrlQuery>
 #include <Geltan/PP/Objects/paymentamount.h>
+#include <Geltan/PP/ppjsonwriter.h>
 
 using namespace Geltan;
 using namespace PP;
@@ -61,25 +59,28 @@ void Execute::call()
     setInOperation(true);
     setAuthentication();
 
-    QJsonObject root;
-    root.insert(QStringLiteral("payer_id"), QJsonValue(payerId()));
+    PPJsonWriter writer;
+    writer.beginObject();
+    writer.writeString(QLatin1String("payer_id"), payerId());
 
     if (!transactions().isEmpty()) {
-        QJsonArray trArr;
+        writer.beginArray(QLatin1String("transactions"));
         const QList<Transaction*> trs = transactions();
         for (Transaction *t : trs) {
             if (t->amount()) {
-                QJsonObject to;
-                to.insert(QStringLiteral("amount"), QJsonValue(t->amount()->toJsonObject()));
-                trArr.append(to);
+                writer.beginObject();
+                t->amount()->writeJson(&writer, QLatin1String("amount"));
+                writer.endObject();
             } else {
                 setError(new Error(Error::InputError, tr("In order to update a transaction, a PaymentAmount object has to be specified."), Error::Warning, QString(), this));
             }
         }
-        root.insert(QStringLiteral("transactions"), QJsonValue(trArr));
+        writer.endArray();
     }
 
-    setPayload(QJsonDocument(root).toJson());
+    writer.endObject();
+
+    setPayload(writer.data());
 
     sendRequest();
 }
@@ -112,9 +113,9 @@ void Execute::call(const QUrl &returnUrl)
 void Execute::successCallBack()
 {
     if (payment()) {
-        payment()->loadFromJson(jsonResult());
+        payment()->loadFromJson(jsonData().root());
     } else {
-        setPayment(new Payment(jsonResult(), this));
+        setPayment(new Payment(jsonData().root(), this));
     }
 
     setInOperation(false);
@@ -0,0 +1,413 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/export.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "export_p.h"
+#include "../ppenumsmap.h"
+#include "../Values/transactionvalue.h"
+#include "../Values/paymentamountvalue.h"
+#include "../Values/relatedresourcevalue.h"
+#include "../pptimestamp.h"
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+using namespace Payments;
+
+Export::Export(QObject *parent) : QObject(parent), d_ptr(new ExportPrivate(this))
+{
+}
+
+
+
+Export::~Export()
+{
+
+}
+
+
+
+
+void Export::start()
+{
+    Q_D(Export);
+
+    if (d->inOperation) {
+        return;
+    }
+
+    // PPListBase::paginate() ignores the request while the list is busy, the export would never finish then
+    if (!d->list || d->list->inOperation() || d->list->paginating() || !d->device || !d->device->isWritable()) {
+        Q_EMIT failed();
+        return;
+    }
+
+    d->exported = 0;
+    Q_EMIT exportedChanged(0);
+    d->writeFailed = false;
+    d->buffer.clear();
+    d->buffer.reserve(qMax(d->bufferSize, 0));
+
+    if ((d->format == Csv) && d->writeHeader) {
+        d->appendHeader();
+    }
+
+    d->succeededConnection = connect(d->list.data(), &List::succeeded, this, [d]() { d->finish(true); });
+    d->failedConnection = connect(d->list.data(), &List::failed, this, [d]() { d->finish(false); });
+
+    d->inOperation = true;
+    Q_EMIT inOperationChanged(true);
+
+    // the list might outlive the export, so stop the pagination if the export has been destroyed
+    const QPointer<Export> guard(this);
+    d->list->paginate([guard](const PPJsonValue &page) -> bool {
+        return guard ? guard->d_func()->consumePage(page) : false;
+    });
+}
+
+
+
+
+QVector<ExportPrivate::Row> ExportPrivate::flatten(const PaymentValue &payment)
+{
+    Row base;
+    base.id = payment.id();
+    base.state = PPEnumsMap::paymentStateEnumToToken(payment.state());
+    base.intent = PPEnumsMap::paymentIntentEnumToToken(payment.intent());
+
+    if (payment.createTimeMSecs() != PPTimestamp::Invalid) {
+        base.createTime = PPTimestamp::format(payment.createTimeMSecs());
+    }
+
+    if (payment.updateTimeMSecs() != PPTimestamp::Invalid) {
+        base.updateTime = PPTimestamp::format(payment.updateTimeMSecs());
+    }
+
+    // amounts in different currencies can not be summed up, so every currency gets its own row
+    QVector<Row> rows;
+
+    const QList<TransactionValue> ts = payment.transactions();
+    for (const TransactionValue &t : ts) {
+        const PaymentAmountValue a = t.amount();
+
+        Row *row = nullptr;
+        for (Row &r : rows) {
+            if (r.currency == a.currency()) {
+                row = &r;
+                break;
+            }
+        }
+        if (!row) {
+            rows.append(base);
+            row = &rows.last();
+            row->currency = a.currency();
+        }
+
+        row->total += a.totalMoney();
+
+        const QList<RelatedResourceValue> rs = t.relatedResources();
+        for (const RelatedResourceValue &r : rs) {
+            if (r.type() == RelatedResourceValue::Sale) {
+                row->saleIds.append(r.id());
+            } else if (r.type() == RelatedResourceValue::Refund) {
+                row->refundIds.append(r.id());
+            }
+        }
+    }
+
+    if (rows.isEmpty()) {
+        rows.append(base);
+    }
+
+    return rows;
+}
+
+
+
+QByteArray ExportPrivate::csvField(const QString &value)
+{
+    QByteArray f = value.toUtf8();
+    if (f.contains(',') || f.contains('"') || f.contains('\n') || f.contains('\r')) {
+        f.replace('"', QByteArrayLiteral("\"\""));
+        f.prepend('"');
+        f.append('"');
+    }
+    return f;
+}
+
+
+
+void ExportPrivate::appendHeader()
+{
+    QList<QByteArray> names;
+    if (columns.testFlag(Export::Id)) { names.append(QByteArrayLiteral("id")); }
+    if (columns.testFlag(Export::State)) { names.append(QByteArrayLiteral("state")); }
+    if (columns.testFlag(Export::Intent)) { names.append(QByteArrayLiteral("intent")); }
+    if (columns.testFlag(Export::Total)) { names.append(QByteArrayLiteral("total")); }
+    if (columns.testFlag(Export::Currency)) { names.append(QByteArrayLiteral("currency")); }
+    if (columns.testFlag(Export::SaleIds)) { names.append(QByteArrayLiteral("sale_ids")); }
+    if (columns.testFlag(Export::RefundIds)) { names.append(QByteArrayLiteral("refund_ids")); }
+    if (columns.testFlag(Export::CreateTime)) { names.append(QByteArrayLiteral("create_time")); }
+    if (columns.testFlag(Export::UpdateTime)) { names.append(QByteArrayLiteral("update_time")); }
+
+    for (int i = 0; i < names.count(); ++i) {
+        if (i > 0) {
+            buffer.append(',');
+        }
+        buffer.append(names.at(i));
+    }
+    buffer.append("\r\n");
+}
+
+
+
+void ExportPrivate::appendRow(const Row &row)
+{
+    const QString total = row.total.toString(Money::currencyDecimals(row.currency));
+
+    if (format == Export::Csv) {
+
+        QList<QByteArray> fields;
+        if (columns.testFlag(Export::Id)) { fields.append(csvField(row.id)); }
+        if (columns.testFlag(Export::State)) { fields.append(csvField(row.state)); }
+        if (columns.testFlag(Export::Intent)) { fields.append(csvField(row.intent)); }
+        if (columns.testFlag(Export::Total)) { fields.append(total.toLatin1()); }
+        if (columns.testFlag(Export::Currency)) { fields.append(csvField(row.currency)); }
+        if (columns.testFlag(Export::SaleIds)) { fields.append(csvField(row.saleIds.join(QLatin1Char(' ')))); }
+        if (columns.testFlag(Export::RefundIds)) { fields.append(csvField(row.refundIds.join(QLatin1Char(' ')))); }
+        if (columns.testFlag(Export::CreateTime)) { fields.append(csvField(row.createTime)); }
+        if (columns.testFlag(Export::UpdateTime)) { fields.append(csvField(row.updateTime)); }
+
+        for (int i = 0; i < fields.count(); ++i) {
+            if (i > 0) {
+                buffer.append(',');
+            }
+            buffer.append(fields.at(i));
+        }
+        buffer.append("\r\n");
+
+    } else {
+
+        QJsonObject o;
+        if (columns.testFlag(Export::Id)) { o.insert(QStringLiteral("id"), row.id); }
+        if (columns.testFlag(Export::State)) { o.insert(QStringLiteral("state"), row.state); }
+        if (columns.testFlag(Export::Intent)) { o.insert(QStringLiteral("intent"), row.intent); }
+        if (columns.testFlag(Export::Total)) { o.insert(QStringLiteral("total"), total); }
+        if (columns.testFlag(Export::Currency)) { o.insert(QStringLiteral("currency"), row.currency); }
+        if (columns.testFlag(Export::SaleIds)) { o.insert(QStringLiteral("sale_ids"), QJsonArray::fromStringList(row.saleIds)); }
+        if (columns.testFlag(Export::RefundIds)) { o.insert(QStringLiteral("refund_ids"), QJsonArray::fromStringList(row.refundIds)); }
+        if (columns.testFlag(Export::CreateTime)) { o.insert(QStringLiteral("create_time"), row.createTime); }
+        if (columns.testFlag(Export::UpdateTime)) { o.insert(QStringLiteral("update_time"), row.updateTime); }
+
+        buffer.append(QJsonDocument(o).toJson(QJsonDocument::Compact));
+        buffer.append('\n');
+    }
+}
+
+
+
+bool ExportPrivate::consumePage(const PPJsonValue &page)
+{
+    Q_Q(Export);
+
+    if (writeFailed) {
+        return false;
+    }
+
+    const PPJsonValue ps = page.value(QLatin1String("payments"));
+
+    for (const PPJsonValue &p : ps) {
+        const QVector<Row> rows = flatten(PaymentValue::fromJson(p));
+        for (const Row &row : rows) {
+            appendRow(row);
+        }
+        if ((buffer.size() >= bufferSize) && !flush()) {
+            return false;
+        }
+    }
+
+    if (!flush()) {
+        return false;
+    }
+
+    exported += ps.count();
+    Q_EMIT q->exportedChanged(exported);
+
+    return true;
+}
+
+
+
+bool ExportPrivate::flush()
+{
+    if (buffer.isEmpty()) {
+        return true;
+    }
+
+    if (!device || device->write(buffer) != buffer.size()) {
+#ifdef QT_DEBUG
+        qDebug() << "Failed to write exported payments:" << (device ? device->errorString() : QString());
+#endif
+        writeFailed = true;
+        buffer.clear();
+        return false;
+    }
+
+    buffer.clear();
+    return true;
+}
+
+
+
+void ExportPrivate::finish(bool success)
+{
+    Q_Q(Export);
+
+    QObject::disconnect(succeededConnection);
+    QObject::disconnect(failedConnection);
+
+    const bool flushed = flush();
+
+    // release the memory of the buffer
+    buffer = QByteArray();
+
+    inOperation = false;
+    Q_EMIT q->inOperationChanged(false);
+
+    if (success && flushed && !writeFailed) {
+        Q_EMIT q->finished();
+    } else {
+        Q_EMIT q->failed();
+    }
+}
+
+
+
+
+List *Export::list() const { Q_D(const Export); return d->list.data(); }
+
+void Export::setList(List *nList)
+{
+    Q_D(Export);
+    if (nList != d->list) {
+        d->list = nList;
+#ifdef QT_DEBUG
+        qDebug() << "Changed list to" << d->list;
+#endif
+        Q_EMIT listChanged(list());
+    }
+}
+
+
+
+
+QIODevice *Export::device() const { Q_D(const Export); return d->device.data(); }
+
+void Export::setDevice(QIODevice *nDevice)
+{
+    Q_D(Export);
+    if (nDevice != d->device) {
+        d->device = nDevice;
+#ifdef QT_DEBUG
+        qDebug() << "Changed device to" << d->device;
+#endif
+        Q_EMIT deviceChanged(device());
+    }
+}
+
+
+
+
+Export::Format Export::format() const { Q_D(const Export); return d->format; }
+
+void Export::setFormat(Format nFormat)
+{
+    Q_D(Export);
+    if (nFormat != d->format) {
+        d->format = nFormat;
+#ifdef QT_DEBUG
+        qDebug() << "Changed format to" << d->format;
+#endif
+        Q_EMIT formatChanged(format());
+    }
+}
+
+
+
+
+Export::Columns Export::columns() const { Q_D(const Export); return d->columns; }
+
+void Export::setColumns(Columns nColumns)
+{
+    Q_D(Export);
+    if (nColumns != d->columns) {
+        d->columns = nColumns;
+#ifdef QT_DEBUG
+        qDebug() << "Changed columns to" << d->columns;
+#endif
+        Q_EMIT columnsChanged(columns());
+    }
+}
+
+
+
+
+int Export::bufferSize() const { Q_D(const Export); return d->bufferSize; }
+
+void Export::setBufferSize(int nBufferSize)
+{
+    Q_D(Export);
+    if (nBufferSize != d->bufferSize) {
+        d->bufferSize = nBufferSize;
+#ifdef QT_DEBUG
+        qDebug() << "Changed bufferSize to" << d->bufferSize;
+#endif
+        Q_EMIT bufferSizeChanged(bufferSize());
+    }
+}
+
+
+
+
+bool Export::writeHeader() const { Q_D(const Export); return d->writeHeader; }
+
+void Export::setWriteHeader(bool nWriteHeader)
+{
+    Q_D(Export);
+    if (nWriteHeader != d->writeHeader) {
+        d->writeHeader = nWriteHeader;
+#ifdef QT_DEBUG
+        qDebug() << "Changed writeHeader to" << d->writeHeader;
+#endif
+        Q_EMIT writeHeaderChanged(writeHeader());
+    }
+}
+
+
+
+
+int Export::exported() const { Q_D(const Export); return d->exported; }
+
+bool Export::inOperation() const { Q_D(const Export); return d->inOperation; }
@@ -0,0 +1,264 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/export.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXPORTPAYMENTS_H
+#define EXPORTPAYMENTS_H
+
+#include <QObject>
+#include "../../geltan_global.h"
+
+class QIODevice;
+
+namespace Geltan {
+namespace PP {
+namespace Payments {
+
+class List;
+class ExportPrivate;
+
+/*!
+ * \brief Writes the payments returned by a List operation as flattened rows to a QIODevice.
+ *
+ * Export uses the paginator of the \link Export::list list \endlink operation to request one
+ * page after the other. Every page is converted into rows as soon as it has been received and
+ * the rows are written through a buffer of \link Export::bufferSize bufferSize \endlink bytes
+ * to the \link Export::device device \endlink. Neither the pages nor the rows are kept in
+ * memory, so the memory usage is constant regardless of the number of exported payments.
+ *
+ * The rows can be written as newline delimited JSON, one compact JSON object per line, or as
+ * comma separated values. The exported \link Export::columns columns \endlink are configurable.
+ *
+ * \code{.cpp}
+ * QFile *file = new QFile(QStringLiteral("payments.csv"), this);
+ * file->open(QIODevice::WriteOnly);
+ *
+ * Geltan::PP::Payments::List *list = new Geltan::PP::Payments::List(this);
+ * list->setToken(token);
+ * list->setStartTime(start);
+ * list->setEndTime(end);
+ *
+ * Geltan::PP::Payments::Export *exp = new Geltan::PP::Payments::Export(this);
+ * exp->setList(list);
+ * exp->setDevice(file);
+ * exp->setFormat(Geltan::PP::Payments::Export::Csv);
+ * exp->start();
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Payments/export.h>
+ */
+class GELTANSHARED_EXPORT Export : public QObject
+{
+    Q_OBJECT
+    /*!
+     * \brief The list operation used to request the payments.
+     *
+     * Filter and sort settings of the operation are used. The Export does not take ownership of it.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>List*</TD><TD>list() const</TD></TR><TR><TD>void</TD><TD>setList(List *nList)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>listChanged(List *list)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::Payments::List *list READ list WRITE setList NOTIFY listChanged)
+    /*!
+     * \brief The device the rows are written to. Has to be opened for writing.
+     *
+     * The Export does not take ownership of the device.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QIODevice*</TD><TD>device() const</TD></TR><TR><TD>void</TD><TD>setDevice(QIODevice *nDevice)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>deviceChanged(QIODevice *device)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QIODevice *device READ device WRITE setDevice NOTIFY deviceChanged)
+    /*!
+     * \brief The output format. Default: Export::NDJson
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Format</TD><TD>format() const</TD></TR><TR><TD>void</TD><TD>setFormat(Format nFormat)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>formatChanged(Format format)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Format format READ format WRITE setFormat NOTIFY formatChanged)
+    /*!
+     * \brief The columns to export. Default: Export::AllColumns
+     *
+     * The columns are always written in the order of the Column enumeration.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Columns</TD><TD>columns() const</TD></TR><TR><TD>void</TD><TD>setColumns(Columns nColumns)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>columnsChanged(Columns columns)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Columns columns READ columns WRITE setColumns NOTIFY columnsChanged)
+    /*!
+     * \brief Number of bytes that are collected before they are written to the device. The default is \a 65536.
+     *
+     * The buffer is also written at the end of every page.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>bufferSize() const</TD></TR><TR><TD>void</TD><TD>setBufferSize(int nBufferSize)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>bufferSizeChanged(int bufferSize)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int bufferSize READ bufferSize WRITE setBufferSize NOTIFY bufferSizeChanged)
+    /*!
+     * \brief If true, a header line with the column names will be written in CSV format. The default is \a true.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>writeHeader() const</TD></TR><TR><TD>void</TD><TD>setWriteHeader(bool nWriteHeader)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>writeHeaderChanged(bool writeHeader)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool writeHeader READ writeHeader WRITE setWriteHeader NOTIFY writeHeaderChanged)
+    /*!
+     * \brief The number of payments written by the current or last export.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>exported() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>exportedChanged(int exported)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int exported READ exported NOTIFY exportedChanged)
+    /*!
+     * \brief Returns true while an export is running.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>inOperation() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>inOperationChanged(bool inOperation)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool inOperation READ inOperation NOTIFY inOperationChanged)
+public:
+    /*!
+     * \brief The output formats.
+     */
+    enum Format {
+        NDJson  = 0,    /**< Newline delimited JSON, one object per payment and currency. */
+        Csv     = 1     /**< Comma separated values as described in RFC 4180. */
+    };
+#if QT_VERSION >= QT_VERSION_CHECK(5, 5, 0)
+    Q_ENUM(Format)
+#else
+    Q_ENUMS(Format)
+#endif
+
+    /*!
+     * \brief The exportable columns.
+     *
+     * The names in brackets are used as CSV header and as JSON keys.
+     */
+    enum Column {
+        NoColumn    = 0x000,    /**< No column. */
+        Id          = 0x001,    /**< The ID of the payment (id). */
+        State       = 0x002,    /**< The state of the payment (state). */
+        Intent      = 0x004,    /**< The intent of the payment (intent). */
+        Total       = 0x008,    /**< The sum of the totals of all transactions in the currency of the row (total). */
+        Currency    = 0x010,    /**< The currency of the row, payments with transactions in different currencies get one row per currency (currency). */
+        SaleIds     = 0x020,    /**< The IDs of all sales, separated by spaces in CSV (sale_ids). */
+        RefundIds   = 0x040,    /**< The IDs of all refunds, separated by spaces in CSV (refund_ids). */
+        CreateTime  = 0x080,    /**< The creation time of the payment (create_time). */
+        UpdateTime  = 0x100,    /**< The last update time of the payment (update_time). */
+        AllColumns  = 0x1ff     /**< All columns. */
+    };
+    Q_DECLARE_FLAGS(Columns, Column)
+#if QT_VERSION >= QT_VERSION_CHECK(5, 5, 0)
+    Q_FLAG(Columns)
+#else
+    Q_FLAGS(Columns)
+#endif
+
+    /*!
+     * \brief Constructs a new Export object.
+     */
+    explicit Export(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the Export object.
+     */
+    ~Export();
+
+    /*!
+     * \brief Starts the export.
+     *
+     * Emits failed() immediately if no list or no writable device is set or if the list is
+     * currently in operation or paginating.
+     */
+    Q_INVOKABLE void start();
+
+    List *list() const;
+    QIODevice *device() const;
+    Format format() const;
+    Columns columns() const;
+    int bufferSize() const;
+    bool writeHeader() const;
+    int exported() const;
+    bool inOperation() const;
+
+    void setList(List *nList);
+    void setDevice(QIODevice *nDevice);
+    void setFormat(Format nFormat);
+    void setColumns(Columns nColumns);
+    void setBufferSize(int nBufferSize);
+    void setWriteHeader(bool nWriteHeader);
+
+Q_SIGNALS:
+    /*!
+     * \brief This signal will be emitted when all payments have been written.
+     */
+    void finished();
+
+    /*!
+     * \brief This signal will be emitted when a request or writing to the device failed.
+     *
+     * Use the error of the \link Export::list list \endlink and the error string of the
+     * \link Export::device device \endlink to get more information.
+     */
+    void failed();
+
+    void listChanged(List *list);
+    void deviceChanged(QIODevice *device);
+    void formatChanged(Format format);
+    void columnsChanged(Columns columns);
+    void bufferSizeChanged(int bufferSize);
+    void writeHeaderChanged(bool writeHeader);
+    void exportedChanged(int exported);
+    void inOperationChanged(bool inOperation);
+
+protected:
+    const QScopedPointer<ExportPrivate> d_ptr;
+
+private:
+    Q_DISABLE_COPY(Export)
+    Q_DECLARE_PRIVATE(Export)
+};
+
+}
+}
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Geltan::PP::Payments::Export::Columns)
+#if QT_VERSION < QT_VERSION_CHECK(5, 5, 0)
+Q_DECLARE_METATYPE(Geltan::PP::Payments::Export::Format)
+Q_DECLARE_METATYPE(Geltan::PP::Payments::Export::Columns)
+#endif
+
+#endif // EXPORTPAYMENTS_H
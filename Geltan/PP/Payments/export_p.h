@@ -0,0 +1,99 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/export_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXPORTPAYMENTS_P_H
+#define EXPORTPAYMENTS_P_H
+
+#include "export.h"
+#include "list.h"
+#include "../Values/paymentvalue.h"
+#include "../Values/money.h"
+#include <QPointer>
+#include <QIODevice>
+#include <QStringList>
+#include <QVector>
+
+namespace Geltan {
+namespace PP {
+namespace Payments {
+
+class ExportPrivate
+{
+public:
+    ExportPrivate(Export *parent) :
+        q_ptr(parent),
+        format(Export::NDJson),
+        columns(Export::AllColumns),
+        bufferSize(65536),
+        writeHeader(true),
+        exported(0),
+        inOperation(false),
+        writeFailed(false)
+    {}
+
+    ~ExportPrivate() {}
+
+    /*!
+     * \internal
+     * \brief The flattened values of a single payment in a single currency.
+     */
+    struct Row {
+        QString id;
+        QString state;
+        QString intent;
+        Money total;
+        QString currency;
+        QStringList saleIds;
+        QStringList refundIds;
+        QString createTime;
+        QString updateTime;
+    };
+
+    static QVector<Row> flatten(const PaymentValue &payment);
+    static QByteArray csvField(const QString &value);
+
+    void appendHeader();
+    void appendRow(const Row &row);
+    bool consumePage(const PPJsonValue &page);
+    bool flush();
+    void finish(bool success);
+
+    Export * const q_ptr;
+    Q_DECLARE_PUBLIC(Export)
+    QPointer<List> list;
+    QPointer<QIODevice> device;
+    Export::Format format;
+    Export::Columns columns;
+    int bufferSize;
+    bool writeHeader;
+    int exported;
+    bool inOperation;
+    bool writeFailed;
+    QByteArray buffer;
+    QMetaObject::Connection succeededConnection;
+    QMetaObject::Connection failedConnection;
+};
+
+}
+}
+}
+
+#endif // EXPORTPAYMENTS_P_H
@@ -20,6 +20,8 @@
  */
 
 #include "get_p.h"
+#include <QJsonObject>
+#include <QTimer>
 
 using namespace Geltan;
 using namespace PP;
@@ -29,6 +31,7 @@ Get::Get(QObject *parent) : PPBase(*new GetPrivate, parent)
 {
     Q_D(Get);
     d->payment = nullptr;
+    d->preferStore = false;
     setNetworkOperation(QNetworkAccessManager::GetOperation);
     setExpectedType(PPBase::Object);
     addRequestHeader(QByteArrayLiteral("Content-Type"), QByteArrayLiteral("application/json"));
@@ -59,6 +62,21 @@ void Get::call()
         }
     }
 
+    if (d->store && d->preferStore && !paymentId().isEmpty()) {
+        const QJsonObject stored = d->store->paymentJson(paymentId());
+        if (!stored.isEmpty()) {
+            // deliver the result asynchronously like a result from the API
+            QTimer::singleShot(0, this, [this, stored] () {
+                Q_D(Get);
+                d->payment = new Payment(stored, this);
+                Q_EMIT paymentChanged(payment());
+                setInOperation(false);
+                Q_EMIT succeeded();
+            });
+            return;
+        }
+    }
+
     setApiPath(QStringLiteral("/v1/payments/payment/%1").arg(paymentId()));
 
     sendRequest();
@@ -78,9 +96,13 @@ void Get::successCallBack()
 {
     Q_D(Get);
 
-    d->payment = new Payment(jsonResult(), this);
+    d->payment = new Payment(jsonData().root(), this);
     Q_EMIT paymentChanged(payment());
 
+    if (d->store) {
+        d->store->store(jsonResult().object());
+    }
+
     setInOperation(false);
     Q_EMIT succeeded();
 }
@@ -133,3 +155,34 @@ void Get::setPaymentId(const QString &nPaymentId)
 
 
 Payment *Get::payment() const { Q_D(const Get); return d->payment; }
+
+
+
+PaymentStore *Get::store() const { Q_D(const Get); return d->store.data(); }
+
+void Get::setStore(PaymentStore *nStore)
+{
+    Q_D(Get);
+    if (nStore != d->store) {
+        d->store = nStore;
+#ifdef QT_DEBUG
+        qDebug() << "Changed store to" << d->store;
+#endif
+        Q_EMIT storeChanged(store());
+    }
+}
+
+
+bool Get::preferStore() const { Q_D(const Get); return d->preferStore; }
+
+void Get::setPreferStore(bool nPreferStore)
+{
+    Q_D(Get);
+    if (nPreferStore != d->preferStore) {
+        d->preferStore = nPreferStore;
+#ifdef QT_DEBUG
+        qDebug() << "Changed preferStore to" << d->preferStore;
+#endif
+        Q_EMIT preferStoreChanged(preferStore());
+    }
+}
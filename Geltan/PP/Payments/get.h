@@ -30,6 +30,7 @@ namespace Geltan {
 namespace PP {
 
 class Payment;
+class PaymentStore;
 
 namespace Payments {
 
@@ -38,6 +39,10 @@ class GetPrivate;
 /*!
  * \brief Requests information about a single PayPal payment.
  *
+ * If a PaymentStore is set via the \link Get::store store \endlink property, the JSON data of payments
+ * requested from the API will be written to the store. If \link Get::preferStore preferStore \endlink is
+ * enabled, payments found in the store will be returned without a request to the API.
+ *
  * \ppPaymentsApi{payment_get}
  *
  * \headerfile "" <Geltan/PP/Payments/get.h>
@@ -64,6 +69,30 @@ class GELTANSHARED_EXPORT Get : public PPBase
      * <TABLE><TR><TD>void</TD><TD>paymentIdChanged(const QString &paymentId)</TD></TR></TABLE>
      */
     Q_PROPERTY(QString paymentId READ paymentId WRITE setPaymentId NOTIFY paymentIdChanged)
+    /*!
+     * \brief Local store that is consulted before the API is requested.
+     *
+     * Requested payments will be written to the store. The Get object does not take ownership of the store.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>PaymentStore*</TD><TD>store() const</TD></TR><TR><TD>void</TD><TD>setStore(PaymentStore *nStore)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>storeChanged(PaymentStore *store)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::PaymentStore *store READ store WRITE setStore NOTIFY storeChanged)
+    /*!
+     * \brief If true, a payment found in the \link Get::store store \endlink will be returned without requesting the API.
+     *
+     * The stored data might be outdated, so this is disabled by default and the current data is always requested
+     * from the API, the store is only updated. The result from the store is delivered asynchronously like a result
+     * from the API. The default is \a false.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>preferStore() const</TD></TR><TR><TD>void</TD><TD>setPreferStore(bool nPreferStore)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>preferStoreChanged(bool preferStore)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool preferStore READ preferStore WRITE setPreferStore NOTIFY preferStoreChanged)
 public:
     /*!
      * \brief Constructs a new ShowPayment object.
@@ -86,8 +115,12 @@ public:
 
     Payment *payment() const;
     QString paymentId() const;
+    PaymentStore *store() const;
+    bool preferStore() const;
 
     void setPaymentId(const QString &nPaymentId);
+    void setStore(PaymentStore *nStore);
+    void setPreferStore(bool nPreferStore);
 
 Q_SIGNALS:
     /*!
@@ -102,6 +135,8 @@ Q_SIGNALS:
 
     void paymentChanged(Payment *payment);
     void paymentIdChanged(const QString &paymentId);
+    void storeChanged(PaymentStore *store);
+    void preferStoreChanged(bool preferStore);
 
 protected:
     void successCallBack() Q_DECL_OVERRIDE;
@@ -25,6 +25,8 @@
 #include "get.h"
 #include "../ppbase_p.h"
 #include "../Objects/payment.h"
+#include "../Store/paymentstore.h"
+#include <QPointer>
 
 namespace Geltan {
 namespace PP {
@@ -34,6 +36,8 @@ class GetPrivate : public PPBasePrivate {
 public:
     Payment *payment;
     QString paymentId;
+    QPointer<PaymentStore> store;
+    bool preferStore;
 };
 
 }
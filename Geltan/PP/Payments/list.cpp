@@ -20,13 +20,15 @@
  */
 
 #include "list_p.h"
+#include "../Values/paymentvalue.h"
+#include "../pptimestamp.h"
 #include <QUrlQuery>
 
 using namespace Geltan;
 using namespace PP;
 using namespace Payments;
 
-List::List(QObject *parent) : PPBase(*new ListPrivate, parent)
+List::List(QObject *parent) : PPListBase(*new ListPrivate, parent)
 {
     Q_D(List);
     d->count = 0;
@@ -43,7 +45,7 @@ List::List(QObject *parent) : PPBase(*new ListPrivate, parent)
 
 
 
-List::List(ListPrivate &dd, QObject *parent) : PPBase(dd, parent)
+List::List(ListPrivate &dd, QObject *parent) : PPListBase(dd, parent)
 {
 
 }
@@ -53,6 +55,8 @@ List::List(ListPrivate &dd, QObject *parent) : PPBase(dd, parent)
 
 void List::call()
 {
+    Q_D(List);
+
     setError(nullptr);
     setInOperation(true);
     setAuthentication();
@@ -63,20 +67,26 @@ void List::call()
         uq.addQueryItem(QStringLiteral("count"), QString::number(count()));
     }
 
-    if (!startId().isEmpty()) {
-        uq.addQueryItem(QStringLiteral("start_id"), startId());
-    }
+    if (!d->pageStartId.isEmpty()) {
+        // following pages are addressed by the ID only, the start index would override it
+        uq.addQueryItem(QStringLiteral("start_id"), d->pageStartId);
+        d->pageStartId.clear();
+    } else {
+        if (!startId().isEmpty()) {
+            uq.addQueryItem(QStringLiteral("start_id"), startId());
+        }
 
-    if (startIndex() > -1) {
-        uq.addQueryItem(QStringLiteral("start_index"), QString::number(startIndex()));
+        if (startIndex() > -1) {
+            uq.addQueryItem(QStringLiteral("start_index"), QString::number(startIndex()));
+        }
     }
 
     if (startTime().isValid()) {
-        uq.addQueryItem(QStringLiteral("start_time"), startTime().toUTC().toString(Qt::ISODate));
+        uq.addQueryItem(QStringLiteral("start_time"), PPTimestamp::format(startTime()));
     }
 
     if (endTime().isValid()) {
-        uq.addQueryItem(QStringLiteral("end_time"), endTime().toUTC().toString(Qt::ISODate));
+        uq.addQueryItem(QStringLiteral("end_time"), PPTimestamp::format(endTime()));
     }
 
     if (sortBy() == UpdateTime) {
@@ -115,14 +125,55 @@ void List::call(int count, const QString &startId, int startIndex, const QDateTi
 
 
 
+void List::forEachPayment(const std::function<bool (const PaymentValue &)> &consumer)
+{
+    if (!consumer) {
+        return;
+    }
+
+    paginate([consumer](const PPJsonValue &page) -> bool {
+        const PPJsonValue ps = page.value(QLatin1String("payments"));
+        for (const PPJsonValue &p : ps) {
+            if (!consumer(PaymentValue::fromJson(p))) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+
+
+
+void List::requestPage(const QString &startId)
+{
+    Q_D(List);
+
+    // the cursor is only used for this request, the startId and startIndex set by the user stay untouched
+    d->pageStartId = startId;
+
+    call();
+}
+
+
+
+
 void List::successCallBack()
 {
     Q_D(List);
 
+    if (consumePage()) {
+        if (!paginating()) {
+            setInOperation(false);
+            Q_EMIT succeeded();
+        }
+        return;
+    }
+
     if (d->paymentList) {
-        d->paymentList->loadFromJson(jsonResult(), append());
+        d->paymentList->loadFromJson(jsonData().root(), append());
     } else {
-        d->paymentList = new PaymentList(jsonResult(), this);
+        d->paymentList = new PaymentList(jsonData().root(), this);
         Q_EMIT paymentListChanged(d->paymentList);
     }
 
@@ -134,6 +185,7 @@ void List::successCallBack()
 
 void List::errorCallBack()
 {
+    finishPagination();
     setInOperation(false);
     Q_EMIT failed();
 }
@@ -285,6 +337,18 @@ void List::setSortOrder(Qt::SortOrder nSortOrder)
 
 PaymentList *List::paymentList() const { Q_D(const List); return d->paymentList; }
 
+void List::setPaymentList(PaymentList *nPaymentList)
+{
+    Q_D(List);
+    if (nPaymentList != d->paymentList) {
+        d->paymentList = nPaymentList;
+#ifdef QT_DEBUG
+        qDebug() << "Changed paymentList to" << d->paymentList;
+#endif
+        Q_EMIT paymentListChanged(paymentList());
+    }
+}
+
 
 bool List::append() const { Q_D(const List); return d->append; }
 
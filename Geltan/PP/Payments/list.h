@@ -22,13 +22,14 @@
 #ifndef LISTPAYMENTS_H
 #define LISTPAYMENTS_H
 
-#include "../ppbase.h"
+#include "../pplistbase.h"
 #include <QDateTime>
 
 namespace Geltan {
 namespace PP {
 
 class PaymentList;
+class PaymentValue;
 
 namespace Payments {
 
@@ -40,11 +41,13 @@ class ListPrivate;
  * Lists payments that were created by the Geltan::PP::Payments::Create call and are in any state.
  * The list shows the payments that are made to the merchant who makes the call.
  *
+ * Use forEachPayment() to walk through all payments in a range without keeping them in memory.
+ *
  * \ppPaymentsApi{payment_list}
  *
  * \headerfile "" <Geltan/PP/Payments/list.h>
  */
-class GELTANSHARED_EXPORT List : public PPBase
+class GELTANSHARED_EXPORT List : public PPListBase
 {
     Q_OBJECT
     Q_DECLARE_PRIVATE(List)
@@ -126,12 +129,17 @@ class GELTANSHARED_EXPORT List : public PPBase
     /*!
      * \brief The list that contains the replied payments.
      *
+     * If no list has been set, a new one will be created on the first successful request. Setting an
+     * existing PaymentList model will load the results into that model. The List does not take
+     * ownership of a list set by setPaymentList(). See PaymentList::listOperation for a model that
+     * uses this operation to fetch further pages on its own.
+     *
      * \par Access functions:
-     * <TABLE><TR><TD>PaymentList*</TD><TD>paymentList() const</TD></TR></TABLE>
+     * <TABLE><TR><TD>PaymentList*</TD><TD>paymentList() const</TD></TR><TR><TD>void</TD><TD>setPaymentList(PaymentList *nPaymentList)</TD></TR></TABLE>
      * \par Notifier signal:
      * <TABLE><TR><TD>void</TD><TD>paymentListChanged(PaymentList *paymentList)</TD></TR></TABLE>
      */
-    Q_PROPERTY(Geltan::PP::PaymentList *paymentList READ paymentList NOTIFY paymentListChanged)
+    Q_PROPERTY(Geltan::PP::PaymentList *paymentList READ paymentList WRITE setPaymentList NOTIFY paymentListChanged)
     /*!
      * \brief If set to true, new Payment items will be appended to the paymentList.
      *
@@ -174,6 +182,29 @@ public:
      */
     Q_INVOKABLE void call(int count, const QString &startId, int startIndex, const QDateTime &startTime, const QDateTime &endTime, SortBy sortBy, Qt::SortOrder sortOrder);
 
+    /*!
+     * \brief Requests all pages and hands every returned payment to the \a consumer.
+     *
+     * The payments are not loaded into the \link List::paymentList paymentList \endlink. Every page
+     * is released after it has been consumed while the next page is already requested, so the
+     * memory usage stays constant regardless of the length of the history. The \a consumer has to
+     * return false to stop the iteration. succeeded() will be emitted after the last page, failed()
+     * if a request failed.
+     *
+     * \code{.cpp}
+     * list->setStartTime(start);
+     * list->setEndTime(end);
+     * list->setCount(20);
+     * list->forEachPayment([&out](const Geltan::PP::PaymentValue &payment) {
+     *     out << payment.id() << '\n';
+     *     return true;
+     * });
+     * \endcode
+     *
+     * \sa PPListBase::paginate()
+     */
+    void forEachPayment(const std::function<bool(const PaymentValue &payment)> &consumer);
+
 
     int count() const;
     QString startId() const;
@@ -192,6 +223,7 @@ public:
     void setEndTime(const QDateTime &nEndTime);
     void setSortBy(SortBy nSortBy);
     void setSortOrder(Qt::SortOrder nSortOrder);
+    void setPaymentList(PaymentList *nPaymentList);
     void setAppend(bool nAppend);
 
 Q_SIGNALS:
@@ -217,6 +249,7 @@ Q_SIGNALS:
 
 
 protected:
+    void requestPage(const QString &startId) Q_DECL_OVERRIDE;
     void successCallBack() Q_DECL_OVERRIDE;
     void errorCallBack() Q_DECL_OVERRIDE;
     bool checkInput() Q_DECL_OVERRIDE;
@@ -226,6 +259,8 @@ protected:
 
 private:
     Q_DISABLE_COPY(List)
+    // PaymentList::fetchMore() requests the following pages by their cursor
+    friend class Geltan::PP::PaymentList;
 };
 
 }
@@ -23,7 +23,7 @@
 #define LISTPAYMENTS_P_H
 
 #include "list.h"
-#include "../ppbase_p.h"
+#include "../pplistbase_p.h"
 #include "../Objects/paymentlist.h"
 
 namespace Geltan {
@@ -31,7 +31,7 @@ namespace PP {
 namespace Payments {
 
 
-class ListPrivate : public PPBasePrivate {
+class ListPrivate : public PPListBasePrivate {
 public:
     int count;
     QString startId;
@@ -42,6 +42,8 @@ public:
     Qt::SortOrder sortOrder;
     PaymentList *paymentList;
     bool append;
+    // cursor of the next page requested by requestPage(), used by the next call() only
+    QString pageStartId;
 };
 
 }
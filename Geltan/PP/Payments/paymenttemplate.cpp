@@ -0,0 +1,542 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/paymenttemplate.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymenttemplate_p.h"
+#include <Geltan/PP/ppjsonwriter.h>
+#include <Geltan/PP/ppenums.h>
+#include <Geltan/PP/Objects/payment.h>
+#include <Geltan/PP/Objects/payer.h>
+#include <Geltan/PP/Objects/redirecturls.h>
+#include <Geltan/PP/Objects/transaction.h>
+#include <Geltan/PP/Objects/paymentamount.h>
+#include <Geltan/PP/Objects/details.h>
+#include <Geltan/PP/Objects/itemlist.h>
+#include <Geltan/PP/Objects/item.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QHash>
+
+using namespace Geltan;
+using namespace PP;
+using namespace Payments;
+
+namespace {
+
+/*
+ * Renders the skeleton JSON into static fragments, writing the slot members last in their objects.
+ */
+class TemplateCompiler
+{
+public:
+    struct SlotDef {
+        PaymentTemplate::Field field;
+        QByteArray name;
+        int item;
+    };
+
+    explicit TemplateCompiler(PaymentTemplateData *data) : d(data), group(0) {}
+
+    void addSlot(const QString &path, PaymentTemplate::Field field, const QByteArray &name, int item = -1)
+    {
+        if (d->fields.testFlag(field)) {
+            SlotDef def;
+            def.field = field;
+            def.name = name;
+            def.item = item;
+            slotDefs[path].append(def);
+        }
+    }
+
+    void writeObject(const QJsonObject &object, const QString &path)
+    {
+        current.append('{');
+
+        const QVector<SlotDef> defs = slotDefs.value(path);
+        bool first = true;
+
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            if (isSlot(defs, it.key())) {
+                continue;
+            }
+            if (!first) {
+                current.append(',');
+            }
+            first = false;
+            PPJsonWriter::appendString(&current, it.key());
+            current.append(':');
+            writeValue(it.value(), path.isEmpty() ? it.key() : path + QLatin1Char('/') + it.key());
+        }
+
+        if (!defs.isEmpty()) {
+            const int g = group++;
+            for (const SlotDef &def : defs) {
+                PaymentTemplateData::Piece p;
+                p.json = current;
+                p.field = def.field;
+                p.item = def.item;
+                p.name = def.name;
+                p.group = g;
+                p.staticBefore = !first;
+                d->size += current.size();
+                d->pieces.append(p);
+                current.clear();
+            }
+        }
+
+        current.append('}');
+    }
+
+    void finish()
+    {
+        PaymentTemplateData::Piece p;
+        p.json = current;
+        d->size += current.size();
+        d->pieces.append(p);
+        current.clear();
+    }
+
+private:
+    static bool isSlot(const QVector<SlotDef> &defs, const QString &key)
+    {
+        for (const SlotDef &def : defs) {
+            if (key == QLatin1String(def.name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void writeValue(const QJsonValue &value, const QString &path)
+    {
+        switch (value.type()) {
+        case QJsonValue::Object:
+            writeObject(value.toObject(), path);
+            break;
+        case QJsonValue::Array:
+        {
+            const QJsonArray a = value.toArray();
+            current.append('[');
+            for (int i = 0; i < a.size(); ++i) {
+                if (i > 0) {
+                    current.append(',');
+                }
+                writeValue(a.at(i), path + QLatin1Char('/') + QString::number(i));
+            }
+            current.append(']');
+        }
+            break;
+        case QJsonValue::String:
+            PPJsonWriter::appendString(&current, value.toString());
+            break;
+        case QJsonValue::Double:
+        {
+            // the payment objects only write integers as numbers
+            const double n = value.toDouble();
+            const qint64 i = static_cast<qint64>(n);
+            if (static_cast<double>(i) == n) {
+                current.append(QByteArray::number(i));
+            } else {
+                current.append(QByteArray::number(n, 'g', 17));
+            }
+        }
+            break;
+        case QJsonValue::Bool:
+            current.append(value.toBool() ? QByteArrayLiteral("true") : QByteArrayLiteral("false"));
+            break;
+        default:
+            current.append(QByteArrayLiteral("null"));
+            break;
+        }
+    }
+
+    PaymentTemplateData *d;
+    QHash<QString, QVector<SlotDef>> slotDefs;
+    QByteArray current;
+    int group;
+};
+
+}
+
+
+PaymentTemplate::PaymentTemplate() :
+    d(new PaymentTemplateData)
+{
+}
+
+
+PaymentTemplate::PaymentTemplate(const PaymentTemplate &other) :
+    d(other.d)
+{
+}
+
+
+PaymentTemplate::~PaymentTemplate()
+{
+}
+
+
+PaymentTemplate &PaymentTemplate::operator=(const PaymentTemplate &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+
+PaymentTemplate PaymentTemplate::compile(Payment *payment, Fields fields)
+{
+    PaymentTemplate t;
+    PaymentTemplateData *d = t.d.data();
+
+    if (!payment) {
+        d->errorString = tr("No valid payment data available.");
+        return t;
+    }
+
+    if (payment->intent() == Payment::NoIntent) {
+        d->errorString = tr("No valid payment intent set.");
+        return t;
+    }
+
+    if (!payment->payer()) {
+        d->errorString = tr("No valid Payer object available on the Payment object.");
+        return t;
+    }
+
+    const QList<Transaction*> trs = payment->transactions();
+    if (trs.count() != 1) {
+        d->errorString = tr("Payment templates support exactly one transaction.");
+        return t;
+    }
+
+    Transaction *trans = trs.first();
+    PaymentAmount *amount = trans->amount();
+    if (!amount || amount->currency().size() != 3) {
+        d->errorString = tr("The transaction needs an amount with a valid currency code.");
+        return t;
+    }
+
+    const bool payPal = (payment->payer()->paymentMethod() == PayPal::PayPalWallet);
+
+    if ((payment->intent() == Payment::Sale) && payPal && (!payment->redirectUrls() || !payment->redirectUrls()->isValid())) {
+        d->errorString = tr("In order to accept a PayPal payment, you have to provide valid redirect URLs.");
+        return t;
+    }
+
+    Details *det = amount->details();
+    if (det && !payPal && (det->handlingFeeMoney().isPositive() || det->shippingDiscountMoney().isPositive() || det->insuranceMoney().isPositive())) {
+        d->errorString = tr("Handling fees, shipping discount and insurance are only supported if the payment method is set to PayPal.");
+        return t;
+    }
+
+    d->currency = amount->currency();
+    d->defaults.total = amount->totalMoney();
+    d->defaults.description = trans->description();
+    d->defaults.invoiceNumber = trans->invoiceNumber();
+    d->defaults.custom = trans->custom();
+    d->defaults.noteToPayer = payment->noteToPayer();
+
+    if (det) {
+        d->hasDetails = true;
+        d->defaults.subtotal = det->subtotalMoney();
+        d->defaults.shipping = det->shippingMoney();
+        d->defaults.tax = det->taxMoney();
+        d->otherDetails = det->handlingFeeMoney();
+        d->otherDetails += det->shippingDiscountMoney();
+        d->otherDetails += det->insuranceMoney();
+        d->otherDetails += det->giftWrapMoney();
+    }
+
+    if (trans->itemList()) {
+        const QList<Item*> its = trans->itemList()->items();
+        for (Item *it : its) {
+            if (it->currency() != d->currency) {
+                d->errorString = tr("Item currency codes should be the same as the transaction currency code in all buckets.");
+                return t;
+            }
+            if (!payPal && (!it->description().isEmpty() || it->taxMoney().isPositive())) {
+                d->errorString = tr("Item descriptions and per item tax are only supported if the payment method is set to PayPal.");
+                return t;
+            }
+            d->defaults.itemPrices.append(it->priceMoney());
+            d->defaults.itemQuantities.append(it->quantity());
+            d->itemTaxes.append(it->taxMoney());
+        }
+    }
+
+    d->itemCount = d->defaults.itemPrices.size();
+
+    if (d->itemCount == 0) {
+        fields &= ~(ItemPrices|ItemQuantities);
+    }
+
+    if (fields & (Subtotal|Shipping|Tax)) {
+        d->hasDetails = true;
+    }
+
+    d->fields = fields;
+
+    PPJsonWriter writer;
+    payment->writeJson(&writer);
+
+    QJsonObject root = QJsonDocument::fromJson(writer.data()).object();
+
+    // the details object has to exist to get slots, even if all its static amounts are zero
+    if (fields & (Subtotal|Shipping|Tax)) {
+        QJsonArray ts = root.value(QStringLiteral("transactions")).toArray();
+        QJsonObject t0 = ts.at(0).toObject();
+        QJsonObject a = t0.value(QStringLiteral("amount")).toObject();
+        if (!a.contains(QStringLiteral("details"))) {
+            a.insert(QStringLiteral("details"), QJsonObject());
+            t0.insert(QStringLiteral("amount"), a);
+            ts.replace(0, t0);
+            root.insert(QStringLiteral("transactions"), ts);
+        }
+    }
+
+    TemplateCompiler c(d);
+    c.addSlot(QString(), NoteToPayer, QByteArrayLiteral("note_to_payer"));
+    c.addSlot(QStringLiteral("transactions/0"), Description, QByteArrayLiteral("description"));
+    c.addSlot(QStringLiteral("transactions/0"), InvoiceNumber, QByteArrayLiteral("invoice_number"));
+    c.addSlot(QStringLiteral("transactions/0"), Custom, QByteArrayLiteral("custom"));
+    c.addSlot(QStringLiteral("transactions/0/amount"), Total, QByteArrayLiteral("total"));
+    c.addSlot(QStringLiteral("transactions/0/amount/details"), Subtotal, QByteArrayLiteral("subtotal"));
+    c.addSlot(QStringLiteral("transactions/0/amount/details"), Shipping, QByteArrayLiteral("shipping"));
+    c.addSlot(QStringLiteral("transactions/0/amount/details"), Tax, QByteArrayLiteral("tax"));
+    for (int i = 0; i < d->itemCount; ++i) {
+        const QString itemPath = QStringLiteral("transactions/0/item_list/items/") + QString::number(i);
+        c.addSlot(itemPath, ItemPrices, QByteArrayLiteral("price"), i);
+        c.addSlot(itemPath, ItemQuantities, QByteArrayLiteral("quantity"), i);
+    }
+
+    c.writeObject(root, QString());
+    c.finish();
+
+    d->valid = true;
+
+    return t;
+}
+
+
+
+
+bool PaymentTemplate::isValid() const { return d->valid; }
+
+QString PaymentTemplate::errorString() const { return d->errorString; }
+
+PaymentTemplate::Fields PaymentTemplate::fields() const { return d->fields; }
+
+QString PaymentTemplate::currency() const { return d->currency; }
+
+int PaymentTemplate::itemCount() const { return d->itemCount; }
+
+PaymentTemplate::Values PaymentTemplate::defaults() const { return d->defaults; }
+
+
+
+
+bool PaymentTemplate::check(const Values &values, QString *errorString) const
+{
+    auto fail = [errorString](const QString &error) -> bool {
+        if (errorString) {
+            *errorString = error;
+        }
+        return false;
+    };
+
+    if (!d->valid) {
+        return fail(tr("The payment template is not valid."));
+    }
+
+    const Values &def = d->defaults;
+    const Fields f = d->fields;
+
+    const Money total = f.testFlag(Total) ? values.total : def.total;
+    const Money subtotal = f.testFlag(Subtotal) ? values.subtotal : def.subtotal;
+    const Money shipping = f.testFlag(Shipping) ? values.shipping : def.shipping;
+    const Money tax = f.testFlag(Tax) ? values.tax : def.tax;
+
+    if (!total.isPositive()) {
+        return fail(tr("The total amount has to be greater than zero."));
+    }
+
+    if (d->hasDetails) {
+        const Money sum = subtotal + shipping + tax + d->otherDetails;
+        if (sum.isPositive() && (sum != total)) {
+            return fail(tr("The amount data is not valid. Maybe data is missing or the values do not sum up as expected."));
+        }
+    }
+
+    if (d->itemCount > 0) {
+        if (f.testFlag(ItemPrices) && (values.itemPrices.size() != d->itemCount)) {
+            return fail(tr("There has to be one price value per item."));
+        }
+
+        if (f.testFlag(ItemQuantities) && (values.itemQuantities.size() != d->itemCount)) {
+            return fail(tr("There has to be one quantity value per item."));
+        }
+
+        const QVector<Money> &prices = f.testFlag(ItemPrices) ? values.itemPrices : def.itemPrices;
+        const QVector<int> &quantities = f.testFlag(ItemQuantities) ? values.itemQuantities : def.itemQuantities;
+
+        Money ilTotal; // total of all item price values
+        Money ilTax; // total of all item tax values
+
+        for (int i = 0; i < d->itemCount; ++i) {
+            if (quantities.at(i) < 1) {
+                return fail(tr("Item quantity has to be more than one."));
+            }
+            ilTotal += (prices.at(i) * quantities.at(i));
+            ilTax += (d->itemTaxes.at(i) * quantities.at(i));
+        }
+
+        if (!d->hasDetails && (ilTotal != total)) {
+            return fail(tr("The sum of all item prices in a transaction has to be the same as the total amount of the transaction."));
+        }
+
+        if (d->hasDetails) {
+            if (subtotal.isPositive() && (ilTotal != subtotal)) {
+                return fail(tr("The sum of all item prices in a transaction has to be the same as the subtotal amount of the transaction."));
+            }
+
+            if (tax.isPositive() && (ilTax != tax)) {
+                return fail(tr("The sum of all item tax values in a transaction has to be the same as the tax amount of the transaction."));
+            }
+        }
+    }
+
+    return true;
+}
+
+
+
+
+QByteArray PaymentTemplate::render(const Values &values) const
+{
+    QByteArray out;
+
+    if (!d->valid) {
+        return out;
+    }
+
+    // slot values are short, the static fragments are most of the payload
+    out.reserve(d->size + 64 * d->pieces.size());
+
+    int group = -1;
+    bool wrote = false;
+
+    for (const PaymentTemplateData::Piece &p : d->pieces) {
+        out.append(p.json);
+
+        if (p.field == NoField) {
+            continue;
+        }
+
+        if (p.group != group) {
+            group = p.group;
+            wrote = p.staticBefore;
+        }
+
+        if (d->appendSlot(&out, p, values, wrote)) {
+            wrote = true;
+        }
+    }
+
+    return out;
+}
+
+
+
+
+bool PaymentTemplateData::appendSlot(QByteArray *out, const Piece &piece, const PaymentTemplate::Values &values, bool separate) const
+{
+    Money money;
+    QString string;
+    bool isMoney = false;
+    int maxLength = 127;
+
+    switch (piece.field) {
+    case PaymentTemplate::Total:
+        money = values.total;
+        isMoney = true;
+        break;
+    case PaymentTemplate::Subtotal:
+        money = values.subtotal;
+        isMoney = true;
+        break;
+    case PaymentTemplate::Shipping:
+        money = values.shipping;
+        isMoney = true;
+        break;
+    case PaymentTemplate::Tax:
+        money = values.tax;
+        isMoney = true;
+        break;
+    case PaymentTemplate::ItemPrices:
+        money = values.itemPrices.value(piece.item);
+        isMoney = true;
+        break;
+    case PaymentTemplate::ItemQuantities:
+        string = QString::number(values.itemQuantities.value(piece.item));
+        break;
+    case PaymentTemplate::Description:
+        string = values.description;
+        break;
+    case PaymentTemplate::InvoiceNumber:
+        string = values.invoiceNumber;
+        break;
+    case PaymentTemplate::Custom:
+        string = values.custom;
+        break;
+    case PaymentTemplate::NoteToPayer:
+        string = values.noteToPayer;
+        maxLength = 165;
+        break;
+    default:
+        return false;
+    }
+
+    if (isMoney) {
+        if (money.isZero()) {
+            return false;
+        }
+        string = money.toString(Money::currencyDecimals(currency));
+        if (string.size() > 10) {
+            return false;
+        }
+    }
+
+    if (string.isEmpty()) {
+        return false;
+    }
+
+    if (separate) {
+        out->append(',');
+    }
+    out->append('"');
+    out->append(piece.name);
+    out->append("\":", 2);
+    PPJsonWriter::appendString(out, string.left(maxLength));
+
+    return true;
+}
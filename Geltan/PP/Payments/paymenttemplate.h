@@ -0,0 +1,192 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/paymenttemplate.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTTEMPLATE_H
+#define PAYMENTTEMPLATE_H
+
+#include <QSharedDataPointer>
+#include <QCoreApplication>
+#include <QVector>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/Values/money.h>
+
+namespace Geltan {
+namespace PP {
+
+class Payment;
+
+namespace Payments {
+
+class PaymentTemplateData;
+
+/*!
+ * \brief Implicitly shared, pre-rendered payment request with typed slots for the variable fields.
+ *
+ * Checkouts often only differ in a few fields like the amount, the description and the invoice number,
+ * while payer, redirect URLs, experience profile and item structure stay the same. compile() validates the
+ * structure of such a skeleton Payment once and renders it into static JSON fragments with slots for the
+ * selected \link PaymentTemplate::Field fields \endlink. Each request then only has to check the amounts
+ * of the filled Values and concatenate fragments and values, no Payment object tree has to be created.
+ *
+ * The template supports payments with a single transaction. Fields that are not selected as slots are
+ * taken from the skeleton. Slot values that are empty or zero are omitted from the request like empty
+ * properties of a Payment object.
+ *
+ * \code{.cpp}
+ * const Geltan::PP::Payments::PaymentTemplate tmpl = Geltan::PP::Payments::PaymentTemplate::compile(skeleton, Geltan::PP::Payments::PaymentTemplate::Total|Geltan::PP::Payments::PaymentTemplate::Description|Geltan::PP::Payments::PaymentTemplate::InvoiceNumber);
+ *
+ * Geltan::PP::Payments::PaymentTemplate::Values v = tmpl.defaults();
+ * v.total = Geltan::PP::Money::fromString(QStringLiteral("19.99"));
+ * v.description = QStringLiteral("Order 4711");
+ * v.invoiceNumber = QStringLiteral("4711");
+ *
+ * create->call(tmpl, v);
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Payments/paymenttemplate.h>
+ */
+class GELTANSHARED_EXPORT PaymentTemplate
+{
+    Q_DECLARE_TR_FUNCTIONS(PaymentTemplate)
+public:
+    /*!
+     * \brief The fields that can be filled per request.
+     */
+    enum Field {
+        NoField         = 0x000,    /**< No variable fields, the complete request is static. */
+        Total           = 0x001,    /**< The total amount of the transaction. */
+        Subtotal        = 0x002,    /**< The subtotal of the transaction amount details. */
+        Shipping        = 0x004,    /**< The shipping amount of the transaction amount details. */
+        Tax             = 0x008,    /**< The tax amount of the transaction amount details. */
+        Description     = 0x010,    /**< The description of the transaction. */
+        InvoiceNumber   = 0x020,    /**< The invoice number of the transaction. */
+        Custom          = 0x040,    /**< The custom field of the transaction. */
+        NoteToPayer     = 0x080,    /**< The note to the payer of the payment. */
+        ItemPrices      = 0x100,    /**< The prices of all items of the transaction. */
+        ItemQuantities  = 0x200     /**< The quantities of all items of the transaction. */
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    /*!
+     * \brief The values of the variable fields of a single request.
+     *
+     * Only the members of the fields the template has been compiled with are used. itemPrices and
+     * itemQuantities need one entry per item of the skeleton.
+     */
+    struct Values {
+        Money total;                    /**< Value for the Total field. */
+        Money subtotal;                 /**< Value for the Subtotal field. */
+        Money shipping;                 /**< Value for the Shipping field. */
+        Money tax;                      /**< Value for the Tax field. */
+        QString description;            /**< Value for the Description field. */
+        QString invoiceNumber;          /**< Value for the InvoiceNumber field. */
+        QString custom;                 /**< Value for the Custom field. */
+        QString noteToPayer;            /**< Value for the NoteToPayer field. */
+        QVector<Money> itemPrices;      /**< Values for the ItemPrices field. */
+        QVector<int> itemQuantities;    /**< Values for the ItemQuantities field. */
+    };
+
+    /*!
+     * \brief Constructs a new invalid PaymentTemplate.
+     */
+    PaymentTemplate();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    PaymentTemplate(const PaymentTemplate &other);
+
+    /*!
+     * \brief Deconstructs the PaymentTemplate.
+     */
+    ~PaymentTemplate();
+
+    /*!
+     * \brief Assigns \a other to this PaymentTemplate.
+     */
+    PaymentTemplate &operator=(const PaymentTemplate &other);
+
+    /*!
+     * \brief Validates the structure of the skeleton \a payment and renders it with slots for the \a fields.
+     *
+     * Returns an invalid template if the skeleton is not suitable, the reason will be available from errorString().
+     */
+    static PaymentTemplate compile(Payment *payment, Fields fields);
+
+    /*!
+     * \brief Returns true if the template has been compiled successfully.
+     */
+    bool isValid() const;
+
+    /*!
+     * \brief Returns the reason why compile() failed.
+     */
+    QString errorString() const;
+
+    /*!
+     * \brief Returns the variable fields of the template.
+     */
+    Fields fields() const;
+
+    /*!
+     * \brief Returns the currency code of the transaction amount.
+     */
+    QString currency() const;
+
+    /*!
+     * \brief Returns the number of items of the skeleton transaction.
+     */
+    int itemCount() const;
+
+    /*!
+     * \brief Returns the values of the skeleton, useful as starting point to fill a request.
+     */
+    Values defaults() const;
+
+    /*!
+     * \brief Returns true if the \a values sum up as expected by the PayPal API.
+     *
+     * Performs the same amount and item checks as Create does for a Payment object. If \a errorString
+     * is not a \c nullptr, it will contain the reason if the check fails.
+     */
+    bool check(const Values &values, QString *errorString = nullptr) const;
+
+    /*!
+     * \brief Returns the compact JSON request payload filled with \a values.
+     *
+     * The values are not checked, use check() before. Returns an empty QByteArray if the template is not valid.
+     */
+    QByteArray render(const Values &values) const;
+
+private:
+    QSharedDataPointer<PaymentTemplateData> d;
+};
+
+}
+}
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Geltan::PP::Payments::PaymentTemplate::Fields)
+Q_DECLARE_TYPEINFO(Geltan::PP::Payments::PaymentTemplate, Q_MOVABLE_TYPE);
+
+#endif // PAYMENTTEMPLATE_H
@@ -0,0 +1,102 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/paymenttemplate_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTTEMPLATE_P_H
+#define PAYMENTTEMPLATE_P_H
+
+#include "paymenttemplate.h"
+#include <QSharedData>
+#include <QByteArray>
+
+namespace Geltan {
+namespace PP {
+namespace Payments {
+
+class PaymentTemplateData : public QSharedData
+{
+public:
+    /*!
+     * \internal
+     * \brief Static JSON fragment followed by a slot.
+     *
+     * Slots are always the last members of their object, so a slot only needs a separator if
+     * the object has static members or a previous slot of the same object has been written.
+     */
+    struct Piece {
+        Piece() : field(PaymentTemplate::NoField), item(-1), group(-1), staticBefore(false) {}
+
+        QByteArray json;                // static JSON preceding the slot
+        PaymentTemplate::Field field;   // NoField for the trailing fragment
+        int item;                       // item index for the item fields
+        QByteArray name;                // JSON member name of the slot
+        int group;                      // index of the JSON object the slot belongs to
+        bool staticBefore;              // the object has static members before the slot
+    };
+
+    PaymentTemplateData() :
+        fields(PaymentTemplate::NoField),
+        itemCount(0),
+        size(0),
+        hasDetails(false),
+        valid(false)
+    {}
+
+    PaymentTemplateData(const PaymentTemplateData &other) :
+        QSharedData(other),
+        pieces(other.pieces),
+        defaults(other.defaults),
+        itemTaxes(other.itemTaxes),
+        otherDetails(other.otherDetails),
+        currency(other.currency),
+        errorString(other.errorString),
+        fields(other.fields),
+        itemCount(other.itemCount),
+        size(other.size),
+        hasDetails(other.hasDetails),
+        valid(other.valid)
+    {}
+
+    ~PaymentTemplateData() {}
+
+    /*!
+     * \internal
+     * \brief Appends the member for the slot of \a piece, returns false if the value is empty and has been omitted.
+     */
+    bool appendSlot(QByteArray *out, const Piece &piece, const PaymentTemplate::Values &values, bool separate) const;
+
+    QVector<Piece> pieces;
+    PaymentTemplate::Values defaults;
+    QVector<Money> itemTaxes;
+    Money otherDetails;     // sum of the details amounts that can not be filled
+    QString currency;
+    QString errorString;
+    PaymentTemplate::Fields fields;
+    int itemCount;
+    int size;               // size of all static fragments
+    bool hasDetails;
+    bool valid;
+};
+
+}
+}
+}
+
+#endif // PAYMENTTEMPLATE_P_H
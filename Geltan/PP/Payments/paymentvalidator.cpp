@@ -0,0 +1,293 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/paymentvalidator.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentvalidator.h"
+#include <Geltan/PP/Objects/payment.h>
+#include <Geltan/PP/Values/money.h>
+#include <QtConcurrent>
+
+using namespace Geltan;
+using namespace PP;
+using namespace Payments;
+
+namespace {
+
+/*
+ * Collects the issues and tells the checks if they should go on.
+ */
+class IssueCollector
+{
+public:
+    explicit IssueCollector(bool stopAtFirst) : m_stopAtFirst(stopAtFirst) {}
+
+    // returns false if the validation should stop
+    bool add(PaymentValidator::Rule rule, const QString &message, int transaction = -1, int item = -1)
+    {
+        PaymentValidator::Issue issue;
+        issue.rule = rule;
+        issue.transaction = transaction;
+        issue.item = item;
+        issue.message = message;
+        issues.append(issue);
+        return !m_stopAtFirst;
+    }
+
+    PaymentValidator::Issues issues;
+
+private:
+    bool m_stopAtFirst;
+};
+
+
+/*
+ * Same rules as PaymentAmount::valid().
+ */
+bool amountValid(const PaymentAmountValue &amount)
+{
+    if (amount.totalMoney().isZero() || amount.currency().length() != 3) {
+        return false;
+    }
+
+    const DetailsValue det = amount.details();
+    if (!det.isEmpty()) {
+        Money sum = det.subtotalMoney();
+        sum += det.taxMoney();
+        sum += det.shippingMoney();
+        sum += det.insuranceMoney();
+        sum += det.handlingFeeMoney();
+        sum += det.shippingDiscountMoney();
+        sum += det.giftWrapMoney();
+
+        if (sum.isPositive() && (amount.totalMoney() != sum)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+
+PaymentValidator::Issues PaymentValidator::validate(const Payment *payment, bool stopAtFirst)
+{
+    if (!payment) {
+        IssueCollector c(stopAtFirst);
+        c.add(NoPayment, tr("No valid payment data available."));
+        return c.issues;
+    }
+
+    return validate(payment->toValue(), stopAtFirst);
+}
+
+
+
+PaymentValidator::Issues PaymentValidator::validate(const PaymentValue &payment, bool stopAtFirst)
+{
+    IssueCollector c(stopAtFirst);
+
+    if (payment.intent() == Payment::NoIntent) {
+        if (!c.add(NoIntent, tr("No valid payment intent set."))) {
+            return c.issues;
+        }
+    }
+
+    // all further checks depend on the payer and the transactions
+    const PayerValue payer = payment.payer();
+    if (payer.isEmpty()) {
+        c.add(NoPayer, tr("No valid Payer object available on the Payment object."));
+        return c.issues;
+    }
+
+    const QList<TransactionValue> trs = payment.transactions();
+    if (trs.isEmpty()) {
+        c.add(NoTransactions, tr("You have to specify at least one transaction with total amount, currency and description."));
+        return c.issues;
+    }
+
+    const bool wallet = (payer.paymentMethod() == PayPal::PayPalWallet);
+
+    if ((payment.intent() == Payment::Sale) && wallet) {
+
+        if (!payment.returnUrl().isValid() || !payment.cancelUrl().isValid()) {
+            if (!c.add(InvalidRedirectUrls, tr("In order to accept a PayPal payment, you have to provide valid redirect URLs."))) {
+                return c.issues;
+            }
+        }
+
+        for (int i = 0; i < trs.size(); ++i) {
+            if (!trs.at(i).referenceId().isEmpty()) {
+                if (!c.add(ReferenceIdNotAllowed, tr("Reference ID is not allowed when accepting PayPal payments."), i)) {
+                    return c.issues;
+                }
+            }
+        }
+    }
+
+    if ((payment.intent() == Payment::Sale) && (payer.paymentMethod() == PayPal::CreditCard)) {
+        if (!payer.fundingInstruments().isEmpty()) {
+            if (!c.add(InvalidCreditCardData, tr("No valid credit card data available."))) {
+                return c.issues;
+            }
+        }
+    }
+
+    for (int ti = 0; ti < trs.size(); ++ti) {
+
+        const TransactionValue &t = trs.at(ti);
+        const PaymentAmountValue amount = t.amount();
+
+        if (amount.isEmpty()) {
+            if (!c.add(NoAmount, tr("You have to specify the amount of the transaction."), ti)) {
+                return c.issues;
+            }
+            // the remaining checks of the transaction compare with the amount
+            continue;
+        }
+
+        if (!amountValid(amount)) {
+            if (!c.add(InvalidAmount, tr("The amount data is not valid. Maybe data is missing or the values do not sum up as expected."), ti)) {
+                return c.issues;
+            }
+        }
+
+        const DetailsValue det = amount.details();
+        const bool hasDetails = !det.isEmpty();
+
+        if (hasDetails && !wallet) {
+            if (det.handlingFeeMoney().isPositive()) {
+                if (!c.add(HandlingFeeNotSupported, tr("Handling fees are only supported if the payment method is set to PayPal."), ti)) {
+                    return c.issues;
+                }
+            }
+
+            if (det.shippingDiscountMoney().isPositive()) {
+                if (!c.add(ShippingDiscountNotSupported, tr("Shipping discount is only supported if the payment method is set to PayPal."), ti)) {
+                    return c.issues;
+                }
+            }
+
+            if (det.insuranceMoney().isPositive()) {
+                if (!c.add(InsuranceNotSupported, tr("Insurance is only supported if the payment method is set to PayPal."), ti)) {
+                    return c.issues;
+                }
+            }
+        }
+
+        if (!t.shippingAddress().fitsLimits()) {
+            if (!c.add(ShippingAddressFieldTooLong, tr("A member of the shipping address is longer than PayPal accepts."), ti)) {
+                return c.issues;
+            }
+        }
+
+        const QList<ItemValue> its = t.items();
+        if (its.isEmpty()) {
+            continue;
+        }
+
+        Money ilTotal; // total of all item price values
+        Money ilTax; // total of all item tax values
+
+        for (int ii = 0; ii < its.size(); ++ii) {
+
+            const ItemValue &it = its.at(ii);
+
+            if (it.quantity() < 1) {
+                if (!c.add(InvalidItemQuantity, tr("Item quantity has to be more than one."), ti, ii)) {
+                    return c.issues;
+                }
+            }
+
+            if (!it.fitsLimits()) {
+                if (!c.add(ItemFieldTooLong, tr("A member of the item is longer than PayPal accepts."), ti, ii)) {
+                    return c.issues;
+                }
+            }
+
+            if (it.currency() != amount.currency()) {
+                if (!c.add(ItemCurrencyMismatch, tr("Item currency codes should be the same as the transaction currency code in all buckets."), ti, ii)) {
+                    return c.issues;
+                }
+            }
+
+            if (!wallet) {
+                if (!it.description().isEmpty()) {
+                    if (!c.add(ItemDescriptionNotSupported, tr("Item description is only allowed if the payment method is set to PayPal."), ti, ii)) {
+                        return c.issues;
+                    }
+                }
+
+                if (it.taxMoney().isPositive()) {
+                    if (!c.add(ItemTaxNotSupported, tr("Per item tax is only supported if the payment method is set to PayPal."), ti, ii)) {
+                        return c.issues;
+                    }
+                }
+            }
+
+            ilTotal += (it.priceMoney() * it.quantity());
+            ilTax += (it.taxMoney() * it.quantity());
+        }
+
+        if (!hasDetails) {
+            if (ilTotal != amount.totalMoney()) {
+                if (!c.add(ItemTotalMismatch, tr("The sum of all item prices in a transaction has to be the same as the total amount of the transaction."), ti)) {
+                    return c.issues;
+                }
+            }
+        } else {
+            if (det.subtotalMoney().isPositive() && (ilTotal != det.subtotalMoney())) {
+                if (!c.add(ItemSubtotalMismatch, tr("The sum of all item prices in a transaction has to be the same as the subtotal amount of the transaction."), ti)) {
+                    return c.issues;
+                }
+            }
+
+            if (det.taxMoney().isPositive() && (ilTax != det.taxMoney())) {
+                if (!c.add(ItemTaxMismatch, tr("The sum of all item tax values in a transaction has to be the same as the tax amount of the transaction."), ti)) {
+                    return c.issues;
+                }
+            }
+        }
+    }
+
+    return c.issues;
+}
+
+
+
+QVector<PaymentValidator::Issues> PaymentValidator::validate(const QList<PaymentValue> &payments)
+{
+    const QList<Issues> results = QtConcurrent::blockingMapped<QList<Issues> >(payments, &PaymentValidator::validateAll);
+    return results.toVector();
+}
+
+
+
+QFuture<PaymentValidator::Issues> PaymentValidator::validateAsync(const QList<PaymentValue> &payments)
+{
+    return QtConcurrent::mapped(payments, &PaymentValidator::validateAll);
+}
+
+
+
+PaymentValidator::Issues PaymentValidator::validateAll(const PaymentValue &payment)
+{
+    return validate(payment, false);
+}
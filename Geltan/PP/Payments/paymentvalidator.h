@@ -0,0 +1,155 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/paymentvalidator.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTVALIDATOR_H
+#define PAYMENTVALIDATOR_H
+
+#include <QCoreApplication>
+#include <QVector>
+#include <QList>
+#include <QString>
+#include <QFuture>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/Values/paymentvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class Payment;
+
+namespace Payments {
+
+/*!
+ * \brief Checks payment drafts against the rules the PayPal API applies when creating a payment.
+ *
+ * These are the same checks Create performs before sending a request, available without an operation
+ * and without a network connection. Other than Create, the validator does not stop at the first violation,
+ * it returns all found issues with the index of the affected transaction and item, so bulk jobs can report
+ * and reject bad drafts before spending API calls on them.
+ *
+ * Lists of payments are validated in parallel by the global QThreadPool. The parallel functions only take
+ * PaymentValue snapshots, create them with Payment::toValue() on the thread the payments live in. The
+ * worker threads never touch the Payment objects, so they can be changed or deleted right after the
+ * snapshots have been taken.
+ *
+ * \code{.cpp}
+ * QList<Geltan::PP::PaymentValue> values;
+ * for (const Geltan::PP::Payment *draft : drafts) {
+ *     values.append(draft->toValue());
+ * }
+ * const QVector<Geltan::PP::Payments::PaymentValidator::Issues> results = Geltan::PP::Payments::PaymentValidator::validate(values);
+ * for (int i = 0; i < results.size(); ++i) {
+ *     for (const Geltan::PP::Payments::PaymentValidator::Issue &issue : results.at(i)) {
+ *         qWarning() << "Draft" << i << "transaction" << issue.transaction << issue.message;
+ *     }
+ * }
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Payments/paymentvalidator.h>
+ */
+class GELTANSHARED_EXPORT PaymentValidator
+{
+    Q_DECLARE_TR_FUNCTIONS(PaymentValidator)
+public:
+    /*!
+     * \brief The violated rule.
+     */
+    enum Rule {
+        NoPayment,                      /**< The payment is a \c nullptr. */
+        NoIntent,                       /**< The payment has no intent. */
+        NoPayer,                        /**< The payment has no Payer object. */
+        NoTransactions,                 /**< The payment has no transactions. */
+        InvalidRedirectUrls,            /**< PayPal payments need valid redirect URLs. */
+        ReferenceIdNotAllowed,          /**< PayPal payments must not have a reference ID. */
+        InvalidCreditCardData,          /**< The credit card data is not valid. */
+        NoAmount,                       /**< The transaction has no amount. */
+        InvalidAmount,                  /**< The amount data is missing values or the values do not sum up. */
+        HandlingFeeNotSupported,        /**< Handling fees need the PayPal payment method. */
+        ShippingDiscountNotSupported,   /**< Shipping discounts need the PayPal payment method. */
+        InsuranceNotSupported,          /**< Insurance needs the PayPal payment method. */
+        InvalidItemQuantity,            /**< The item quantity is less than one. */
+        ItemCurrencyMismatch,           /**< The item currency differs from the transaction currency. */
+        ItemDescriptionNotSupported,    /**< Item descriptions need the PayPal payment method. */
+        ItemTaxNotSupported,            /**< Per item taxes need the PayPal payment method. */
+        ItemTotalMismatch,              /**< The item prices do not sum up to the transaction total. */
+        ItemSubtotalMismatch,           /**< The item prices do not sum up to the transaction subtotal. */
+        ItemTaxMismatch,                /**< The item taxes do not sum up to the transaction tax. */
+        ItemFieldTooLong,               /**< The item name, SKU, description or currency is longer than the API accepts. */
+        ShippingAddressFieldTooLong     /**< A member of the transaction's shipping address is longer than the API accepts. */
+    };
+
+    /*!
+     * \brief A single rule violation.
+     */
+    struct Issue {
+        Rule rule;          /**< The violated rule. */
+        int transaction;    /**< Index of the affected transaction, -1 if the payment itself is affected. */
+        int item;           /**< Index of the affected item in the transaction's item list, -1 if no item is affected. */
+        QString message;    /**< Translated description of the violation. */
+    };
+
+    /*!
+     * \brief List of the rule violations of a payment, empty if the payment is valid.
+     */
+    typedef QVector<Issue> Issues;
+
+    /*!
+     * \brief Validates a single \a payment on the calling thread.
+     *
+     * If \a stopAtFirst is true, the validation stops at the first violation, which is the fastest way to
+     * check if a payment is valid.
+     */
+    static Issues validate(const Payment *payment, bool stopAtFirst = false);
+
+    /*!
+     * \brief Validates a single \a payment snapshot.
+     * \overload
+     */
+    static Issues validate(const PaymentValue &payment, bool stopAtFirst = false);
+
+    /*!
+     * \brief Validates the \a payments in parallel and blocks until all are done.
+     *
+     * The result contains the issues for each payment at the same index.
+     */
+    static QVector<Issues> validate(const QList<PaymentValue> &payments);
+
+    /*!
+     * \brief Starts validating the \a payments in parallel and returns immediately.
+     *
+     * The results are available from the returned QFuture in the order of \a payments. Use a
+     * QFutureWatcher to get notified when results are ready.
+     */
+    static QFuture<Issues> validateAsync(const QList<PaymentValue> &payments);
+
+private:
+    PaymentValidator() {}
+
+    static Issues validateAll(const PaymentValue &payment);
+};
+
+}
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::Payments::PaymentValidator::Issue, Q_MOVABLE_TYPE);
+
+#endif // PAYMENTVALIDATOR_H
@@ -0,0 +1,455 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/shardedlist.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "shardedlist_p.h"
+#include <QSet>
+#include <algorithm>
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+using namespace Payments;
+
+ShardedList::ShardedList(QObject *parent) : PPBase(*new ShardedListPrivate, parent)
+{
+}
+
+
+
+ShardedList::ShardedList(ShardedListPrivate &dd, QObject *parent) : PPBase(dd, parent)
+{
+
+}
+
+
+
+ShardedList::~ShardedList()
+{
+
+}
+
+
+
+
+void ShardedList::call()
+{
+    Q_D(ShardedList);
+
+    if (inOperation()) {
+        return;
+    }
+
+    setError(nullptr);
+
+    if (!checkInput()) {
+        errorCallBack();
+        return;
+    }
+
+    setInOperation(true);
+
+    d->failed = false;
+    d->windows.clear();
+    d->pendingWindows.clear();
+    d->payments.clear();
+    d->received = 0;
+    Q_EMIT receivedChanged(0);
+
+    // start with one window per allowed request, dense windows will be split later
+    const qint64 rangeSecs = d->startTime.secsTo(d->endTime);
+    const qint64 rangeMSecs = d->startTime.msecsTo(d->endTime);
+    const int shards = static_cast<int>(qMax(Q_INT64_C(1), qMin(static_cast<qint64>(qMax(d->maxConcurrentRequests, 1)), rangeSecs / qMax(d->minimumWindow, 1))));
+
+    d->windows.reserve(shards);
+    for (int i = 0; i < shards; ++i) {
+        const QDateTime s = d->startTime.addMSecs(rangeMSecs * i / shards);
+        const QDateTime e = (i == (shards - 1)) ? d->endTime : d->startTime.addMSecs(rangeMSecs * (i + 1) / shards);
+        d->windows.append(ShardWindow(s, e));
+        d->pendingWindows.append(i);
+    }
+
+#ifdef QT_DEBUG
+    qDebug() << "Splitted time range from" << d->startTime << "to" << d->endTime << "into" << shards << "windows";
+#endif
+
+    startWindows();
+}
+
+
+
+
+void ShardedList::call(const QDateTime &startTime, const QDateTime &endTime)
+{
+    setStartTime(startTime);
+    setEndTime(endTime);
+
+    call();
+}
+
+
+
+
+QList<PaymentValue> ShardedList::payments() const { Q_D(const ShardedList); return d->payments; }
+
+
+
+
+void ShardedList::startWindows()
+{
+    Q_D(ShardedList);
+
+    while (!d->failed && !d->pendingWindows.isEmpty() && d->activeWorkers.count() < qMax(d->maxConcurrentRequests, 1)) {
+
+        const int idx = d->pendingWindows.takeFirst();
+
+        List *worker = nullptr;
+        if (d->idleWorkers.isEmpty()) {
+            worker = new List(this);
+            connect(worker, &List::succeeded, this, [this, worker]() { windowFinished(worker, true); });
+            connect(worker, &List::failed, this, [this, worker]() { windowFinished(worker, false); });
+        } else {
+            worker = d->idleWorkers.takeLast();
+        }
+
+        worker->setClientID(clientID());
+        worker->setSecret(secret());
+        worker->setToken(token());
+        worker->setTokenType(tokenType());
+        worker->setNetworkAccessManager(networkAccessManager());
+        worker->setRequestTimeout(requestTimeout());
+
+        worker->setCount(d->pageSize);
+        worker->setStartIndex(-1);
+        worker->setStartId(QString());
+        worker->setStartTime(d->windows.at(idx).start);
+        worker->setEndTime(d->windows.at(idx).end);
+        worker->setSortBy(d->sortBy);
+        worker->setSortOrder(d->sortOrder);
+
+        d->activeWorkers.insert(worker, idx);
+
+        worker->paginate([this, idx](const PPJsonValue &page) -> bool {
+            return consumeWindowPage(idx, page);
+        });
+    }
+}
+
+
+
+
+bool ShardedList::consumeWindowPage(int window, const PPJsonValue &page)
+{
+    Q_D(ShardedList);
+
+    if (d->failed) {
+        return false;
+    }
+
+    const PPJsonValue ps = page.value(QLatin1String("payments"));
+    const bool hasNext = !page.value(QLatin1String("next_id")).toString().isEmpty();
+
+    if (hasNext && d->windows.at(window).payments.isEmpty() && d->splittable(d->windows.at(window))) {
+
+        // the window contains more than one page, request its halves in parallel instead of paging through it
+        const QDateTime s = d->windows.at(window).start;
+        const QDateTime e = d->windows.at(window).end;
+        const QDateTime m = s.addMSecs(s.msecsTo(e) / 2);
+
+        d->windows[window].split = true;
+        d->windows.append(ShardWindow(s, m));
+        d->windows.append(ShardWindow(m, e));
+        d->pendingWindows.prepend(d->windows.count() - 1);
+        d->pendingWindows.prepend(d->windows.count() - 2);
+
+#ifdef QT_DEBUG
+        qDebug() << "Splitted dense window from" << s << "to" << e << "at" << m;
+#endif
+
+        startWindows();
+
+        return false;
+    }
+
+    QList<PaymentValue> &wps = d->windows[window].payments;
+    wps.reserve(wps.count() + ps.count());
+    for (const PPJsonValue &p : ps) {
+        wps.append(PaymentValue::fromJson(p));
+    }
+
+    d->received += ps.count();
+    Q_EMIT receivedChanged(d->received);
+
+    return true;
+}
+
+
+
+
+void ShardedList::windowFinished(List *worker, bool success)
+{
+    Q_D(ShardedList);
+
+    const int idx = d->activeWorkers.take(worker);
+    d->idleWorkers.append(worker);
+
+    if (!success) {
+        if (!d->failed) {
+            d->failed = true;
+            const Error *e = worker->error();
+            if (e) {
+                setError(new Error(e->type(), e->text(), e->severity(), e->data(), this));
+            } else {
+                setError(new Error(Error::RequestError, tr("Failed to request the payments of a time window."), Error::Critical, QString(), this));
+            }
+        }
+    } else if (!d->windows.at(idx).split) {
+        d->windows[idx].done = true;
+    }
+
+    if (d->failed) {
+        if (d->activeWorkers.isEmpty()) {
+            d->windows.clear();
+            d->pendingWindows.clear();
+            errorCallBack();
+        }
+        return;
+    }
+
+    startWindows();
+
+    if (d->activeWorkers.isEmpty() && d->pendingWindows.isEmpty()) {
+        finish();
+    }
+}
+
+
+
+
+void ShardedList::finish()
+{
+    Q_D(ShardedList);
+
+    QVector<const ShardWindow*> done;
+    done.reserve(d->windows.count());
+    for (const ShardWindow &w : d->windows) {
+        if (w.done) {
+            done.append(&w);
+        }
+    }
+
+    std::sort(done.begin(), done.end(), [](const ShardWindow *a, const ShardWindow *b) {
+        return a->start < b->start;
+    });
+
+    QList<PaymentValue> merged;
+    merged.reserve(d->received);
+    QSet<QString> seen;
+    seen.reserve(d->received);
+
+    // windows share their borders, so payments at a border might be returned twice
+    for (const ShardWindow *w : done) {
+        for (const PaymentValue &p : w->payments) {
+            if (!seen.contains(p.id())) {
+                seen.insert(p.id());
+                merged.append(p);
+            }
+        }
+    }
+
+    d->windows.clear();
+
+    const bool byCreateTime = (d->sortBy == List::CreateTime);
+    const bool ascending = (d->sortOrder == Qt::AscendingOrder);
+
+    std::stable_sort(merged.begin(), merged.end(), [byCreateTime, ascending](const PaymentValue &a, const PaymentValue &b) {
+        const qint64 ta = byCreateTime ? a.createTimeMSecs() : a.updateTimeMSecs();
+        const qint64 tb = byCreateTime ? b.createTimeMSecs() : b.updateTimeMSecs();
+        return ascending ? (ta < tb) : (tb < ta);
+    });
+
+    d->payments = merged;
+
+#ifdef QT_DEBUG
+    qDebug() << "Merged" << d->payments.count() << "payments";
+#endif
+
+    successCallBack();
+}
+
+
+
+
+void ShardedList::successCallBack()
+{
+    setInOperation(false);
+    Q_EMIT succeeded();
+}
+
+
+
+void ShardedList::errorCallBack()
+{
+    setInOperation(false);
+    Q_EMIT failed();
+}
+
+
+
+bool ShardedList::checkInput()
+{
+    if (!startTime().isValid() || !endTime().isValid()) {
+        setError(new Error(Error::InputError, tr("The start and the end time are required for a sharded list."), Error::Critical, QString(), this));
+        return false;
+    }
+
+    if (startTime() >= endTime()) {
+        setError(new Error(Error::InputError, tr("The end time has to be later than the start time."), Error::Critical, QString(), this));
+        return false;
+    }
+
+    return true;
+}
+
+
+
+
+QDateTime ShardedList::startTime() const { Q_D(const ShardedList); return d->startTime; }
+
+void ShardedList::setStartTime(const QDateTime &nStartTime)
+{
+    Q_D(ShardedList);
+    if (nStartTime != d->startTime) {
+        d->startTime = nStartTime;
+#ifdef QT_DEBUG
+        qDebug() << "Changed startTime to" << d->startTime;
+#endif
+        Q_EMIT startTimeChanged(startTime());
+    }
+}
+
+
+
+
+QDateTime ShardedList::endTime() const { Q_D(const ShardedList); return d->endTime; }
+
+void ShardedList::setEndTime(const QDateTime &nEndTime)
+{
+    Q_D(ShardedList);
+    if (nEndTime != d->endTime) {
+        d->endTime = nEndTime;
+#ifdef QT_DEBUG
+        qDebug() << "Changed endTime to" << d->endTime;
+#endif
+        Q_EMIT endTimeChanged(endTime());
+    }
+}
+
+
+
+
+List::SortBy ShardedList::sortBy() const { Q_D(const ShardedList); return d->sortBy; }
+
+void ShardedList::setSortBy(List::SortBy nSortBy)
+{
+    Q_D(ShardedList);
+    if (nSortBy != d->sortBy) {
+        d->sortBy = nSortBy;
+#ifdef QT_DEBUG
+        qDebug() << "Changed sortBy to" << d->sortBy;
+#endif
+        Q_EMIT sortByChanged(sortBy());
+    }
+}
+
+
+
+
+Qt::SortOrder ShardedList::sortOrder() const { Q_D(const ShardedList); return d->sortOrder; }
+
+void ShardedList::setSortOrder(Qt::SortOrder nSortOrder)
+{
+    Q_D(ShardedList);
+    if (nSortOrder != d->sortOrder) {
+        d->sortOrder = nSortOrder;
+#ifdef QT_DEBUG
+        qDebug() << "Changed sortOrder to" << d->sortOrder;
+#endif
+        Q_EMIT sortOrderChanged(sortOrder());
+    }
+}
+
+
+
+
+int ShardedList::maxConcurrentRequests() const { Q_D(const ShardedList); return d->maxConcurrentRequests; }
+
+void ShardedList::setMaxConcurrentRequests(int nMaxConcurrentRequests)
+{
+    Q_D(ShardedList);
+    if (nMaxConcurrentRequests != d->maxConcurrentRequests) {
+        d->maxConcurrentRequests = nMaxConcurrentRequests;
+#ifdef QT_DEBUG
+        qDebug() << "Changed maxConcurrentRequests to" << d->maxConcurrentRequests;
+#endif
+        Q_EMIT maxConcurrentRequestsChanged(maxConcurrentRequests());
+    }
+}
+
+
+
+
+int ShardedList::pageSize() const { Q_D(const ShardedList); return d->pageSize; }
+
+void ShardedList::setPageSize(int nPageSize)
+{
+    Q_D(ShardedList);
+    if (nPageSize != d->pageSize) {
+        d->pageSize = nPageSize;
+#ifdef QT_DEBUG
+        qDebug() << "Changed pageSize to" << d->pageSize;
+#endif
+        Q_EMIT pageSizeChanged(pageSize());
+    }
+}
+
+
+
+
+int ShardedList::minimumWindow() const { Q_D(const ShardedList); return d->minimumWindow; }
+
+void ShardedList::setMinimumWindow(int nMinimumWindow)
+{
+    Q_D(ShardedList);
+    if (nMinimumWindow != d->minimumWindow) {
+        d->minimumWindow = nMinimumWindow;
+#ifdef QT_DEBUG
+        qDebug() << "Changed minimumWindow to" << d->minimumWindow;
+#endif
+        Q_EMIT minimumWindowChanged(minimumWindow());
+    }
+}
+
+
+
+
+int ShardedList::received() const { Q_D(const ShardedList); return d->received; }
@@ -0,0 +1,232 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/shardedlist.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARDEDLISTPAYMENTS_H
+#define SHARDEDLISTPAYMENTS_H
+
+#include "../ppbase.h"
+#include "list.h"
+#include <QDateTime>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentValue;
+
+namespace Payments {
+
+class ShardedListPrivate;
+
+/*!
+ * \brief Requests all payments in a time range by splitting it into concurrently fetched windows.
+ *
+ * Paging through a long time range with a single List operation needs one round trip after
+ * the other. ShardedList splits the range between \link ShardedList::startTime startTime \endlink
+ * and \link ShardedList::endTime endTime \endlink into time windows that are requested by
+ * internal List operations in parallel, limited per instance by \link ShardedList::maxConcurrentRequests maxConcurrentRequests \endlink.
+ *
+ * The window sizes adapt to the data: if the first page of a window already has a next page,
+ * the window is considered dense and is split into two halves that are requested separately,
+ * as long as the halves are not shorter than \link ShardedList::minimumWindow minimumWindow \endlink.
+ * Windows that can not be split further are paged through sequentially.
+ *
+ * When all windows have been fetched, the results are merged into a single list sorted by
+ * \link ShardedList::sortBy sortBy \endlink and \link ShardedList::sortOrder sortOrder \endlink
+ * that is available via payments(). Payments returned by more than one window are only
+ * contained once.
+ *
+ * The credentials, the network access manager and the request timeout of the ShardedList
+ * are used for the internal List operations.
+ *
+ * \ppPaymentsApi{payment_list}
+ *
+ * \headerfile "" <Geltan/PP/Payments/shardedlist.h>
+ */
+class GELTANSHARED_EXPORT ShardedList : public PPBase
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(ShardedList)
+    /*!
+     * \brief The start of the time range. Required.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QDateTime</TD><TD>startTime() const</TD></TR><TR><TD>void</TD><TD>setStartTime(const QDateTime &nStartTime)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>startTimeChanged(const QDateTime &startTime)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QDateTime startTime READ startTime WRITE setStartTime NOTIFY startTimeChanged)
+    /*!
+     * \brief The end of the time range. Required.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QDateTime</TD><TD>endTime() const</TD></TR><TR><TD>void</TD><TD>setEndTime(const QDateTime &nEndTime)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>endTimeChanged(const QDateTime &endTime)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QDateTime endTime READ endTime WRITE setEndTime NOTIFY endTimeChanged)
+    /*!
+     * \brief The value the merged results should be sorted by. Default: List::CreateTime
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>List::SortBy</TD><TD>sortBy() const</TD></TR><TR><TD>void</TD><TD>setSortBy(List::SortBy nSortBy)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>sortByChanged(List::SortBy sortBy)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::Payments::List::SortBy sortBy READ sortBy WRITE setSortBy NOTIFY sortByChanged)
+    /*!
+     * \brief The way the merged results are sorted. Default: Qt::AscendingOrder
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Qt::SortOrder</TD><TD>sortOrder() const</TD></TR><TR><TD>void</TD><TD>setSortOrder(Qt::SortOrder nSortOrder)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>sortOrderChanged(Qt::SortOrder sortOrder)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged)
+    /*!
+     * \brief The maximum number of requests this ShardedList performs at the same time. The default is \a 4.
+     *
+     * The limit applies per instance, it is not shared with other ShardedList or List operations. Several
+     * ShardedList objects running at the same time can together perform the sum of their limits, so lower
+     * the limits accordingly or run them one after the other if the total load on the API matters.
+     *
+     * Note that QNetworkAccessManager itself does not open more than six connections to the same host,
+     * further requests on the same manager are queued by it.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>maxConcurrentRequests() const</TD></TR><TR><TD>void</TD><TD>setMaxConcurrentRequests(int nMaxConcurrentRequests)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>maxConcurrentRequestsChanged(int maxConcurrentRequests)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int maxConcurrentRequests READ maxConcurrentRequests WRITE setMaxConcurrentRequests NOTIFY maxConcurrentRequestsChanged)
+    /*!
+     * \brief The number of payments requested per page. The default is \a 20.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>pageSize() const</TD></TR><TR><TD>void</TD><TD>setPageSize(int nPageSize)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>pageSizeChanged(int pageSize)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+    /*!
+     * \brief The minimum length of a time window in seconds. The default is \a 60.
+     *
+     * Dense windows will not be split into halves shorter than this.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>minimumWindow() const</TD></TR><TR><TD>void</TD><TD>setMinimumWindow(int nMinimumWindow)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>minimumWindowChanged(int minimumWindow)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int minimumWindow READ minimumWindow WRITE setMinimumWindow NOTIFY minimumWindowChanged)
+    /*!
+     * \brief The number of payments that have been received by the current or last call.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>received() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>receivedChanged(int received)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int received READ received NOTIFY receivedChanged)
+public:
+    /*!
+     * \brief Constructs a new ShardedList object.
+     */
+    ShardedList(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the ShardedList object.
+     */
+    ~ShardedList();
+
+    /*!
+     * \brief Invokes the API calls.
+     */
+    Q_INVOKABLE void call();
+
+    /*!
+     * \brief Invokes the API calls.
+     * \overload
+     */
+    Q_INVOKABLE void call(const QDateTime &startTime, const QDateTime &endTime);
+
+    /*!
+     * \brief Returns the merged payments of the last successful call.
+     */
+    QList<PaymentValue> payments() const;
+
+    QDateTime startTime() const;
+    QDateTime endTime() const;
+    List::SortBy sortBy() const;
+    Qt::SortOrder sortOrder() const;
+    int maxConcurrentRequests() const;
+    int pageSize() const;
+    int minimumWindow() const;
+    int received() const;
+
+    void setStartTime(const QDateTime &nStartTime);
+    void setEndTime(const QDateTime &nEndTime);
+    void setSortBy(List::SortBy nSortBy);
+    void setSortOrder(Qt::SortOrder nSortOrder);
+    void setMaxConcurrentRequests(int nMaxConcurrentRequests);
+    void setPageSize(int nPageSize);
+    void setMinimumWindow(int nMinimumWindow);
+
+Q_SIGNALS:
+    /*!
+     * \brief This signal will be emitted when all windows have been fetched and merged.
+     */
+    void succeeded();
+
+    /*!
+     * \brief This signal will be emitted when one of the requests failed.
+     */
+    void failed();
+
+    void startTimeChanged(const QDateTime &startTime);
+    void endTimeChanged(const QDateTime &endTime);
+    void sortByChanged(List::SortBy sortBy);
+    void sortOrderChanged(Qt::SortOrder sortOrder);
+    void maxConcurrentRequestsChanged(int maxConcurrentRequests);
+    void pageSizeChanged(int pageSize);
+    void minimumWindowChanged(int minimumWindow);
+    void receivedChanged(int received);
+
+protected:
+    void successCallBack() Q_DECL_OVERRIDE;
+    void errorCallBack() Q_DECL_OVERRIDE;
+    bool checkInput() Q_DECL_OVERRIDE;
+
+    ShardedList(ShardedListPrivate &dd, QObject *parent = nullptr);
+
+private:
+    Q_DISABLE_COPY(ShardedList)
+
+    void startWindows();
+    bool consumeWindowPage(int window, const PPJsonValue &page);
+    void windowFinished(List *worker, bool success);
+    void finish();
+};
+
+}
+}
+}
+
+#endif // SHARDEDLISTPAYMENTS_H
@@ -0,0 +1,92 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/shardedlist_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARDEDLISTPAYMENTS_P_H
+#define SHARDEDLISTPAYMENTS_P_H
+
+#include "shardedlist.h"
+#include "../ppbase_p.h"
+#include "../Values/paymentvalue.h"
+#include <QHash>
+#include <QVector>
+
+namespace Geltan {
+namespace PP {
+namespace Payments {
+
+/*!
+ * \internal
+ * \brief A time window of the range requested by ShardedList.
+ */
+struct ShardWindow
+{
+    ShardWindow() : split(false), done(false) {}
+    ShardWindow(const QDateTime &s, const QDateTime &e) : start(s), end(e), split(false), done(false) {}
+
+    QDateTime start;
+    QDateTime end;
+    QList<PaymentValue> payments;
+    bool split;
+    bool done;
+};
+
+class ShardedListPrivate : public PPBasePrivate {
+public:
+    ShardedListPrivate() :
+        sortBy(List::CreateTime),
+        sortOrder(Qt::AscendingOrder),
+        maxConcurrentRequests(4),
+        pageSize(20),
+        minimumWindow(60),
+        received(0),
+        failed(false)
+    {}
+
+    /*!
+     * \internal
+     * \brief Returns true if \a window is long enough to be split into two halves.
+     */
+    bool splittable(const ShardWindow &window) const
+    {
+        return (window.start.secsTo(window.end) >= (2 * static_cast<qint64>(qMax(minimumWindow, 1))));
+    }
+
+    QDateTime startTime;
+    QDateTime endTime;
+    List::SortBy sortBy;
+    Qt::SortOrder sortOrder;
+    int maxConcurrentRequests;
+    int pageSize;
+    int minimumWindow;
+    int received;
+    bool failed;
+    QVector<ShardWindow> windows;
+    QList<int> pendingWindows;
+    QHash<List*, int> activeWorkers;
+    QList<List*> idleWorkers;
+    QList<PaymentValue> payments;
+};
+
+}
+}
+}
+
+#endif // SHARDEDLISTPAYMENTS_P_H
@@ -0,0 +1,428 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/sync.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "sync_p.h"
+#include "../Values/paymentvalue.h"
+#include <QFile>
+#include <QSaveFile>
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+using namespace Payments;
+
+Sync::Sync(QObject *parent) : PPBase(*new SyncPrivate, parent)
+{
+}
+
+
+
+Sync::Sync(SyncPrivate &dd, QObject *parent) : PPBase(dd, parent)
+{
+
+}
+
+
+
+Sync::~Sync()
+{
+
+}
+
+
+
+
+void Sync::call()
+{
+    Q_D(Sync);
+
+    if (inOperation()) {
+        return;
+    }
+
+    setError(nullptr);
+    setInOperation(true);
+
+    loadWatermark();
+
+    d->aborted = false;
+    d->changed = 0;
+    d->runWatermark = d->watermark;
+
+    if (!d->worker) {
+        d->worker = new List(this);
+        connect(d->worker, &List::succeeded, this, [this]() { runFinished(true); });
+        connect(d->worker, &List::failed, this, [this]() { runFinished(false); });
+    }
+
+    d->worker->setClientID(clientID());
+    d->worker->setSecret(secret());
+    d->worker->setToken(token());
+    d->worker->setTokenType(tokenType());
+    d->worker->setNetworkAccessManager(networkAccessManager());
+    d->worker->setRequestTimeout(requestTimeout());
+
+    // the list API filters by creation time only, so the newest updates are requested first
+    // and the pagination stops at the first payment that is older than the watermark
+    d->worker->setCount(d->pageSize);
+    d->worker->setStartIndex(-1);
+    d->worker->setStartId(QString());
+    d->worker->setStartTime(QDateTime());
+    d->worker->setEndTime(QDateTime());
+    d->worker->setSortBy(List::UpdateTime);
+    d->worker->setSortOrder(Qt::DescendingOrder);
+
+#ifdef QT_DEBUG
+    qDebug() << "Start synchronizing payments updated since" << d->watermark;
+#endif
+
+    d->worker->paginate([this](const PPJsonValue &page) -> bool {
+        return consumePage(page);
+    });
+}
+
+
+
+
+void Sync::start()
+{
+    Q_D(Sync);
+
+    if (!d->timer) {
+        d->timer = new QTimer(this);
+        d->timer->setTimerType(Qt::VeryCoarseTimer);
+        connect(d->timer, &QTimer::timeout, this, [this]() { call(); });
+    }
+
+    const bool wasActive = d->timer->isActive();
+
+    d->timer->start(qMax(d->interval, 1) * 1000);
+
+    if (!wasActive) {
+        Q_EMIT activeChanged(true);
+    }
+
+    call();
+}
+
+
+
+
+void Sync::stop()
+{
+    Q_D(Sync);
+
+    if (d->timer && d->timer->isActive()) {
+        d->timer->stop();
+        Q_EMIT activeChanged(false);
+    }
+}
+
+
+
+
+void Sync::setSink(const Sink &sink)
+{
+    Q_D(Sync);
+    d->sink = sink;
+}
+
+
+
+
+/*
+ * Returns the update time of the payment, or the creation time if it has never been updated.
+ */
+static QDateTime syncTime(const PaymentValue &v)
+{
+    const QDateTime ut = v.updateTime();
+    return ut.isValid() ? ut : v.createTime();
+}
+
+
+
+bool Sync::consumePage(const PPJsonValue &page)
+{
+    Q_D(Sync);
+
+    const PPJsonValue ps = page.value(QLatin1String("payments"));
+
+    QList<PaymentValue> changed;
+    changed.reserve(ps.count());
+    bool reachedWatermark = false;
+
+    for (const PPJsonValue &p : ps) {
+        const PaymentValue v = PaymentValue::fromJson(p);
+        // a payment without any valid time can not be compared, so it is treated as changed
+        const QDateTime t = syncTime(v);
+        if (d->watermark.isValid() && t.isValid() && (t < d->watermark)) {
+            reachedWatermark = true;
+            break;
+        }
+        changed.append(v);
+    }
+
+    if (d->store && !changed.isEmpty() && !d->store->store(changed)) {
+        d->aborted = true;
+        setError(new Error(Error::OutputError, tr("Failed to write the synchronized payments to the store."), Error::Critical, d->store->lastError(), this));
+        return false;
+    }
+
+    for (const PaymentValue &v : changed) {
+        if (d->sink && !d->sink(v)) {
+            d->aborted = true;
+            setError(new Error(Error::OutputError, tr("The synchronization has been aborted by the sink."), Error::Warning, QString(), this));
+            return false;
+        }
+        const QDateTime t = syncTime(v);
+        if (t.isValid() && (!d->runWatermark.isValid() || (t > d->runWatermark))) {
+            d->runWatermark = t;
+        }
+    }
+
+    d->changed += changed.count();
+
+    return !reachedWatermark;
+}
+
+
+
+
+void Sync::runFinished(bool success)
+{
+    Q_D(Sync);
+
+    if (!success) {
+        const Error *e = d->worker->error();
+        if (e) {
+            setError(new Error(e->type(), e->text(), e->severity(), e->data(), this));
+        }
+        errorCallBack();
+        return;
+    }
+
+    if (d->aborted) {
+        errorCallBack();
+        return;
+    }
+
+    if (d->runWatermark != d->watermark) {
+        d->watermark = d->runWatermark;
+        saveWatermark();
+        Q_EMIT watermarkChanged(d->watermark);
+    }
+
+#ifdef QT_DEBUG
+    qDebug() << "Synchronized" << d->changed << "payments, new watermark is" << d->watermark;
+#endif
+
+    successCallBack();
+}
+
+
+
+
+void Sync::loadWatermark()
+{
+    Q_D(Sync);
+
+    if (d->watermarkLoaded) {
+        return;
+    }
+
+    QDateTime wm;
+
+    if (d->store) {
+        wm = d->store->watermark(d->name);
+    } else if (!d->stateFile.isEmpty()) {
+        QFile f(d->stateFile);
+        if (f.open(QIODevice::ReadOnly)) {
+            bool ok = false;
+            const qint64 msecs = f.readAll().trimmed().toLongLong(&ok);
+            if (ok) {
+                wm = QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+            }
+        }
+    }
+
+    d->watermarkLoaded = true;
+
+    if (wm.isValid() && (wm != d->watermark)) {
+        d->watermark = wm;
+        Q_EMIT watermarkChanged(d->watermark);
+    }
+}
+
+
+
+
+void Sync::saveWatermark()
+{
+    Q_D(Sync);
+
+    if (d->store) {
+        d->store->setWatermark(d->name, d->watermark);
+    } else if (!d->stateFile.isEmpty()) {
+        // QSaveFile replaces the file atomically, a crash while writing keeps the old watermark
+        QSaveFile f(d->stateFile);
+        if (f.open(QIODevice::WriteOnly)) {
+            if (d->watermark.isValid()) {
+                f.write(QByteArray::number(d->watermark.toMSecsSinceEpoch()));
+            }
+            f.commit();
+        }
+    }
+}
+
+
+
+
+void Sync::successCallBack()
+{
+    Q_D(Sync);
+    setInOperation(false);
+    Q_EMIT succeeded(d->changed);
+}
+
+
+
+void Sync::errorCallBack()
+{
+    setInOperation(false);
+    Q_EMIT failed();
+}
+
+
+
+
+QDateTime Sync::watermark() const { Q_D(const Sync); return d->watermark; }
+
+void Sync::setWatermark(const QDateTime &nWatermark)
+{
+    Q_D(Sync);
+    d->watermarkLoaded = true;
+    if (nWatermark != d->watermark) {
+        d->watermark = nWatermark;
+        saveWatermark();
+#ifdef QT_DEBUG
+        qDebug() << "Changed watermark to" << d->watermark;
+#endif
+        Q_EMIT watermarkChanged(watermark());
+    }
+}
+
+
+
+
+QString Sync::name() const { Q_D(const Sync); return d->name; }
+
+void Sync::setName(const QString &nName)
+{
+    Q_D(Sync);
+    if (nName != d->name) {
+        d->name = nName;
+        d->watermarkLoaded = false;
+#ifdef QT_DEBUG
+        qDebug() << "Changed name to" << d->name;
+#endif
+        Q_EMIT nameChanged(name());
+    }
+}
+
+
+
+
+PaymentStore *Sync::store() const { Q_D(const Sync); return d->store.data(); }
+
+void Sync::setStore(PaymentStore *nStore)
+{
+    Q_D(Sync);
+    if (nStore != d->store) {
+        d->store = nStore;
+        d->watermarkLoaded = false;
+#ifdef QT_DEBUG
+        qDebug() << "Changed store to" << d->store;
+#endif
+        Q_EMIT storeChanged(store());
+    }
+}
+
+
+
+
+QString Sync::stateFile() const { Q_D(const Sync); return d->stateFile; }
+
+void Sync::setStateFile(const QString &nStateFile)
+{
+    Q_D(Sync);
+    if (nStateFile != d->stateFile) {
+        d->stateFile = nStateFile;
+        d->watermarkLoaded = false;
+#ifdef QT_DEBUG
+        qDebug() << "Changed stateFile to" << d->stateFile;
+#endif
+        Q_EMIT stateFileChanged(stateFile());
+    }
+}
+
+
+
+
+int Sync::interval() const { Q_D(const Sync); return d->interval; }
+
+void Sync::setInterval(int nInterval)
+{
+    Q_D(Sync);
+    if (nInterval != d->interval) {
+        d->interval = nInterval;
+        if (d->timer && d->timer->isActive()) {
+            d->timer->setInterval(qMax(d->interval, 1) * 1000);
+        }
+#ifdef QT_DEBUG
+        qDebug() << "Changed interval to" << d->interval;
+#endif
+        Q_EMIT intervalChanged(interval());
+    }
+}
+
+
+
+
+int Sync::pageSize() const { Q_D(const Sync); return d->pageSize; }
+
+void Sync::setPageSize(int nPageSize)
+{
+    Q_D(Sync);
+    if (nPageSize != d->pageSize) {
+        d->pageSize = nPageSize;
+#ifdef QT_DEBUG
+        qDebug() << "Changed pageSize to" << d->pageSize;
+#endif
+        Q_EMIT pageSizeChanged(pageSize());
+    }
+}
+
+
+
+
+bool Sync::active() const { Q_D(const Sync); return (d->timer && d->timer->isActive()); }
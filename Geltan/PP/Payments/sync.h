@@ -0,0 +1,238 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/sync.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNCPAYMENTS_H
+#define SYNCPAYMENTS_H
+
+#include "../ppbase.h"
+#include <QDateTime>
+#include <functional>
+
+class QJsonObject;
+
+namespace Geltan {
+namespace PP {
+
+class PaymentValue;
+class PaymentStore;
+
+namespace Payments {
+
+class SyncPrivate;
+
+/*!
+ * \brief Keeps local payment data up to date by requesting only the payments updated since the last run.
+ *
+ * Sync saves the highest \c update_time of all payments it has processed as \link Sync::watermark watermark \endlink.
+ * Every run lists the payments sorted by update time in descending order and stops at the first payment
+ * that has not been updated since the watermark, so in the steady state a run only needs a single small
+ * request. As the list API filters by creation time only, the time range of the request can not be
+ * used for this.
+ *
+ * The changed payments are written to the \link Sync::store store \endlink and/or handed to the sink
+ * set by setSink(). The watermark is only advanced and saved after a run has been completed, so after
+ * a crash or a failed request the next run continues at the last saved watermark. Payments that have
+ * been updated exactly at the watermark time will be processed again, so the sink should handle
+ * payments idempotently. Payments without an \c update_time are compared by their \c create_time, payments
+ * without any valid time are always treated as changed and never end a run.
+ *
+ * The watermark is saved in the store if one has been set, otherwise in the \link Sync::stateFile stateFile \endlink.
+ * If neither is set, the watermark is only kept in memory.
+ *
+ * \code{.cpp}
+ * Geltan::PP::Payments::Sync *sync = new Geltan::PP::Payments::Sync(this);
+ * sync->setToken(token);
+ * sync->setStore(store);
+ * sync->setInterval(300);
+ * sync->start();
+ * \endcode
+ *
+ * \ppPaymentsApi{payment_list}
+ *
+ * \headerfile "" <Geltan/PP/Payments/sync.h>
+ */
+class GELTANSHARED_EXPORT Sync : public PPBase
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(Sync)
+    /*!
+     * \brief The highest update time of all processed payments.
+     *
+     * Setting the watermark saves it. Set it before the first run to not synchronize the complete history.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QDateTime</TD><TD>watermark() const</TD></TR><TR><TD>void</TD><TD>setWatermark(const QDateTime &nWatermark)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>watermarkChanged(const QDateTime &watermark)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QDateTime watermark READ watermark WRITE setWatermark NOTIFY watermarkChanged)
+    /*!
+     * \brief The name used to save the watermark in the store. The default is \a payments.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>name() const</TD></TR><TR><TD>void</TD><TD>setName(const QString &nName)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>nameChanged(const QString &name)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    /*!
+     * \brief The store the changed payments and the watermark are written to.
+     *
+     * The Sync object does not take ownership of the store.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>PaymentStore*</TD><TD>store() const</TD></TR><TR><TD>void</TD><TD>setStore(PaymentStore *nStore)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>storeChanged(PaymentStore *store)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::PaymentStore *store READ store WRITE setStore NOTIFY storeChanged)
+    /*!
+     * \brief Path to a file the watermark is saved to if no store is set.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>stateFile() const</TD></TR><TR><TD>void</TD><TD>setStateFile(const QString &nStateFile)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>stateFileChanged(const QString &stateFile)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString stateFile READ stateFile WRITE setStateFile NOTIFY stateFileChanged)
+    /*!
+     * \brief Seconds between two runs after start() has been called. The default is \a 300.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>interval() const</TD></TR><TR><TD>void</TD><TD>setInterval(int nInterval)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>intervalChanged(int interval)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged)
+    /*!
+     * \brief The number of payments requested per page. The default is \a 20.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>pageSize() const</TD></TR><TR><TD>void</TD><TD>setPageSize(int nPageSize)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>pageSizeChanged(int pageSize)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+    /*!
+     * \brief Returns true if the periodic synchronization has been started.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>active() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>activeChanged(bool active)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool active READ active NOTIFY activeChanged)
+public:
+    /*!
+     * \brief Function that gets the changed payments. Has to return false to abort the run.
+     */
+    typedef std::function<bool(const PaymentValue &payment)> Sink;
+
+    /*!
+     * \brief Constructs a new Sync object.
+     */
+    Sync(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the Sync object.
+     */
+    ~Sync();
+
+    /*!
+     * \brief Performs a single synchronization run.
+     *
+     * Does nothing if a run is already in operation.
+     */
+    Q_INVOKABLE void call();
+
+    /*!
+     * \brief Performs a synchronization run now and then every \link Sync::interval interval \endlink seconds.
+     */
+    Q_INVOKABLE void start();
+
+    /*!
+     * \brief Stops the periodic synchronization. A running request will be finished.
+     */
+    Q_INVOKABLE void stop();
+
+    /*!
+     * \brief Sets the function that gets the changed payments.
+     *
+     * If the \a sink returns false, the run is aborted and the watermark is not advanced.
+     */
+    void setSink(const Sink &sink);
+
+    QDateTime watermark() const;
+    QString name() const;
+    PaymentStore *store() const;
+    QString stateFile() const;
+    int interval() const;
+    int pageSize() const;
+    bool active() const;
+
+    void setWatermark(const QDateTime &nWatermark);
+    void setName(const QString &nName);
+    void setStore(PaymentStore *nStore);
+    void setStateFile(const QString &nStateFile);
+    void setInterval(int nInterval);
+    void setPageSize(int nPageSize);
+
+Q_SIGNALS:
+    /*!
+     * \brief This signal will be emitted when a run has been completed.
+     *
+     * \a changed is the number of payments that have been processed by the run.
+     */
+    void succeeded(int changed);
+
+    /*!
+     * \brief This signal will be emitted when a run failed or has been aborted by the sink.
+     */
+    void failed();
+
+    void watermarkChanged(const QDateTime &watermark);
+    void nameChanged(const QString &name);
+    void storeChanged(PaymentStore *store);
+    void stateFileChanged(const QString &stateFile);
+    void intervalChanged(int interval);
+    void pageSizeChanged(int pageSize);
+    void activeChanged(bool active);
+
+protected:
+    void successCallBack() Q_DECL_OVERRIDE;
+    void errorCallBack() Q_DECL_OVERRIDE;
+
+    Sync(SyncPrivate &dd, QObject *parent = nullptr);
+
+private:
+    Q_DISABLE_COPY(Sync)
+
+    void loadWatermark();
+    void saveWatermark();
+    bool consumePage(const PPJsonValue &page);
+    void runFinished(bool success);
+};
+
+}
+}
+}
+
+#endif // SYNCPAYMENTS_H
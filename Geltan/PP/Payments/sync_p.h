@@ -0,0 +1,68 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/sync_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNCPAYMENTS_P_H
+#define SYNCPAYMENTS_P_H
+
+#include "sync.h"
+#include "list.h"
+#include "../ppbase_p.h"
+#include "../Store/paymentstore.h"
+#include <QPointer>
+#include <QTimer>
+
+namespace Geltan {
+namespace PP {
+namespace Payments {
+
+class SyncPrivate : public PPBasePrivate {
+public:
+    SyncPrivate() :
+        name(QStringLiteral("payments")),
+        interval(300),
+        pageSize(20),
+        watermarkLoaded(false),
+        aborted(false),
+        changed(0),
+        worker(nullptr),
+        timer(nullptr)
+    {}
+
+    QDateTime watermark;
+    QString name;
+    QPointer<PaymentStore> store;
+    QString stateFile;
+    int interval;
+    int pageSize;
+    Sync::Sink sink;
+    bool watermarkLoaded;
+    bool aborted;
+    int changed;
+    QDateTime runWatermark;
+    List *worker;
+    QTimer *timer;
+};
+
+}
+}
+}
+
+#endif // SYNCPAYMENTS_P_H
@@ -0,0 +1,201 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/update.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "update_p.h"
+#include <QJsonDocument>
+
+using namespace Geltan;
+using namespace PP;
+using namespace Payments;
+
+Update::Update(QObject *parent) : PPBase(*new UpdatePrivate, parent)
+{
+    Q_D(Update);
+    d->init(this);
+    setNetworkOperation(QNetworkAccessManager::CustomOperation);
+    setCustomVerb(QByteArrayLiteral("PATCH"));
+    setExpectedType(PPBase::Object);
+    addRequestHeader(QByteArrayLiteral("Content-Type"), QByteArrayLiteral("application/json"));
+}
+
+
+Update::Update(UpdatePrivate &dd, QObject *parent) : PPBase(dd, parent)
+{
+    Q_D(Update);
+    d->init(this);
+}
+
+
+
+
+void Update::call()
+{
+    Q_D(Update);
+
+    d->timer->stop();
+
+    if (!payment()) {
+        d->setPending(this, false);
+        setError(new Error(Error::InputError, tr("You have to set a payment in order to update it."), Error::Critical, QString(), this));
+        Q_EMIT failed();
+        return;
+    }
+
+    if (inOperation()) {
+        d->setPending(this, true);
+        return;
+    }
+
+    d->setPending(this, false);
+
+    const QJsonArray patch = payment()->jsonPatch();
+
+    if (patch.isEmpty()) {
+        Q_EMIT succeeded();
+        return;
+    }
+
+    setError(nullptr);
+    setInOperation(true);
+    setAuthentication();
+
+    d->sentPatch = patch;
+
+    setApiPath(QStringLiteral("/v1/payments/payment/%1").arg(payment()->id()));
+
+    setPayload(QJsonDocument(patch).toJson(QJsonDocument::Compact));
+
+    sendRequest();
+}
+
+
+
+void Update::call(Payment *payment)
+{
+    setPayment(payment);
+
+    call();
+}
+
+
+
+void Update::schedule()
+{
+    Q_D(Update);
+    d->timer->start();
+}
+
+
+
+void Update::successCallBack()
+{
+    Q_D(Update);
+
+    if (!payment()) {
+        // the payment has been deleted or replaced by nullptr while the request was running
+        d->sentPatch = QJsonArray();
+        d->setPending(this, false);
+        setError(new Error(Error::OutputError, tr("The payment has been removed before the update finished."), Error::Warning, QString(), this));
+        setInOperation(false);
+        Q_EMIT failed();
+        return;
+    }
+
+    payment()->commitPatch(d->sentPatch);
+    d->sentPatch = QJsonArray();
+
+    // only reload if no modifications have been made during the request, they would get lost otherwise
+    if (!payment()->isModified()) {
+        payment()->loadFromJson(jsonData().root());
+    }
+
+    setInOperation(false);
+    Q_EMIT succeeded();
+
+    if (d->pending) {
+        call();
+    }
+}
+
+
+
+void Update::errorCallBack()
+{
+    Q_D(Update);
+    // the modifications of the failed request have not been committed, so the next call() sends them
+    // together with the pending ones, pending stays set to show that they have not been sent
+    d->sentPatch = QJsonArray();
+    setInOperation(false);
+    Q_EMIT failed();
+}
+
+
+
+
+bool Update::checkInput()
+{
+    if (!payment()) {
+        setError(new Error(Error::InputError, tr("You have to set a payment in order to update it."), Error::Critical, QString(), this));
+        return false;
+    }
+
+    if (payment()->id().isEmpty()) {
+        setError(new Error(Error::InputError, tr("You have to set a payment ID in order to update a payment."), Error::Critical, QString(), this));
+        return false;
+    }
+
+    return true;
+}
+
+
+
+Payment *Update::payment() const { Q_D(const Update); return d->payment.data(); }
+
+void Update::setPayment(Payment *nPayment)
+{
+    Q_D(Update);
+    if (nPayment != d->payment) {
+        d->payment = nPayment;
+#ifdef QT_DEBUG
+        qDebug() << "Changed payment to" << d->payment;
+#endif
+        Q_EMIT paymentChanged(payment());
+    }
+}
+
+
+
+
+int Update::coalesceInterval() const { Q_D(const Update); return d->timer->interval(); }
+
+bool Update::pending() const { Q_D(const Update); return d->pending; }
+
+void Update::setCoalesceInterval(int nCoalesceInterval)
+{
+    Q_D(Update);
+    if (nCoalesceInterval != d->timer->interval()) {
+        d->timer->setInterval(nCoalesceInterval);
+#ifdef QT_DEBUG
+        qDebug() << "Changed coalesceInterval to" << d->timer->interval();
+#endif
+        Q_EMIT coalesceIntervalChanged(coalesceInterval());
+    }
+}
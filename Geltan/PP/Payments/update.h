@@ -0,0 +1,156 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/update.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UPDATEPAYMENT_H
+#define UPDATEPAYMENT_H
+
+#include <QObject>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppbase.h>
+
+namespace Geltan {
+namespace PP {
+
+class Payment;
+
+namespace Payments {
+
+class UpdatePrivate;
+
+/*!
+ * \brief Updates a created but not yet executed PayPal payment with a JSON Patch.
+ *
+ * Only the members of the payment that have been modified since it has been loaded are sent,
+ * see Payment::jsonPatch(). If nothing has been modified, no request is sent and succeeded()
+ * is emitted directly.
+ *
+ * Changes that are made in quick succession, like updating shipping address, amount and description
+ * after each other on a checkout page, can be coalesced into a single request by using schedule()
+ * instead of call(). Calls that are made while a request is still running are combined and sent
+ * as a single request after the running one has finished successfully, see \link Update::pending pending \endlink.
+ *
+ * \ppPaymentsApi{payment_update}
+ *
+ * \headerfile "" <Geltan/PP/Payments/update.h>
+ */
+class GELTANSHARED_EXPORT Update : public PPBase
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(Update)
+    /*!
+     * \brief Payment object to update.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>Payment*</TD><TD>payment() const</TD></TR><TR><TD>void</TD><TD>setPayment(Payment *nPayment)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>paymentChanged(Payment *payment)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::Payment *payment READ payment WRITE setPayment NOTIFY paymentChanged)
+    /*!
+     * \brief Time in milliseconds schedule() waits for further changes before the request is sent.
+     *
+     * Default value: 250
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>coalesceInterval() const</TD></TR><TR><TD>void</TD><TD>setCoalesceInterval(int nCoalesceInterval)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>coalesceIntervalChanged(int coalesceInterval)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int coalesceInterval READ coalesceInterval WRITE setCoalesceInterval NOTIFY coalesceIntervalChanged)
+    /*!
+     * \brief Returns true if call() has been invoked while a request was running and the modifications have not been sent yet.
+     *
+     * If the running request succeeds, the pending modifications are sent directly afterwards. If it fails,
+     * they are not sent automatically to not repeat a failing request, pending stays true until call() is
+     * invoked again.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>pending() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>pendingChanged(bool pending)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool pending READ pending NOTIFY pendingChanged)
+public:
+    /*!
+     * \brief Constructs a new Update object.
+     */
+    Update(QObject *parent = nullptr);
+
+    /*!
+     * \brief Sends the modifications of the payment.
+     *
+     * If a request is currently running, the modifications will be sent after it has finished.
+     */
+    Q_INVOKABLE void call();
+
+    /*!
+     * \brief Sets the \a payment and sends its modifications.
+     */
+    Q_INVOKABLE void call(Payment *payment);
+
+    /*!
+     * \brief Sends the modifications of the payment after coalesceInterval has elapsed.
+     *
+     * Each call restarts the interval, so modifications made in quick succession result in a single request.
+     */
+    Q_INVOKABLE void schedule();
+
+    Payment *payment() const;
+    int coalesceInterval() const;
+    bool pending() const;
+
+    void setPayment(Payment *nPayment);
+    void setCoalesceInterval(int nCoalesceInterval);
+
+Q_SIGNALS:
+    /*!
+     * \brief This signal will be emitted when the request was successful or when there was nothing to update.
+     */
+    void succeeded();
+
+    /*!
+     * \brief This signal will be emitted when the request failed.
+     *
+     * It is also emitted if no payment is set when calling call() or if the payment has been deleted
+     * before the request finished.
+     */
+    void failed();
+
+    void paymentChanged(Payment *payment);
+    void coalesceIntervalChanged(int coalesceInterval);
+    void pendingChanged(bool pending);
+
+protected:
+    void successCallBack() Q_DECL_OVERRIDE;
+    void errorCallBack() Q_DECL_OVERRIDE;
+    bool checkInput() Q_DECL_OVERRIDE;
+
+    Update(UpdatePrivate &dd, QObject *parent = nullptr);
+
+private:
+    Q_DISABLE_COPY(Update)
+};
+
+}
+}
+}
+
+#endif // UPDATEPAYMENT_H
@@ -0,0 +1,77 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Payments/update_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UPDATEPAYMENT_P_H
+#define UPDATEPAYMENT_P_H
+
+#include "update.h"
+#include "../ppbase_p.h"
+#include "../Objects/payment.h"
+#include <QTimer>
+#include <QJsonArray>
+#include <QPointer>
+
+namespace Geltan {
+namespace PP {
+namespace Payments {
+
+class UpdatePrivate : public PPBasePrivate {
+public:
+    UpdatePrivate() :
+        timer(nullptr),
+        pending(false)
+    {}
+
+    /*!
+     * \internal
+     * \brief Creates the coalescing timer, has to be called by all constructors of \a q.
+     */
+    void init(Update *q)
+    {
+        timer = new QTimer(q);
+        timer->setSingleShot(true);
+        timer->setInterval(250);
+        QObject::connect(timer, &QTimer::timeout, q, static_cast<void (Update::*)()>(&Update::call));
+    }
+
+    /*!
+     * \internal
+     * \brief Sets the pending state and emits pendingChanged() on \a q if it changed.
+     */
+    void setPending(Update *q, bool nPending)
+    {
+        if (nPending != pending) {
+            pending = nPending;
+            Q_EMIT q->pendingChanged(pending);
+        }
+    }
+
+    QPointer<Payment> payment;  // might be deleted while a request is running
+    QTimer *timer;
+    QJsonArray sentPatch;   // operations of the running request
+    bool pending;           // call() has been invoked while a request was running
+};
+
+}
+}
+}
+
+#endif // UPDATEPAYMENT_P_H
@@ -0,0 +1,497 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentarchive.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentarchive_p.h"
+#include "../Values/paymentvalue.h"
+#include "../Values/money.h"
+#include <QFileInfo>
+#include <QtEndian>
+#include <limits>
+#include <cstring>
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+
+/*
+ * Layout of a single record, all integers are little endian.
+ */
+enum RecordField {
+    CreateTimeField     = 0,    // qint64, ms since epoch, minimum value for invalid times
+    UpdateTimeField     = 8,    // qint64, ms since epoch, minimum value for invalid times
+    AmountField         = 16,   // qint64, minor units
+    IdOffsetField       = 24,   // quint64, heap offset
+    EmailOffsetField    = 32,   // quint64, heap offset
+    JsonOffsetField     = 40,   // quint64, heap offset
+    JsonLengthField     = 48,   // quint32
+    IdLengthField       = 52,   // quint16
+    EmailLengthField    = 54,   // quint16
+    CurrencyField       = 56,   // 4 bytes, ISO 4217 code padded with zeros
+    StateField          = 60,   // quint8
+    IntentField         = 61    // quint8, bytes 62 and 63 are reserved
+};
+
+static const char recordMagic[4] = {'G', 'P', 'P', 'A'};
+static const char heapMagic[4] = {'G', 'P', 'P', 'H'};
+
+static QDateTime msecsToTime(qint64 msecs)
+{
+    return (msecs == std::numeric_limits<qint64>::min()) ? QDateTime() : QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+}
+
+
+PaymentArchive::PaymentArchive(QObject *parent) : QObject(parent), d_ptr(new PaymentArchivePrivate(this))
+{
+
+}
+
+
+
+PaymentArchive::~PaymentArchive()
+{
+    close();
+}
+
+
+
+
+bool PaymentArchive::open(const QString &fileName, bool writable)
+{
+    Q_D(PaymentArchive);
+
+    close();
+
+    d->lastError.clear();
+    d->writable = writable;
+    d->recordFile.setFileName(fileName);
+    d->heapFile.setFileName(fileName + QLatin1String(".heap"));
+
+    const QIODevice::OpenMode mode = writable ? QIODevice::ReadWrite : QIODevice::ReadOnly;
+
+    if (!d->recordFile.open(mode) || !d->heapFile.open(mode)) {
+        d->lastError = d->recordFile.isOpen() ? d->heapFile.errorString() : d->recordFile.errorString();
+        d->recordFile.close();
+        d->heapFile.close();
+        return false;
+    }
+
+    if (!d->initFiles() || !d->map()) {
+        d->unmap();
+        d->recordFile.close();
+        d->heapFile.close();
+        return false;
+    }
+
+    d->fileName = fileName;
+    d->lookup.clear();
+    d->lookupRows = 0;
+
+#ifdef QT_DEBUG
+    qDebug() << "Opened payment archive" << fileName << "with" << d->count << "payments";
+#endif
+
+    Q_EMIT fileNameChanged(d->fileName);
+    Q_EMIT isOpenChanged(true);
+    Q_EMIT countChanged(d->count);
+
+    return true;
+}
+
+
+
+
+void PaymentArchive::close()
+{
+    Q_D(PaymentArchive);
+
+    if (d->fileName.isEmpty()) {
+        return;
+    }
+
+    d->unmap();
+    d->recordFile.close();
+    d->heapFile.close();
+    d->count = 0;
+    d->lookup.clear();
+    d->lookupRows = 0;
+    d->fileName.clear();
+
+    Q_EMIT fileNameChanged(d->fileName);
+    Q_EMIT isOpenChanged(false);
+    Q_EMIT countChanged(0);
+}
+
+
+
+
+bool PaymentArchive::append(const PaymentValue &payment)
+{
+    return append(QList<PaymentValue>({payment}));
+}
+
+
+
+bool PaymentArchive::append(const QList<PaymentValue> &payments)
+{
+    Q_D(PaymentArchive);
+
+    if (d->fileName.isEmpty() || !d->writable) {
+        d->lastError = tr("The payment archive has not been opened for writing.");
+        return false;
+    }
+
+    if (payments.isEmpty()) {
+        return true;
+    }
+
+    const quint64 heapStart = static_cast<quint64>(d->heapFile.size());
+
+    QByteArray heap;
+    QByteArray recs(payments.count() * PaymentArchivePrivate::RecordSize, '\0');
+    uchar *rec = reinterpret_cast<uchar*>(recs.data());
+
+    for (const PaymentValue &p : payments) {
+
+        const QByteArray id = p.id().toUtf8();
+        const QByteArray email = p.payer().email().toUtf8();
+        const QByteArray json = p.toJson();
+
+        if (id.size() > 0xFFFF || email.size() > 0xFFFF) {
+            d->lastError = tr("The ID or payer email of payment %1 is too long to be archived.").arg(p.id());
+            return false;
+        }
+
+        QString currency;
+        Money amount;
+        const QList<TransactionValue> ts = p.transactions();
+        for (const TransactionValue &t : ts) {
+            const PaymentAmountValue a = t.amount();
+            if (currency.isEmpty()) {
+                currency = a.currency();
+            }
+            if (a.currency() == currency) {
+                amount += a.totalMoney();
+            }
+        }
+
+        qToLittleEndian<qint64>(p.createTimeMSecs(), rec + CreateTimeField);
+        qToLittleEndian<qint64>(p.updateTimeMSecs(), rec + UpdateTimeField);
+        qToLittleEndian<qint64>(amount.rescaled(Money::currencyDecimals(currency)).minorUnits(), rec + AmountField);
+
+        qToLittleEndian<quint64>(heapStart + heap.size(), rec + IdOffsetField);
+        qToLittleEndian<quint16>(static_cast<quint16>(id.size()), rec + IdLengthField);
+        heap.append(id);
+
+        qToLittleEndian<quint64>(heapStart + heap.size(), rec + EmailOffsetField);
+        qToLittleEndian<quint16>(static_cast<quint16>(email.size()), rec + EmailLengthField);
+        heap.append(email);
+
+        qToLittleEndian<quint64>(heapStart + heap.size(), rec + JsonOffsetField);
+        qToLittleEndian<quint32>(static_cast<quint32>(json.size()), rec + JsonLengthField);
+        heap.append(json);
+
+        const QByteArray cur = currency.toLatin1().left(4);
+        std::memcpy(rec + CurrencyField, cur.constData(), cur.size());
+
+        rec[StateField] = static_cast<uchar>(p.state());
+        rec[IntentField] = static_cast<uchar>(p.intent());
+
+        rec += PaymentArchivePrivate::RecordSize;
+    }
+
+    // the mappings have to be released before the files grow
+    d->unmap();
+
+    // write the heap first, so that a record never references data that has not been written
+    if (!d->heapFile.seek(heapStart) || d->heapFile.write(heap) != heap.size() || !d->heapFile.flush()) {
+        d->lastError = d->heapFile.errorString();
+        d->map();
+        return false;
+    }
+
+    // overwrite an incomplete record of an interrupted append
+    const qint64 recordsEnd = PaymentArchivePrivate::HeaderSize + static_cast<qint64>(d->count) * PaymentArchivePrivate::RecordSize;
+    if (!d->recordFile.resize(recordsEnd) || !d->recordFile.seek(recordsEnd) || d->recordFile.write(recs) != recs.size() || !d->recordFile.flush()) {
+        d->lastError = d->recordFile.errorString();
+        d->recordFile.resize(recordsEnd);
+        d->map();
+        return false;
+    }
+
+    const int first = d->count;
+
+    if (!d->map()) {
+        return false;
+    }
+
+#ifdef QT_DEBUG
+    qDebug() << "Appended" << payments.count() << "payments to the archive" << d->fileName;
+#endif
+
+    Q_EMIT rowsAppended(first, d->count - 1);
+    Q_EMIT countChanged(d->count);
+
+    return true;
+}
+
+
+
+
+bool PaymentArchive::isValid(int row) const
+{
+    Q_D(const PaymentArchive);
+    return d->record(row) != nullptr;
+}
+
+
+QString PaymentArchive::id(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? QString::fromUtf8(d->heapBytes(qFromLittleEndian<quint64>(rec + IdOffsetField), qFromLittleEndian<quint16>(rec + IdLengthField))) : QString();
+}
+
+
+QDateTime PaymentArchive::createTime(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? msecsToTime(qFromLittleEndian<qint64>(rec + CreateTimeField)) : QDateTime();
+}
+
+
+QDateTime PaymentArchive::updateTime(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? msecsToTime(qFromLittleEndian<qint64>(rec + UpdateTimeField)) : QDateTime();
+}
+
+
+qint64 PaymentArchive::amount(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? qFromLittleEndian<qint64>(rec + AmountField) : 0;
+}
+
+
+QString PaymentArchive::currency(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    if (!rec) {
+        return QString();
+    }
+    const char *c = reinterpret_cast<const char*>(rec + CurrencyField);
+    return QString::fromLatin1(c, static_cast<int>(qstrnlen(c, 4)));
+}
+
+
+Payment::State PaymentArchive::state(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? static_cast<Payment::State>(rec[StateField]) : Payment::NoState;
+}
+
+
+Payment::Intent PaymentArchive::intent(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? static_cast<Payment::Intent>(rec[IntentField]) : Payment::NoIntent;
+}
+
+
+QString PaymentArchive::payerEmail(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? QString::fromUtf8(d->heapBytes(qFromLittleEndian<quint64>(rec + EmailOffsetField), qFromLittleEndian<quint16>(rec + EmailLengthField))) : QString();
+}
+
+
+PaymentValue PaymentArchive::payment(int row) const
+{
+    Q_D(const PaymentArchive);
+    const uchar *rec = d->record(row);
+    return rec ? PaymentValue::fromJson(d->heapBytes(qFromLittleEndian<quint64>(rec + JsonOffsetField), qFromLittleEndian<quint32>(rec + JsonLengthField))) : PaymentValue();
+}
+
+
+
+
+int PaymentArchive::indexOf(const QString &id) const
+{
+    Q_D(const PaymentArchive);
+
+    // only rows appended since the last call have to be added to the lookup table
+    for (int row = d->lookupRows; row < d->count; ++row) {
+        const QString rowId = this->id(row);
+        if (!rowId.isEmpty()) {
+            d->lookup.insert(rowId, row);
+        }
+    }
+    d->lookupRows = d->count;
+
+    return d->lookup.value(id, -1);
+}
+
+
+
+
+QString PaymentArchive::fileName() const { Q_D(const PaymentArchive); return d->fileName; }
+
+bool PaymentArchive::isOpen() const { Q_D(const PaymentArchive); return !d->fileName.isEmpty(); }
+
+int PaymentArchive::count() const { Q_D(const PaymentArchive); return d->count; }
+
+QString PaymentArchive::lastError() const { Q_D(const PaymentArchive); return d->lastError; }
+
+
+
+
+bool PaymentArchivePrivate::initFiles()
+{
+    uchar header[HeaderSize];
+
+    if (recordFile.size() == 0) {
+
+        if (!writable) {
+            lastError = PaymentArchive::tr("The payment archive file is empty.");
+            return false;
+        }
+
+        std::memset(header, 0, HeaderSize);
+        std::memcpy(header, recordMagic, 4);
+        qToLittleEndian<quint32>(Version, header + 4);
+        qToLittleEndian<quint32>(RecordSize, header + 8);
+
+        if (recordFile.write(reinterpret_cast<const char*>(header), HeaderSize) != HeaderSize) {
+            lastError = recordFile.errorString();
+            return false;
+        }
+
+        // start the heap with its own header, so that no string has the offset 0
+        std::memcpy(header, heapMagic, 4);
+        heapFile.resize(0);
+        if (heapFile.write(reinterpret_cast<const char*>(header), 8) != 8) {
+            lastError = heapFile.errorString();
+            return false;
+        }
+
+        recordFile.flush();
+        heapFile.flush();
+    }
+
+    if (recordFile.size() < HeaderSize || !recordFile.seek(0) || recordFile.read(reinterpret_cast<char*>(header), HeaderSize) != HeaderSize) {
+        lastError = PaymentArchive::tr("Failed to read the header of the payment archive.");
+        return false;
+    }
+
+    if (std::memcmp(header, recordMagic, 4) != 0 || qFromLittleEndian<quint32>(header + 4) != Version || qFromLittleEndian<quint32>(header + 8) != static_cast<quint32>(RecordSize)) {
+        lastError = PaymentArchive::tr("The file is not a supported payment archive.");
+        return false;
+    }
+
+    char heapHeader[4];
+    if (!heapFile.seek(0) || heapFile.read(heapHeader, 4) != 4 || std::memcmp(heapHeader, heapMagic, 4) != 0) {
+        lastError = PaymentArchive::tr("The heap file of the payment archive is missing or invalid.");
+        return false;
+    }
+
+    return true;
+}
+
+
+
+bool PaymentArchivePrivate::map()
+{
+    unmap();
+
+    recordsSize = recordFile.size();
+    heapSize = heapFile.size();
+
+    // a partially written record at the end is ignored
+    count = static_cast<int>((recordsSize - HeaderSize) / RecordSize);
+
+    records = recordFile.map(0, recordsSize);
+    heapData = heapFile.map(0, heapSize);
+
+    if (!records || !heapData) {
+        lastError = records ? heapFile.errorString() : recordFile.errorString();
+        unmap();
+        count = 0;
+        return false;
+    }
+
+    return true;
+}
+
+
+
+void PaymentArchivePrivate::unmap()
+{
+    if (records) {
+        recordFile.unmap(records);
+        records = nullptr;
+    }
+    if (heapData) {
+        heapFile.unmap(heapData);
+        heapData = nullptr;
+    }
+    recordsSize = 0;
+    heapSize = 0;
+}
+
+
+
+const uchar *PaymentArchivePrivate::record(int row) const
+{
+    if ((row < 0) || (row >= count)) {
+        return nullptr;
+    }
+
+    const uchar *rec = records + HeaderSize + static_cast<qint64>(row) * RecordSize;
+
+    // append() only writes known enumerators, anything else means the record has been damaged
+    if ((rec[StateField] > Payment::Failed) || (rec[IntentField] > Payment::Order)) {
+#ifdef QT_DEBUG
+        qDebug() << "Ignoring corrupt payment archive record at row" << row;
+#endif
+        return nullptr;
+    }
+
+    return rec;
+}
+
+
+
+QByteArray PaymentArchivePrivate::heapBytes(quint64 offset, quint32 length) const
+{
+    if (!heapData || offset > static_cast<quint64>(heapSize) || length > (static_cast<quint64>(heapSize) - offset)) {
+        return QByteArray();
+    }
+    return QByteArray(reinterpret_cast<const char*>(heapData + offset), static_cast<int>(length));
+}
@@ -0,0 +1,226 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentarchive.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTARCHIVE_H
+#define PAYMENTARCHIVE_H
+
+#include <QObject>
+#include <QDateTime>
+#include "../Objects/payment.h"
+#include "../../geltan_global.h"
+
+namespace Geltan {
+namespace PP {
+
+class PaymentValue;
+class PaymentArchivePrivate;
+
+/*!
+ * \brief Append-only on-disk archive of historical payments that is read via memory mapping.
+ *
+ * Payments that reached a final state do not change anymore, so there is no need to keep them as
+ * Payment object trees or to request them again. The archive stores them in two files:
+ *
+ * \li the record file \a fileName with one fixed-width 64 byte record per payment, containing the
+ *     creation and update time, the amount in minor units, the currency, the state, the intent and
+ *     references into the heap
+ * \li the heap file \a fileName.heap containing the variable length strings: the payment ID, the
+ *     payer email address and the complete payment as compact JSON
+ *
+ * Both files are mapped into memory when the archive is opened, so opening is independent of the
+ * archive size and reading a row only touches the pages containing it. All integers are stored in
+ * little endian byte order.
+ *
+ * New payments are only appended, existing records are never changed. The heap data is written before
+ * the records referencing it, so an interrupted append never leaves a record pointing to missing data.
+ * An incomplete record at the end of the record file is ignored and overwritten by the next append.
+ *
+ * The amount of a payment is the sum of all transaction amounts in the currency of the first transaction.
+ * Use PaymentArchiveModel to show the archive in a view.
+ *
+ * \code{.cpp}
+ * Geltan::PP::PaymentArchive *archive = new Geltan::PP::PaymentArchive(this);
+ * if (archive->open(QStringLiteral("/var/lib/myshop/payments-2016.archive"), true)) {
+ *     archive->append(finishedPayments);
+ * }
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Store/paymentarchive.h>
+ */
+class GELTANSHARED_EXPORT PaymentArchive : public QObject
+{
+    Q_OBJECT
+    /*!
+     * \brief The path of the currently opened record file.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>fileName() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>fileNameChanged(const QString &fileName)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString fileName READ fileName NOTIFY fileNameChanged)
+    /*!
+     * \brief Returns true if the archive is open.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>isOpen() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>isOpenChanged(bool isOpen)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool isOpen READ isOpen NOTIFY isOpenChanged)
+    /*!
+     * \brief The number of archived payments.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>count() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>countChanged(int count)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    /*!
+     * \brief The text of the last error.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>lastError() const</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString lastError READ lastError)
+public:
+    /*!
+     * \brief Constructs a new PaymentArchive object.
+     */
+    explicit PaymentArchive(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the PaymentArchive object and closes the files.
+     */
+    ~PaymentArchive();
+
+    /*!
+     * \brief Opens the archive at \a fileName.
+     *
+     * If \a writable is true, the archive will be created if it does not exist and payments can be appended.
+     * Returns false if the files could not be opened or are no valid archive files.
+     */
+    Q_INVOKABLE bool open(const QString &fileName, bool writable = false);
+
+    /*!
+     * \brief Closes the archive and unmaps the files.
+     */
+    Q_INVOKABLE void close();
+
+    /*!
+     * \brief Appends \a payment to the archive.
+     */
+    bool append(const PaymentValue &payment);
+
+    /*!
+     * \brief Appends the \a payments to the archive with a single write per file.
+     */
+    bool append(const QList<PaymentValue> &payments);
+
+    /*!
+     * \brief Returns false if \a row is out of range or its record is corrupt.
+     *
+     * A record is corrupt if its state or intent is not a known enumerator. The other functions
+     * return empty values for such rows.
+     */
+    Q_INVOKABLE bool isValid(int row) const;
+
+    /*!
+     * \brief Returns the ID of the payment at \a row.
+     */
+    Q_INVOKABLE QString id(int row) const;
+
+    /*!
+     * \brief Returns the creation time of the payment at \a row.
+     */
+    Q_INVOKABLE QDateTime createTime(int row) const;
+
+    /*!
+     * \brief Returns the update time of the payment at \a row.
+     */
+    Q_INVOKABLE QDateTime updateTime(int row) const;
+
+    /*!
+     * \brief Returns the amount of the payment at \a row in minor units of its currency.
+     */
+    Q_INVOKABLE qint64 amount(int row) const;
+
+    /*!
+     * \brief Returns the currency code of the payment at \a row.
+     */
+    Q_INVOKABLE QString currency(int row) const;
+
+    /*!
+     * \brief Returns the state of the payment at \a row.
+     */
+    Q_INVOKABLE Geltan::PP::Payment::State state(int row) const;
+
+    /*!
+     * \brief Returns the intent of the payment at \a row.
+     */
+    Q_INVOKABLE Geltan::PP::Payment::Intent intent(int row) const;
+
+    /*!
+     * \brief Returns the payer email address of the payment at \a row.
+     */
+    Q_INVOKABLE QString payerEmail(int row) const;
+
+    /*!
+     * \brief Returns the complete payment at \a row, parsed from the archived JSON data.
+     */
+    PaymentValue payment(int row) const;
+
+    /*!
+     * \brief Returns the row of the payment with \a id or \a -1 if it has not been archived.
+     *
+     * The first call reads the IDs of all rows to build a lookup table.
+     */
+    Q_INVOKABLE int indexOf(const QString &id) const;
+
+    QString fileName() const;
+    bool isOpen() const;
+    int count() const;
+    QString lastError() const;
+
+Q_SIGNALS:
+    /*!
+     * \brief This signal will be emitted after the rows \a first to \a last have been appended.
+     */
+    void rowsAppended(int first, int last);
+
+    void fileNameChanged(const QString &fileName);
+    void isOpenChanged(bool isOpen);
+    void countChanged(int count);
+
+protected:
+    const QScopedPointer<PaymentArchivePrivate> d_ptr;
+
+private:
+    Q_DISABLE_COPY(PaymentArchive)
+    Q_DECLARE_PRIVATE(PaymentArchive)
+
+};
+
+}
+}
+
+#endif // PAYMENTARCHIVE_H
@@ -0,0 +1,101 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentarchive_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTARCHIVE_P_H
+#define PAYMENTARCHIVE_P_H
+
+#include "paymentarchive.h"
+#include <QFile>
+#include <QHash>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentArchivePrivate
+{
+public:
+    PaymentArchivePrivate(PaymentArchive *parent) :
+        q_ptr(parent),
+        records(nullptr),
+        recordsSize(0),
+        heapData(nullptr),
+        heapSize(0),
+        count(0),
+        writable(false),
+        lookupRows(0)
+    {}
+
+    ~PaymentArchivePrivate() {}
+
+    static const int HeaderSize = 16;
+    static const int RecordSize = 64;
+    static const quint32 Version = 1;
+
+    /*!
+     * \internal
+     * \brief Creates the headers of new empty files or checks the headers of existing files.
+     */
+    bool initFiles();
+
+    /*!
+     * \internal
+     * \brief Maps both files into memory, existing mappings will be released before.
+     */
+    bool map();
+
+    /*!
+     * \internal
+     * \brief Releases the memory mappings.
+     */
+    void unmap();
+
+    /*!
+     * \internal
+     * \brief Returns a pointer to the record of \a row or a \c nullptr if \a row is out of range or the record is corrupt.
+     */
+    const uchar *record(int row) const;
+
+    /*!
+     * \internal
+     * \brief Returns the heap data at \a offset with \a length bytes, an empty array if it is out of range.
+     */
+    QByteArray heapBytes(quint64 offset, quint32 length) const;
+
+    PaymentArchive * const q_ptr;
+    Q_DECLARE_PUBLIC(PaymentArchive)
+    QFile recordFile;
+    QFile heapFile;
+    uchar *records;
+    qint64 recordsSize;
+    uchar *heapData;
+    qint64 heapSize;
+    int count;
+    bool writable;
+    QString fileName;
+    mutable QString lastError;
+    mutable QHash<QString, int> lookup;
+    mutable int lookupRows;
+};
+
+}
+}
+
+#endif // PAYMENTARCHIVE_P_H
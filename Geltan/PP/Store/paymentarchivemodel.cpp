@@ -0,0 +1,158 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentarchivemodel.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentarchivemodel_p.h"
+#include "../Values/paymentvalue.h"
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+
+PaymentArchiveModel::PaymentArchiveModel(QObject *parent) : QAbstractListModel(parent), d_ptr(new PaymentArchiveModelPrivate(this))
+{
+
+}
+
+
+
+PaymentArchiveModel::~PaymentArchiveModel()
+{
+
+}
+
+
+
+
+QHash<int, QByteArray> PaymentArchiveModel::roleNames() const
+{
+    QHash<int, QByteArray> roles = QAbstractItemModel::roleNames();
+    roles.insert(Item, QByteArrayLiteral("item"));
+    roles.insert(Id, QByteArrayLiteral("id"));
+    roles.insert(CreateTime, QByteArrayLiteral("createTime"));
+    roles.insert(UpdateTime, QByteArrayLiteral("updateTime"));
+    roles.insert(State, QByteArrayLiteral("state"));
+    roles.insert(Intent, QByteArrayLiteral("intent"));
+    roles.insert(Amount, QByteArrayLiteral("amount"));
+    roles.insert(Currency, QByteArrayLiteral("currency"));
+    roles.insert(PayerEmail, QByteArrayLiteral("payerEmail"));
+    return roles;
+}
+
+
+int PaymentArchiveModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    Q_D(const PaymentArchiveModel);
+    return d->rows;
+}
+
+
+QVariant PaymentArchiveModel::data(const QModelIndex &index, int role) const
+{
+    Q_D(const PaymentArchiveModel);
+
+    if (!index.isValid() || !d->archive) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+
+    if (row > (rowCount() - 1)) {
+        return QVariant();
+    }
+
+    const PaymentArchive *a = d->archive.data();
+
+    switch (role) {
+    case Item:
+        return QVariant::fromValue<PaymentValue>(a->payment(row));
+    case Id:
+    case Qt::DisplayRole:
+        return QVariant::fromValue<QString>(a->id(row));
+    case CreateTime:
+        return QVariant::fromValue<QDateTime>(a->createTime(row));
+    case UpdateTime:
+        return QVariant::fromValue<QDateTime>(a->updateTime(row));
+    case State:
+        return QVariant::fromValue<Geltan::PP::Payment::State>(a->state(row));
+    case Intent:
+        return QVariant::fromValue<Geltan::PP::Payment::Intent>(a->intent(row));
+    case Amount:
+        return QVariant::fromValue<qint64>(a->amount(row));
+    case Currency:
+        return QVariant::fromValue<QString>(a->currency(row));
+    case PayerEmail:
+        return QVariant::fromValue<QString>(a->payerEmail(row));
+    default:
+        return QVariant();
+    }
+}
+
+
+
+
+PaymentArchive *PaymentArchiveModel::archive() const { Q_D(const PaymentArchiveModel); return d->archive.data(); }
+
+void PaymentArchiveModel::setArchive(PaymentArchive *nArchive)
+{
+    Q_D(PaymentArchiveModel);
+    if (nArchive != d->archive) {
+
+        beginResetModel();
+
+        if (d->archive) {
+            disconnect(d->archive.data(), nullptr, this, nullptr);
+        }
+
+        d->archive = nArchive;
+        d->rows = d->archive ? d->archive->count() : 0;
+
+        if (d->archive) {
+            connect(d->archive.data(), &PaymentArchive::rowsAppended, this, [this](int first, int last) {
+                Q_D(PaymentArchiveModel);
+                beginInsertRows(QModelIndex(), first, last);
+                d->rows = last + 1;
+                endInsertRows();
+            });
+            connect(d->archive.data(), &PaymentArchive::isOpenChanged, this, [this]() {
+                Q_D(PaymentArchiveModel);
+                beginResetModel();
+                d->rows = d->archive ? d->archive->count() : 0;
+                endResetModel();
+            });
+            connect(d->archive.data(), &QObject::destroyed, this, [this]() {
+                Q_D(PaymentArchiveModel);
+                beginResetModel();
+                d->rows = 0;
+                endResetModel();
+            });
+        }
+
+        endResetModel();
+
+#ifdef QT_DEBUG
+        qDebug() << "Changed archive to" << d->archive;
+#endif
+        Q_EMIT archiveChanged(archive());
+    }
+}
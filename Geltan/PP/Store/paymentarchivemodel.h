@@ -0,0 +1,115 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentarchivemodel.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTARCHIVEMODEL_H
+#define PAYMENTARCHIVEMODEL_H
+
+#include <QAbstractListModel>
+#include "../../geltan_global.h"
+
+namespace Geltan {
+namespace PP {
+
+class PaymentArchive;
+class PaymentArchiveModelPrivate;
+
+/*!
+ * \brief Read-only list model showing the payments of a PaymentArchive.
+ *
+ * The model reads the data of a row directly from the memory mapped archive files when the view requests
+ * it, so it does not create any Payment objects and only the pages of the visible rows will be loaded.
+ * Payments appended to the archive are inserted as new rows.
+ *
+ * \headerfile "" <Geltan/PP/Store/paymentarchivemodel.h>
+ */
+class GELTANSHARED_EXPORT PaymentArchiveModel : public QAbstractListModel
+{
+    Q_OBJECT
+    /*!
+     * \brief The archive that should be shown. The model does not take ownership of the archive.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>PaymentArchive*</TD><TD>archive() const</TD></TR><TR><TD>void</TD><TD>setArchive(PaymentArchive *nArchive)</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>archiveChanged(PaymentArchive *archive)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(Geltan::PP::PaymentArchive *archive READ archive WRITE setArchive NOTIFY archiveChanged)
+public:
+    /*!
+     * \brief Constructs a new PaymentArchiveModel.
+     */
+    explicit PaymentArchiveModel(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the PaymentArchiveModel.
+     */
+    ~PaymentArchiveModel();
+
+    /*!
+     * \brief The roles of this model.
+     *
+     * To access them from QML, use the enumeration name starting lowercase.
+     */
+    enum Roles {
+        Item = Qt::UserRole + 1,    /**< The complete payment as PaymentValue, parsed from the archived JSON data. */
+        Id,                         /**< The ID of the payment. */
+        CreateTime,                 /**< The creation time of the payment. */
+        UpdateTime,                 /**< The time the payment has been last updated. */
+        State,                      /**< The state of the payment. */
+        Intent,                     /**< The intent of the payment. */
+        Amount,                     /**< The amount of the payment in minor units. */
+        Currency,                   /**< The currency code of the amount. */
+        PayerEmail                  /**< The email address of the payer. */
+    };
+
+    /*!
+     * \brief Reimplemented from QAbstractItemModel.
+     */
+    QHash<int, QByteArray> roleNames() const Q_DECL_OVERRIDE;
+    /*!
+     * \brief Reimplemented from QAbstractItemModel.
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    /*!
+     * \brief Reimplemented from QAbstractItemModel.
+     */
+    QVariant data(const QModelIndex &index, int role) const Q_DECL_OVERRIDE;
+
+    PaymentArchive *archive() const;
+
+    void setArchive(PaymentArchive *nArchive);
+
+Q_SIGNALS:
+    void archiveChanged(PaymentArchive *archive);
+
+protected:
+    const QScopedPointer<PaymentArchiveModelPrivate> d_ptr;
+
+private:
+    Q_DISABLE_COPY(PaymentArchiveModel)
+    Q_DECLARE_PRIVATE(PaymentArchiveModel)
+
+};
+
+}
+}
+
+#endif // PAYMENTARCHIVEMODEL_H
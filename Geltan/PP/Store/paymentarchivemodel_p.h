@@ -0,0 +1,51 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentarchivemodel_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTARCHIVEMODEL_P_H
+#define PAYMENTARCHIVEMODEL_P_H
+
+#include "paymentarchivemodel.h"
+#include "paymentarchive.h"
+#include <QPointer>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentArchiveModelPrivate
+{
+public:
+    PaymentArchiveModelPrivate(PaymentArchiveModel *parent) :
+        q_ptr(parent),
+        rows(0)
+    {}
+
+    ~PaymentArchiveModelPrivate() {}
+
+    PaymentArchiveModel * const q_ptr;
+    Q_DECLARE_PUBLIC(PaymentArchiveModel)
+    QPointer<PaymentArchive> archive;
+    int rows;
+};
+
+}
+}
+
+#endif // PAYMENTARCHIVEMODEL_P_H
@@ -0,0 +1,637 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentstore.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentstore_p.h"
+#include "../ppenumsmap.h"
+#include "../Values/payervalue.h"
+#include "../Values/transactionvalue.h"
+#include "../Values/relatedresourcevalue.h"
+#include <QVariant>
+#include <QJsonDocument>
+#include <QUuid>
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+
+namespace {
+
+QString relatedResourceTypeToken(RelatedResourceValue::Type type)
+{
+    switch (type) {
+    case RelatedResourceValue::Sale:
+        return QStringLiteral("sale");
+    case RelatedResourceValue::Authorization:
+        return QStringLiteral("authorization");
+    case RelatedResourceValue::Order:
+        return QStringLiteral("order");
+    case RelatedResourceValue::Capture:
+        return QStringLiteral("capture");
+    case RelatedResourceValue::Refund:
+        return QStringLiteral("refund");
+    default:
+        return QString();
+    }
+}
+
+}
+
+PaymentStore::PaymentStore(QObject *parent) : QObject(parent), d_ptr(new PaymentStorePrivate(this))
+{
+}
+
+
+
+PaymentStore::~PaymentStore()
+{
+    close();
+}
+
+
+
+
+bool PaymentStore::open(const QString &fileName)
+{
+    Q_D(PaymentStore);
+
+    close();
+
+    d->connectionName = QStringLiteral("geltan_paymentstore_") + QUuid::createUuid().toString();
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), d->connectionName);
+        db.setDatabaseName(fileName);
+
+        if (!db.open()) {
+            d->check(db.lastError());
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(d->connectionName);
+            d->connectionName.clear();
+            return false;
+        }
+    }
+
+    if (!d->createSchema()) {
+        close();
+        return false;
+    }
+
+    d->fileName = fileName;
+    Q_EMIT fileNameChanged(d->fileName);
+    Q_EMIT isOpenChanged(true);
+
+    return true;
+}
+
+
+
+
+void PaymentStore::close()
+{
+    Q_D(PaymentStore);
+
+    if (d->connectionName.isEmpty()) {
+        return;
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::database(d->connectionName, false);
+        if (db.isOpen()) {
+            db.close();
+        }
+    }
+
+    QSqlDatabase::removeDatabase(d->connectionName);
+    d->connectionName.clear();
+
+    if (!d->fileName.isEmpty()) {
+        d->fileName.clear();
+        Q_EMIT fileNameChanged(d->fileName);
+        Q_EMIT isOpenChanged(false);
+    }
+}
+
+
+
+
+bool PaymentStorePrivate::createSchema()
+{
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    QSqlQuery q(db);
+
+    // foreign key enforcement is off by default and has to be enabled per connection,
+    // otherwise the ON DELETE CASCADE of related_resources is ignored
+    const QStringList statements({
+        QStringLiteral("PRAGMA foreign_keys = ON"),
+        QStringLiteral("PRAGMA journal_mode=WAL"),
+        QStringLiteral("CREATE TABLE IF NOT EXISTS payments ("
+                       "id TEXT PRIMARY KEY NOT NULL, "
+                       "state TEXT, "
+                       "intent TEXT, "
+                       "payer_email TEXT, "
+                       "create_time INTEGER, "
+                       "update_time INTEGER, "
+                       "json TEXT NOT NULL)"),
+        QStringLiteral("CREATE TABLE IF NOT EXISTS related_resources ("
+                       "id TEXT PRIMARY KEY NOT NULL, "
+                       "payment_id TEXT NOT NULL REFERENCES payments(id) ON DELETE CASCADE, "
+                       "type TEXT NOT NULL, "
+                       "state TEXT, "
+                       "create_time INTEGER, "
+                       "update_time INTEGER)"),
+        QStringLiteral("CREATE TABLE IF NOT EXISTS sync_state ("
+                       "name TEXT PRIMARY KEY NOT NULL, "
+                       "watermark INTEGER NOT NULL)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS payments_state_idx ON payments (state)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS payments_payer_email_idx ON payments (payer_email)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS payments_create_time_idx ON payments (create_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS payments_update_time_idx ON payments (update_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS related_resources_payment_id_idx ON related_resources (payment_id)")
+    });
+
+    for (const QString &statement : statements) {
+        if (!q.exec(statement)) {
+            return check(q.lastError());
+        }
+    }
+
+    return true;
+}
+
+
+
+
+bool PaymentStorePrivate::write(const PaymentValue &payment, const QByteArray &json)
+{
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    QSqlQuery q(db);
+
+    if (!q.prepare(QStringLiteral("INSERT OR REPLACE INTO payments (id, state, intent, payer_email, create_time, update_time, json) VALUES (?, ?, ?, ?, ?, ?, ?)"))) {
+        return check(q.lastError());
+    }
+    q.addBindValue(payment.id());
+    q.addBindValue(PPEnumsMap::paymentStateEnumToToken(payment.state()));
+    q.addBindValue(PPEnumsMap::paymentIntentEnumToToken(payment.intent()));
+    q.addBindValue(payment.payer().email());
+    q.addBindValue(toMSecs(payment.createTimeMSecs()));
+    q.addBindValue(toMSecs(payment.updateTimeMSecs()));
+    q.addBindValue(QString::fromUtf8(json.isEmpty() ? payment.toJson() : json));
+    if (!q.exec()) {
+        return check(q.lastError());
+    }
+
+    // related resources might have been removed since the payment has been stored the last time
+    if (!q.prepare(QStringLiteral("DELETE FROM related_resources WHERE payment_id = ?"))) {
+        return check(q.lastError());
+    }
+    q.addBindValue(payment.id());
+    if (!q.exec()) {
+        return check(q.lastError());
+    }
+
+    if (!q.prepare(QStringLiteral("INSERT OR REPLACE INTO related_resources (id, payment_id, type, state, create_time, update_time) VALUES (?, ?, ?, ?, ?, ?)"))) {
+        return check(q.lastError());
+    }
+
+    const QList<TransactionValue> ts = payment.transactions();
+    for (const TransactionValue &t : ts) {
+        const QList<RelatedResourceValue> rs = t.relatedResources();
+        for (const RelatedResourceValue &r : rs) {
+            if (r.id().isEmpty()) {
+                continue;
+            }
+            q.addBindValue(r.id());
+            q.addBindValue(payment.id());
+            q.addBindValue(relatedResourceTypeToken(r.type()));
+            q.addBindValue(PPEnumsMap::stateTypeEnumToToken(r.state()));
+            q.addBindValue(toMSecs(r.createTimeMSecs()));
+            q.addBindValue(toMSecs(r.updateTimeMSecs()));
+            if (!q.exec()) {
+                return check(q.lastError());
+            }
+        }
+    }
+
+    return true;
+}
+
+
+
+
+QList<PaymentValue> PaymentStorePrivate::read(QSqlQuery &query) const
+{
+    QList<PaymentValue> payments;
+
+    if (!query.exec()) {
+        check(query.lastError());
+        return payments;
+    }
+
+    while (query.next()) {
+        payments.append(PaymentValue::fromJson(query.value(0).toString().toUtf8()));
+    }
+
+    return payments;
+}
+
+
+
+
+bool PaymentStorePrivate::check(const QSqlError &error) const
+{
+    if (error.type() == QSqlError::NoError) {
+        return true;
+    }
+
+    lastError = error.text();
+#ifdef QT_DEBUG
+    qDebug() << "Payment store error:" << lastError;
+#endif
+    return false;
+}
+
+
+
+
+bool PaymentStore::store(const PaymentValue &payment)
+{
+    return store(QList<PaymentValue>({payment}));
+}
+
+
+
+
+bool PaymentStorePrivate::writeAll(const QList<PaymentValue> &payments, const QList<QByteArray> &jsons)
+{
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+
+    if (!db.transaction()) {
+        return check(db.lastError());
+    }
+
+    for (int i = 0; i < payments.size(); ++i) {
+        const PaymentValue &p = payments.at(i);
+        if (p.id().isEmpty()) {
+            continue;
+        }
+        if (!write(p, jsons.value(i))) {
+            db.rollback();
+            return false;
+        }
+    }
+
+    if (!db.commit()) {
+        check(db.lastError());
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
+
+
+
+bool PaymentStore::store(const QList<PaymentValue> &payments)
+{
+    Q_D(PaymentStore);
+
+    if (!isOpen()) {
+        return false;
+    }
+
+    return d->writeAll(payments);
+}
+
+
+
+
+bool PaymentStore::store(const Payment *payment)
+{
+    if (!payment) {
+        return false;
+    }
+
+    return store(payment->toValue());
+}
+
+
+
+
+bool PaymentStore::store(const QJsonObject &json)
+{
+    Q_D(PaymentStore);
+
+    if (!isOpen() || json.isEmpty()) {
+        return false;
+    }
+
+    return d->writeAll(QList<PaymentValue>({PaymentValue::fromJson(json)}), QList<QByteArray>({QJsonDocument(json).toJson(QJsonDocument::Compact)}));
+}
+
+
+
+
+bool PaymentStore::remove(const QString &id)
+{
+    Q_D(PaymentStore);
+
+    if (!isOpen()) {
+        return false;
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(d->connectionName, false);
+
+    if (!db.transaction()) {
+        return d->check(db.lastError());
+    }
+
+    QSqlQuery q(db);
+    q.prepare(QStringLiteral("DELETE FROM related_resources WHERE payment_id = ?"));
+    q.addBindValue(id);
+    if (!q.exec()) {
+        d->check(q.lastError());
+        db.rollback();
+        return false;
+    }
+
+    q.prepare(QStringLiteral("DELETE FROM payments WHERE id = ?"));
+    q.addBindValue(id);
+    if (!q.exec()) {
+        d->check(q.lastError());
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        d->check(db.lastError());
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
+
+
+
+bool PaymentStore::contains(const QString &id) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return false;
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.prepare(QStringLiteral("SELECT 1 FROM payments WHERE id = ?"));
+    q.addBindValue(id);
+
+    if (!q.exec()) {
+        d->check(q.lastError());
+        return false;
+    }
+
+    return q.next();
+}
+
+
+
+
+PaymentValue PaymentStore::payment(const QString &id) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return PaymentValue();
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.prepare(QStringLiteral("SELECT json FROM payments WHERE id = ?"));
+    q.addBindValue(id);
+
+    const QList<PaymentValue> ps = d->read(q);
+
+    return ps.isEmpty() ? PaymentValue() : ps.first();
+}
+
+
+
+
+QJsonObject PaymentStore::paymentJson(const QString &id) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return QJsonObject();
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.prepare(QStringLiteral("SELECT json FROM payments WHERE id = ?"));
+    q.addBindValue(id);
+
+    if (!q.exec()) {
+        d->check(q.lastError());
+        return QJsonObject();
+    }
+
+    if (!q.next()) {
+        return QJsonObject();
+    }
+
+    return QJsonDocument::fromJson(q.value(0).toString().toUtf8()).object();
+}
+
+
+
+
+PaymentValue PaymentStore::paymentByResourceId(const QString &resourceId) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return PaymentValue();
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.prepare(QStringLiteral("SELECT p.json FROM payments p JOIN related_resources r ON r.payment_id = p.id WHERE r.id = ?"));
+    q.addBindValue(resourceId);
+
+    const QList<PaymentValue> ps = d->read(q);
+
+    return ps.isEmpty() ? PaymentValue() : ps.first();
+}
+
+
+
+
+QList<PaymentValue> PaymentStore::find(const QDateTime &from, const QDateTime &to, Payment::State state, const QString &payerEmail) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return QList<PaymentValue>();
+    }
+
+    QStringList conditions;
+    QVariantList values;
+
+    if (from.isValid()) {
+        conditions.append(QStringLiteral("create_time >= ?"));
+        values.append(from.toMSecsSinceEpoch());
+    }
+
+    if (to.isValid()) {
+        conditions.append(QStringLiteral("create_time <= ?"));
+        values.append(to.toMSecsSinceEpoch());
+    }
+
+    if (state != Payment::NoState) {
+        conditions.append(QStringLiteral("state = ?"));
+        values.append(PPEnumsMap::paymentStateEnumToToken(state));
+    }
+
+    if (!payerEmail.isEmpty()) {
+        conditions.append(QStringLiteral("payer_email = ?"));
+        values.append(payerEmail);
+    }
+
+    QString sql = QStringLiteral("SELECT json FROM payments");
+    if (!conditions.isEmpty()) {
+        sql.append(QStringLiteral(" WHERE ")).append(conditions.join(QStringLiteral(" AND ")));
+    }
+    sql.append(QStringLiteral(" ORDER BY create_time"));
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.setForwardOnly(true);
+    q.prepare(sql);
+    for (const QVariant &v : values) {
+        q.addBindValue(v);
+    }
+
+    return d->read(q);
+}
+
+
+
+
+QList<PaymentValue> PaymentStore::updatedSince(const QDateTime &since) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return QList<PaymentValue>();
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.setForwardOnly(true);
+    q.prepare(QStringLiteral("SELECT json FROM payments WHERE update_time > ? ORDER BY update_time"));
+    q.addBindValue(since.isValid() ? since.toMSecsSinceEpoch() : Q_INT64_C(0));
+
+    return d->read(q);
+}
+
+
+
+
+QDateTime PaymentStore::watermark(const QString &name) const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return QDateTime();
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    q.prepare(QStringLiteral("SELECT watermark FROM sync_state WHERE name = ?"));
+    q.addBindValue(name);
+
+    if (!q.exec()) {
+        d->check(q.lastError());
+        return QDateTime();
+    }
+
+    if (!q.next()) {
+        return QDateTime();
+    }
+
+    return QDateTime::fromMSecsSinceEpoch(q.value(0).toLongLong(), Qt::UTC);
+}
+
+
+
+
+bool PaymentStore::setWatermark(const QString &name, const QDateTime &watermark)
+{
+    Q_D(PaymentStore);
+
+    if (!isOpen()) {
+        return false;
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+
+    if (watermark.isValid()) {
+        q.prepare(QStringLiteral("INSERT OR REPLACE INTO sync_state (name, watermark) VALUES (?, ?)"));
+        q.addBindValue(name);
+        q.addBindValue(watermark.toMSecsSinceEpoch());
+    } else {
+        q.prepare(QStringLiteral("DELETE FROM sync_state WHERE name = ?"));
+        q.addBindValue(name);
+    }
+
+    if (!q.exec()) {
+        return d->check(q.lastError());
+    }
+
+    return true;
+}
+
+
+
+
+int PaymentStore::count() const
+{
+    Q_D(const PaymentStore);
+
+    if (!isOpen()) {
+        return 0;
+    }
+
+    QSqlQuery q(QSqlDatabase::database(d->connectionName, false));
+    if (!q.exec(QStringLiteral("SELECT COUNT(*) FROM payments")) || !q.next()) {
+        d->check(q.lastError());
+        return 0;
+    }
+
+    return q.value(0).toInt();
+}
+
+
+
+
+QString PaymentStore::fileName() const { Q_D(const PaymentStore); return d->fileName; }
+
+bool PaymentStore::isOpen() const { Q_D(const PaymentStore); return !d->fileName.isEmpty(); }
+
+QString PaymentStore::lastError() const { Q_D(const PaymentStore); return d->lastError; }
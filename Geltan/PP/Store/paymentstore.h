@@ -0,0 +1,227 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentstore.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTSTORE_H
+#define PAYMENTSTORE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QJsonObject>
+#include "../Objects/payment.h"
+#include "../../geltan_global.h"
+
+namespace Geltan {
+namespace PP {
+
+class PaymentValue;
+class PaymentStorePrivate;
+
+/*!
+ * \brief Local SQLite database containing Payment data.
+ *
+ * The store persists complete payments including their transactions and related resources,
+ * so historic payments can be looked up and reports can be created without requesting the
+ * PayPal API. The complete payment data is stored as JSON, additionally the following values
+ * are stored in indexed columns to query them:
+ *
+ * \li the payment ID
+ * \li the IDs of sales, authorizations, orders, captures and refunds
+ * \li the state of the payment
+ * \li the email address of the payer
+ * \li the creation and update time of the payment
+ *
+ * Storing a payment that is already in the store replaces the old data. Every store object
+ * uses its own database connection, so a store should only be used in the thread it has been
+ * created in.
+ *
+ * \code{.cpp}
+ * Geltan::PP::PaymentStore *store = new Geltan::PP::PaymentStore(this);
+ * if (store->open(QStringLiteral("/var/lib/myshop/payments.sqlite"))) {
+ *     const QList<Geltan::PP::PaymentValue> approved = store->find(monthStart, monthEnd, Geltan::PP::Payment::Approved);
+ * }
+ * \endcode
+ *
+ * \sa Payments::Get::store
+ *
+ * \headerfile "" <Geltan/PP/Store/paymentstore.h>
+ */
+class GELTANSHARED_EXPORT PaymentStore : public QObject
+{
+    Q_OBJECT
+    /*!
+     * \brief The path of the currently opened database file.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>fileName() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>fileNameChanged(const QString &fileName)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString fileName READ fileName NOTIFY fileNameChanged)
+    /*!
+     * \brief Returns true if the database is open.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>isOpen() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>isOpenChanged(bool isOpen)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool isOpen READ isOpen NOTIFY isOpenChanged)
+    /*!
+     * \brief The text of the last database error.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>QString</TD><TD>lastError() const</TD></TR></TABLE>
+     */
+    Q_PROPERTY(QString lastError READ lastError)
+public:
+    /*!
+     * \brief Constructs a new PaymentStore object.
+     */
+    explicit PaymentStore(QObject *parent = nullptr);
+
+    /*!
+     * \brief Deconstructs the PaymentStore object and closes the database.
+     */
+    ~PaymentStore();
+
+    /*!
+     * \brief Opens the SQLite database at \a fileName and creates the tables and indexes if needed.
+     *
+     * Returns false if the database could not be opened or initialized.
+     */
+    Q_INVOKABLE bool open(const QString &fileName);
+
+    /*!
+     * \brief Closes the database.
+     */
+    Q_INVOKABLE void close();
+
+    /*!
+     * \brief Stores \a payment and its related resources.
+     */
+    bool store(const PaymentValue &payment);
+
+    /*!
+     * \brief Stores the \a payments inside a single transaction.
+     */
+    bool store(const QList<PaymentValue> &payments);
+
+    /*!
+     * \brief Stores the data of the Payment object \a payment.
+     * \overload
+     */
+    bool store(const Payment *payment);
+
+    /*!
+     * \brief Stores the \a json data of a payment as returned by the API.
+     *
+     * Other than the PaymentValue overloads, this keeps all members of the API response in the store.
+     * \overload
+     */
+    bool store(const QJsonObject &json);
+
+    /*!
+     * \brief Removes the payment with \a id and its related resources from the store.
+     */
+    Q_INVOKABLE bool remove(const QString &id);
+
+    /*!
+     * \brief Returns true if the store contains the payment identified by \a id.
+     */
+    Q_INVOKABLE bool contains(const QString &id) const;
+
+    /*!
+     * \brief Returns the payment identified by \a id.
+     *
+     * Returns an empty PaymentValue if the store does not contain the payment.
+     */
+    PaymentValue payment(const QString &id) const;
+
+    /*!
+     * \brief Returns the stored JSON data of the payment identified by \a id.
+     *
+     * If the payment has been stored with store(const QJsonObject &json), this is the unchanged
+     * data returned by the API. Returns an empty QJsonObject if the store does not contain the payment.
+     */
+    QJsonObject paymentJson(const QString &id) const;
+
+    /*!
+     * \brief Returns the payment that contains the sale, authorization, order, capture or refund identified by \a resourceId.
+     *
+     * Returns an empty PaymentValue if the store does not contain the resource.
+     */
+    PaymentValue paymentByResourceId(const QString &resourceId) const;
+
+    /*!
+     * \brief Returns the payments created between \a from and \a to.
+     *
+     * Invalid times are not used for the query. If \a state is not Payment::NoState, only payments
+     * in that state are returned, if \a payerEmail is not empty, only payments of that payer.
+     * The result is sorted by creation time.
+     */
+    QList<PaymentValue> find(const QDateTime &from, const QDateTime &to, Payment::State state = Payment::NoState, const QString &payerEmail = QString()) const;
+
+    /*!
+     * \brief Returns the payments that have been updated after \a since, sorted by update time.
+     */
+    QList<PaymentValue> updatedSince(const QDateTime &since) const;
+
+    /*!
+     * \brief Returns the synchronization watermark saved for \a name.
+     *
+     * Returns an invalid QDateTime if no watermark has been saved.
+     *
+     * \sa Payments::Sync
+     */
+    QDateTime watermark(const QString &name) const;
+
+    /*!
+     * \brief Saves the synchronization \a watermark for \a name.
+     *
+     * An invalid \a watermark removes the saved value.
+     */
+    bool setWatermark(const QString &name, const QDateTime &watermark);
+
+    /*!
+     * \brief Returns the number of stored payments.
+     */
+    Q_INVOKABLE int count() const;
+
+    QString fileName() const;
+    bool isOpen() const;
+    QString lastError() const;
+
+Q_SIGNALS:
+    void fileNameChanged(const QString &fileName);
+    void isOpenChanged(bool isOpen);
+
+protected:
+    const QScopedPointer<PaymentStorePrivate> d_ptr;
+
+private:
+    Q_DISABLE_COPY(PaymentStore)
+    Q_DECLARE_PRIVATE(PaymentStore)
+};
+
+}
+}
+
+#endif // PAYMENTSTORE_H
@@ -0,0 +1,104 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Store/paymentstore_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTSTORE_P_H
+#define PAYMENTSTORE_P_H
+
+#include "paymentstore.h"
+#include "../Values/paymentvalue.h"
+#include "../pptimestamp.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentStorePrivate
+{
+public:
+    PaymentStorePrivate(PaymentStore *parent) :
+        q_ptr(parent)
+    {}
+
+    ~PaymentStorePrivate() {}
+
+    /*!
+     * \internal
+     * \brief Creates the tables and indexes if they do not exist yet.
+     */
+    bool createSchema();
+
+    /*!
+     * \internal
+     * \brief Writes a single payment, has to be called inside a transaction.
+     *
+     * \a json is stored as complete payment data, if it is empty, the JSON of \a payment is used.
+     */
+    bool write(const PaymentValue &payment, const QByteArray &json = QByteArray());
+
+    /*!
+     * \internal
+     * \brief Writes the \a payments inside a single transaction, \a jsons can contain the raw data for them.
+     */
+    bool writeAll(const QList<PaymentValue> &payments, const QList<QByteArray> &jsons = QList<QByteArray>());
+
+    /*!
+     * \internal
+     * \brief Executes the prepared \a query and returns the payments of the \c json column.
+     */
+    QList<PaymentValue> read(QSqlQuery &query) const;
+
+    /*!
+     * \internal
+     * \brief Returns false and saves the error text if \a error is valid.
+     */
+    bool check(const QSqlError &error) const;
+
+    /*!
+     * \internal
+     * \brief Converts a QDateTime into milliseconds since the epoch, invalid times are stored as NULL.
+     */
+    static QVariant toMSecs(const QDateTime &dt)
+    {
+        return dt.isValid() ? QVariant(dt.toMSecsSinceEpoch()) : QVariant(QVariant::LongLong);
+    }
+
+    /*!
+     * \internal
+     * \brief Converts milliseconds since the epoch into a QVariant, PPTimestamp::Invalid is stored as NULL.
+     */
+    static QVariant toMSecs(qint64 msecs)
+    {
+        return (msecs != PPTimestamp::Invalid) ? QVariant(msecs) : QVariant(QVariant::LongLong);
+    }
+
+    PaymentStore * const q_ptr;
+    Q_DECLARE_PUBLIC(PaymentStore)
+    QString connectionName;
+    QString fileName;
+    mutable QString lastError;
+};
+
+}
+}
+
+#endif // PAYMENTSTORE_P_H
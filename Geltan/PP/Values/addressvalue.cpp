@@ -0,0 +1,234 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/addressvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "addressvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+
+using namespace Geltan;
+using namespace PP;
+
+static const PPEnumToken addressNormalizationStatusTokens[] = {
+    {"NORMALIZED", Address::NORMALIZED},
+    {"UNNORMALIZED", Address::UNNORMALIZED},
+    {"UNNORMALIZED_USER_PREFERRED", Address::UNNORMALIZED_USER_PREFERRED},
+    {nullptr, 0}
+};
+
+static const PPEnumToken addressStatusTokens[] = {
+    {"CONFIRMED", Address::CONFIRMED},
+    {"UNCONFIRMED", Address::UNCONFIRMED},
+    {nullptr, 0}
+};
+
+// sorted by key, the state is handled separately as "Empty" means no state
+static const PPValueField<AddressValueData> addressValueFields[] = {
+    ppStringField("city", &AddressValueData::city, 50),
+    ppPooledStringField("country_code", &AddressValueData::countryCode, 2),
+    ppStringField("line1", &AddressValueData::line1, 100),
+    ppStringField("line2", &AddressValueData::line2, 100),
+    ppEnumField<AddressValueData, Address::NormalizationStatus, &AddressValueData::normalizationStatus>("normalization_status", addressNormalizationStatusTokens),
+    ppStringField("phone", &AddressValueData::phone),
+    ppStringField("postal_code", &AddressValueData::postalCode, 20),
+    ppStringField("recipient_name", &AddressValueData::recipientName, 127),
+    ppEnumField<AddressValueData, Address::Status, &AddressValueData::status>("status", addressStatusTokens),
+    ppPooledStringField("type", &AddressValueData::type)
+};
+
+AddressValue::AddressValue() :
+    d(new AddressValueData)
+{
+}
+
+
+AddressValue::AddressValue(const AddressValue &other) :
+    d(other.d)
+{
+}
+
+
+AddressValue::~AddressValue()
+{
+}
+
+
+AddressValue &AddressValue::operator=(const AddressValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+QString AddressValue::line1() const { return d->line1; }
+
+void AddressValue::setLine1(const QString &nLine1) { d->line1 = nLine1; }
+
+
+QString AddressValue::line2() const { return d->line2; }
+
+void AddressValue::setLine2(const QString &nLine2) { d->line2 = nLine2; }
+
+
+QString AddressValue::city() const { return d->city; }
+
+void AddressValue::setCity(const QString &nCity) { d->city = nCity; }
+
+
+QString AddressValue::countryCode() const { return d->countryCode; }
+
+void AddressValue::setCountryCode(const QString &nCountryCode) { d->countryCode = nCountryCode; }
+
+
+QString AddressValue::postalCode() const { return d->postalCode; }
+
+void AddressValue::setPostalCode(const QString &nPostalCode) { d->postalCode = nPostalCode; }
+
+
+QString AddressValue::state() const { return d->state; }
+
+void AddressValue::setState(const QString &nState) { d->state = nState; }
+
+
+QString AddressValue::phone() const { return d->phone; }
+
+void AddressValue::setPhone(const QString &nPhone) { d->phone = nPhone; }
+
+
+Address::NormalizationStatus AddressValue::normalizationStatus() const { return d->normalizationStatus; }
+
+void AddressValue::setNormalizationStatus(Address::NormalizationStatus nNormalizationStatus) { d->normalizationStatus = nNormalizationStatus; }
+
+
+Address::Status AddressValue::status() const { return d->status; }
+
+void AddressValue::setStatus(Address::Status nStatus) { d->status = nStatus; }
+
+
+QString AddressValue::type() const { return d->type; }
+
+void AddressValue::setType(const QString &nType) { d->type = nType; }
+
+
+QString AddressValue::recipientName() const { return d->recipientName; }
+
+void AddressValue::setRecipientName(const QString &nRecipientName) { d->recipientName = nRecipientName; }
+
+
+
+
+AddressValue AddressValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+AddressValue AddressValue::fromJson(const PPJsonValue &json)
+{
+    AddressValue a;
+
+    if (json.isEmpty()) {
+        return a;
+    }
+
+    AddressValueData *d = a.d.data();
+
+    ppReadValueFields(d, json, addressValueFields);
+
+    const QString stateString = json.value(QLatin1String("state")).toString();
+    if (QString::compare(stateString, QStringLiteral("Empty"), Qt::CaseInsensitive) != 0) {
+        d->state = stateString;
+    }
+
+    return a;
+}
+
+
+
+QJsonObject AddressValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    ppWriteValueFields(d.constData(), &json, addressValueFields);
+
+    if (!d->state.isEmpty()) {
+        json.insert(QStringLiteral("state"), d->state.left(100));
+    }
+
+    return json;
+}
+
+
+
+bool AddressValue::isEmpty() const
+{
+    return (d->state.isEmpty() && ppValueFieldsEmpty(d.constData(), addressValueFields));
+}
+
+
+
+bool AddressValue::fitsLimits() const
+{
+    return ((d->state.size() <= 100) && !ppValueFieldsTooLong(d.constData(), addressValueFields));
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const AddressValue &value)
+{
+    const AddressValueData *d = value.d.constData();
+
+    stream << d->line1
+           << d->line2
+           << d->city
+           << d->countryCode
+           << d->postalCode
+           << d->state
+           << d->phone
+           << static_cast<qint32>(d->normalizationStatus)
+           << static_cast<qint32>(d->status)
+           << d->type
+           << d->recipientName;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, AddressValue &value)
+{
+    AddressValueData *d = value.d.data();
+
+    stream >> d->line1
+           >> d->line2
+           >> d->city
+           >> d->countryCode
+           >> d->postalCode
+           >> d->state
+           >> d->phone;
+    PPValuesBasePrivate::readInt(stream, &d->normalizationStatus);
+    PPValuesBasePrivate::readInt(stream, &d->status);
+    stream >> d->type
+           >> d->recipientName;
+
+    return stream;
+}
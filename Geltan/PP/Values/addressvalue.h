@@ -0,0 +1,152 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/addressvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADDRESSVALUE_H
+#define ADDRESSVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Objects/address.h>
+
+namespace Geltan {
+namespace PP {
+
+class AddressValueData;
+
+/*!
+ * \brief Implicitly shared value type containing the data of an address.
+ *
+ * Other than Address and ShippingAddress this is not a QObject, it is cheap to copy and can be passed
+ * between threads. The recipient name is only used for shipping addresses.
+ *
+ * \sa Address, ShippingAddress
+ *
+ * \headerfile "" <Geltan/PP/Values/addressvalue.h>
+ */
+class GELTANSHARED_EXPORT AddressValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty AddressValue.
+     */
+    AddressValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    AddressValue(const AddressValue &other);
+
+    /*!
+     * \brief Deconstructs the AddressValue.
+     */
+    ~AddressValue();
+
+    /*!
+     * \brief Assigns \a other to this AddressValue.
+     */
+    AddressValue &operator=(const AddressValue &other);
+
+    /*!
+     * \brief Creates a new AddressValue from JSON data.
+     */
+    static AddressValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new AddressValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static AddressValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the address data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns true if no string member exceeds the maximum length accepted by the PayPal API.
+     *
+     * toJsonObject() cuts longer members.
+     */
+    bool fitsLimits() const;
+
+    QString line1() const;
+    QString line2() const;
+    QString city() const;
+    QString countryCode() const;
+    QString postalCode() const;
+    QString state() const;
+    QString phone() const;
+    Address::NormalizationStatus normalizationStatus() const;
+    Address::Status status() const;
+    QString type() const;
+    QString recipientName() const;
+
+    void setLine1(const QString &nLine1);
+    void setLine2(const QString &nLine2);
+    void setCity(const QString &nCity);
+    void setCountryCode(const QString &nCountryCode);
+    void setPostalCode(const QString &nPostalCode);
+    void setState(const QString &nState);
+    void setPhone(const QString &nPhone);
+    void setNormalizationStatus(Address::NormalizationStatus nNormalizationStatus);
+    void setStatus(Address::Status nStatus);
+    void setType(const QString &nType);
+    void setRecipientName(const QString &nRecipientName);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const AddressValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, AddressValue &value);
+
+    QSharedDataPointer<AddressValueData> d;
+};
+
+/*!
+ * \relates AddressValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const AddressValue &value);
+
+/*!
+ * \relates AddressValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, AddressValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::AddressValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::AddressValue)
+
+#endif // ADDRESSVALUE_H
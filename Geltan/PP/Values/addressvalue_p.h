@@ -0,0 +1,72 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/addressvalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADDRESSVALUE_P_H
+#define ADDRESSVALUE_P_H
+
+#include "addressvalue.h"
+#include <QSharedData>
+
+namespace Geltan {
+namespace PP {
+
+class AddressValueData : public QSharedData
+{
+public:
+    AddressValueData() :
+        normalizationStatus(Address::UNKNOWN),
+        status(Address::NO_STATUS)
+    {}
+
+    AddressValueData(const AddressValueData &other) :
+        QSharedData(other),
+        line1(other.line1),
+        line2(other.line2),
+        city(other.city),
+        countryCode(other.countryCode),
+        postalCode(other.postalCode),
+        state(other.state),
+        phone(other.phone),
+        normalizationStatus(other.normalizationStatus),
+        status(other.status),
+        type(other.type),
+        recipientName(other.recipientName)
+    {}
+
+    ~AddressValueData() {}
+
+    QString line1;
+    QString line2;
+    QString city;
+    QString countryCode;
+    QString postalCode;
+    QString state;
+    QString phone;
+    Address::NormalizationStatus normalizationStatus;
+    Address::Status status;
+    QString type;
+    QString recipientName;
+};
+
+}
+}
+
+#endif // ADDRESSVALUE_P_H
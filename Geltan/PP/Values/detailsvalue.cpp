@@ -0,0 +1,200 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/detailsvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "detailsvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+
+using namespace Geltan;
+using namespace PP;
+
+// sorted by key
+static const PPValueField<DetailsValueData> detailsValueFields[] = {
+    ppMoneyField("gift_wrap", &DetailsValueData::giftWrap),
+    ppMoneyField("handling_fee", &DetailsValueData::handlingFee),
+    ppMoneyField("insurance", &DetailsValueData::insurance),
+    ppMoneyField("shipping", &DetailsValueData::shipping),
+    ppMoneyField("shipping_discount", &DetailsValueData::shippingDiscount),
+    ppMoneyField("subtotal", &DetailsValueData::subtotal),
+    ppMoneyField("tax", &DetailsValueData::tax)
+};
+
+DetailsValue::DetailsValue() :
+    d(new DetailsValueData)
+{
+}
+
+
+DetailsValue::DetailsValue(const DetailsValue &other) :
+    d(other.d)
+{
+}
+
+
+DetailsValue::~DetailsValue()
+{
+}
+
+
+DetailsValue &DetailsValue::operator=(const DetailsValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+float DetailsValue::subtotal() const { return d->subtotal.toFloat(); }
+
+Money DetailsValue::subtotalMoney() const { return d->subtotal; }
+
+void DetailsValue::setSubtotal(float nSubtotal) { d->subtotal = Money::fromDouble(nSubtotal); }
+
+void DetailsValue::setSubtotalMoney(const Money &nSubtotal) { d->subtotal = nSubtotal; }
+
+
+float DetailsValue::shipping() const { return d->shipping.toFloat(); }
+
+Money DetailsValue::shippingMoney() const { return d->shipping; }
+
+void DetailsValue::setShipping(float nShipping) { d->shipping = Money::fromDouble(nShipping); }
+
+void DetailsValue::setShippingMoney(const Money &nShipping) { d->shipping = nShipping; }
+
+
+float DetailsValue::tax() const { return d->tax.toFloat(); }
+
+Money DetailsValue::taxMoney() const { return d->tax; }
+
+void DetailsValue::setTax(float nTax) { d->tax = Money::fromDouble(nTax); }
+
+void DetailsValue::setTaxMoney(const Money &nTax) { d->tax = nTax; }
+
+
+float DetailsValue::handlingFee() const { return d->handlingFee.toFloat(); }
+
+Money DetailsValue::handlingFeeMoney() const { return d->handlingFee; }
+
+void DetailsValue::setHandlingFee(float nHandlingFee) { d->handlingFee = Money::fromDouble(nHandlingFee); }
+
+void DetailsValue::setHandlingFeeMoney(const Money &nHandlingFee) { d->handlingFee = nHandlingFee; }
+
+
+float DetailsValue::shippingDiscount() const { return d->shippingDiscount.toFloat(); }
+
+Money DetailsValue::shippingDiscountMoney() const { return d->shippingDiscount; }
+
+void DetailsValue::setShippingDiscount(float nShippingDiscount) { d->shippingDiscount = Money::fromDouble(nShippingDiscount); }
+
+void DetailsValue::setShippingDiscountMoney(const Money &nShippingDiscount) { d->shippingDiscount = nShippingDiscount; }
+
+
+float DetailsValue::insurance() const { return d->insurance.toFloat(); }
+
+Money DetailsValue::insuranceMoney() const { return d->insurance; }
+
+void DetailsValue::setInsurance(float nInsurance) { d->insurance = Money::fromDouble(nInsurance); }
+
+void DetailsValue::setInsuranceMoney(const Money &nInsurance) { d->insurance = nInsurance; }
+
+
+float DetailsValue::giftWrap() const { return d->giftWrap.toFloat(); }
+
+Money DetailsValue::giftWrapMoney() const { return d->giftWrap; }
+
+void DetailsValue::setGiftWrap(float nGiftWrap) { d->giftWrap = Money::fromDouble(nGiftWrap); }
+
+void DetailsValue::setGiftWrapMoney(const Money &nGiftWrap) { d->giftWrap = nGiftWrap; }
+
+
+
+
+DetailsValue DetailsValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+DetailsValue DetailsValue::fromJson(const PPJsonValue &json)
+{
+    DetailsValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    ppReadValueFields(v.d.data(), json, detailsValueFields);
+
+    return v;
+}
+
+
+
+QJsonObject DetailsValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    ppWriteValueFields(d.constData(), &json, detailsValueFields);
+
+    return json;
+}
+
+
+
+bool DetailsValue::isEmpty() const
+{
+    return ppValueFieldsEmpty(d.constData(), detailsValueFields);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const DetailsValue &value)
+{
+    const DetailsValueData *d = value.d.constData();
+
+    stream << d->subtotal
+           << d->shipping
+           << d->tax
+           << d->handlingFee
+           << d->shippingDiscount
+           << d->insurance
+           << d->giftWrap;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, DetailsValue &value)
+{
+    DetailsValueData *d = value.d.data();
+
+    stream >> d->subtotal
+           >> d->shipping
+           >> d->tax
+           >> d->handlingFee
+           >> d->shippingDiscount
+           >> d->insurance
+           >> d->giftWrap;
+
+    return stream;
+}
@@ -0,0 +1,150 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/detailsvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DETAILSVALUE_H
+#define DETAILSVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
+
+namespace Geltan {
+namespace PP {
+
+class DetailsValueData;
+
+/*!
+ * \brief Implicitly shared value type containing details about a payment amount.
+ *
+ * Other than Details this is not a QObject, it is cheap to copy and can be passed between threads.
+ *
+ * \sa Details
+ *
+ * \headerfile "" <Geltan/PP/Values/detailsvalue.h>
+ */
+class GELTANSHARED_EXPORT DetailsValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty DetailsValue.
+     */
+    DetailsValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    DetailsValue(const DetailsValue &other);
+
+    /*!
+     * \brief Deconstructs the DetailsValue.
+     */
+    ~DetailsValue();
+
+    /*!
+     * \brief Assigns \a other to this DetailsValue.
+     */
+    DetailsValue &operator=(const DetailsValue &other);
+
+    /*!
+     * \brief Creates a new DetailsValue from JSON data.
+     */
+    static DetailsValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new DetailsValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static DetailsValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the details data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    float subtotal() const;
+    Money subtotalMoney() const;
+    float shipping() const;
+    Money shippingMoney() const;
+    float tax() const;
+    Money taxMoney() const;
+    float handlingFee() const;
+    Money handlingFeeMoney() const;
+    float shippingDiscount() const;
+    Money shippingDiscountMoney() const;
+    float insurance() const;
+    Money insuranceMoney() const;
+    float giftWrap() const;
+    Money giftWrapMoney() const;
+
+    void setSubtotal(float nSubtotal);
+    void setSubtotalMoney(const Money &nSubtotal);
+    void setShipping(float nShipping);
+    void setShippingMoney(const Money &nShipping);
+    void setTax(float nTax);
+    void setTaxMoney(const Money &nTax);
+    void setHandlingFee(float nHandlingFee);
+    void setHandlingFeeMoney(const Money &nHandlingFee);
+    void setShippingDiscount(float nShippingDiscount);
+    void setShippingDiscountMoney(const Money &nShippingDiscount);
+    void setInsurance(float nInsurance);
+    void setInsuranceMoney(const Money &nInsurance);
+    void setGiftWrap(float nGiftWrap);
+    void setGiftWrapMoney(const Money &nGiftWrap);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const DetailsValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, DetailsValue &value);
+
+    QSharedDataPointer<DetailsValueData> d;
+};
+
+/*!
+ * \relates DetailsValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const DetailsValue &value);
+
+/*!
+ * \relates DetailsValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, DetailsValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::DetailsValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::DetailsValue)
+
+#endif // DETAILSVALUE_H
@@ -0,0 +1,69 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/detailsvalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DETAILSVALUE_P_H
+#define DETAILSVALUE_P_H
+
+#include "detailsvalue.h"
+#include <QSharedData>
+
+namespace Geltan {
+namespace PP {
+
+class DetailsValueData : public QSharedData
+{
+public:
+    DetailsValueData() :
+        subtotal(),
+        shipping(),
+        tax(),
+        handlingFee(),
+        shippingDiscount(),
+        insurance(),
+        giftWrap()
+    {}
+
+    DetailsValueData(const DetailsValueData &other) :
+        QSharedData(other),
+        subtotal(other.subtotal),
+        shipping(other.shipping),
+        tax(other.tax),
+        handlingFee(other.handlingFee),
+        shippingDiscount(other.shippingDiscount),
+        insurance(other.insurance),
+        giftWrap(other.giftWrap)
+    {}
+
+    ~DetailsValueData() {}
+
+    Money subtotal;
+    Money shipping;
+    Money tax;
+    Money handlingFee;
+    Money shippingDiscount;
+    Money insurance;
+    Money giftWrap;
+};
+
+}
+}
+
+#endif // DETAILSVALUE_P_H
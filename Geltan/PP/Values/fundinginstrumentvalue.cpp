@@ -0,0 +1,411 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/fundinginstrumentvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "fundinginstrumentvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include <Geltan/PP/ppenumsmap.h>
+#include <QJsonArray>
+
+using namespace Geltan;
+using namespace PP;
+
+FundingInstrumentValue::FundingInstrumentValue() :
+    d(new FundingInstrumentValueData)
+{
+}
+
+
+FundingInstrumentValue::FundingInstrumentValue(const FundingInstrumentValue &other) :
+    d(other.d)
+{
+}
+
+
+FundingInstrumentValue::~FundingInstrumentValue()
+{
+}
+
+
+FundingInstrumentValue &FundingInstrumentValue::operator=(const FundingInstrumentValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+FundingInstrumentValue::Type FundingInstrumentValue::type() const { return d->type; }
+
+void FundingInstrumentValue::setType(Type nType) { d->type = nType; }
+
+
+QString FundingInstrumentValue::number() const { return d->number; }
+
+void FundingInstrumentValue::setNumber(const QString &nNumber) { d->number = nNumber; }
+
+
+PayPal::CreditCardType FundingInstrumentValue::cardType() const { return d->cardType; }
+
+void FundingInstrumentValue::setCardType(PayPal::CreditCardType nCardType) { d->cardType = nCardType; }
+
+
+int FundingInstrumentValue::expireMonth() const { return d->expireMonth; }
+
+void FundingInstrumentValue::setExpireMonth(int nExpireMonth) { d->expireMonth = nExpireMonth; }
+
+
+int FundingInstrumentValue::expireYear() const { return d->expireYear; }
+
+void FundingInstrumentValue::setExpireYear(int nExpireYear) { d->expireYear = nExpireYear; }
+
+
+QString FundingInstrumentValue::cvv2() const { return d->cvv2; }
+
+void FundingInstrumentValue::setCvv2(const QString &nCvv2) { d->cvv2 = nCvv2; }
+
+
+QString FundingInstrumentValue::firstName() const { return d->firstName; }
+
+void FundingInstrumentValue::setFirstName(const QString &nFirstName) { d->firstName = nFirstName; }
+
+
+QString FundingInstrumentValue::lastName() const { return d->lastName; }
+
+void FundingInstrumentValue::setLastName(const QString &nLastName) { d->lastName = nLastName; }
+
+
+AddressValue FundingInstrumentValue::billingAddress() const { return d->billingAddress; }
+
+void FundingInstrumentValue::setBillingAddress(const AddressValue &nBillingAddress) { d->billingAddress = nBillingAddress; }
+
+
+QString FundingInstrumentValue::externalCustomerId() const { return d->externalCustomerId; }
+
+void FundingInstrumentValue::setExternalCustomerId(const QString &nExternalCustomerId) { d->externalCustomerId = nExternalCustomerId; }
+
+
+CreditCard::State FundingInstrumentValue::state() const { return d->state; }
+
+void FundingInstrumentValue::setState(CreditCard::State nState) { d->state = nState; }
+
+
+QDateTime FundingInstrumentValue::validUntil() const { return PPTimestamp::toDateTime(d->validUntil); }
+
+void FundingInstrumentValue::setValidUntil(const QDateTime &nValidUntil) { d->validUntil = PPTimestamp::toMSecs(nValidUntil); }
+
+
+QList<LinkValue> FundingInstrumentValue::links() const { return d->links; }
+
+void FundingInstrumentValue::setLinks(const QList<LinkValue> &nLinks) { d->links = nLinks; }
+
+
+QString FundingInstrumentValue::creditCardId() const { return d->creditCardId; }
+
+void FundingInstrumentValue::setCreditCardId(const QString &nCreditCardId) { d->creditCardId = nCreditCardId; }
+
+
+QString FundingInstrumentValue::payerId() const { return d->payerId; }
+
+void FundingInstrumentValue::setPayerId(const QString &nPayerId) { d->payerId = nPayerId; }
+
+
+QString FundingInstrumentValue::last4() const { return d->last4; }
+
+void FundingInstrumentValue::setLast4(const QString &nLast4) { d->last4 = nLast4; }
+
+
+QString FundingInstrumentValue::billingAgreementId() const { return d->billingAgreementId; }
+
+void FundingInstrumentValue::setBillingAgreementId(const QString &nBillingAgreementId) { d->billingAgreementId = nBillingAgreementId; }
+
+
+int FundingInstrumentValue::installmentTerm() const { return d->installmentTerm; }
+
+void FundingInstrumentValue::setInstallmentTerm(int nInstallmentTerm) { d->installmentTerm = nInstallmentTerm; }
+
+
+PaymentAmountValue FundingInstrumentValue::installmentMonthlyPayment() const { return d->installmentMonthlyPayment; }
+
+void FundingInstrumentValue::setInstallmentMonthlyPayment(const PaymentAmountValue &nInstallmentMonthlyPayment) { d->installmentMonthlyPayment = nInstallmentMonthlyPayment; }
+
+
+PaymentAmountValue FundingInstrumentValue::installmentDiscountAmount() const { return d->installmentDiscountAmount; }
+
+void FundingInstrumentValue::setInstallmentDiscountAmount(const PaymentAmountValue &nInstallmentDiscountAmount) { d->installmentDiscountAmount = nInstallmentDiscountAmount; }
+
+
+double FundingInstrumentValue::installmentDiscountPercentage() const { return d->installmentDiscountPercentage; }
+
+void FundingInstrumentValue::setInstallmentDiscountPercentage(double nInstallmentDiscountPercentage) { d->installmentDiscountPercentage = nInstallmentDiscountPercentage; }
+
+
+
+
+
+static void fundingInstrumentInsertCurrency(QJsonObject *json, const QString &key, const PaymentAmountValue &value)
+{
+    if (!value.isEmpty()) {
+        QJsonObject c;
+        PPValuesBasePrivate::insertString(&c, QStringLiteral("currency"), value.currency());
+        PPValuesBasePrivate::insertMoney(&c, QStringLiteral("value"), value.totalMoney());
+        json->insert(key, c);
+    }
+}
+
+
+
+FundingInstrumentValue FundingInstrumentValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+FundingInstrumentValue FundingInstrumentValue::fromJson(const PPJsonValue &json)
+{
+    FundingInstrumentValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    FundingInstrumentValueData *d = v.d.data();
+
+    const PPJsonValue cco = json.value(QLatin1String("credit_card")).toObject();
+    const PPJsonValue ccto = json.value(QLatin1String("credit_card_token")).toObject();
+    const PPJsonValue bo = json.value(QLatin1String("billing")).toObject();
+
+    if (!cco.isEmpty()) {
+
+        d->type = Card;
+        d->number = cco.value(QLatin1String("number")).toString();
+        d->cardType = PPEnumsMap::creditCardTypeTokenToEnum(cco.value(QLatin1String("type")).toString());
+        d->expireMonth = cco.value(QLatin1String("expire_month")).toString().toInt();
+        d->expireYear = cco.value(QLatin1String("expire_year")).toString().toInt();
+        d->cvv2 = cco.value(QLatin1String("cvv2")).toString();
+        d->firstName = cco.value(QLatin1String("first_name")).toString();
+        d->lastName = cco.value(QLatin1String("last_name")).toString();
+        d->billingAddress = AddressValue::fromJson(cco.value(QLatin1String("billing_address")).toObject());
+        d->externalCustomerId = cco.value(QLatin1String("external_customer_id")).toString();
+
+        const QString sState = cco.value(QLatin1String("state")).toString();
+        if (sState == QLatin1String("ok")) {
+            d->state = CreditCard::Ok;
+        } else if (sState == QLatin1String("expired")) {
+            d->state = CreditCard::Expired;
+        }
+
+        d->validUntil = PPValuesBasePrivate::toMSecs(cco.value(QLatin1String("valid_until")));
+
+        const PPJsonValue la = cco.value(QLatin1String("links")).toArray();
+        if (!la.isEmpty()) {
+            d->links.reserve(la.count());
+            for (const PPJsonValue &l : la) {
+                d->links.append(LinkValue::fromJson(l.toObject()));
+            }
+        }
+
+    } else if (!ccto.isEmpty()) {
+
+        d->type = CardToken;
+        d->creditCardId = ccto.value(QLatin1String("credit_card_id")).toString();
+        d->payerId = ccto.value(QLatin1String("payer_id")).toString();
+        d->last4 = ccto.value(QLatin1String("last4")).toString();
+        d->cardType = PPEnumsMap::creditCardTypeTokenToEnum(ccto.value(QLatin1String("type")).toString());
+        d->expireMonth = ccto.value(QLatin1String("expire_month")).toString().toInt();
+        d->expireYear = ccto.value(QLatin1String("expire_year")).toString().toInt();
+
+    } else if (!bo.isEmpty()) {
+
+        d->type = Billing;
+        d->billingAgreementId = bo.value(QLatin1String("billing_agreement_id")).toString();
+
+        const PPJsonValue sio = bo.value(QLatin1String("selected_installment_option")).toObject();
+        if (!sio.isEmpty()) {
+            d->installmentTerm = sio.value(QLatin1String("term")).toString().toInt();
+            d->installmentMonthlyPayment = PaymentAmountValue::fromJson(sio.value(QLatin1String("monthly_payment")).toObject());
+            d->installmentDiscountAmount = PaymentAmountValue::fromJson(sio.value(QLatin1String("discount_amount")).toObject());
+            // the API really calls it discount_percentag
+            d->installmentDiscountPercentage = sio.value(QLatin1String("discount_percentag")).toString().toDouble();
+        }
+    }
+
+    return v;
+}
+
+
+
+QJsonObject FundingInstrumentValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    QJsonObject o;
+
+    switch(d->type) {
+    case Card:
+    {
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("number"), d->number);
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("type"), PPEnumsMap::creditCardTypeEnumToToken(d->cardType));
+        if (d->expireMonth > 0) {
+            o.insert(QStringLiteral("expire_month"), QString::number(d->expireMonth));
+        }
+        if (d->expireYear > 0) {
+            o.insert(QStringLiteral("expire_year"), QString::number(d->expireYear));
+        }
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("cvv2"), d->cvv2);
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("first_name"), d->firstName);
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("last_name"), d->lastName);
+        PPValuesBasePrivate::insertObject(&o, QStringLiteral("billing_address"), d->billingAddress.toJsonObject());
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("external_customer_id"), d->externalCustomerId);
+
+        switch(d->state) {
+        case CreditCard::Ok:
+            o.insert(QStringLiteral("state"), QStringLiteral("ok"));
+            break;
+        case CreditCard::Expired:
+            o.insert(QStringLiteral("state"), QStringLiteral("expired"));
+            break;
+        default:
+            break;
+        }
+
+        PPValuesBasePrivate::insertTimestamp(&o, QStringLiteral("valid_until"), d->validUntil);
+
+        if (!d->links.isEmpty()) {
+            QJsonArray la;
+            for (const LinkValue &l : d->links) {
+                la.append(l.toJsonObject());
+            }
+            o.insert(QStringLiteral("links"), la);
+        }
+
+        json.insert(QStringLiteral("credit_card"), o);
+        break;
+    }
+    case CardToken:
+    {
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("credit_card_id"), d->creditCardId);
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("payer_id"), d->payerId);
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("last4"), d->last4);
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("type"), PPEnumsMap::creditCardTypeEnumToToken(d->cardType));
+        if (d->expireMonth > 0) {
+            o.insert(QStringLiteral("expire_month"), QString::number(d->expireMonth));
+        }
+        if (d->expireYear > 0) {
+            o.insert(QStringLiteral("expire_year"), QString::number(d->expireYear));
+        }
+
+        json.insert(QStringLiteral("credit_card_token"), o);
+        break;
+    }
+    case Billing:
+    {
+        PPValuesBasePrivate::insertString(&o, QStringLiteral("billing_agreement_id"), d->billingAgreementId);
+
+        QJsonObject sio;
+        if (d->installmentTerm > 0) {
+            sio.insert(QStringLiteral("term"), QString::number(d->installmentTerm));
+        }
+        fundingInstrumentInsertCurrency(&sio, QStringLiteral("monthly_payment"), d->installmentMonthlyPayment);
+        fundingInstrumentInsertCurrency(&sio, QStringLiteral("discount_amount"), d->installmentDiscountAmount);
+        if (d->installmentDiscountPercentage != 0.0) {
+            sio.insert(QStringLiteral("discount_percentag"), QString::number(d->installmentDiscountPercentage));
+        }
+        PPValuesBasePrivate::insertObject(&o, QStringLiteral("selected_installment_option"), sio);
+
+        json.insert(QStringLiteral("billing"), o);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return json;
+}
+
+
+
+bool FundingInstrumentValue::isEmpty() const
+{
+    return (d->type == NoType);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const FundingInstrumentValue &value)
+{
+    const FundingInstrumentValueData *d = value.d.constData();
+
+    stream << static_cast<qint32>(d->type)
+           << d->number
+           << static_cast<qint32>(d->cardType)
+           << static_cast<qint32>(d->expireMonth)
+           << static_cast<qint32>(d->expireYear)
+           << d->cvv2
+           << d->firstName
+           << d->lastName
+           << d->billingAddress
+           << d->externalCustomerId
+           << static_cast<qint32>(d->state)
+           << d->validUntil
+           << d->links
+           << d->creditCardId
+           << d->payerId
+           << d->last4
+           << d->billingAgreementId
+           << static_cast<qint32>(d->installmentTerm)
+           << d->installmentMonthlyPayment
+           << d->installmentDiscountAmount
+           << d->installmentDiscountPercentage;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, FundingInstrumentValue &value)
+{
+    FundingInstrumentValueData *d = value.d.data();
+
+    PPValuesBasePrivate::readInt(stream, &d->type);
+    stream >> d->number;
+    PPValuesBasePrivate::readInt(stream, &d->cardType);
+    PPValuesBasePrivate::readInt(stream, &d->expireMonth);
+    PPValuesBasePrivate::readInt(stream, &d->expireYear);
+    stream >> d->cvv2
+           >> d->firstName
+           >> d->lastName
+           >> d->billingAddress
+           >> d->externalCustomerId;
+    PPValuesBasePrivate::readInt(stream, &d->state);
+    stream >> d->validUntil
+           >> d->links
+           >> d->creditCardId
+           >> d->payerId
+           >> d->last4
+           >> d->billingAgreementId;
+    PPValuesBasePrivate::readInt(stream, &d->installmentTerm);
+    stream >> d->installmentMonthlyPayment
+           >> d->installmentDiscountAmount
+           >> d->installmentDiscountPercentage;
+
+    return stream;
+}
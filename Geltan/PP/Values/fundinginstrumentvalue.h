@@ -0,0 +1,188 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/fundinginstrumentvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FUNDINGINSTRUMENTVALUE_H
+#define FUNDINGINSTRUMENTVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QDateTime>
+#include <QList>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/ppenums.h>
+#include <Geltan/PP/Objects/creditcard.h>
+#include <Geltan/PP/Values/addressvalue.h>
+#include <Geltan/PP/Values/paymentamountvalue.h>
+#include <Geltan/PP/Values/linkvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class FundingInstrumentValueData;
+
+/*!
+ * \brief Implicitly shared value type containing a funding instrument of a payer.
+ *
+ * A funding instrument is a credit card, a tokenized credit card or a billing instrument. Other than
+ * FundingInstrument, which contains one QObject for every possible type, this value holds the members of
+ * the single instrument that is set, the type() tells which one it is. Members that are not available for
+ * a type stay empty. The members of the billing_address and selected_installment_option objects are
+ * flattened into this value.
+ *
+ * \sa FundingInstrument, CreditCard, TokenizedCreditCard, BillingInstrument, InstallmentDescription
+ *
+ * \headerfile "" <Geltan/PP/Values/fundinginstrumentvalue.h>
+ */
+class GELTANSHARED_EXPORT FundingInstrumentValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty FundingInstrumentValue.
+     */
+    FundingInstrumentValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    FundingInstrumentValue(const FundingInstrumentValue &other);
+
+    /*!
+     * \brief Deconstructs the FundingInstrumentValue.
+     */
+    ~FundingInstrumentValue();
+
+    /*!
+     * \brief Assigns \a other to this FundingInstrumentValue.
+     */
+    FundingInstrumentValue &operator=(const FundingInstrumentValue &other);
+
+    /*!
+     * \brief The type of the funding instrument.
+     */
+    enum Type {
+        NoType      = 0,    /**< No funding instrument set. */
+        Card        = 1,    /**< The instrument is a credit card. PayPal API Name: credit_card */
+        CardToken   = 2,    /**< The instrument is a tokenized credit card. PayPal API Name: credit_card_token */
+        Billing     = 3     /**< The instrument is a billing instrument. PayPal API Name: billing */
+    };
+
+    /*!
+     * \brief Creates a new FundingInstrumentValue from JSON data.
+     *
+     * \a json has to be a funding instrument object as found in the funding_instruments array,
+     * containing one key named after the instrument type.
+     */
+    static FundingInstrumentValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new FundingInstrumentValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static FundingInstrumentValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the funding instrument data, including the read only members.
+     *
+     * The returned object has the same layout as the objects in the funding_instruments array,
+     * the instrument data is nested into a key named after the instrument type.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if no type is set.
+     */
+    bool isEmpty() const;
+
+    Type type() const;
+    QString number() const;
+    PayPal::CreditCardType cardType() const;
+    int expireMonth() const;
+    int expireYear() const;
+    QString cvv2() const;
+    QString firstName() const;
+    QString lastName() const;
+    AddressValue billingAddress() const;
+    QString externalCustomerId() const;
+    CreditCard::State state() const;
+    QDateTime validUntil() const;
+    QList<LinkValue> links() const;
+    QString creditCardId() const;
+    QString payerId() const;
+    QString last4() const;
+    QString billingAgreementId() const;
+    int installmentTerm() const;
+    PaymentAmountValue installmentMonthlyPayment() const;
+    PaymentAmountValue installmentDiscountAmount() const;
+    double installmentDiscountPercentage() const;
+
+    void setType(Type nType);
+    void setNumber(const QString &nNumber);
+    void setCardType(PayPal::CreditCardType nCardType);
+    void setExpireMonth(int nExpireMonth);
+    void setExpireYear(int nExpireYear);
+    void setCvv2(const QString &nCvv2);
+    void setFirstName(const QString &nFirstName);
+    void setLastName(const QString &nLastName);
+    void setBillingAddress(const AddressValue &nBillingAddress);
+    void setExternalCustomerId(const QString &nExternalCustomerId);
+    void setState(CreditCard::State nState);
+    void setValidUntil(const QDateTime &nValidUntil);
+    void setLinks(const QList<LinkValue> &nLinks);
+    void setCreditCardId(const QString &nCreditCardId);
+    void setPayerId(const QString &nPayerId);
+    void setLast4(const QString &nLast4);
+    void setBillingAgreementId(const QString &nBillingAgreementId);
+    void setInstallmentTerm(int nInstallmentTerm);
+    void setInstallmentMonthlyPayment(const PaymentAmountValue &nInstallmentMonthlyPayment);
+    void setInstallmentDiscountAmount(const PaymentAmountValue &nInstallmentDiscountAmount);
+    void setInstallmentDiscountPercentage(double nInstallmentDiscountPercentage);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const FundingInstrumentValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, FundingInstrumentValue &value);
+
+    QSharedDataPointer<FundingInstrumentValueData> d;
+};
+
+/*!
+ * \relates FundingInstrumentValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const FundingInstrumentValue &value);
+
+/*!
+ * \relates FundingInstrumentValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, FundingInstrumentValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::FundingInstrumentValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::FundingInstrumentValue)
+
+#endif // FUNDINGINSTRUMENTVALUE_H
@@ -0,0 +1,99 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/fundinginstrumentvalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FUNDINGINSTRUMENTVALUE_P_H
+#define FUNDINGINSTRUMENTVALUE_P_H
+
+#include "fundinginstrumentvalue.h"
+#include <QSharedData>
+#include <Geltan/PP/pptimestamp.h>
+
+namespace Geltan {
+namespace PP {
+
+class FundingInstrumentValueData : public QSharedData
+{
+public:
+    FundingInstrumentValueData() :
+        type(FundingInstrumentValue::NoType),
+        cardType(PayPal::NoCreditCardType),
+        expireMonth(0),
+        expireYear(0),
+        state(CreditCard::NoState),
+        validUntil(PPTimestamp::Invalid),
+        installmentTerm(0),
+        installmentDiscountPercentage(0.0)
+    {}
+
+    FundingInstrumentValueData(const FundingInstrumentValueData &other) :
+        QSharedData(other),
+        type(other.type),
+        number(other.number),
+        cardType(other.cardType),
+        expireMonth(other.expireMonth),
+        expireYear(other.expireYear),
+        cvv2(other.cvv2),
+        firstName(other.firstName),
+        lastName(other.lastName),
+        billingAddress(other.billingAddress),
+        externalCustomerId(other.externalCustomerId),
+        state(other.state),
+        validUntil(other.validUntil),
+        links(other.links),
+        creditCardId(other.creditCardId),
+        payerId(other.payerId),
+        last4(other.last4),
+        billingAgreementId(other.billingAgreementId),
+        installmentTerm(other.installmentTerm),
+        installmentMonthlyPayment(other.installmentMonthlyPayment),
+        installmentDiscountAmount(other.installmentDiscountAmount),
+        installmentDiscountPercentage(other.installmentDiscountPercentage)
+    {}
+
+    ~FundingInstrumentValueData() {}
+
+    FundingInstrumentValue::Type type;
+    QString number;
+    PayPal::CreditCardType cardType;
+    int expireMonth;
+    int expireYear;
+    QString cvv2;
+    QString firstName;
+    QString lastName;
+    AddressValue billingAddress;
+    QString externalCustomerId;
+    CreditCard::State state;
+    qint64 validUntil;
+    QList<LinkValue> links;
+    QString creditCardId;
+    QString payerId;
+    QString last4;
+    QString billingAgreementId;
+    int installmentTerm;
+    PaymentAmountValue installmentMonthlyPayment;
+    PaymentAmountValue installmentDiscountAmount;
+    double installmentDiscountPercentage;
+};
+
+}
+}
+
+#endif // FUNDINGINSTRUMENTVALUE_P_H
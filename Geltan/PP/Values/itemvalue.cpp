@@ -0,0 +1,195 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/itemvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "itemvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+
+using namespace Geltan;
+using namespace PP;
+
+// sorted by key
+static const PPValueField<ItemValueData> itemValueFields[] = {
+    ppPooledStringField("currency", &ItemValueData::currency, 3),
+    ppStringField("description", &ItemValueData::description, 127),
+    ppStringField("name", &ItemValueData::name, 127),
+    ppMoneyField("price", &ItemValueData::price),
+    ppIntStringField("quantity", &ItemValueData::quantity),
+    ppStringField("sku", &ItemValueData::sku, 127),
+    ppMoneyField("tax", &ItemValueData::tax),
+    ppUrlField("url", &ItemValueData::url)
+};
+
+ItemValue::ItemValue() :
+    d(new ItemValueData)
+{
+}
+
+
+ItemValue::ItemValue(const ItemValue &other) :
+    d(other.d)
+{
+}
+
+
+ItemValue::~ItemValue()
+{
+}
+
+
+ItemValue &ItemValue::operator=(const ItemValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+QString ItemValue::sku() const { return d->sku; }
+
+void ItemValue::setSku(const QString &nSku) { d->sku = nSku; }
+
+
+QString ItemValue::name() const { return d->name; }
+
+void ItemValue::setName(const QString &nName) { d->name = nName; }
+
+
+QString ItemValue::description() const { return d->description; }
+
+void ItemValue::setDescription(const QString &nDescription) { d->description = nDescription; }
+
+
+int ItemValue::quantity() const { return d->quantity; }
+
+void ItemValue::setQuantity(int nQuantity) { d->quantity = nQuantity; }
+
+
+float ItemValue::price() const { return d->price.toFloat(); }
+
+Money ItemValue::priceMoney() const { return d->price; }
+
+void ItemValue::setPrice(float nPrice) { d->price = Money::fromDouble(nPrice); }
+
+void ItemValue::setPriceMoney(const Money &nPrice) { d->price = nPrice; }
+
+
+QString ItemValue::currency() const { return d->currency; }
+
+void ItemValue::setCurrency(const QString &nCurrency) { d->currency = nCurrency; }
+
+
+float ItemValue::tax() const { return d->tax.toFloat(); }
+
+Money ItemValue::taxMoney() const { return d->tax; }
+
+void ItemValue::setTax(float nTax) { d->tax = Money::fromDouble(nTax); }
+
+void ItemValue::setTaxMoney(const Money &nTax) { d->tax = nTax; }
+
+
+QUrl ItemValue::url() const { return d->url; }
+
+void ItemValue::setUrl(const QUrl &nUrl) { d->url = nUrl; }
+
+
+
+
+ItemValue ItemValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+ItemValue ItemValue::fromJson(const PPJsonValue &json)
+{
+    ItemValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    ppReadValueFields(v.d.data(), json, itemValueFields);
+
+    return v;
+}
+
+
+
+QJsonObject ItemValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    ppWriteValueFields(d.constData(), &json, itemValueFields);
+
+    return json;
+}
+
+
+
+bool ItemValue::isEmpty() const
+{
+    return ppValueFieldsEmpty(d.constData(), itemValueFields);
+}
+
+
+
+bool ItemValue::fitsLimits() const
+{
+    return !ppValueFieldsTooLong(d.constData(), itemValueFields);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const ItemValue &value)
+{
+    const ItemValueData *d = value.d.constData();
+
+    stream << d->sku
+           << d->name
+           << d->description
+           << static_cast<qint32>(d->quantity)
+           << d->price
+           << d->currency
+           << d->tax
+           << d->url;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, ItemValue &value)
+{
+    ItemValueData *d = value.d.data();
+
+    stream >> d->sku
+           >> d->name
+           >> d->description;
+    PPValuesBasePrivate::readInt(stream, &d->quantity);
+    stream >> d->price
+           >> d->currency
+           >> d->tax
+           >> d->url;
+
+    return stream;
+}
@@ -0,0 +1,150 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/itemvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ITEMVALUE_H
+#define ITEMVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QUrl>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
+
+namespace Geltan {
+namespace PP {
+
+class ItemValueData;
+
+/*!
+ * \brief Implicitly shared value type containing the data of a single item.
+ *
+ * Other than Item this is not a QObject, it is cheap to copy and can be passed between threads.
+ *
+ * \sa Item
+ *
+ * \headerfile "" <Geltan/PP/Values/itemvalue.h>
+ */
+class GELTANSHARED_EXPORT ItemValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty ItemValue.
+     */
+    ItemValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    ItemValue(const ItemValue &other);
+
+    /*!
+     * \brief Deconstructs the ItemValue.
+     */
+    ~ItemValue();
+
+    /*!
+     * \brief Assigns \a other to this ItemValue.
+     */
+    ItemValue &operator=(const ItemValue &other);
+
+    /*!
+     * \brief Creates a new ItemValue from JSON data.
+     */
+    static ItemValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new ItemValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static ItemValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the item data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns true if no string member exceeds the maximum length accepted by the PayPal API.
+     *
+     * toJsonObject() cuts longer members.
+     */
+    bool fitsLimits() const;
+
+    QString sku() const;
+    QString name() const;
+    QString description() const;
+    int quantity() const;
+    float price() const;
+    Money priceMoney() const;
+    QString currency() const;
+    float tax() const;
+    Money taxMoney() const;
+    QUrl url() const;
+
+    void setSku(const QString &nSku);
+    void setName(const QString &nName);
+    void setDescription(const QString &nDescription);
+    void setQuantity(int nQuantity);
+    void setPrice(float nPrice);
+    void setPriceMoney(const Money &nPrice);
+    void setCurrency(const QString &nCurrency);
+    void setTax(float nTax);
+    void setTaxMoney(const Money &nTax);
+    void setUrl(const QUrl &nUrl);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const ItemValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, ItemValue &value);
+
+    QSharedDataPointer<ItemValueData> d;
+};
+
+/*!
+ * \relates ItemValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const ItemValue &value);
+
+/*!
+ * \relates ItemValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, ItemValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::ItemValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::ItemValue)
+
+#endif // ITEMVALUE_H
@@ -0,0 +1,147 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/linkvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "linkvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+
+using namespace Geltan;
+using namespace PP;
+
+static const PPEnumToken linkMethodTokens[] = {
+    {"GET", Link::Get},
+    {"POST", Link::Post},
+    {"REDIRECT", Link::Redirect},
+    {nullptr, 0}
+};
+
+// sorted by key
+static const PPValueField<LinkValueData> linkValueFields[] = {
+    ppUrlField("href", &LinkValueData::href),
+    ppEnumField<LinkValueData, Link::MethodType, &LinkValueData::method>("method", linkMethodTokens),
+    ppPooledStringField("rel", &LinkValueData::rel)
+};
+
+LinkValue::LinkValue() :
+    d(new LinkValueData)
+{
+}
+
+
+LinkValue::LinkValue(const LinkValue &other) :
+    d(other.d)
+{
+}
+
+
+LinkValue::~LinkValue()
+{
+}
+
+
+LinkValue &LinkValue::operator=(const LinkValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+QUrl LinkValue::href() const { return d->href; }
+
+void LinkValue::setHref(const QUrl &nHref) { d->href = nHref; }
+
+
+QString LinkValue::rel() const { return d->rel; }
+
+void LinkValue::setRel(const QString &nRel) { d->rel = nRel; }
+
+
+Link::MethodType LinkValue::method() const { return d->method; }
+
+void LinkValue::setMethod(Link::MethodType nMethod) { d->method = nMethod; }
+
+
+
+
+LinkValue LinkValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+LinkValue LinkValue::fromJson(const PPJsonValue &json)
+{
+    LinkValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    ppReadValueFields(v.d.data(), json, linkValueFields);
+
+    return v;
+}
+
+
+
+QJsonObject LinkValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    ppWriteValueFields(d.constData(), &json, linkValueFields);
+
+    return json;
+}
+
+
+
+bool LinkValue::isEmpty() const
+{
+    return ppValueFieldsEmpty(d.constData(), linkValueFields);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const LinkValue &value)
+{
+    const LinkValueData *d = value.d.constData();
+
+    stream << d->href
+           << d->rel
+           << static_cast<qint32>(d->method);
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, LinkValue &value)
+{
+    LinkValueData *d = value.d.data();
+
+    stream >> d->href
+           >> d->rel;
+    PPValuesBasePrivate::readInt(stream, &d->method);
+
+    return stream;
+}
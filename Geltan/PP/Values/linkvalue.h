@@ -0,0 +1,129 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/linkvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LINKVALUE_H
+#define LINKVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QUrl>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Objects/link.h>
+
+namespace Geltan {
+namespace PP {
+
+class LinkValueData;
+
+/*!
+ * \brief Implicitly shared value type containing a <a href="https://en.wikipedia.org/wiki/HATEOAS">HATEOAS</a> link.
+ *
+ * Other than Link this is not a QObject, it is cheap to copy and can be passed between threads.
+ *
+ * \sa Link
+ *
+ * \headerfile "" <Geltan/PP/Values/linkvalue.h>
+ */
+class GELTANSHARED_EXPORT LinkValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty LinkValue.
+     */
+    LinkValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    LinkValue(const LinkValue &other);
+
+    /*!
+     * \brief Deconstructs the LinkValue.
+     */
+    ~LinkValue();
+
+    /*!
+     * \brief Assigns \a other to this LinkValue.
+     */
+    LinkValue &operator=(const LinkValue &other);
+
+    /*!
+     * \brief Creates a new LinkValue from JSON data.
+     */
+    static LinkValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new LinkValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static LinkValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the link data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    QUrl href() const;
+    QString rel() const;
+    Link::MethodType method() const;
+
+    void setHref(const QUrl &nHref);
+    void setRel(const QString &nRel);
+    void setMethod(Link::MethodType nMethod);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const LinkValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, LinkValue &value);
+
+    QSharedDataPointer<LinkValueData> d;
+};
+
+/*!
+ * \relates LinkValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const LinkValue &value);
+
+/*!
+ * \relates LinkValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, LinkValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::LinkValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::LinkValue)
+
+#endif // LINKVALUE_H
@@ -0,0 +1,55 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/linkvalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LINKVALUE_P_H
+#define LINKVALUE_P_H
+
+#include "linkvalue.h"
+#include <QSharedData>
+
+namespace Geltan {
+namespace PP {
+
+class LinkValueData : public QSharedData
+{
+public:
+    LinkValueData() :
+        method(Link::Undefined)
+    {}
+
+    LinkValueData(const LinkValueData &other) :
+        QSharedData(other),
+        href(other.href),
+        rel(other.rel),
+        method(other.method)
+    {}
+
+    ~LinkValueData() {}
+
+    QUrl href;
+    QString rel;
+    Link::MethodType method;
+};
+
+}
+}
+
+#endif // LINKVALUE_P_H
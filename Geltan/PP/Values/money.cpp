@@ -0,0 +1,396 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/money.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "money.h"
+#include "../ppjsonvalue.h"
+#include <QJsonValue>
+#include <limits>
+
+using namespace Geltan;
+using namespace PP;
+
+const int Money::MaxDecimals;
+
+static const qint64 powersOfTen[Money::MaxDecimals + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+/*
+ * Multiplies units by 10^places, saturating at the limits of qint64 instead of overflowing.
+ */
+static qint64 scaleUp(qint64 units, int places)
+{
+    const qint64 max = std::numeric_limits<qint64>::max();
+    const qint64 min = std::numeric_limits<qint64>::min();
+
+    for (int i = 0; i < places && units != 0; ++i) {
+        if (units > max / 10) {
+            return max;
+        }
+        if (units < min / 10) {
+            return min;
+        }
+        units *= 10;
+    }
+
+    return units;
+}
+
+/*
+ * Divides units by 10^places, rounded half away from zero.
+ */
+static qint64 scaleDown(qint64 units, int places)
+{
+    // 10^19 exceeds qint64, every value is less than half of it
+    if (places > 18) {
+        return 0;
+    }
+
+    qint64 divisor = 1;
+    for (int i = 0; i < places; ++i) {
+        divisor *= 10;
+    }
+
+    qint64 result = units / divisor;
+    const qint64 remainder = units % divisor;
+    if (remainder >= divisor - remainder) {
+        ++result;
+    } else if (-remainder >= divisor + remainder) {
+        --result;
+    }
+
+    return result;
+}
+
+static inline ushort charCode(QChar c) { return c.unicode(); }
+static inline ushort charCode(char c) { return static_cast<uchar>(c); }
+
+/*
+ * Parses a decimal number directly into minor units, without going through a floating point number.
+ */
+template<typename Char>
+static Money parseDecimal(const Char *s, int size, bool *ok)
+{
+    if (ok) {
+        *ok = false;
+    }
+
+    int begin = 0;
+    int end = size;
+
+    while (begin < end && (charCode(s[begin]) == ' ' || charCode(s[begin]) == '\t')) {
+        ++begin;
+    }
+    while (end > begin && (charCode(s[end - 1]) == ' ' || charCode(s[end - 1]) == '\t')) {
+        --end;
+    }
+
+    bool negative = false;
+    if (begin < end && (charCode(s[begin]) == '-' || charCode(s[begin]) == '+')) {
+        negative = (charCode(s[begin]) == '-');
+        ++begin;
+    }
+
+    const qint64 max = std::numeric_limits<qint64>::max();
+    qint64 units = 0;
+    int decimals = 0;
+    int digits = 0;
+    bool fraction = false;
+    bool roundUp = false;
+    bool rounded = false;
+
+    for (int i = begin; i < end; ++i) {
+        const ushort c = charCode(s[i]);
+        if (c == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            return Money();
+        }
+        const int digit = c - '0';
+        ++digits;
+        if (fraction && decimals == Money::MaxDecimals) {
+            // only the first surplus digit decides the rounding
+            if (!rounded) {
+                roundUp = (digit >= 5);
+                rounded = true;
+            }
+            continue;
+        }
+        if (units > (max - digit) / 10) {
+            return Money();
+        }
+        units = units * 10 + digit;
+        if (fraction) {
+            ++decimals;
+        }
+    }
+
+    if (digits == 0) {
+        return Money();
+    }
+
+    if (roundUp) {
+        if (units == max) {
+            return Money();
+        }
+        ++units;
+    }
+
+    if (ok) {
+        *ok = true;
+    }
+
+    return Money(negative ? -units : units, decimals);
+}
+
+
+Money::Money() :
+    m_units(0), m_decimals(0)
+{
+}
+
+
+Money::Money(qint64 minorUnits, int decimals) :
+    m_units(minorUnits), m_decimals(decimals)
+{
+    // keep the amount when the decimals are out of range
+    if (decimals < 0) {
+        m_units = scaleUp(minorUnits, -decimals);
+        m_decimals = 0;
+    } else if (decimals > MaxDecimals) {
+        m_units = scaleDown(minorUnits, decimals - MaxDecimals);
+        m_decimals = MaxDecimals;
+    }
+}
+
+
+
+
+Money Money::fromString(const QString &value, bool *ok)
+{
+    return parseDecimal(value.constData(), value.size(), ok);
+}
+
+
+
+Money Money::fromUtf8(const char *data, int size, bool *ok)
+{
+    return parseDecimal(data, size, ok);
+}
+
+
+
+Money Money::fromJson(const QJsonValue &value)
+{
+    if (value.isString()) {
+        return fromString(value.toString());
+    } else if (value.isDouble()) {
+        // JSON numbers are doubles already, format them with the maximum number of decimals and parse that
+        return fromString(QString::number(value.toDouble(), 'f', MaxDecimals));
+    }
+    return Money();
+}
+
+
+Money Money::fromJson(const PPJsonValue &value)
+{
+    if (value.isString()) {
+        const QByteArray s = value.toUtf8();
+        return fromUtf8(s.constData(), s.size());
+    } else if (value.isDouble()) {
+        return fromString(QString::number(value.toDouble(), 'f', MaxDecimals));
+    }
+    return Money();
+}
+
+
+
+Money Money::fromDouble(double value, int decimals)
+{
+    decimals = qBound(0, decimals, MaxDecimals);
+    return Money(qRound64(value * static_cast<double>(powersOfTen[decimals])), decimals);
+}
+
+
+
+int Money::currencyDecimals(const QString &currency)
+{
+    if (currency.size() != 3) {
+        return 2;
+    }
+
+    // ISO 4217 currencies without minor unit and the ones PayPal does not support decimals for
+    static const char zero[][4] = {"BIF", "CLP", "DJF", "GNF", "HUF", "ISK", "JPY", "KMF", "KRW", "PYG",
+                                   "RWF", "TWD", "UGX", "UYI", "VND", "VUV", "XAF", "XOF", "XPF"};
+    static const char three[][4] = {"BHD", "IQD", "JOD", "KWD", "LYD", "OMR", "TND"};
+
+    const QByteArray c = currency.toLatin1();
+
+    for (const char *z : zero) {
+        if (qstrncmp(c.constData(), z, 3) == 0) {
+            return 0;
+        }
+    }
+
+    for (const char *t : three) {
+        if (qstrncmp(c.constData(), t, 3) == 0) {
+            return 3;
+        }
+    }
+
+    return 2;
+}
+
+
+
+
+Money Money::rescaled(int decimals) const
+{
+    decimals = qBound(0, decimals, MaxDecimals);
+
+    if (decimals == m_decimals) {
+        return *this;
+    }
+
+    if (decimals > m_decimals) {
+        return Money(scaleUp(m_units, decimals - m_decimals), decimals);
+    }
+
+    return Money(scaleDown(m_units, m_decimals - decimals), decimals);
+}
+
+
+
+
+QString Money::toString() const
+{
+    // 19 digits, sign, decimal point and a leading zero
+    char buf[24];
+    int pos = sizeof(buf);
+
+    const bool negative = (m_units < 0);
+    quint64 u = negative ? (0 - static_cast<quint64>(m_units)) : static_cast<quint64>(m_units);
+
+    int written = 0;
+    do {
+        buf[--pos] = static_cast<char>('0' + (u % 10));
+        u /= 10;
+        ++written;
+        if (written == m_decimals) {
+            buf[--pos] = '.';
+            if (u == 0) {
+                buf[--pos] = '0';
+            }
+        }
+    } while (u != 0 || written < m_decimals);
+
+    if (negative) {
+        buf[--pos] = '-';
+    }
+
+    return QString::fromLatin1(buf + pos, static_cast<int>(sizeof(buf)) - pos);
+}
+
+
+
+QString Money::toString(int decimals) const
+{
+    return rescaled(decimals).toString();
+}
+
+
+
+double Money::toDouble() const
+{
+    return static_cast<double>(m_units) / static_cast<double>(powersOfTen[m_decimals]);
+}
+
+
+
+float Money::toFloat() const
+{
+    return static_cast<float>(toDouble());
+}
+
+
+
+
+Money Money::operator-() const
+{
+    return Money(-m_units, m_decimals);
+}
+
+
+
+Money &Money::operator+=(const Money &other)
+{
+    const int dec = qMax(m_decimals, other.m_decimals);
+    m_units = rescaled(dec).m_units + other.rescaled(dec).m_units;
+    m_decimals = dec;
+    return *this;
+}
+
+
+
+Money &Money::operator-=(const Money &other)
+{
+    const int dec = qMax(m_decimals, other.m_decimals);
+    m_units = rescaled(dec).m_units - other.rescaled(dec).m_units;
+    m_decimals = dec;
+    return *this;
+}
+
+
+
+Money &Money::operator*=(qint64 factor)
+{
+    m_units *= factor;
+    return *this;
+}
+
+
+
+int Money::compare(const Money &lhs, const Money &rhs)
+{
+    const int dec = qMax(lhs.m_decimals, rhs.m_decimals);
+    const qint64 l = lhs.rescaled(dec).m_units;
+    const qint64 r = rhs.rescaled(dec).m_units;
+    return (l < r) ? -1 : ((l > r) ? 1 : 0);
+}
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const Money &money)
+{
+    stream << money.minorUnits() << static_cast<qint8>(money.decimals());
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, Money &money)
+{
+    qint64 units = 0;
+    qint8 decimals = 0;
+    stream >> units >> decimals;
+    money = Money(units, qBound(0, static_cast<int>(decimals), static_cast<int>(Money::MaxDecimals)));
+    return stream;
+}
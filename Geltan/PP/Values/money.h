@@ -0,0 +1,214 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/money.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <QString>
+#include <QMetaType>
+#include <QDataStream>
+#include <Geltan/geltan_global.h>
+
+class QJsonValue;
+
+namespace Geltan {
+namespace PP {
+
+class PPJsonValue;
+
+/*!
+ * \brief Exact fixed-point money amount stored as 64 bit integer of minor units.
+ *
+ * A Money value consists of an integer number of minor units and the number of decimal places
+ * these units have, so 12.34 is stored as \a 1234 with \a 2 decimals. Other than \c float, every
+ * decimal amount up to 18 digits can be represented exactly, sums do not accumulate rounding
+ * errors and comparisons are exact.
+ *
+ * Comparison and arithmetic operators take the decimals into account, so 12.5 with one decimal
+ * and 12.50 with two decimals are equal. fromString() parses decimal strings as returned by the
+ * PayPal API directly into minor units, toString() formats them directly, neither goes through
+ * floating point numbers. Use currencyDecimals() to get the number of decimals of a currency.
+ *
+ * \code{.cpp}
+ * Geltan::PP::Money total = Geltan::PP::Money::fromString(QStringLiteral("19.99"));
+ * total += Geltan::PP::Money(500, 2);
+ * total.toString(); // "24.99"
+ * total.toString(Geltan::PP::Money::currencyDecimals(QStringLiteral("JPY"))); // "25"
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Values/money.h>
+ */
+class GELTANSHARED_EXPORT Money
+{
+public:
+    /*!
+     * \brief The maximum number of decimal places, further digits will be rounded.
+     */
+    static const int MaxDecimals = 6;
+
+    /*!
+     * \brief Constructs a new Money value of zero.
+     */
+    Money();
+
+    /*!
+     * \brief Constructs a new Money value of \a minorUnits with \a decimals decimal places.
+     *
+     * If \a decimals is out of the range from \a 0 to MaxDecimals, the units are rescaled to the nearest
+     * valid number of decimals, so the amount stays the same apart from rounding.
+     */
+    explicit Money(qint64 minorUnits, int decimals = 2);
+
+    /*!
+     * \brief Parses the decimal string \a value like \c "-12.34".
+     *
+     * Leading and trailing whitespace is ignored. If \a ok is not a \c nullptr, it will be set to false
+     * if \a value is not a valid decimal number or does not fit into 64 bit.
+     */
+    static Money fromString(const QString &value, bool *ok = nullptr);
+
+    /*!
+     * \brief Parses the Latin-1 or UTF-8 encoded decimal string in \a data with \a size bytes.
+     * \overload
+     */
+    static Money fromUtf8(const char *data, int size, bool *ok = nullptr);
+
+    /*!
+     * \brief Reads a JSON value that is either a decimal string or a number.
+     */
+    static Money fromJson(const QJsonValue &value);
+
+    /*!
+     * \brief Reads a JSON value that is either a decimal string or a number.
+     * \overload
+     *
+     * Strings from an on-demand index are parsed directly from the reply data.
+     */
+    static Money fromJson(const PPJsonValue &value);
+
+    /*!
+     * \brief Converts the floating point \a value, rounded to \a decimals decimal places.
+     */
+    static Money fromDouble(double value, int decimals = 2);
+
+    /*!
+     * \brief Returns the number of decimal places of the minor unit of the ISO 4217 \a currency code.
+     *
+     * Returns \a 0 for currencies without minor unit and for the currencies PayPal does not support
+     * decimals for (HUF, JPY, TWD), \a 3 for currencies with three decimal places and \a 2 for all other.
+     */
+    static int currencyDecimals(const QString &currency);
+
+    /*!
+     * \brief Returns the amount in minor units.
+     */
+    qint64 minorUnits() const { return m_units; }
+
+    /*!
+     * \brief Returns the number of decimal places of the minor units.
+     */
+    int decimals() const { return m_decimals; }
+
+    /*!
+     * \brief Returns true if the amount is zero.
+     */
+    bool isZero() const { return m_units == 0; }
+
+    /*!
+     * \brief Returns true if the amount is less than zero.
+     */
+    bool isNegative() const { return m_units < 0; }
+
+    /*!
+     * \brief Returns true if the amount is greater than zero.
+     */
+    bool isPositive() const { return m_units > 0; }
+
+    /*!
+     * \brief Returns the amount with \a decimals decimal places, rounded half away from zero if needed.
+     *
+     * Amounts that do not fit into 64 bit minor units with more decimals saturate at the limits.
+     */
+    Money rescaled(int decimals) const;
+
+    /*!
+     * \brief Formats the amount with its own number of decimal places, like \c "12.34".
+     */
+    QString toString() const;
+
+    /*!
+     * \brief Formats the amount rounded to \a decimals decimal places.
+     * \overload
+     */
+    QString toString(int decimals) const;
+
+    /*!
+     * \brief Returns the amount as \c double.
+     */
+    double toDouble() const;
+
+    /*!
+     * \brief Returns the amount as \c float.
+     */
+    float toFloat() const;
+
+    Money operator-() const;
+    Money &operator+=(const Money &other);
+    Money &operator-=(const Money &other);
+    Money &operator*=(qint64 factor);
+
+    friend Money operator+(Money lhs, const Money &rhs) { lhs += rhs; return lhs; }
+    friend Money operator-(Money lhs, const Money &rhs) { lhs -= rhs; return lhs; }
+    friend Money operator*(Money lhs, qint64 factor) { lhs *= factor; return lhs; }
+
+    friend bool operator==(const Money &lhs, const Money &rhs) { return compare(lhs, rhs) == 0; }
+    friend bool operator!=(const Money &lhs, const Money &rhs) { return compare(lhs, rhs) != 0; }
+    friend bool operator<(const Money &lhs, const Money &rhs) { return compare(lhs, rhs) < 0; }
+    friend bool operator<=(const Money &lhs, const Money &rhs) { return compare(lhs, rhs) <= 0; }
+    friend bool operator>(const Money &lhs, const Money &rhs) { return compare(lhs, rhs) > 0; }
+    friend bool operator>=(const Money &lhs, const Money &rhs) { return compare(lhs, rhs) >= 0; }
+
+private:
+    static int compare(const Money &lhs, const Money &rhs);
+
+    qint64 m_units;
+    int m_decimals;
+};
+
+/*!
+ * \relates Money
+ * \brief Writes \a money to the \a stream as minor units and decimal places.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const Money &money);
+
+/*!
+ * \relates Money
+ * \brief Reads \a money from the \a stream.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, Money &money);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::Money, Q_PRIMITIVE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::Money)
+
+#endif // MONEY_H
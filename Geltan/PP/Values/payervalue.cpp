@@ -0,0 +1,365 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/payervalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "payervalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+#include <Geltan/PP/ppenumsmap.h>
+#include <Geltan/PP/ppstringpool.h>
+#include <QJsonArray>
+
+using namespace Geltan;
+using namespace PP;
+
+static const PPEnumToken fundingInstrumentTypeTokens[] = {
+    {"CREDIT", Payer::Credit},
+    {"PAY_UPON_INVOICE", Payer::PayUponInvoice},
+    {nullptr, 0}
+};
+
+static const PPEnumToken phoneTypeTokens[] = {
+    {"HOME", PayerInfo::Home},
+    {"WORK", PayerInfo::Work},
+    {"MOBILE", PayerInfo::Mobile},
+    {"OTHER", PayerInfo::Other},
+    {nullptr, 0}
+};
+
+static const PPEnumToken taxIdTypeTokens[] = {
+    {"BR_CPF", PayerInfo::BR_CPF},
+    {"BR_CNPJ", PayerInfo::BR_CNPJ},
+    {nullptr, 0}
+};
+
+PayerValue::PayerValue() :
+    d(new PayerValueData)
+{
+}
+
+
+PayerValue::PayerValue(const PayerValue &other) :
+    d(other.d)
+{
+}
+
+
+PayerValue::~PayerValue()
+{
+}
+
+
+PayerValue &PayerValue::operator=(const PayerValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+PayPal::PaymentMethod PayerValue::paymentMethod() const { return d->paymentMethod; }
+
+void PayerValue::setPaymentMethod(PayPal::PaymentMethod nPaymentMethod) { d->paymentMethod = nPaymentMethod; }
+
+
+Payer::Status PayerValue::status() const { return d->status; }
+
+void PayerValue::setStatus(Payer::Status nStatus) { d->status = nStatus; }
+
+
+QString PayerValue::email() const { return d->email; }
+
+void PayerValue::setEmail(const QString &nEmail) { d->email = nEmail; }
+
+
+QString PayerValue::salutation() const { return d->salutation; }
+
+void PayerValue::setSalutation(const QString &nSalutation) { d->salutation = nSalutation; }
+
+
+QString PayerValue::firstName() const { return d->firstName; }
+
+void PayerValue::setFirstName(const QString &nFirstName) { d->firstName = nFirstName; }
+
+
+QString PayerValue::middleName() const { return d->middleName; }
+
+void PayerValue::setMiddleName(const QString &nMiddleName) { d->middleName = nMiddleName; }
+
+
+QString PayerValue::lastName() const { return d->lastName; }
+
+void PayerValue::setLastName(const QString &nLastName) { d->lastName = nLastName; }
+
+
+QString PayerValue::suffix() const { return d->suffix; }
+
+void PayerValue::setSuffix(const QString &nSuffix) { d->suffix = nSuffix; }
+
+
+QString PayerValue::payerId() const { return d->payerId; }
+
+void PayerValue::setPayerId(const QString &nPayerId) { d->payerId = nPayerId; }
+
+
+QString PayerValue::phone() const { return d->phone; }
+
+void PayerValue::setPhone(const QString &nPhone) { d->phone = nPhone; }
+
+
+QString PayerValue::countryCode() const { return d->countryCode; }
+
+void PayerValue::setCountryCode(const QString &nCountryCode) { d->countryCode = nCountryCode; }
+
+
+AddressValue PayerValue::billingAddress() const { return d->billingAddress; }
+
+void PayerValue::setBillingAddress(const AddressValue &nBillingAddress) { d->billingAddress = nBillingAddress; }
+
+
+QList<FundingInstrumentValue> PayerValue::fundingInstruments() const { return d->fundingInstruments; }
+
+void PayerValue::setFundingInstruments(const QList<FundingInstrumentValue> &nFundingInstruments) { d->fundingInstruments = nFundingInstruments; }
+
+
+Payer::FundingInstrumentType PayerValue::externalSelectedFundingInstrumentType() const { return d->externalSelectedFundingInstrumentType; }
+
+void PayerValue::setExternalSelectedFundingInstrumentType(Payer::FundingInstrumentType nExternalSelectedFundingInstrumentType) { d->externalSelectedFundingInstrumentType = nExternalSelectedFundingInstrumentType; }
+
+
+QString PayerValue::externalRememberMeId() const { return d->externalRememberMeId; }
+
+void PayerValue::setExternalRememberMeId(const QString &nExternalRememberMeId) { d->externalRememberMeId = nExternalRememberMeId; }
+
+
+QString PayerValue::buyerAccountNumber() const { return d->buyerAccountNumber; }
+
+void PayerValue::setBuyerAccountNumber(const QString &nBuyerAccountNumber) { d->buyerAccountNumber = nBuyerAccountNumber; }
+
+
+PayerInfo::PhoneType PayerValue::phoneType() const { return d->phoneType; }
+
+void PayerValue::setPhoneType(PayerInfo::PhoneType nPhoneType) { d->phoneType = nPhoneType; }
+
+
+QDate PayerValue::birthDate() const { return d->birthDate; }
+
+void PayerValue::setBirthDate(const QDate &nBirthDate) { d->birthDate = nBirthDate; }
+
+
+QString PayerValue::taxId() const { return d->taxId; }
+
+void PayerValue::setTaxId(const QString &nTaxId) { d->taxId = nTaxId; }
+
+
+PayerInfo::TaxIdType PayerValue::taxIdType() const { return d->taxIdType; }
+
+void PayerValue::setTaxIdType(PayerInfo::TaxIdType nTaxIdType) { d->taxIdType = nTaxIdType; }
+
+
+
+
+PayerValue PayerValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+PayerValue PayerValue::fromJson(const PPJsonValue &json)
+{
+    PayerValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    PayerValueData *d = v.d.data();
+
+    d->paymentMethod = PPEnumsMap::paymentMethodTokenToEnum(json.value(QLatin1String("payment_method")).toString());
+
+    const QString sStatus = json.value(QLatin1String("status")).toString();
+    if (sStatus == QLatin1String("VERIFIED")) {
+        d->status = Payer::Verified;
+    } else if (sStatus == QLatin1String("UNVERIFIED")) {
+        d->status = Payer::Unverified;
+    }
+
+    const PPJsonValue fia = json.value(QLatin1String("funding_instruments")).toArray();
+    if (!fia.isEmpty()) {
+        d->fundingInstruments.reserve(fia.count());
+        for (const PPJsonValue &fi : fia) {
+            d->fundingInstruments.append(FundingInstrumentValue::fromJson(fi.toObject()));
+        }
+    }
+
+    d->externalSelectedFundingInstrumentType = static_cast<Payer::FundingInstrumentType>(ppEnumTokenToValue(fundingInstrumentTypeTokens, json.value(QLatin1String("external_selected_funding_instrument_type")).toString()));
+
+    const PPJsonValue pio = json.value(QLatin1String("payer_info")).toObject();
+    if (!pio.isEmpty()) {
+        d->email = pio.value(QLatin1String("email")).toString();
+        d->salutation = pio.value(QLatin1String("salutation")).toString();
+        d->firstName = pio.value(QLatin1String("first_name")).toString();
+        d->middleName = pio.value(QLatin1String("middle_name")).toString();
+        d->lastName = pio.value(QLatin1String("last_name")).toString();
+        d->suffix = pio.value(QLatin1String("suffix")).toString();
+        d->payerId = pio.value(QLatin1String("payer_id")).toString();
+        d->phone = pio.value(QLatin1String("phone")).toString();
+        d->countryCode = PPStringPool::intern(pio.value(QLatin1String("country_code")).toString());
+        d->billingAddress = AddressValue::fromJson(pio.value(QLatin1String("billing_address")).toObject());
+        d->externalRememberMeId = pio.value(QLatin1String("external_remember_me_id")).toString();
+        d->buyerAccountNumber = pio.value(QLatin1String("buyer_account_number")).toString();
+        // older API versions used Mobile instead of MOBILE
+        d->phoneType = static_cast<PayerInfo::PhoneType>(ppEnumTokenToValue(phoneTypeTokens, pio.value(QLatin1String("phone_type")).toString().toUpper()));
+        d->birthDate = QDate::fromString(pio.value(QLatin1String("birth_date")).toString(), QStringLiteral("yyyy-MM-dd"));
+        d->taxId = pio.value(QLatin1String("tax_id")).toString();
+        d->taxIdType = static_cast<PayerInfo::TaxIdType>(ppEnumTokenToValue(taxIdTypeTokens, pio.value(QLatin1String("tax_id_type")).toString()));
+    }
+
+    return v;
+}
+
+
+
+QJsonObject PayerValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("payment_method"), PPEnumsMap::paymentMethodEnumToToken(d->paymentMethod));
+
+    switch(d->status) {
+    case Payer::Verified:
+        json.insert(QStringLiteral("status"), QStringLiteral("VERIFIED"));
+        break;
+    case Payer::Unverified:
+        json.insert(QStringLiteral("status"), QStringLiteral("UNVERIFIED"));
+        break;
+    default:
+        break;
+    }
+
+    if (!d->fundingInstruments.isEmpty()) {
+        QJsonArray fia;
+        for (const FundingInstrumentValue &fi : d->fundingInstruments) {
+            fia.append(fi.toJsonObject());
+        }
+        json.insert(QStringLiteral("funding_instruments"), fia);
+    }
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("external_selected_funding_instrument_type"), ppEnumValueToToken(fundingInstrumentTypeTokens, d->externalSelectedFundingInstrumentType));
+
+    QJsonObject pio;
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("email"), d->email);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("salutation"), d->salutation);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("first_name"), d->firstName);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("middle_name"), d->middleName);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("last_name"), d->lastName);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("suffix"), d->suffix);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("payer_id"), d->payerId);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("phone"), d->phone);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("country_code"), d->countryCode);
+    PPValuesBasePrivate::insertObject(&pio, QStringLiteral("billing_address"), d->billingAddress.toJsonObject());
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("external_remember_me_id"), d->externalRememberMeId);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("buyer_account_number"), d->buyerAccountNumber);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("phone_type"), ppEnumValueToToken(phoneTypeTokens, d->phoneType));
+    if (d->birthDate.isValid()) {
+        pio.insert(QStringLiteral("birth_date"), d->birthDate.toString(QStringLiteral("yyyy-MM-dd")));
+    }
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("tax_id"), d->taxId);
+    PPValuesBasePrivate::insertString(&pio, QStringLiteral("tax_id_type"), ppEnumValueToToken(taxIdTypeTokens, d->taxIdType));
+
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("payer_info"), pio);
+
+    return json;
+}
+
+
+
+bool PayerValue::isEmpty() const
+{
+    return (d->paymentMethod == PayPal::NoPaymentMethod && d->status == Payer::NoStatus && d->email.isEmpty()
+            && d->salutation.isEmpty() && d->firstName.isEmpty() && d->middleName.isEmpty() && d->lastName.isEmpty()
+            && d->suffix.isEmpty() && d->payerId.isEmpty() && d->phone.isEmpty() && d->countryCode.isEmpty()
+            && d->billingAddress.isEmpty() && d->fundingInstruments.isEmpty()
+            && d->externalSelectedFundingInstrumentType == Payer::NoFundingInstrumentType
+            && d->externalRememberMeId.isEmpty() && d->buyerAccountNumber.isEmpty()
+            && d->phoneType == PayerInfo::NoPhoneType && d->birthDate.isNull() && d->taxId.isEmpty()
+            && d->taxIdType == PayerInfo::NoTaxIdType);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const PayerValue &value)
+{
+    const PayerValueData *d = value.d.constData();
+
+    stream << static_cast<qint32>(d->paymentMethod)
+           << static_cast<qint32>(d->status)
+           << d->email
+           << d->salutation
+           << d->firstName
+           << d->middleName
+           << d->lastName
+           << d->suffix
+           << d->payerId
+           << d->phone
+           << d->countryCode
+           << d->billingAddress
+           << d->fundingInstruments
+           << static_cast<qint32>(d->externalSelectedFundingInstrumentType)
+           << d->externalRememberMeId
+           << d->buyerAccountNumber
+           << static_cast<qint32>(d->phoneType)
+           << d->birthDate
+           << d->taxId
+           << static_cast<qint32>(d->taxIdType);
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, PayerValue &value)
+{
+    PayerValueData *d = value.d.data();
+
+    PPValuesBasePrivate::readInt(stream, &d->paymentMethod);
+    PPValuesBasePrivate::readInt(stream, &d->status);
+    stream >> d->email
+           >> d->salutation
+           >> d->firstName
+           >> d->middleName
+           >> d->lastName
+           >> d->suffix
+           >> d->payerId
+           >> d->phone
+           >> d->countryCode
+           >> d->billingAddress
+           >> d->fundingInstruments;
+    PPValuesBasePrivate::readInt(stream, &d->externalSelectedFundingInstrumentType);
+    stream >> d->externalRememberMeId
+           >> d->buyerAccountNumber;
+    PPValuesBasePrivate::readInt(stream, &d->phoneType);
+    stream >> d->birthDate
+           >> d->taxId;
+    PPValuesBasePrivate::readInt(stream, &d->taxIdType);
+
+    return stream;
+}
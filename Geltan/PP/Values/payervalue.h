@@ -0,0 +1,170 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/payervalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYERVALUE_H
+#define PAYERVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QDate>
+#include <QList>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/ppenums.h>
+#include <Geltan/PP/Objects/payer.h>
+#include <Geltan/PP/Objects/payerinfo.h>
+#include <Geltan/PP/Values/addressvalue.h>
+#include <Geltan/PP/Values/fundinginstrumentvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class PayerValueData;
+
+/*!
+ * \brief Implicitly shared value type containing the data of a payer.
+ *
+ * Other than Payer this is not a QObject, it is cheap to copy and can be passed between threads.
+ * The members of the payer_info object are flattened into this value, the funding instruments are
+ * contained as list of FundingInstrumentValue.
+ *
+ * \sa Payer, PayerInfo, FundingInstrumentValue
+ *
+ * \headerfile "" <Geltan/PP/Values/payervalue.h>
+ */
+class GELTANSHARED_EXPORT PayerValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty PayerValue.
+     */
+    PayerValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    PayerValue(const PayerValue &other);
+
+    /*!
+     * \brief Deconstructs the PayerValue.
+     */
+    ~PayerValue();
+
+    /*!
+     * \brief Assigns \a other to this PayerValue.
+     */
+    PayerValue &operator=(const PayerValue &other);
+
+    /*!
+     * \brief Creates a new PayerValue from JSON data.
+     */
+    static PayerValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new PayerValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static PayerValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the payer data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    PayPal::PaymentMethod paymentMethod() const;
+    Payer::Status status() const;
+    QString email() const;
+    QString salutation() const;
+    QString firstName() const;
+    QString middleName() const;
+    QString lastName() const;
+    QString suffix() const;
+    QString payerId() const;
+    QString phone() const;
+    QString countryCode() const;
+    AddressValue billingAddress() const;
+    QList<FundingInstrumentValue> fundingInstruments() const;
+    Payer::FundingInstrumentType externalSelectedFundingInstrumentType() const;
+    QString externalRememberMeId() const;
+    QString buyerAccountNumber() const;
+    PayerInfo::PhoneType phoneType() const;
+    QDate birthDate() const;
+    QString taxId() const;
+    PayerInfo::TaxIdType taxIdType() const;
+
+    void setPaymentMethod(PayPal::PaymentMethod nPaymentMethod);
+    void setStatus(Payer::Status nStatus);
+    void setEmail(const QString &nEmail);
+    void setSalutation(const QString &nSalutation);
+    void setFirstName(const QString &nFirstName);
+    void setMiddleName(const QString &nMiddleName);
+    void setLastName(const QString &nLastName);
+    void setSuffix(const QString &nSuffix);
+    void setPayerId(const QString &nPayerId);
+    void setPhone(const QString &nPhone);
+    void setCountryCode(const QString &nCountryCode);
+    void setBillingAddress(const AddressValue &nBillingAddress);
+    void setFundingInstruments(const QList<FundingInstrumentValue> &nFundingInstruments);
+    void setExternalSelectedFundingInstrumentType(Payer::FundingInstrumentType nExternalSelectedFundingInstrumentType);
+    void setExternalRememberMeId(const QString &nExternalRememberMeId);
+    void setBuyerAccountNumber(const QString &nBuyerAccountNumber);
+    void setPhoneType(PayerInfo::PhoneType nPhoneType);
+    void setBirthDate(const QDate &nBirthDate);
+    void setTaxId(const QString &nTaxId);
+    void setTaxIdType(PayerInfo::TaxIdType nTaxIdType);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const PayerValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, PayerValue &value);
+
+    QSharedDataPointer<PayerValueData> d;
+};
+
+/*!
+ * \relates PayerValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const PayerValue &value);
+
+/*!
+ * \relates PayerValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, PayerValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::PayerValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::PayerValue)
+
+#endif // PAYERVALUE_H
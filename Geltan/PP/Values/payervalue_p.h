@@ -0,0 +1,93 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/payervalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYERVALUE_P_H
+#define PAYERVALUE_P_H
+
+#include "payervalue.h"
+#include <QSharedData>
+
+namespace Geltan {
+namespace PP {
+
+class PayerValueData : public QSharedData
+{
+public:
+    PayerValueData() :
+        paymentMethod(PayPal::NoPaymentMethod),
+        status(Payer::NoStatus),
+        externalSelectedFundingInstrumentType(Payer::NoFundingInstrumentType),
+        phoneType(PayerInfo::NoPhoneType),
+        taxIdType(PayerInfo::NoTaxIdType)
+    {}
+
+    PayerValueData(const PayerValueData &other) :
+        QSharedData(other),
+        paymentMethod(other.paymentMethod),
+        status(other.status),
+        email(other.email),
+        salutation(other.salutation),
+        firstName(other.firstName),
+        middleName(other.middleName),
+        lastName(other.lastName),
+        suffix(other.suffix),
+        payerId(other.payerId),
+        phone(other.phone),
+        countryCode(other.countryCode),
+        billingAddress(other.billingAddress),
+        fundingInstruments(other.fundingInstruments),
+        externalSelectedFundingInstrumentType(other.externalSelectedFundingInstrumentType),
+        externalRememberMeId(other.externalRememberMeId),
+        buyerAccountNumber(other.buyerAccountNumber),
+        phoneType(other.phoneType),
+        birthDate(other.birthDate),
+        taxId(other.taxId),
+        taxIdType(other.taxIdType)
+    {}
+
+    ~PayerValueData() {}
+
+    PayPal::PaymentMethod paymentMethod;
+    Payer::Status status;
+    QString email;
+    QString salutation;
+    QString firstName;
+    QString middleName;
+    QString lastName;
+    QString suffix;
+    QString payerId;
+    QString phone;
+    QString countryCode;
+    AddressValue billingAddress;
+    QList<FundingInstrumentValue> fundingInstruments;
+    Payer::FundingInstrumentType externalSelectedFundingInstrumentType;
+    QString externalRememberMeId;
+    QString buyerAccountNumber;
+    PayerInfo::PhoneType phoneType;
+    QDate birthDate;
+    QString taxId;
+    PayerInfo::TaxIdType taxIdType;
+};
+
+}
+}
+
+#endif // PAYERVALUE_P_H
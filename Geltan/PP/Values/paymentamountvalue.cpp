@@ -0,0 +1,153 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentamountvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentamountvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+
+using namespace Geltan;
+using namespace PP;
+
+// sorted by key, the details are a nested value
+static const PPValueField<PaymentAmountValueData> paymentAmountValueFields[] = {
+    ppPooledStringField("currency", &PaymentAmountValueData::currency, 3),
+    ppMoneyField("total", &PaymentAmountValueData::total)
+};
+
+PaymentAmountValue::PaymentAmountValue() :
+    d(new PaymentAmountValueData)
+{
+}
+
+
+PaymentAmountValue::PaymentAmountValue(const PaymentAmountValue &other) :
+    d(other.d)
+{
+}
+
+
+PaymentAmountValue::~PaymentAmountValue()
+{
+}
+
+
+PaymentAmountValue &PaymentAmountValue::operator=(const PaymentAmountValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+QString PaymentAmountValue::currency() const { return d->currency; }
+
+void PaymentAmountValue::setCurrency(const QString &nCurrency) { d->currency = nCurrency; }
+
+
+float PaymentAmountValue::total() const { return d->total.toFloat(); }
+
+Money PaymentAmountValue::totalMoney() const { return d->total; }
+
+void PaymentAmountValue::setTotal(float nTotal) { d->total = Money::fromDouble(nTotal); }
+
+void PaymentAmountValue::setTotalMoney(const Money &nTotal) { d->total = nTotal; }
+
+
+DetailsValue PaymentAmountValue::details() const { return d->details; }
+
+void PaymentAmountValue::setDetails(const DetailsValue &nDetails) { d->details = nDetails; }
+
+
+
+
+PaymentAmountValue PaymentAmountValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+PaymentAmountValue PaymentAmountValue::fromJson(const PPJsonValue &json)
+{
+    PaymentAmountValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    PaymentAmountValueData *d = v.d.data();
+
+    ppReadValueFields(d, json, paymentAmountValueFields);
+
+    // the transaction fee is returned as Currency object with a value instead of a total
+    if (json.value(QLatin1String("total")).isUndefined()) {
+        d->total = PPValuesBasePrivate::toMoney(json.value(QLatin1String("value")));
+    }
+
+    d->details = DetailsValue::fromJson(json.value(QLatin1String("details")).toObject());
+
+    return v;
+}
+
+
+
+QJsonObject PaymentAmountValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    ppWriteValueFields(d.constData(), &json, paymentAmountValueFields);
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("details"), d->details.toJsonObject());
+
+    return json;
+}
+
+
+
+bool PaymentAmountValue::isEmpty() const
+{
+    return (ppValueFieldsEmpty(d.constData(), paymentAmountValueFields) && d->details.isEmpty());
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const PaymentAmountValue &value)
+{
+    const PaymentAmountValueData *d = value.d.constData();
+
+    stream << d->currency
+           << d->total
+           << d->details;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, PaymentAmountValue &value)
+{
+    PaymentAmountValueData *d = value.d.data();
+
+    stream >> d->currency
+           >> d->total
+           >> d->details;
+
+    return stream;
+}
@@ -0,0 +1,132 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentamountvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTAMOUNTVALUE_H
+#define PAYMENTAMOUNTVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Values/money.h>
+#include <Geltan/PP/Values/detailsvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentAmountValueData;
+
+/*!
+ * \brief Implicitly shared value type containing a payment amount.
+ *
+ * Other than PaymentAmount this is not a QObject, it is cheap to copy and can be passed between threads.
+ * It is also used for the transaction fee of related resources.
+ *
+ * \sa PaymentAmount
+ *
+ * \headerfile "" <Geltan/PP/Values/paymentamountvalue.h>
+ */
+class GELTANSHARED_EXPORT PaymentAmountValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty PaymentAmountValue.
+     */
+    PaymentAmountValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    PaymentAmountValue(const PaymentAmountValue &other);
+
+    /*!
+     * \brief Deconstructs the PaymentAmountValue.
+     */
+    ~PaymentAmountValue();
+
+    /*!
+     * \brief Assigns \a other to this PaymentAmountValue.
+     */
+    PaymentAmountValue &operator=(const PaymentAmountValue &other);
+
+    /*!
+     * \brief Creates a new PaymentAmountValue from JSON data.
+     */
+    static PaymentAmountValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new PaymentAmountValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static PaymentAmountValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the amount data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    QString currency() const;
+    float total() const;
+    Money totalMoney() const;
+    DetailsValue details() const;
+
+    void setCurrency(const QString &nCurrency);
+    void setTotal(float nTotal);
+    void setTotalMoney(const Money &nTotal);
+    void setDetails(const DetailsValue &nDetails);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const PaymentAmountValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, PaymentAmountValue &value);
+
+    QSharedDataPointer<PaymentAmountValueData> d;
+};
+
+/*!
+ * \relates PaymentAmountValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const PaymentAmountValue &value);
+
+/*!
+ * \relates PaymentAmountValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, PaymentAmountValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::PaymentAmountValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::PaymentAmountValue)
+
+#endif // PAYMENTAMOUNTVALUE_H
@@ -0,0 +1,325 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentcolumns.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentcolumns_p.h"
+#include "paymentvalue.h"
+#include "../Objects/paymentlist.h"
+#include "../Objects/transaction.h"
+#include "../Objects/paymentamount.h"
+#include "../pptimestamp.h"
+#include <algorithm>
+
+using namespace Geltan;
+using namespace PP;
+
+PaymentColumns::PaymentColumns() :
+    d(new PaymentColumnsData)
+{
+}
+
+
+PaymentColumns::PaymentColumns(const PaymentColumns &other) :
+    d(other.d)
+{
+}
+
+
+PaymentColumns::~PaymentColumns()
+{
+}
+
+
+PaymentColumns &PaymentColumns::operator=(const PaymentColumns &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+
+PaymentColumns PaymentColumns::fromValues(const QList<PaymentValue> &payments)
+{
+    PaymentColumns c;
+    c.reserve(payments.count());
+    for (const PaymentValue &p : payments) {
+        c.append(p);
+    }
+    return c;
+}
+
+
+
+PaymentColumns PaymentColumns::fromPaymentList(const PaymentList *list)
+{
+    PaymentColumns c;
+
+    if (!list) {
+        return c;
+    }
+
+    const int rows = list->rowCount();
+    c.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+        c.append(list->at(i));
+    }
+
+    return c;
+}
+
+
+
+void PaymentColumns::append(const PaymentValue &payment)
+{
+    const QList<TransactionValue> ts = payment.transactions();
+    for (const TransactionValue &t : ts) {
+        const PaymentAmountValue a = t.amount();
+        d->appendRow(a.totalMoney(), a.currency(), payment.state(), payment.createTimeMSecs());
+    }
+}
+
+
+
+void PaymentColumns::append(const Payment *payment)
+{
+    if (!payment) {
+        return;
+    }
+
+    const QList<Transaction*> ts = payment->transactions();
+    for (const Transaction *t : ts) {
+        const PaymentAmount *a = t->amount();
+        if (a) {
+            d->appendRow(a->totalMoney(), a->currency(), payment->state(), PPTimestamp::toMSecs(payment->createTime()));
+        }
+    }
+}
+
+
+
+void PaymentColumns::reserve(int rows)
+{
+    d->amounts.reserve(rows);
+    d->currencyIndexes.reserve(rows);
+    d->states.reserve(rows);
+    d->createTimes.reserve(rows);
+}
+
+
+
+int PaymentColumns::rowCount() const { return d->amounts.count(); }
+
+bool PaymentColumns::isEmpty() const { return d->amounts.isEmpty(); }
+
+QStringList PaymentColumns::currencies() const { return d->currencies; }
+
+const qint64 *PaymentColumns::amounts() const { return d->amounts.constData(); }
+
+const quint16 *PaymentColumns::currencyIndexes() const { return d->currencyIndexes.constData(); }
+
+const quint8 *PaymentColumns::states() const { return d->states.constData(); }
+
+const qint64 *PaymentColumns::createTimes() const { return d->createTimes.constData(); }
+
+
+
+void PaymentColumnsData::appendRow(const Money &total, const QString &currency, Payment::State state, qint64 createTime)
+{
+    quint16 ci = 0;
+    const auto it = currencyLookup.constFind(currency);
+    if (it != currencyLookup.cend()) {
+        ci = it.value();
+    } else {
+        ci = static_cast<quint16>(currencies.count());
+        currencies.append(currency);
+        currencyLookup.insert(currency, ci);
+    }
+
+    amounts.append(total.rescaled(Money::currencyDecimals(currency)).minorUnits());
+    currencyIndexes.append(ci);
+    states.append(static_cast<quint8>(state));
+    createTimes.append(createTime);
+
+    maxState = qMax(maxState, static_cast<quint8>(state));
+}
+
+
+
+
+QVector<PaymentColumns::Aggregate> PaymentColumns::aggregate(GroupFlags groupBy, const QDateTime &from, const QDateTime &to) const
+{
+    QVector<Aggregate> result;
+
+    const int n = d->amounts.count();
+    if (n == 0) {
+        return result;
+    }
+
+    const qint64 *amount = d->amounts.constData();
+    const quint16 *currency = d->currencyIndexes.constData();
+    const quint8 *state = d->states.constData();
+    const qint64 *created = d->createTimes.constData();
+
+    const qint64 msPerDay = 86400000;
+    const bool byCurrency = groupBy.testFlag(ByCurrency);
+    const bool byState = groupBy.testFlag(ByState);
+    const bool byDay = groupBy.testFlag(ByDay);
+    const bool filtered = from.isValid() || to.isValid();
+    const qint64 lower = from.isValid() ? from.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+    const qint64 upper = to.isValid() ? to.toMSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+
+    // the day slot 0 is used for payments without creation time
+    qint64 firstDay = 0;
+    qint64 daySlots = 1;
+    QVector<qint64> days;
+    if (byDay) {
+        days.resize(n);
+        qint64 lastDay = std::numeric_limits<qint64>::min();
+        firstDay = std::numeric_limits<qint64>::max();
+        for (int i = 0; i < n; ++i) {
+            const qint64 t = created[i];
+            // floor division, times before the epoch are negative
+            const qint64 day = (t >= 0) ? (t / msPerDay) : ((t + 1) / msPerDay - 1);
+            days[i] = day;
+            if (t != PaymentColumnsData::InvalidTime) {
+                firstDay = qMin(firstDay, day);
+                lastDay = qMax(lastDay, day);
+            }
+        }
+        if (lastDay >= firstDay) {
+            daySlots = lastDay - firstDay + 2;
+        }
+    }
+
+    const qint64 stateSlots = byState ? (d->maxState + 1) : 1;
+    const qint64 currencySlots = byCurrency ? qMax(d->currencies.count(), 1) : 1;
+    const qint64 slots = currencySlots * stateSlots * daySlots;
+
+    // Compute the group slot of every row first, so that the accumulation loop below only has to
+    // read flat arrays. Sparse groupings that would need a huge dense table are compacted with a hash.
+    QVector<int> slotOf(n);
+    int slotCount = 0;
+    QVector<qint64> slotKeys;
+    const bool dense = (slots <= qMax<qint64>(1 << 16, 4 * static_cast<qint64>(n)));
+
+    {
+        QHash<qint64, int> compact;
+        for (int i = 0; i < n; ++i) {
+            const qint64 c = byCurrency ? currency[i] : 0;
+            const qint64 s = byState ? state[i] : 0;
+            qint64 dy = 0;
+            if (byDay && created[i] != PaymentColumnsData::InvalidTime) {
+                dy = days.at(i) - firstDay + 1;
+            }
+            const qint64 key = (c * stateSlots + s) * daySlots + dy;
+            if (dense) {
+                slotOf[i] = static_cast<int>(key);
+            } else {
+                auto it = compact.constFind(key);
+                if (it == compact.cend()) {
+                    it = compact.insert(key, slotCount++);
+                    slotKeys.append(key);
+                }
+                slotOf[i] = it.value();
+            }
+        }
+    }
+
+    if (dense) {
+        slotCount = static_cast<int>(slots);
+    }
+
+    QVector<qint64> counts(slotCount, 0);
+    QVector<qint64> sums(slotCount, 0);
+    QVector<qint64> mins(slotCount, std::numeric_limits<qint64>::max());
+    QVector<qint64> maxs(slotCount, std::numeric_limits<qint64>::min());
+
+    qint64 *cnt = counts.data();
+    qint64 *sum = sums.data();
+    qint64 *mn = mins.data();
+    qint64 *mx = maxs.data();
+    const int *slot = slotOf.constData();
+
+    if (!filtered && slotCount == 1) {
+        // single group, a pure reduction over the amount column
+        qint64 s = 0;
+        qint64 lo = std::numeric_limits<qint64>::max();
+        qint64 hi = std::numeric_limits<qint64>::min();
+        for (int i = 0; i < n; ++i) {
+            const qint64 a = amount[i];
+            s += a;
+            lo = (a < lo) ? a : lo;
+            hi = (a > hi) ? a : hi;
+        }
+        cnt[0] = n;
+        sum[0] = s;
+        mn[0] = lo;
+        mx[0] = hi;
+    } else {
+        for (int i = 0; i < n; ++i) {
+            if (filtered) {
+                const qint64 t = created[i];
+                if (t == PaymentColumnsData::InvalidTime || t < lower || t >= upper) {
+                    continue;
+                }
+            }
+            const int g = slot[i];
+            const qint64 a = amount[i];
+            ++cnt[g];
+            sum[g] += a;
+            mn[g] = (a < mn[g]) ? a : mn[g];
+            mx[g] = (a > mx[g]) ? a : mx[g];
+        }
+    }
+
+    for (int g = 0; g < slotCount; ++g) {
+        if (cnt[g] == 0) {
+            continue;
+        }
+
+        const qint64 key = dense ? g : slotKeys.at(g);
+        const qint64 dy = key % daySlots;
+        const qint64 s = (key / daySlots) % stateSlots;
+        const qint64 c = key / (daySlots * stateSlots);
+
+        Aggregate a;
+        a.currency = byCurrency ? d->currencies.at(static_cast<int>(c)) : QString();
+        a.state = byState ? static_cast<Payment::State>(s) : Payment::NoState;
+        a.day = (byDay && dy > 0) ? QDate(1970, 1, 1).addDays(firstDay + dy - 1) : QDate();
+        a.count = cnt[g];
+        a.sum = sum[g];
+        a.min = mn[g];
+        a.max = mx[g];
+        result.append(a);
+    }
+
+    std::sort(result.begin(), result.end(), [](const Aggregate &l, const Aggregate &r) {
+        if (l.currency != r.currency) {
+            return l.currency < r.currency;
+        }
+        if (l.state != r.state) {
+            return l.state < r.state;
+        }
+        return l.day < r.day;
+    });
+
+    return result;
+}
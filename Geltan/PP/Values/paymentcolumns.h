@@ -0,0 +1,196 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentcolumns.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTCOLUMNS_H
+#define PAYMENTCOLUMNS_H
+
+#include <QSharedDataPointer>
+#include <QMetaType>
+#include <QDateTime>
+#include <QStringList>
+#include <QVector>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/Objects/payment.h>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentColumnsData;
+class PaymentValue;
+class PaymentList;
+
+/*!
+ * \brief Implicitly shared columnar projection of payment amounts used to compute aggregates.
+ *
+ * Summarizing a PaymentList by walking through the Payment, Transaction and PaymentAmount objects needs
+ * several pointer indirections per row. PaymentColumns copies the fields needed for aggregations once
+ * into flat arrays with one row per transaction: the amount in integer minor units (cents), the index of
+ * the currency code, the state of the payment and the creation time of the payment in milliseconds since
+ * the epoch. aggregate() then computes count, sum, minimum and maximum per group with tight loops over
+ * these arrays that the compiler can vectorize.
+ *
+ * Sums over different currencies are meaningless, so you will most likely want to group by
+ * \link PaymentColumns::ByCurrency ByCurrency \endlink.
+ *
+ * \code{.cpp}
+ * const Geltan::PP::PaymentColumns cols = Geltan::PP::PaymentColumns::fromPaymentList(list);
+ * const auto rows = cols.aggregate(Geltan::PP::PaymentColumns::ByCurrency|Geltan::PP::PaymentColumns::ByDay);
+ * for (const Geltan::PP::PaymentColumns::Aggregate &a : rows) {
+ *     qDebug() << a.day << a.currency << a.count << a.sum;
+ * }
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/Values/paymentcolumns.h>
+ */
+class GELTANSHARED_EXPORT PaymentColumns
+{
+public:
+    /*!
+     * \brief The dimensions the rows can be grouped by.
+     */
+    enum GroupBy {
+        NoGrouping  = 0x0,  /**< All rows form a single group. */
+        ByCurrency  = 0x1,  /**< Group by currency code. */
+        ByState     = 0x2,  /**< Group by payment state. */
+        ByDay       = 0x4   /**< Group by the UTC day of the payment creation time. */
+    };
+    Q_DECLARE_FLAGS(GroupFlags, GroupBy)
+
+    /*!
+     * \brief Result of a single group.
+     *
+     * Members of dimensions that have not been grouped by are empty, Payment::NoState or an invalid date.
+     * Amounts are in minor units of the currency.
+     */
+    struct Aggregate {
+        QString currency;       /**< Currency code of the group. */
+        Payment::State state;   /**< Payment state of the group. */
+        QDate day;              /**< UTC day of the group, invalid for payments without creation time. */
+        qint64 count;           /**< Number of transaction rows in the group. */
+        qint64 sum;             /**< Sum of the amounts. */
+        qint64 min;             /**< Smallest amount. */
+        qint64 max;             /**< Largest amount. */
+    };
+
+    /*!
+     * \brief Constructs new empty PaymentColumns.
+     */
+    PaymentColumns();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    PaymentColumns(const PaymentColumns &other);
+
+    /*!
+     * \brief Deconstructs the PaymentColumns.
+     */
+    ~PaymentColumns();
+
+    /*!
+     * \brief Assigns \a other to this PaymentColumns.
+     */
+    PaymentColumns &operator=(const PaymentColumns &other);
+
+    /*!
+     * \brief Projects the transactions of all \a payments into columns.
+     */
+    static PaymentColumns fromValues(const QList<PaymentValue> &payments);
+
+    /*!
+     * \brief Projects the transactions of all payments in the \a list into columns.
+     */
+    static PaymentColumns fromPaymentList(const PaymentList *list);
+
+    /*!
+     * \brief Appends the transactions of \a payment as new rows.
+     */
+    void append(const PaymentValue &payment);
+
+    /*!
+     * \brief Appends the transactions of \a payment as new rows.
+     */
+    void append(const Payment *payment);
+
+    /*!
+     * \brief Reserves space for at least \a rows rows.
+     */
+    void reserve(int rows);
+
+    /*!
+     * \brief Returns the number of rows.
+     */
+    int rowCount() const;
+
+    /*!
+     * \brief Returns true if there are no rows.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns the currency codes, indexed by the values of currencyIndexes().
+     */
+    QStringList currencies() const;
+
+    /*!
+     * \brief Returns the amount column in minor units of the row's currency.
+     */
+    const qint64 *amounts() const;
+
+    /*!
+     * \brief Returns the currency column as indexes into currencies().
+     */
+    const quint16 *currencyIndexes() const;
+
+    /*!
+     * \brief Returns the payment state column, values of Payment::State.
+     */
+    const quint8 *states() const;
+
+    /*!
+     * \brief Returns the payment creation time column in milliseconds since the epoch.
+     *
+     * Payments without creation time have the value \c std::numeric_limits<qint64>::min().
+     */
+    const qint64 *createTimes() const;
+
+    /*!
+     * \brief Computes count, sum, minimum and maximum of the amounts per group.
+     *
+     * If \a from and/or \a to are valid, only rows of payments created in the half open range [\a from, \a to)
+     * will be taken into account. The result is sorted by currency, state and day.
+     */
+    QVector<Aggregate> aggregate(GroupFlags groupBy, const QDateTime &from = QDateTime(), const QDateTime &to = QDateTime()) const;
+
+private:
+    QSharedDataPointer<PaymentColumnsData> d;
+};
+
+}
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Geltan::PP::PaymentColumns::GroupFlags)
+Q_DECLARE_TYPEINFO(Geltan::PP::PaymentColumns, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::PaymentColumns)
+
+#endif // PAYMENTCOLUMNS_H
@@ -0,0 +1,78 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentcolumns_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTCOLUMNS_P_H
+#define PAYMENTCOLUMNS_P_H
+
+#include "paymentcolumns.h"
+#include "money.h"
+#include <QSharedData>
+#include <QHash>
+#include <limits>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentColumnsData : public QSharedData
+{
+public:
+    PaymentColumnsData() :
+        maxState(0)
+    {}
+
+    PaymentColumnsData(const PaymentColumnsData &other) :
+        QSharedData(other),
+        amounts(other.amounts),
+        currencyIndexes(other.currencyIndexes),
+        states(other.states),
+        createTimes(other.createTimes),
+        currencies(other.currencies),
+        currencyLookup(other.currencyLookup),
+        maxState(other.maxState)
+    {}
+
+    ~PaymentColumnsData() {}
+
+    /*!
+     * \internal
+     * \brief Value of the creation time column for payments without creation time.
+     */
+    static const qint64 InvalidTime = std::numeric_limits<qint64>::min();
+
+    /*!
+     * \internal
+     * \brief Appends a single row, converting the \a total into minor units of the \a currency.
+     */
+    void appendRow(const Money &total, const QString &currency, Payment::State state, qint64 createTime);
+
+    QVector<qint64> amounts;
+    QVector<quint16> currencyIndexes;
+    QVector<quint8> states;
+    QVector<qint64> createTimes;
+    QStringList currencies;
+    QHash<QString, quint16> currencyLookup;
+    quint8 maxState;
+};
+
+}
+}
+
+#endif // PAYMENTCOLUMNS_P_H
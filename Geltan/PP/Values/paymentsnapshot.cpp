@@ -0,0 +1,89 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentsnapshot.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentsnapshot.h"
+#include <QDataStream>
+#include <cstring>
+
+using namespace Geltan;
+using namespace PP;
+
+static const char snapshotMagic[4] = {'G', 'P', 'P', 'S'};
+
+
+QByteArray PaymentSnapshot::write(const QList<PaymentValue> &payments, const QString &nextId)
+{
+    QByteArray data;
+    // rough estimate of a typical payment, saves most reallocations
+    data.reserve(64 + payments.size() * 1024);
+
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    // fixed stream version, so snapshots do not depend on the Qt version that wrote them
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream.writeRawData(snapshotMagic, sizeof(snapshotMagic));
+    stream << Version << nextId << payments;
+
+    return data;
+}
+
+
+
+QList<PaymentValue> PaymentSnapshot::read(const QByteArray &data, QString *nextId, bool *ok)
+{
+    QList<PaymentValue> payments;
+
+    if (ok) {
+        *ok = false;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    char magic[4];
+    if (stream.readRawData(magic, sizeof(magic)) != sizeof(magic) || std::memcmp(magic, snapshotMagic, sizeof(magic)) != 0) {
+        return payments;
+    }
+
+    quint16 version = 0;
+    stream >> version;
+    if (version != Version) {
+        return payments;
+    }
+
+    QString nid;
+    stream >> nid >> payments;
+
+    if (stream.status() != QDataStream::Ok) {
+        payments.clear();
+        return payments;
+    }
+
+    if (nextId) {
+        *nextId = nid;
+    }
+
+    if (ok) {
+        *ok = true;
+    }
+
+    return payments;
+}
@@ -0,0 +1,89 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentsnapshot.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTSNAPSHOT_H
+#define PAYMENTSNAPSHOT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/Values/paymentvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \brief Versioned binary snapshot of payments for caches and inter process communication.
+ *
+ * Other than the JSON created by Payment::toJson(), which only contains the members that can be sent to the
+ * API, a snapshot contains the complete payment data including read only members like the state, the links
+ * and the related resources of the transactions. It is written with QDataStream, so it is smaller than JSON
+ * and reading it needs no JSON parser at all.
+ *
+ * Every snapshot starts with a magic number and the format Version. read() rejects snapshots with an unknown
+ * magic number or any version other than the current one. Snapshots are meant for caches, after the format
+ * changed they have to be created again from the API data.
+ *
+ * \code{.cpp}
+ * const QByteArray data = Geltan::PP::PaymentSnapshot::write(payments);
+ * cache.insert(key, data);
+ *
+ * bool ok = false;
+ * const QList<Geltan::PP::PaymentValue> cached = Geltan::PP::PaymentSnapshot::read(cache.value(key), nullptr, &ok);
+ * \endcode
+ *
+ * \sa Payment::toSnapshot(), PaymentList::toSnapshot()
+ *
+ * \headerfile "" <Geltan/PP/Values/paymentsnapshot.h>
+ */
+class GELTANSHARED_EXPORT PaymentSnapshot
+{
+public:
+    /*!
+     * \brief The version of the snapshot format written by write().
+     *
+     * Version 2 added the funding instruments and the remaining payer info, payment options and related
+     * resource members.
+     */
+    static const quint16 Version = 2;
+
+    /*!
+     * \brief Returns a snapshot of the \a payments and the \a nextId of the list they belong to.
+     */
+    static QByteArray write(const QList<PaymentValue> &payments, const QString &nextId = QString());
+
+    /*!
+     * \brief Returns the payments contained in the snapshot \a data.
+     *
+     * If \a nextId is not a \c nullptr, it will contain the next ID of the list written to the snapshot. If \a ok
+     * is not a \c nullptr, it is set to false if \a data is not a valid snapshot, an empty list is returned then.
+     */
+    static QList<PaymentValue> read(const QByteArray &data, QString *nextId = nullptr, bool *ok = nullptr);
+
+private:
+    PaymentSnapshot() {}
+};
+
+}
+}
+
+#endif // PAYMENTSNAPSHOT_H
@@ -0,0 +1,306 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "paymentvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include <Geltan/PP/ppenumsmap.h>
+#include <Geltan/PP/ppjsondocument.h>
+#include <QJsonArray>
+
+using namespace Geltan;
+using namespace PP;
+
+PaymentValue::PaymentValue() :
+    d(new PaymentValueData)
+{
+}
+
+
+PaymentValue::PaymentValue(const PaymentValue &other) :
+    d(other.d)
+{
+}
+
+
+PaymentValue::~PaymentValue()
+{
+}
+
+
+PaymentValue &PaymentValue::operator=(const PaymentValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+QString PaymentValue::id() const { return d->id; }
+
+void PaymentValue::setId(const QString &nId) { d->id = nId; }
+
+
+Payment::Intent PaymentValue::intent() const { return d->intent; }
+
+void PaymentValue::setIntent(Payment::Intent nIntent) { d->intent = nIntent; }
+
+
+PayerValue PaymentValue::payer() const { return d->payer; }
+
+void PaymentValue::setPayer(const PayerValue &nPayer) { d->payer = nPayer; }
+
+
+QList<TransactionValue> PaymentValue::transactions() const { return d->transactions; }
+
+void PaymentValue::setTransactions(const QList<TransactionValue> &nTransactions) { d->transactions = nTransactions; }
+
+
+Payment::State PaymentValue::state() const { return d->state; }
+
+void PaymentValue::setState(Payment::State nState) { d->state = nState; }
+
+
+QString PaymentValue::experienceProfileId() const { return d->experienceProfileId; }
+
+void PaymentValue::setExperienceProfileId(const QString &nExperienceProfileId) { d->experienceProfileId = nExperienceProfileId; }
+
+
+QString PaymentValue::noteToPayer() const { return d->noteToPayer; }
+
+void PaymentValue::setNoteToPayer(const QString &nNoteToPayer) { d->noteToPayer = nNoteToPayer; }
+
+
+QUrl PaymentValue::returnUrl() const { return d->returnUrl; }
+
+void PaymentValue::setReturnUrl(const QUrl &nReturnUrl) { d->returnUrl = nReturnUrl; }
+
+
+QUrl PaymentValue::cancelUrl() const { return d->cancelUrl; }
+
+void PaymentValue::setCancelUrl(const QUrl &nCancelUrl) { d->cancelUrl = nCancelUrl; }
+
+
+Payment::FailureReason PaymentValue::failureReason() const { return d->failureReason; }
+
+void PaymentValue::setFailureReason(Payment::FailureReason nFailureReason) { d->failureReason = nFailureReason; }
+
+
+QDateTime PaymentValue::createTime() const { return PPTimestamp::toDateTime(d->createTime); }
+
+void PaymentValue::setCreateTime(const QDateTime &nCreateTime) { d->createTime = PPTimestamp::toMSecs(nCreateTime); }
+
+qint64 PaymentValue::createTimeMSecs() const { return d->createTime; }
+
+
+QDateTime PaymentValue::updateTime() const { return PPTimestamp::toDateTime(d->updateTime); }
+
+void PaymentValue::setUpdateTime(const QDateTime &nUpdateTime) { d->updateTime = PPTimestamp::toMSecs(nUpdateTime); }
+
+qint64 PaymentValue::updateTimeMSecs() const { return d->updateTime; }
+
+
+QList<LinkValue> PaymentValue::links() const { return d->links; }
+
+void PaymentValue::setLinks(const QList<LinkValue> &nLinks) { d->links = nLinks; }
+
+
+
+
+PaymentValue PaymentValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+PaymentValue PaymentValue::fromJson(const PPJsonValue &json)
+{
+    PaymentValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    PaymentValueData *d = v.d.data();
+
+    d->id = json.value(QLatin1String("id")).toString();
+
+    d->intent = PPEnumsMap::paymentIntentTokenToEnum(json.value(QLatin1String("intent")).toString());
+
+    d->payer = PayerValue::fromJson(json.value(QLatin1String("payer")).toObject());
+
+    const PPJsonValue ta = json.value(QLatin1String("transactions")).toArray();
+    if (!ta.isEmpty()) {
+        d->transactions.reserve(ta.count());
+        for (const PPJsonValue &t : ta) {
+            d->transactions.append(TransactionValue::fromJson(t.toObject()));
+        }
+    }
+
+    d->state = PPEnumsMap::paymentStateTokenToEnum(json.value(QLatin1String("state")).toString());
+
+    d->experienceProfileId = json.value(QLatin1String("experience_profile_id")).toString();
+    d->noteToPayer = json.value(QLatin1String("note_to_payer")).toString();
+
+    const PPJsonValue ru = json.value(QLatin1String("redirect_urls")).toObject();
+    if (!ru.isEmpty()) {
+        const QString rus = ru.value(QLatin1String("return_url")).toString();
+        if (!rus.isEmpty()) {
+            d->returnUrl = QUrl(rus);
+        }
+        const QString cus = ru.value(QLatin1String("cancel_url")).toString();
+        if (!cus.isEmpty()) {
+            d->cancelUrl = QUrl(cus);
+        }
+    }
+
+    d->failureReason = PPEnumsMap::paymentFailureReasonTokenToEnum(json.value(QLatin1String("failure_reason")).toString());
+
+    d->createTime = PPValuesBasePrivate::toMSecs(json.value(QLatin1String("create_time")));
+    d->updateTime = PPValuesBasePrivate::toMSecs(json.value(QLatin1String("update_time")));
+
+    const PPJsonValue la = json.value(QLatin1String("links")).toArray();
+    if (!la.isEmpty()) {
+        d->links.reserve(la.count());
+        for (const PPJsonValue &l : la) {
+            d->links.append(LinkValue::fromJson(l.toObject()));
+        }
+    }
+
+    return v;
+}
+
+
+
+PaymentValue PaymentValue::fromJson(const QByteArray &json)
+{
+    const PPJsonDocument doc = PPJsonDocument::fromJson(json);
+    return PaymentValue::fromJson(doc.root());
+}
+
+
+
+QJsonObject PaymentValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("id"), d->id);
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("intent"), PPEnumsMap::paymentIntentEnumToToken(d->intent));
+
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("payer"), d->payer.toJsonObject());
+
+    if (!d->transactions.isEmpty()) {
+        QJsonArray ta;
+        for (const TransactionValue &t : d->transactions) {
+            ta.append(t.toJsonObject());
+        }
+        json.insert(QStringLiteral("transactions"), ta);
+    }
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("state"), PPEnumsMap::paymentStateEnumToToken(d->state));
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("experience_profile_id"), d->experienceProfileId);
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("note_to_payer"), d->noteToPayer);
+
+    QJsonObject ru;
+    PPValuesBasePrivate::insertUrl(&ru, QStringLiteral("return_url"), d->returnUrl);
+    PPValuesBasePrivate::insertUrl(&ru, QStringLiteral("cancel_url"), d->cancelUrl);
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("redirect_urls"), ru);
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("failure_reason"), PPEnumsMap::paymentFailureReasonEnumToToken(d->failureReason));
+
+    PPValuesBasePrivate::insertTimestamp(&json, QStringLiteral("create_time"), d->createTime);
+    PPValuesBasePrivate::insertTimestamp(&json, QStringLiteral("update_time"), d->updateTime);
+
+    if (!d->links.isEmpty()) {
+        QJsonArray la;
+        for (const LinkValue &l : d->links) {
+            la.append(l.toJsonObject());
+        }
+        json.insert(QStringLiteral("links"), la);
+    }
+
+    return json;
+}
+
+
+
+QByteArray PaymentValue::toJson() const
+{
+    return QJsonDocument(toJsonObject()).toJson(QJsonDocument::Compact);
+}
+
+
+
+bool PaymentValue::isEmpty() const
+{
+    return (d->id.isEmpty() && d->intent == Payment::NoIntent && d->payer.isEmpty() && d->transactions.isEmpty()
+            && d->state == Payment::NoState && d->experienceProfileId.isEmpty() && d->noteToPayer.isEmpty()
+            && d->returnUrl.isEmpty() && d->cancelUrl.isEmpty() && d->failureReason == Payment::NoFailureReason
+            && d->createTime == PPTimestamp::Invalid && d->updateTime == PPTimestamp::Invalid && d->links.isEmpty());
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const PaymentValue &value)
+{
+    const PaymentValueData *d = value.d.constData();
+
+    stream << d->id
+           << static_cast<qint32>(d->intent)
+           << d->payer
+           << d->transactions
+           << static_cast<qint32>(d->state)
+           << d->experienceProfileId
+           << d->noteToPayer
+           << d->returnUrl
+           << d->cancelUrl
+           << static_cast<qint32>(d->failureReason)
+           << d->createTime
+           << d->updateTime
+           << d->links;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, PaymentValue &value)
+{
+    PaymentValueData *d = value.d.data();
+
+    stream >> d->id;
+    PPValuesBasePrivate::readInt(stream, &d->intent);
+    stream >> d->payer
+           >> d->transactions;
+    PPValuesBasePrivate::readInt(stream, &d->state);
+    stream >> d->experienceProfileId
+           >> d->noteToPayer
+           >> d->returnUrl
+           >> d->cancelUrl;
+    PPValuesBasePrivate::readInt(stream, &d->failureReason);
+    stream >> d->createTime
+           >> d->updateTime
+           >> d->links;
+
+    return stream;
+}
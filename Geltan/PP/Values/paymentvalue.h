@@ -0,0 +1,185 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTVALUE_H
+#define PAYMENTVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QDateTime>
+#include <QUrl>
+#include <QList>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Objects/payment.h>
+#include <Geltan/PP/Values/payervalue.h>
+#include <Geltan/PP/Values/transactionvalue.h>
+#include <Geltan/PP/Values/linkvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentValueData;
+
+/*!
+ * \brief Implicitly shared value type containing the data of a payment.
+ *
+ * Other than Payment this is not a QObject and does not create an object tree for its members. It is cheap to copy,
+ * can be stored in containers and passed between threads. Use it where a lot of payments have to be handled
+ * without being shown in a view, a Payment object can be created from it at any time by using
+ * Payment::Payment(const PaymentValue &value, QObject *parent) or Payment::loadFromValue().
+ *
+ * The members of the redirect_urls object are flattened into this value.
+ *
+ * \sa Payment
+ *
+ * \headerfile "" <Geltan/PP/Values/paymentvalue.h>
+ */
+class GELTANSHARED_EXPORT PaymentValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty PaymentValue.
+     */
+    PaymentValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    PaymentValue(const PaymentValue &other);
+
+    /*!
+     * \brief Deconstructs the PaymentValue.
+     */
+    ~PaymentValue();
+
+    /*!
+     * \brief Assigns \a other to this PaymentValue.
+     */
+    PaymentValue &operator=(const PaymentValue &other);
+
+    /*!
+     * \brief Creates a new PaymentValue from JSON data.
+     */
+    static PaymentValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new PaymentValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static PaymentValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the payment data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns the creation time as milliseconds since the epoch in UTC, or PPTimestamp::Invalid if it is not set.
+     *
+     * Other than createTime() this does not create a QDateTime, use it for sorting and comparing large numbers of values.
+     */
+    qint64 createTimeMSecs() const;
+
+    /*!
+     * \brief Returns the update time as milliseconds since the epoch in UTC, or PPTimestamp::Invalid if it is not set.
+     *
+     * \sa createTimeMSecs()
+     */
+    qint64 updateTimeMSecs() const;
+
+    /*!
+     * \brief Creates a new PaymentValue from JSON encoded \a json data.
+     *
+     * Returns an empty value if \a json is not a valid JSON object.
+     */
+    static PaymentValue fromJson(const QByteArray &json);
+
+    /*!
+     * \brief Returns the compact JSON representation of this payment.
+     */
+    QByteArray toJson() const;
+
+    QString id() const;
+    Payment::Intent intent() const;
+    PayerValue payer() const;
+    QList<TransactionValue> transactions() const;
+    Payment::State state() const;
+    QString experienceProfileId() const;
+    QString noteToPayer() const;
+    QUrl returnUrl() const;
+    QUrl cancelUrl() const;
+    Payment::FailureReason failureReason() const;
+    QDateTime createTime() const;
+    QDateTime updateTime() const;
+    QList<LinkValue> links() const;
+
+    void setId(const QString &nId);
+    void setIntent(Payment::Intent nIntent);
+    void setPayer(const PayerValue &nPayer);
+    void setTransactions(const QList<TransactionValue> &nTransactions);
+    void setState(Payment::State nState);
+    void setExperienceProfileId(const QString &nExperienceProfileId);
+    void setNoteToPayer(const QString &nNoteToPayer);
+    void setReturnUrl(const QUrl &nReturnUrl);
+    void setCancelUrl(const QUrl &nCancelUrl);
+    void setFailureReason(Payment::FailureReason nFailureReason);
+    void setCreateTime(const QDateTime &nCreateTime);
+    void setUpdateTime(const QDateTime &nUpdateTime);
+    void setLinks(const QList<LinkValue> &nLinks);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const PaymentValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, PaymentValue &value);
+
+    QSharedDataPointer<PaymentValueData> d;
+};
+
+/*!
+ * \relates PaymentValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const PaymentValue &value);
+
+/*!
+ * \relates PaymentValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, PaymentValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::PaymentValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::PaymentValue)
+
+#endif // PAYMENTVALUE_H
@@ -0,0 +1,80 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/paymentvalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAYMENTVALUE_P_H
+#define PAYMENTVALUE_P_H
+
+#include "paymentvalue.h"
+#include <QSharedData>
+#include <Geltan/PP/pptimestamp.h>
+
+namespace Geltan {
+namespace PP {
+
+class PaymentValueData : public QSharedData
+{
+public:
+    PaymentValueData() :
+        intent(Payment::NoIntent),
+        state(Payment::NoState),
+        failureReason(Payment::NoFailureReason),
+        createTime(PPTimestamp::Invalid),
+        updateTime(PPTimestamp::Invalid)
+    {}
+
+    PaymentValueData(const PaymentValueData &other) :
+        QSharedData(other),
+        id(other.id),
+        intent(other.intent),
+        payer(other.payer),
+        transactions(other.transactions),
+        state(other.state),
+        experienceProfileId(other.experienceProfileId),
+        noteToPayer(other.noteToPayer),
+        returnUrl(other.returnUrl),
+        cancelUrl(other.cancelUrl),
+        failureReason(other.failureReason),
+        createTime(other.createTime),
+        updateTime(other.updateTime),
+        links(other.links)
+    {}
+
+    ~PaymentValueData() {}
+
+    QString id;
+    Payment::Intent intent;
+    PayerValue payer;
+    QList<TransactionValue> transactions;
+    Payment::State state;
+    QString experienceProfileId;
+    QString noteToPayer;
+    QUrl returnUrl;
+    QUrl cancelUrl;
+    Payment::FailureReason failureReason;
+    qint64 createTime;     // msecs since epoch in UTC, the QDateTime is only created on access
+    qint64 updateTime;
+    QList<LinkValue> links;
+};
+
+}
+}
+
+#endif // PAYMENTVALUE_P_H
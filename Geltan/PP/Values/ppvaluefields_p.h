@@ -0,0 +1,366 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/ppvaluefields_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPVALUEFIELDS_P_H
+#define PPVALUEFIELDS_P_H
+
+#include <QString>
+#include <QUrl>
+#include <QJsonObject>
+#include <QJsonValue>
+#include "money.h"
+#include <Geltan/PP/pptokenhash_p.h>
+#include <Geltan/PP/ppjsonfields_p.h>
+#include <Geltan/PP/ppstringpool.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Maps an API token to the integer value of an enumerator. Tables are terminated by an entry with a \c nullptr token.
+ */
+struct PPEnumToken
+{
+    const char *token;
+    int value;
+};
+
+
+/*!
+ * \internal
+ * \brief Returns the value of \a token in the \a tokens table, or \a defaultValue if it is not part of it.
+ */
+inline int ppEnumTokenToValue(const PPEnumToken *tokens, const QString &token, int defaultValue = 0)
+{
+    for (const PPEnumToken *t = tokens; t->token; ++t) {
+        if (token == QLatin1String(t->token)) {
+            return t->value;
+        }
+    }
+    return defaultValue;
+}
+
+
+/*!
+ * \internal
+ * \brief Returns the token of \a value in the \a tokens table, or an empty string if it is not part of it.
+ */
+inline QString ppEnumValueToToken(const PPEnumToken *tokens, int value)
+{
+    for (const PPEnumToken *t = tokens; t->token; ++t) {
+        if (t->value == value) {
+            return QString::fromLatin1(t->token);
+        }
+    }
+    return QString();
+}
+
+
+/*!
+ * \internal
+ * \brief Describes a single member of an implicitly shared value type and its JSON representation.
+ *
+ * A static table of descriptors per value type is the single source for parsing, serialization and the
+ * empty check of the described members, see ppReadValueFields(), ppWriteValueFields() and
+ * ppValueFieldsEmpty(). String members can carry the maximum length the API accepts, longer values
+ * are cut on write and reported by ppValueFieldsTooLong(). The constructors are constexpr, so the
+ * tables including the key hashes and sizes are built at compile time.
+ *
+ * The tables describe the implicitly shared value types in Values only, the QObject based types in
+ * Objects keep their own serialization.
+ *
+ * Members that need special treatment, like nested values or tokens with fallbacks, are still handled
+ * by hand next to the generated code.
+ */
+template<typename Data>
+struct PPValueField
+{
+    enum Type {
+        String,         // QString, omitted if empty
+        PooledString,   // QString with few distinct values, interned via PPStringPool on read
+        Url,            // QUrl, omitted if empty
+        MoneyAmount,    // Money, omitted if zero
+        IntString,      // int transported as string, omitted if 0
+        Enumeration     // enumerator mapped by a PPEnumToken table, omitted if not part of the table
+    };
+
+    constexpr PPValueField(const char *k, Type t, QString Data::*s, QUrl Data::*u, Money Data::*m, int Data::*i,
+                           int (*re)(const Data *), void (*we)(Data *, int), const PPEnumToken *tk, int ml = 0) :
+        hash(ppTokenHash(k)), size(ppTokenSize(k)), key(k), type(t), string(s), url(u), money(m), integer(i),
+        readEnum(re), writeEnum(we), tokens(tk), maxLength(ml)
+    {}
+
+    quint32 hash;
+    int size;
+    const char *key;
+    Type type;
+    QString Data::*string;
+    QUrl Data::*url;
+    Money Data::*money;
+    int Data::*integer;
+    int (*readEnum)(const Data *);
+    void (*writeEnum)(Data *, int);
+    const PPEnumToken *tokens;
+    int maxLength;  // maximum number of characters of string members, 0 for no limit
+};
+
+
+template<typename Data>
+constexpr PPValueField<Data> ppStringField(const char *key, QString Data::*member, int maxLength = 0)
+{
+    return PPValueField<Data>(key, PPValueField<Data>::String, member, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, maxLength);
+}
+
+template<typename Data>
+constexpr PPValueField<Data> ppPooledStringField(const char *key, QString Data::*member, int maxLength = 0)
+{
+    return PPValueField<Data>(key, PPValueField<Data>::PooledString, member, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, maxLength);
+}
+
+template<typename Data>
+constexpr PPValueField<Data> ppUrlField(const char *key, QUrl Data::*member)
+{
+    return PPValueField<Data>(key, PPValueField<Data>::Url, nullptr, member, nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+
+template<typename Data>
+constexpr PPValueField<Data> ppMoneyField(const char *key, Money Data::*member)
+{
+    return PPValueField<Data>(key, PPValueField<Data>::MoneyAmount, nullptr, nullptr, member, nullptr, nullptr, nullptr, nullptr);
+}
+
+template<typename Data>
+constexpr PPValueField<Data> ppIntStringField(const char *key, int Data::*member)
+{
+    return PPValueField<Data>(key, PPValueField<Data>::IntString, nullptr, nullptr, nullptr, member, nullptr, nullptr, nullptr);
+}
+
+template<typename Data, typename E, E Data::*Member>
+int ppReadEnumMember(const Data *d) { return static_cast<int>(d->*Member); }
+
+template<typename Data, typename E, E Data::*Member>
+void ppWriteEnumMember(Data *d, int value) { d->*Member = static_cast<E>(value); }
+
+template<typename Data, typename E, E Data::*Member>
+constexpr PPValueField<Data> ppEnumField(const char *key, const PPEnumToken *tokens)
+{
+    return PPValueField<Data>(key, PPValueField<Data>::Enumeration, nullptr, nullptr, nullptr, nullptr,
+                              &ppReadEnumMember<Data, E, Member>, &ppWriteEnumMember<Data, E, Member>, tokens);
+}
+
+
+/*!
+ * \internal
+ * \brief Inserts \a value as member \a key into \a json, without creating a QString for the key where Qt allows it.
+ */
+inline void ppInsertValueField(QJsonObject *json, const char *key, const QJsonValue &value)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    json->insert(QLatin1String(key), value);
+#else
+    json->insert(QString::fromLatin1(key), value);
+#endif
+}
+
+
+/*!
+ * \internal
+ * \brief Reads the members described in \a table from \a json into \a d.
+ *
+ * The members are collected by PPJsonFields in a single pass, so for values from an on-demand index
+ * the member names are hashed and compared on the raw reply bytes. Members not part of \a json keep
+ * their default values.
+ */
+template<typename Data, int N>
+void ppReadValueFields(Data *d, const PPJsonValue &json, const PPValueField<Data> (&table)[N])
+{
+    const PPJsonFields<N> fields(json, table);
+
+    for (int i = 0; i < N; ++i) {
+        const PPValueField<Data> &f = table[i];
+        const PPJsonValue &v = fields[i];
+        if (v.isUndefined()) {
+            continue;
+        }
+
+        switch (f.type) {
+        case PPValueField<Data>::String:
+            d->*f.string = v.toString();
+            break;
+        case PPValueField<Data>::PooledString:
+            d->*f.string = PPStringPool::intern(v.toString());
+            break;
+        case PPValueField<Data>::Url:
+        {
+            const QString s = v.toString();
+            if (!s.isEmpty()) {
+                d->*f.url = QUrl(s);
+            }
+            break;
+        }
+        case PPValueField<Data>::MoneyAmount:
+            d->*f.money = Money::fromJson(v);
+            break;
+        case PPValueField<Data>::IntString:
+            d->*f.integer = v.isString() ? v.toString().toInt() : v.toInt();
+            break;
+        case PPValueField<Data>::Enumeration:
+        {
+            const QByteArray s = v.toUtf8();
+            for (const PPEnumToken *t = f.tokens; t->token; ++t) {
+                if (s == t->token) {
+                    f.writeEnum(d, t->value);
+                    break;
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+
+/*!
+ * \internal
+ * \brief Writes the members described in \a table from \a d into \a json, omitting empty members.
+ *
+ * String members are cut to their maximum length, like PPObjectsBasePrivate::writeString() does.
+ */
+template<typename Data, int N>
+void ppWriteValueFields(const Data *d, QJsonObject *json, const PPValueField<Data> (&table)[N])
+{
+    for (int i = 0; i < N; ++i) {
+        const PPValueField<Data> &f = table[i];
+        switch (f.type) {
+        case PPValueField<Data>::String:
+        case PPValueField<Data>::PooledString:
+            if (!(d->*f.string).isEmpty()) {
+                ppInsertValueField(json, f.key, (f.maxLength > 0) ? (d->*f.string).left(f.maxLength) : d->*f.string);
+            }
+            break;
+        case PPValueField<Data>::Url:
+            if (!(d->*f.url).isEmpty()) {
+                ppInsertValueField(json, f.key, (d->*f.url).toString());
+            }
+            break;
+        case PPValueField<Data>::MoneyAmount:
+        {
+            const Money &m = d->*f.money;
+            if (!m.isZero()) {
+                ppInsertValueField(json, f.key, m.toString(qMax(m.decimals(), 2)));
+            }
+            break;
+        }
+        case PPValueField<Data>::IntString:
+            if (d->*f.integer != 0) {
+                ppInsertValueField(json, f.key, QString::number(d->*f.integer));
+            }
+            break;
+        case PPValueField<Data>::Enumeration:
+        {
+            const int value = f.readEnum(d);
+            for (const PPEnumToken *t = f.tokens; t->token; ++t) {
+                if (t->value == value) {
+                    ppInsertValueField(json, f.key, QLatin1String(t->token));
+                    break;
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+
+/*!
+ * \internal
+ * \brief Returns true if all members described in \a table are empty.
+ *
+ * Enumerations count as empty if their value is not part of their token table.
+ */
+template<typename Data, int N>
+bool ppValueFieldsEmpty(const Data *d, const PPValueField<Data> (&table)[N])
+{
+    for (int i = 0; i < N; ++i) {
+        const PPValueField<Data> &f = table[i];
+        switch (f.type) {
+        case PPValueField<Data>::String:
+        case PPValueField<Data>::PooledString:
+            if (!(d->*f.string).isEmpty()) {
+                return false;
+            }
+            break;
+        case PPValueField<Data>::Url:
+            if (!(d->*f.url).isEmpty()) {
+                return false;
+            }
+            break;
+        case PPValueField<Data>::MoneyAmount:
+            if (!(d->*f.money).isZero()) {
+                return false;
+            }
+            break;
+        case PPValueField<Data>::IntString:
+            if (d->*f.integer != 0) {
+                return false;
+            }
+            break;
+        case PPValueField<Data>::Enumeration:
+        {
+            const int value = f.readEnum(d);
+            for (const PPEnumToken *t = f.tokens; t->token; ++t) {
+                if (t->value == value) {
+                    return false;
+                }
+            }
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+
+/*!
+ * \internal
+ * \brief Returns the key of the first string member described in \a table that exceeds its maximum length.
+ *
+ * Returns a \c nullptr if all members fit.
+ */
+template<typename Data, int N>
+const char *ppValueFieldsTooLong(const Data *d, const PPValueField<Data> (&table)[N])
+{
+    for (int i = 0; i < N; ++i) {
+        const PPValueField<Data> &f = table[i];
+        if ((f.maxLength > 0) && ((f.type == PPValueField<Data>::String) || (f.type == PPValueField<Data>::PooledString))) {
+            if ((d->*f.string).size() > f.maxLength) {
+                return f.key;
+            }
+        }
+    }
+    return nullptr;
+}
+
+}
+}
+
+#endif // PPVALUEFIELDS_P_H
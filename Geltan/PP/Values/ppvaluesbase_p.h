@@ -0,0 +1,130 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/ppvaluesbase_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPVALUESBASE_P_H
+#define PPVALUESBASE_P_H
+
+#include <QString>
+#include <QUrl>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QJsonArray>
+#include <QDataStream>
+#include "money.h"
+#include <Geltan/PP/pptimestamp.h>
+#include <Geltan/PP/ppjsonvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Helper functions shared by the implicitly shared value types.
+ *
+ * Other than the QVariantMap helpers in PPObjectsBasePrivate these do not truncate anything,
+ * the value types are meant to hold the complete data returned by the API.
+ */
+class PPValuesBasePrivate
+{
+public:
+    static QString toString(const QJsonObject &json, const QString &key)
+    {
+        return json.value(key).toString();
+    }
+
+    static Money toMoney(const QJsonValue &v)
+    {
+        return Money::fromJson(v);
+    }
+
+    static Money toMoney(const PPJsonValue &v)
+    {
+        return Money::fromJson(v);
+    }
+
+    static qint64 toMSecs(const QJsonValue &v)
+    {
+        return PPTimestamp::parse(v.toString());
+    }
+
+    static qint64 toMSecs(const PPJsonValue &v)
+    {
+        return PPTimestamp::parse(v.toString());
+    }
+
+    static void insertString(QJsonObject *json, const QString &key, const QString &value)
+    {
+        if (!value.isEmpty()) {
+            json->insert(key, value);
+        }
+    }
+
+    static void insertUrl(QJsonObject *json, const QString &key, const QUrl &value)
+    {
+        if (value.isValid()) {
+            json->insert(key, value.toString());
+        }
+    }
+
+    static void insertMoney(QJsonObject *json, const QString &key, const Money &value)
+    {
+        if (!value.isZero()) {
+            json->insert(key, value.toString(qMax(value.decimals(), 2)));
+        }
+    }
+
+    static void insertTimestamp(QJsonObject *json, const QString &key, qint64 msecs)
+    {
+        if (msecs != PPTimestamp::Invalid) {
+            json->insert(key, PPTimestamp::format(msecs));
+        }
+    }
+
+    static void insertObject(QJsonObject *json, const QString &key, const QJsonObject &value)
+    {
+        if (!value.isEmpty()) {
+            json->insert(key, value);
+        }
+    }
+
+    /*!
+     * \brief Reads an integer or enumerator that has been written as qint32 from \a stream.
+     */
+    template<typename T>
+    static void readInt(QDataStream &stream, T *value)
+    {
+        qint32 v = 0;
+        stream >> v;
+        *value = static_cast<T>(v);
+    }
+
+    static void insertArray(QJsonObject *json, const QString &key, const QJsonArray &value)
+    {
+        if (!value.isEmpty()) {
+            json->insert(key, value);
+        }
+    }
+};
+
+}
+}
+
+#endif // PPVALUESBASE_P_H
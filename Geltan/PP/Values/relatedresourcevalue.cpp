@@ -0,0 +1,649 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/relatedresourcevalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "relatedresourcevalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+#include <Geltan/PP/ppenumsmap.h>
+#include <QJsonArray>
+
+using namespace Geltan;
+using namespace PP;
+
+static const PPEnumToken fmfFilterTypeTokens[] = {
+    {"ACCEPT", FMFDetails::ACCEPT},
+    {"PENDING", FMFDetails::PENDING},
+    {"DENY", FMFDetails::DENY},
+    {"REPORT", FMFDetails::REPORT},
+    {nullptr, 0}
+};
+
+static const PPEnumToken fmfFilterIdTokens[] = {
+    {"AVS_NO_MATCH", FMFDetails::AVS_NO_MATCH},
+    {"AVS_PARTIAL_MATCH", FMFDetails::AVS_PARTIAL_MATCH},
+    {"AVS_UNAVAILABLE_OR_UNSUPPORTED", FMFDetails::AVS_UNAVAILABLE_OR_UNSUPPORTED},
+    {"CARD_SECURITY_CODE_MISMATCH", FMFDetails::CARD_SECURITY_CODE_MISMATCH},
+    {"MAXIMUM_TRANSACTION_AMOUNT", FMFDetails::MAXIMUM_TRANSACTION_AMOUNT},
+    {"UNCONFIRMED_ADDRESS", FMFDetails::UNCONFIRMED_ADDRESS},
+    {"COUNTRY_MONITOR", FMFDetails::COUNTRY_MONITOR},
+    {"LARGE_ORDER_NUMBER", FMFDetails::LARGE_ORDER_NUMBER},
+    {"BILLING_OR_SHIPPING_ADDRESS_MISMATCH", FMFDetails::BILLING_OR_SHIPPING_ADDRESS_MISMATCH},
+    {"RISKY_ZIP_CODE", FMFDetails::RISKY_ZIP_CODE},
+    {"SUSPECTED_FREIGHT_FORWARDER_CHECK", FMFDetails::SUSPECTED_FREIGHT_FORWARDER_CHECK},
+    {"TOTAL_PURCHASE_PRICE_MINIMUM", FMFDetails::TOTAL_PURCHASE_PRICE_MINIMUM},
+    {"IP_ADDRESS_VELOCITY", FMFDetails::IP_ADDRESS_VELOCITY},
+    {"RISKY_EMAIL_ADDRESS_DOMAIN_CHECK", FMFDetails::RISKY_EMAIL_ADDRESS_DOMAIN_CHECK},
+    {"RISKY_BANK_IDENTIFICATION_NUMBER_CHECK", FMFDetails::RISKY_BANK_IDENTIFICATION_NUMBER_CHECK},
+    {"RISKY_IP_ADDRESS_RANGE", FMFDetails::RISKY_IP_ADDRESS_RANGE},
+    {"PAYPAL_FRAUD_MODEL", FMFDetails::PAYPAL_FRAUD_MODEL},
+    {nullptr, 0}
+};
+
+static const PPEnumToken adviceCodeTokens[] = {
+    {"01_NEW_ACCOUNT_INFORMATION", ProcessorResponse::NewAccountInformation},
+    {"02_TRY_AGAIN_LATER", ProcessorResponse::TryAgainLater},
+    {"02_STOP_SPECIFIC_PAYMENT", ProcessorResponse::StopSpecificPayment},
+    {"03_DO_NOT_TRY_AGAIN", ProcessorResponse::DoNotTryAgain},
+    {"03_REVOKE_AUTHORIZATION_FOR_FUTURE_PAYMENT", ProcessorResponse::RevokeAuthorizationForFuturePayment},
+    {"21_DO_NOT_TRY_AGAIN_CARD_HOLDER_CANCELLED_RECURRRING_CHARGE", ProcessorResponse::DoNotTryAgainCardHolderCancelledRecurringCharge},
+    {"21_CANCEL_ALL_RECURRING_PAYMENTS", ProcessorResponse::CancelAllRecurringPayments},
+    {nullptr, 0}
+};
+
+RelatedResourceValue::RelatedResourceValue() :
+    d(new RelatedResourceValueData)
+{
+}
+
+
+RelatedResourceValue::RelatedResourceValue(const RelatedResourceValue &other) :
+    d(other.d)
+{
+}
+
+
+RelatedResourceValue::~RelatedResourceValue()
+{
+}
+
+
+RelatedResourceValue &RelatedResourceValue::operator=(const RelatedResourceValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+RelatedResourceValue::Type RelatedResourceValue::type() const { return d->type; }
+
+void RelatedResourceValue::setType(Type nType) { d->type = nType; }
+
+
+QString RelatedResourceValue::id() const { return d->id; }
+
+void RelatedResourceValue::setId(const QString &nId) { d->id = nId; }
+
+
+PayPal::StateType RelatedResourceValue::state() const { return d->state; }
+
+void RelatedResourceValue::setState(PayPal::StateType nState) { d->state = nState; }
+
+
+PaymentAmountValue RelatedResourceValue::amount() const { return d->amount; }
+
+void RelatedResourceValue::setAmount(const PaymentAmountValue &nAmount) { d->amount = nAmount; }
+
+
+PayPal::PaymentModeType RelatedResourceValue::paymentMode() const { return d->paymentMode; }
+
+void RelatedResourceValue::setPaymentMode(PayPal::PaymentModeType nPaymentMode) { d->paymentMode = nPaymentMode; }
+
+
+PayPal::ReasonCode RelatedResourceValue::reasonCode() const { return d->reasonCode; }
+
+void RelatedResourceValue::setReasonCode(PayPal::ReasonCode nReasonCode) { d->reasonCode = nReasonCode; }
+
+
+PayPal::ProtectionEligibility RelatedResourceValue::protectionEligibility() const { return d->protectionEligibility; }
+
+void RelatedResourceValue::setProtectionEligibility(PayPal::ProtectionEligibility nProtectionEligibility) { d->protectionEligibility = nProtectionEligibility; }
+
+
+QString RelatedResourceValue::parentPayment() const { return d->parentPayment; }
+
+void RelatedResourceValue::setParentPayment(const QString &nParentPayment) { d->parentPayment = nParentPayment; }
+
+
+QString RelatedResourceValue::invoiceNumber() const { return d->invoiceNumber; }
+
+void RelatedResourceValue::setInvoiceNumber(const QString &nInvoiceNumber) { d->invoiceNumber = nInvoiceNumber; }
+
+
+QString RelatedResourceValue::saleId() const { return d->saleId; }
+
+void RelatedResourceValue::setSaleId(const QString &nSaleId) { d->saleId = nSaleId; }
+
+
+QString RelatedResourceValue::captureId() const { return d->captureId; }
+
+void RelatedResourceValue::setCaptureId(const QString &nCaptureId) { d->captureId = nCaptureId; }
+
+
+PaymentAmountValue RelatedResourceValue::transactionFee() const { return d->transactionFee; }
+
+void RelatedResourceValue::setTransactionFee(const PaymentAmountValue &nTransactionFee) { d->transactionFee = nTransactionFee; }
+
+
+QDateTime RelatedResourceValue::createTime() const { return PPTimestamp::toDateTime(d->createTime); }
+
+void RelatedResourceValue::setCreateTime(const QDateTime &nCreateTime) { d->createTime = PPTimestamp::toMSecs(nCreateTime); }
+
+qint64 RelatedResourceValue::createTimeMSecs() const { return d->createTime; }
+
+
+QDateTime RelatedResourceValue::updateTime() const { return PPTimestamp::toDateTime(d->updateTime); }
+
+void RelatedResourceValue::setUpdateTime(const QDateTime &nUpdateTime) { d->updateTime = PPTimestamp::toMSecs(nUpdateTime); }
+
+qint64 RelatedResourceValue::updateTimeMSecs() const { return d->updateTime; }
+
+
+QList<LinkValue> RelatedResourceValue::links() const { return d->links; }
+
+void RelatedResourceValue::setLinks(const QList<LinkValue> &nLinks) { d->links = nLinks; }
+
+
+QString RelatedResourceValue::purchaseUnitReferenceId() const { return d->purchaseUnitReferenceId; }
+
+void RelatedResourceValue::setPurchaseUnitReferenceId(const QString &nPurchaseUnitReferenceId) { d->purchaseUnitReferenceId = nPurchaseUnitReferenceId; }
+
+
+QString RelatedResourceValue::referenceId() const { return d->referenceId; }
+
+void RelatedResourceValue::setReferenceId(const QString &nReferenceId) { d->referenceId = nReferenceId; }
+
+
+QList<PayPal::ProtectionEligibilityType> RelatedResourceValue::protectionEligibilityType() const { return d->protectionEligibilityType; }
+
+void RelatedResourceValue::setProtectionEligibilityType(const QList<PayPal::ProtectionEligibilityType> &nProtectionEligibilityType) { d->protectionEligibilityType = nProtectionEligibilityType; }
+
+
+QDateTime RelatedResourceValue::clearingTime() const { return PPTimestamp::toDateTime(d->clearingTime); }
+
+void RelatedResourceValue::setClearingTime(const QDateTime &nClearingTime) { d->clearingTime = PPTimestamp::toMSecs(nClearingTime); }
+
+
+Sale::PaymentHoldStatus RelatedResourceValue::paymentHoldStatus() const { return d->paymentHoldStatus; }
+
+void RelatedResourceValue::setPaymentHoldStatus(Geltan::PP::Sale::PaymentHoldStatus nPaymentHoldStatus) { d->paymentHoldStatus = nPaymentHoldStatus; }
+
+
+QStringList RelatedResourceValue::paymentHoldReasons() const { return d->paymentHoldReasons; }
+
+void RelatedResourceValue::setPaymentHoldReasons(const QStringList &nPaymentHoldReasons) { d->paymentHoldReasons = nPaymentHoldReasons; }
+
+
+PaymentAmountValue RelatedResourceValue::receivableAmount() const { return d->receivableAmount; }
+
+void RelatedResourceValue::setReceivableAmount(const PaymentAmountValue &nReceivableAmount) { d->receivableAmount = nReceivableAmount; }
+
+
+float RelatedResourceValue::exchangeRate() const { return d->exchangeRate; }
+
+void RelatedResourceValue::setExchangeRate(float nExchangeRate) { d->exchangeRate = nExchangeRate; }
+
+
+FMFDetails::FilterType RelatedResourceValue::fmfFilterType() const { return d->fmfFilterType; }
+
+void RelatedResourceValue::setFmfFilterType(FMFDetails::FilterType nFmfFilterType) { d->fmfFilterType = nFmfFilterType; }
+
+
+FMFDetails::FilterIdentifier RelatedResourceValue::fmfFilterId() const { return d->fmfFilterId; }
+
+void RelatedResourceValue::setFmfFilterId(FMFDetails::FilterIdentifier nFmfFilterId) { d->fmfFilterId = nFmfFilterId; }
+
+
+QString RelatedResourceValue::fmfName() const { return d->fmfName; }
+
+void RelatedResourceValue::setFmfName(const QString &nFmfName) { d->fmfName = nFmfName; }
+
+
+QString RelatedResourceValue::fmfDescription() const { return d->fmfDescription; }
+
+void RelatedResourceValue::setFmfDescription(const QString &nFmfDescription) { d->fmfDescription = nFmfDescription; }
+
+
+QString RelatedResourceValue::receiptId() const { return d->receiptId; }
+
+void RelatedResourceValue::setReceiptId(const QString &nReceiptId) { d->receiptId = nReceiptId; }
+
+
+QString RelatedResourceValue::processorResponseCode() const { return d->processorResponseCode; }
+
+void RelatedResourceValue::setProcessorResponseCode(const QString &nProcessorResponseCode) { d->processorResponseCode = nProcessorResponseCode; }
+
+
+QString RelatedResourceValue::processorAvsCode() const { return d->processorAvsCode; }
+
+void RelatedResourceValue::setProcessorAvsCode(const QString &nProcessorAvsCode) { d->processorAvsCode = nProcessorAvsCode; }
+
+
+QString RelatedResourceValue::processorCvvCode() const { return d->processorCvvCode; }
+
+void RelatedResourceValue::setProcessorCvvCode(const QString &nProcessorCvvCode) { d->processorCvvCode = nProcessorCvvCode; }
+
+
+ProcessorResponse::AdviceCode RelatedResourceValue::processorAdviceCode() const { return d->processorAdviceCode; }
+
+void RelatedResourceValue::setProcessorAdviceCode(ProcessorResponse::AdviceCode nProcessorAdviceCode) { d->processorAdviceCode = nProcessorAdviceCode; }
+
+
+QString RelatedResourceValue::processorEciSubmitted() const { return d->processorEciSubmitted; }
+
+void RelatedResourceValue::setProcessorEciSubmitted(const QString &nProcessorEciSubmitted) { d->processorEciSubmitted = nProcessorEciSubmitted; }
+
+
+QString RelatedResourceValue::processorVpas() const { return d->processorVpas; }
+
+void RelatedResourceValue::setProcessorVpas(const QString &nProcessorVpas) { d->processorVpas = nProcessorVpas; }
+
+
+QString RelatedResourceValue::billingAgreementId() const { return d->billingAgreementId; }
+
+void RelatedResourceValue::setBillingAgreementId(const QString &nBillingAgreementId) { d->billingAgreementId = nBillingAgreementId; }
+
+
+QDateTime RelatedResourceValue::validUntil() const { return PPTimestamp::toDateTime(d->validUntil); }
+
+void RelatedResourceValue::setValidUntil(const QDateTime &nValidUntil) { d->validUntil = PPTimestamp::toMSecs(nValidUntil); }
+
+
+bool RelatedResourceValue::isFinalCapture() const { return d->isFinalCapture; }
+
+void RelatedResourceValue::setIsFinalCapture(bool nIsFinalCapture) { d->isFinalCapture = nIsFinalCapture; }
+
+
+QString RelatedResourceValue::reason() const { return d->reason; }
+
+void RelatedResourceValue::setReason(const QString &nReason) { d->reason = nReason; }
+
+
+QString RelatedResourceValue::description() const { return d->description; }
+
+void RelatedResourceValue::setDescription(const QString &nDescription) { d->description = nDescription; }
+
+
+
+
+static QLatin1String relatedResourceTypeKey(RelatedResourceValue::Type type)
+{
+    switch(type) {
+    case RelatedResourceValue::Sale:
+        return QLatin1String("sale");
+    case RelatedResourceValue::Authorization:
+        return QLatin1String("authorization");
+    case RelatedResourceValue::Order:
+        return QLatin1String("order");
+    case RelatedResourceValue::Capture:
+        return QLatin1String("capture");
+    case RelatedResourceValue::Refund:
+        return QLatin1String("refund");
+    default:
+        return QLatin1String();
+    }
+}
+
+
+
+RelatedResourceValue RelatedResourceValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+RelatedResourceValue RelatedResourceValue::fromJson(const PPJsonValue &json)
+{
+    RelatedResourceValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    RelatedResourceValueData *d = v.d.data();
+
+    PPJsonValue o;
+    for (int t = Sale; t <= Refund; ++t) {
+        o = json.value(relatedResourceTypeKey(static_cast<Type>(t))).toObject();
+        if (!o.isEmpty()) {
+            d->type = static_cast<Type>(t);
+            break;
+        }
+    }
+
+    if (d->type == NoType) {
+        return v;
+    }
+
+    d->id = o.value(QLatin1String("id")).toString();
+    d->state = PPEnumsMap::stateTypeTokenToEnum(o.value(QLatin1String("state")).toString());
+    d->amount = PaymentAmountValue::fromJson(o.value(QLatin1String("amount")).toObject());
+    d->paymentMode = PPEnumsMap::paymentModeTypeTokenToEnum(o.value(QLatin1String("payment_mode")).toString());
+    d->reasonCode = PPEnumsMap::reasonCodeTokenToEnum(o.value(QLatin1String("reason_code")).toString());
+    d->protectionEligibility = PPEnumsMap::protectionEligibilityTokenToEnum(o.value(QLatin1String("protection_eligibility")).toString());
+    d->parentPayment = o.value(QLatin1String("parent_payment")).toString();
+    d->invoiceNumber = o.value(QLatin1String("invoice_number")).toString();
+    d->saleId = o.value(QLatin1String("sale_id")).toString();
+    d->captureId = o.value(QLatin1String("capture_id")).toString();
+    d->transactionFee = PaymentAmountValue::fromJson(o.value(QLatin1String("transaction_fee")).toObject());
+    d->createTime = PPValuesBasePrivate::toMSecs(o.value(QLatin1String("create_time")));
+    d->updateTime = PPValuesBasePrivate::toMSecs(o.value(QLatin1String("update_time")));
+
+    const PPJsonValue la = o.value(QLatin1String("links")).toArray();
+    if (!la.isEmpty()) {
+        d->links.reserve(la.count());
+        for (const PPJsonValue &l : la) {
+            d->links.append(LinkValue::fromJson(l.toObject()));
+        }
+    }
+
+    d->purchaseUnitReferenceId = o.value(QLatin1String("purchase_unit_reference_id")).toString();
+    d->referenceId = o.value(QLatin1String("reference_id")).toString();
+
+    const QString pets = o.value(QLatin1String("protection_eligibility_type")).toString();
+    if (!pets.isEmpty()) {
+        const QStringList petsList = pets.split(QChar(','));
+        d->protectionEligibilityType.reserve(petsList.size());
+        for (const QString &pet : petsList) {
+            d->protectionEligibilityType.append(PPEnumsMap::protectionEligibilityTypeTokenToEnum(pet));
+        }
+    }
+
+    d->clearingTime = PPValuesBasePrivate::toMSecs(o.value(QLatin1String("clearing_time")));
+
+    if (o.value(QLatin1String("payment_hold_status")).toString() == QLatin1String("HELD")) {
+        d->paymentHoldStatus = Geltan::PP::Sale::HELD;
+    }
+
+    const PPJsonValue phrs = o.value(QLatin1String("payment_hold_reasons")).toArray();
+    for (const PPJsonValue &phr : phrs) {
+        d->paymentHoldReasons.append(phr.toString());
+    }
+
+    d->receivableAmount = PaymentAmountValue::fromJson(o.value(QLatin1String("receivable_amount")).toObject());
+    d->exchangeRate = o.value(QLatin1String("exchange_rate")).toString().toFloat();
+
+    const PPJsonValue fmfo = o.value(QLatin1String("fmf_details")).toObject();
+    if (!fmfo.isEmpty()) {
+        d->fmfFilterType = static_cast<FMFDetails::FilterType>(ppEnumTokenToValue(fmfFilterTypeTokens, fmfo.value(QLatin1String("filter_type")).toString()));
+        d->fmfFilterId = static_cast<FMFDetails::FilterIdentifier>(ppEnumTokenToValue(fmfFilterIdTokens, fmfo.value(QLatin1String("filter_id")).toString()));
+        d->fmfName = fmfo.value(QLatin1String("name")).toString();
+        d->fmfDescription = fmfo.value(QLatin1String("description")).toString();
+    }
+
+    d->receiptId = o.value(QLatin1String("receipt_id")).toString();
+
+    const PPJsonValue pro = o.value(QLatin1String("processor_response")).toObject();
+    if (!pro.isEmpty()) {
+        d->processorResponseCode = pro.value(QLatin1String("response_code")).toString();
+        d->processorAvsCode = pro.value(QLatin1String("avs_code")).toString();
+        d->processorCvvCode = pro.value(QLatin1String("cvv_code")).toString();
+        d->processorAdviceCode = static_cast<ProcessorResponse::AdviceCode>(ppEnumTokenToValue(adviceCodeTokens, pro.value(QLatin1String("advice_code")).toString()));
+        d->processorEciSubmitted = pro.value(QLatin1String("eci_submitted")).toString();
+        d->processorVpas = pro.value(QLatin1String("vpas")).toString();
+    }
+
+    d->billingAgreementId = o.value(QLatin1String("billing_agreement_id")).toString();
+    d->validUntil = PPValuesBasePrivate::toMSecs(o.value(QLatin1String("valid_until")));
+
+    const PPJsonValue ifc = o.value(QLatin1String("is_final_capture"));
+    d->isFinalCapture = ifc.isBool() ? ifc.toBool() : (ifc.toString() == QLatin1String("true"));
+
+    d->reason = o.value(QLatin1String("reason")).toString();
+    d->description = o.value(QLatin1String("description")).toString();
+
+    return v;
+}
+
+
+
+QJsonObject RelatedResourceValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    if (d->type == NoType) {
+        return json;
+    }
+
+    QJsonObject o;
+
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("id"), d->id);
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("state"), PPEnumsMap::stateTypeEnumToToken(d->state));
+    PPValuesBasePrivate::insertObject(&o, QStringLiteral("amount"), d->amount.toJsonObject());
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("payment_mode"), PPEnumsMap::paymentModeTypeEnumToToken(d->paymentMode));
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("reason_code"), PPEnumsMap::reasonCodeEnumToToken(d->reasonCode));
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("protection_eligibility"), PPEnumsMap::protectionEligibilityEnumToToken(d->protectionEligibility));
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("parent_payment"), d->parentPayment);
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("invoice_number"), d->invoiceNumber);
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("sale_id"), d->saleId);
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("capture_id"), d->captureId);
+
+    if (!d->transactionFee.isEmpty()) {
+        QJsonObject tf;
+        PPValuesBasePrivate::insertString(&tf, QStringLiteral("currency"), d->transactionFee.currency());
+        PPValuesBasePrivate::insertMoney(&tf, QStringLiteral("value"), d->transactionFee.totalMoney());
+        o.insert(QStringLiteral("transaction_fee"), tf);
+    }
+
+    PPValuesBasePrivate::insertTimestamp(&o, QStringLiteral("create_time"), d->createTime);
+    PPValuesBasePrivate::insertTimestamp(&o, QStringLiteral("update_time"), d->updateTime);
+
+    if (!d->links.isEmpty()) {
+        QJsonArray la;
+        for (const LinkValue &l : d->links) {
+            la.append(l.toJsonObject());
+        }
+        o.insert(QStringLiteral("links"), la);
+    }
+
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("purchase_unit_reference_id"), d->purchaseUnitReferenceId);
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("reference_id"), d->referenceId);
+
+    if (!d->protectionEligibilityType.isEmpty()) {
+        QStringList pets;
+        pets.reserve(d->protectionEligibilityType.size());
+        for (PayPal::ProtectionEligibilityType pet : d->protectionEligibilityType) {
+            pets.append(PPEnumsMap::protectionEligibilityTypeEnumToToken(pet));
+        }
+        o.insert(QStringLiteral("protection_eligibility_type"), pets.join(QChar(',')));
+    }
+
+    PPValuesBasePrivate::insertTimestamp(&o, QStringLiteral("clearing_time"), d->clearingTime);
+
+    if (d->paymentHoldStatus == Geltan::PP::Sale::HELD) {
+        o.insert(QStringLiteral("payment_hold_status"), QStringLiteral("HELD"));
+    }
+
+    PPValuesBasePrivate::insertArray(&o, QStringLiteral("payment_hold_reasons"), QJsonArray::fromStringList(d->paymentHoldReasons));
+
+    if (!d->receivableAmount.isEmpty()) {
+        QJsonObject ra;
+        PPValuesBasePrivate::insertString(&ra, QStringLiteral("currency"), d->receivableAmount.currency());
+        PPValuesBasePrivate::insertMoney(&ra, QStringLiteral("value"), d->receivableAmount.totalMoney());
+        o.insert(QStringLiteral("receivable_amount"), ra);
+    }
+
+    if (d->exchangeRate != 0.0f) {
+        o.insert(QStringLiteral("exchange_rate"), QString::number(d->exchangeRate));
+    }
+
+    QJsonObject fmfo;
+    PPValuesBasePrivate::insertString(&fmfo, QStringLiteral("filter_type"), ppEnumValueToToken(fmfFilterTypeTokens, d->fmfFilterType));
+    PPValuesBasePrivate::insertString(&fmfo, QStringLiteral("filter_id"), ppEnumValueToToken(fmfFilterIdTokens, d->fmfFilterId));
+    PPValuesBasePrivate::insertString(&fmfo, QStringLiteral("name"), d->fmfName);
+    PPValuesBasePrivate::insertString(&fmfo, QStringLiteral("description"), d->fmfDescription);
+    PPValuesBasePrivate::insertObject(&o, QStringLiteral("fmf_details"), fmfo);
+
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("receipt_id"), d->receiptId);
+
+    QJsonObject pro;
+    PPValuesBasePrivate::insertString(&pro, QStringLiteral("response_code"), d->processorResponseCode);
+    PPValuesBasePrivate::insertString(&pro, QStringLiteral("avs_code"), d->processorAvsCode);
+    PPValuesBasePrivate::insertString(&pro, QStringLiteral("cvv_code"), d->processorCvvCode);
+    PPValuesBasePrivate::insertString(&pro, QStringLiteral("advice_code"), ppEnumValueToToken(adviceCodeTokens, d->processorAdviceCode));
+    PPValuesBasePrivate::insertString(&pro, QStringLiteral("eci_submitted"), d->processorEciSubmitted);
+    PPValuesBasePrivate::insertString(&pro, QStringLiteral("vpas"), d->processorVpas);
+    PPValuesBasePrivate::insertObject(&o, QStringLiteral("processor_response"), pro);
+
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("billing_agreement_id"), d->billingAgreementId);
+    PPValuesBasePrivate::insertTimestamp(&o, QStringLiteral("valid_until"), d->validUntil);
+
+    if (d->isFinalCapture) {
+        o.insert(QStringLiteral("is_final_capture"), true);
+    }
+
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("reason"), d->reason);
+    PPValuesBasePrivate::insertString(&o, QStringLiteral("description"), d->description);
+
+    json.insert(QString(relatedResourceTypeKey(d->type)), o);
+
+    return json;
+}
+
+
+
+bool RelatedResourceValue::isEmpty() const
+{
+    return (d->type == NoType);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const RelatedResourceValue &value)
+{
+    const RelatedResourceValueData *d = value.d.constData();
+
+    stream << static_cast<qint32>(d->type)
+           << d->id
+           << static_cast<qint32>(d->state)
+           << d->amount
+           << static_cast<qint32>(d->paymentMode)
+           << static_cast<qint32>(d->reasonCode)
+           << static_cast<qint32>(d->protectionEligibility)
+           << d->parentPayment
+           << d->invoiceNumber
+           << d->saleId
+           << d->captureId
+           << d->transactionFee
+           << d->createTime
+           << d->updateTime
+           << d->links
+           << d->purchaseUnitReferenceId
+           << d->referenceId;
+
+    stream << static_cast<qint32>(d->protectionEligibilityType.size());
+    for (PayPal::ProtectionEligibilityType pet : d->protectionEligibilityType) {
+        stream << static_cast<qint32>(pet);
+    }
+
+    stream << d->clearingTime
+           << static_cast<qint32>(d->paymentHoldStatus)
+           << d->paymentHoldReasons
+           << d->receivableAmount
+           << d->exchangeRate
+           << static_cast<qint32>(d->fmfFilterType)
+           << static_cast<qint32>(d->fmfFilterId)
+           << d->fmfName
+           << d->fmfDescription
+           << d->receiptId
+           << d->processorResponseCode
+           << d->processorAvsCode
+           << d->processorCvvCode
+           << static_cast<qint32>(d->processorAdviceCode)
+           << d->processorEciSubmitted
+           << d->processorVpas
+           << d->billingAgreementId
+           << d->validUntil
+           << d->isFinalCapture
+           << d->reason
+           << d->description;
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, RelatedResourceValue &value)
+{
+    RelatedResourceValueData *d = value.d.data();
+
+    PPValuesBasePrivate::readInt(stream, &d->type);
+    stream >> d->id;
+    PPValuesBasePrivate::readInt(stream, &d->state);
+    stream >> d->amount;
+    PPValuesBasePrivate::readInt(stream, &d->paymentMode);
+    PPValuesBasePrivate::readInt(stream, &d->reasonCode);
+    PPValuesBasePrivate::readInt(stream, &d->protectionEligibility);
+    stream >> d->parentPayment
+           >> d->invoiceNumber
+           >> d->saleId
+           >> d->captureId
+           >> d->transactionFee
+           >> d->createTime
+           >> d->updateTime
+           >> d->links
+           >> d->purchaseUnitReferenceId
+           >> d->referenceId;
+
+    qint32 petCount = 0;
+    stream >> petCount;
+    d->protectionEligibilityType.clear();
+    for (qint32 i = 0; i < petCount && stream.status() == QDataStream::Ok; ++i) {
+        PayPal::ProtectionEligibilityType pet;
+        PPValuesBasePrivate::readInt(stream, &pet);
+        d->protectionEligibilityType.append(pet);
+    }
+
+    stream >> d->clearingTime;
+    PPValuesBasePrivate::readInt(stream, &d->paymentHoldStatus);
+    stream >> d->paymentHoldReasons
+           >> d->receivableAmount
+           >> d->exchangeRate;
+    PPValuesBasePrivate::readInt(stream, &d->fmfFilterType);
+    PPValuesBasePrivate::readInt(stream, &d->fmfFilterId);
+    stream >> d->fmfName
+           >> d->fmfDescription
+           >> d->receiptId
+           >> d->processorResponseCode
+           >> d->processorAvsCode
+           >> d->processorCvvCode;
+    PPValuesBasePrivate::readInt(stream, &d->processorAdviceCode);
+    stream >> d->processorEciSubmitted
+           >> d->processorVpas
+           >> d->billingAgreementId
+           >> d->validUntil
+           >> d->isFinalCapture
+           >> d->reason
+           >> d->description;
+
+    return stream;
+}
@@ -0,0 +1,241 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/relatedresourcevalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RELATEDRESOURCEVALUE_H
+#define RELATEDRESOURCEVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QDateTime>
+#include <QList>
+#include <QStringList>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/ppenums.h>
+#include <Geltan/PP/Objects/sale.h>
+#include <Geltan/PP/Objects/fmfdetails.h>
+#include <Geltan/PP/Objects/processorresponse.h>
+#include <Geltan/PP/Values/paymentamountvalue.h>
+#include <Geltan/PP/Values/linkvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class RelatedResourceValueData;
+
+/*!
+ * \brief Implicitly shared value type containing a resource related to a transaction.
+ *
+ * A related resource is a sale, an authorization, an order, a capture or a refund. Other than Related, which
+ * contains one QObject for every possible type, this value holds the members of the single resource that is
+ * set, the type() tells which one it is. Members that are not available for a type stay empty. The members of
+ * the fmf_details and processor_response objects are flattened into this value.
+ *
+ * \sa Related, Sale, Authorization, Order, Capture, Refund
+ *
+ * \headerfile "" <Geltan/PP/Values/relatedresourcevalue.h>
+ */
+class GELTANSHARED_EXPORT RelatedResourceValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty RelatedResourceValue.
+     */
+    RelatedResourceValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    RelatedResourceValue(const RelatedResourceValue &other);
+
+    /*!
+     * \brief Deconstructs the RelatedResourceValue.
+     */
+    ~RelatedResourceValue();
+
+    /*!
+     * \brief Assigns \a other to this RelatedResourceValue.
+     */
+    RelatedResourceValue &operator=(const RelatedResourceValue &other);
+
+    /*!
+     * \brief The type of the related resource.
+     */
+    enum Type {
+        NoType          = 0,    /**< No related resource set. */
+        Sale            = 1,    /**< The resource is a sale. */
+        Authorization   = 2,    /**< The resource is an authorization. */
+        Order           = 3,    /**< The resource is an order. */
+        Capture         = 4,    /**< The resource is a capture. */
+        Refund          = 5     /**< The resource is a refund. */
+    };
+
+    /*!
+     * \brief Creates a new RelatedResourceValue from JSON data.
+     *
+     * \a json has to be the related resource object as found in the related_resources array,
+     * containing one key named after the resource type.
+     */
+    static RelatedResourceValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new RelatedResourceValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static RelatedResourceValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the related resource data, including the read only members.
+     *
+     * The returned object has the same layout as the objects in the related_resources array,
+     * the resource data is nested into a key named after the resource type.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if no type is set.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns the creation time as milliseconds since the epoch in UTC, or PPTimestamp::Invalid if it is not set.
+     *
+     * Other than createTime() this does not create a QDateTime, use it for sorting and comparing large numbers of values.
+     */
+    qint64 createTimeMSecs() const;
+
+    /*!
+     * \brief Returns the update time as milliseconds since the epoch in UTC, or PPTimestamp::Invalid if it is not set.
+     *
+     * \sa createTimeMSecs()
+     */
+    qint64 updateTimeMSecs() const;
+
+    Type type() const;
+    QString id() const;
+    PayPal::StateType state() const;
+    PaymentAmountValue amount() const;
+    PayPal::PaymentModeType paymentMode() const;
+    PayPal::ReasonCode reasonCode() const;
+    PayPal::ProtectionEligibility protectionEligibility() const;
+    QString parentPayment() const;
+    QString invoiceNumber() const;
+    QString saleId() const;
+    QString captureId() const;
+    PaymentAmountValue transactionFee() const;
+    QDateTime createTime() const;
+    QDateTime updateTime() const;
+    QList<LinkValue> links() const;
+    QString purchaseUnitReferenceId() const;
+    QString referenceId() const;
+    QList<PayPal::ProtectionEligibilityType> protectionEligibilityType() const;
+    QDateTime clearingTime() const;
+    Geltan::PP::Sale::PaymentHoldStatus paymentHoldStatus() const;
+    QStringList paymentHoldReasons() const;
+    PaymentAmountValue receivableAmount() const;
+    float exchangeRate() const;
+    FMFDetails::FilterType fmfFilterType() const;
+    FMFDetails::FilterIdentifier fmfFilterId() const;
+    QString fmfName() const;
+    QString fmfDescription() const;
+    QString receiptId() const;
+    QString processorResponseCode() const;
+    QString processorAvsCode() const;
+    QString processorCvvCode() const;
+    ProcessorResponse::AdviceCode processorAdviceCode() const;
+    QString processorEciSubmitted() const;
+    QString processorVpas() const;
+    QString billingAgreementId() const;
+    QDateTime validUntil() const;
+    bool isFinalCapture() const;
+    QString reason() const;
+    QString description() const;
+
+    void setType(Type nType);
+    void setId(const QString &nId);
+    void setState(PayPal::StateType nState);
+    void setAmount(const PaymentAmountValue &nAmount);
+    void setPaymentMode(PayPal::PaymentModeType nPaymentMode);
+    void setReasonCode(PayPal::ReasonCode nReasonCode);
+    void setProtectionEligibility(PayPal::ProtectionEligibility nProtectionEligibility);
+    void setParentPayment(const QString &nParentPayment);
+    void setInvoiceNumber(const QString &nInvoiceNumber);
+    void setSaleId(const QString &nSaleId);
+    void setCaptureId(const QString &nCaptureId);
+    void setTransactionFee(const PaymentAmountValue &nTransactionFee);
+    void setCreateTime(const QDateTime &nCreateTime);
+    void setUpdateTime(const QDateTime &nUpdateTime);
+    void setLinks(const QList<LinkValue> &nLinks);
+    void setPurchaseUnitReferenceId(const QString &nPurchaseUnitReferenceId);
+    void setReferenceId(const QString &nReferenceId);
+    void setProtectionEligibilityType(const QList<PayPal::ProtectionEligibilityType> &nProtectionEligibilityType);
+    void setClearingTime(const QDateTime &nClearingTime);
+    void setPaymentHoldStatus(Geltan::PP::Sale::PaymentHoldStatus nPaymentHoldStatus);
+    void setPaymentHoldReasons(const QStringList &nPaymentHoldReasons);
+    void setReceivableAmount(const PaymentAmountValue &nReceivableAmount);
+    void setExchangeRate(float nExchangeRate);
+    void setFmfFilterType(FMFDetails::FilterType nFmfFilterType);
+    void setFmfFilterId(FMFDetails::FilterIdentifier nFmfFilterId);
+    void setFmfName(const QString &nFmfName);
+    void setFmfDescription(const QString &nFmfDescription);
+    void setReceiptId(const QString &nReceiptId);
+    void setProcessorResponseCode(const QString &nProcessorResponseCode);
+    void setProcessorAvsCode(const QString &nProcessorAvsCode);
+    void setProcessorCvvCode(const QString &nProcessorCvvCode);
+    void setProcessorAdviceCode(ProcessorResponse::AdviceCode nProcessorAdviceCode);
+    void setProcessorEciSubmitted(const QString &nProcessorEciSubmitted);
+    void setProcessorVpas(const QString &nProcessorVpas);
+    void setBillingAgreementId(const QString &nBillingAgreementId);
+    void setValidUntil(const QDateTime &nValidUntil);
+    void setIsFinalCapture(bool nIsFinalCapture);
+    void setReason(const QString &nReason);
+    void setDescription(const QString &nDescription);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const RelatedResourceValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, RelatedResourceValue &value);
+
+    QSharedDataPointer<RelatedResourceValueData> d;
+};
+
+/*!
+ * \relates RelatedResourceValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const RelatedResourceValue &value);
+
+/*!
+ * \relates RelatedResourceValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, RelatedResourceValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::RelatedResourceValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::RelatedResourceValue)
+
+#endif // RELATEDRESOURCEVALUE_H
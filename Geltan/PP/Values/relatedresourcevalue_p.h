@@ -0,0 +1,143 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/relatedresourcevalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RELATEDRESOURCEVALUE_P_H
+#define RELATEDRESOURCEVALUE_P_H
+
+#include "relatedresourcevalue.h"
+#include <Geltan/PP/ppenums.h>
+#include <QSharedData>
+#include <Geltan/PP/pptimestamp.h>
+
+namespace Geltan {
+namespace PP {
+
+class RelatedResourceValueData : public QSharedData
+{
+public:
+    RelatedResourceValueData() :
+        type(RelatedResourceValue::NoType),
+        state(PayPal::NoState),
+        paymentMode(PayPal::NoPaymentMode),
+        reasonCode(PayPal::NoReasonCode),
+        protectionEligibility(PayPal::NoProtectionEligibility),
+        createTime(PPTimestamp::Invalid),
+        updateTime(PPTimestamp::Invalid),
+        clearingTime(PPTimestamp::Invalid),
+        paymentHoldStatus(Sale::NO_PAYMENT_HOLD_STATUS),
+        exchangeRate(0.0f),
+        fmfFilterType(FMFDetails::NO_FILTER_TYP),
+        fmfFilterId(FMFDetails::NO_FILTER_IDENTIFIER),
+        processorAdviceCode(ProcessorResponse::NoAdviceCode),
+        validUntil(PPTimestamp::Invalid),
+        isFinalCapture(false)
+    {}
+
+    RelatedResourceValueData(const RelatedResourceValueData &other) :
+        QSharedData(other),
+        type(other.type),
+        id(other.id),
+        state(other.state),
+        amount(other.amount),
+        paymentMode(other.paymentMode),
+        reasonCode(other.reasonCode),
+        protectionEligibility(other.protectionEligibility),
+        parentPayment(other.parentPayment),
+        invoiceNumber(other.invoiceNumber),
+        saleId(other.saleId),
+        captureId(other.captureId),
+        transactionFee(other.transactionFee),
+        createTime(other.createTime),
+        updateTime(other.updateTime),
+        links(other.links),
+        purchaseUnitReferenceId(other.purchaseUnitReferenceId),
+        referenceId(other.referenceId),
+        protectionEligibilityType(other.protectionEligibilityType),
+        clearingTime(other.clearingTime),
+        paymentHoldStatus(other.paymentHoldStatus),
+        paymentHoldReasons(other.paymentHoldReasons),
+        receivableAmount(other.receivableAmount),
+        exchangeRate(other.exchangeRate),
+        fmfFilterType(other.fmfFilterType),
+        fmfFilterId(other.fmfFilterId),
+        fmfName(other.fmfName),
+        fmfDescription(other.fmfDescription),
+        receiptId(other.receiptId),
+        processorResponseCode(other.processorResponseCode),
+        processorAvsCode(other.processorAvsCode),
+        processorCvvCode(other.processorCvvCode),
+        processorAdviceCode(other.processorAdviceCode),
+        processorEciSubmitted(other.processorEciSubmitted),
+        processorVpas(other.processorVpas),
+        billingAgreementId(other.billingAgreementId),
+        validUntil(other.validUntil),
+        isFinalCapture(other.isFinalCapture),
+        reason(other.reason),
+        description(other.description)
+    {}
+
+    ~RelatedResourceValueData() {}
+
+    RelatedResourceValue::Type type;
+    QString id;
+    PayPal::StateType state;
+    PaymentAmountValue amount;
+    PayPal::PaymentModeType paymentMode;
+    PayPal::ReasonCode reasonCode;
+    PayPal::ProtectionEligibility protectionEligibility;
+    QString parentPayment;
+    QString invoiceNumber;
+    QString saleId;
+    QString captureId;
+    PaymentAmountValue transactionFee;
+    qint64 createTime;     // msecs since epoch in UTC, the QDateTime is only created on access
+    qint64 updateTime;
+    QList<LinkValue> links;
+    QString purchaseUnitReferenceId;
+    QString referenceId;
+    QList<PayPal::ProtectionEligibilityType> protectionEligibilityType;
+    qint64 clearingTime;
+    Sale::PaymentHoldStatus paymentHoldStatus;
+    QStringList paymentHoldReasons;
+    PaymentAmountValue receivableAmount;
+    float exchangeRate;
+    FMFDetails::FilterType fmfFilterType;
+    FMFDetails::FilterIdentifier fmfFilterId;
+    QString fmfName;
+    QString fmfDescription;
+    QString receiptId;
+    QString processorResponseCode;
+    QString processorAvsCode;
+    QString processorCvvCode;
+    ProcessorResponse::AdviceCode processorAdviceCode;
+    QString processorEciSubmitted;
+    QString processorVpas;
+    QString billingAgreementId;
+    qint64 validUntil;
+    bool isFinalCapture;
+    QString reason;
+    QString description;
+};
+
+}
+}
+
+#endif // RELATEDRESOURCEVALUE_P_H
@@ -0,0 +1,334 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/transactionvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "transactionvalue_p.h"
+#include "ppvaluesbase_p.h"
+#include "ppvaluefields_p.h"
+#include <QJsonArray>
+
+using namespace Geltan;
+using namespace PP;
+
+static const PPEnumToken allowedPaymentMethodTokens[] = {
+    {"UNRESTRICTED", PaymentOptions::Unrestricted},
+    {"INSTANT_FUNDING_SOURCE", PaymentOptions::InstantFundingSource},
+    {"IMMEDIATE_PAY", PaymentOptions::ImmediatePay},
+    {nullptr, 0}
+};
+
+TransactionValue::TransactionValue() :
+    d(new TransactionValueData)
+{
+}
+
+
+TransactionValue::TransactionValue(const TransactionValue &other) :
+    d(other.d)
+{
+}
+
+
+TransactionValue::~TransactionValue()
+{
+}
+
+
+TransactionValue &TransactionValue::operator=(const TransactionValue &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+QString TransactionValue::referenceId() const { return d->referenceId; }
+
+void TransactionValue::setReferenceId(const QString &nReferenceId) { d->referenceId = nReferenceId; }
+
+
+PaymentAmountValue TransactionValue::amount() const { return d->amount; }
+
+void TransactionValue::setAmount(const PaymentAmountValue &nAmount) { d->amount = nAmount; }
+
+
+QString TransactionValue::description() const { return d->description; }
+
+void TransactionValue::setDescription(const QString &nDescription) { d->description = nDescription; }
+
+
+QString TransactionValue::noteToPayee() const { return d->noteToPayee; }
+
+void TransactionValue::setNoteToPayee(const QString &nNoteToPayee) { d->noteToPayee = nNoteToPayee; }
+
+
+QString TransactionValue::custom() const { return d->custom; }
+
+void TransactionValue::setCustom(const QString &nCustom) { d->custom = nCustom; }
+
+
+QString TransactionValue::invoiceNumber() const { return d->invoiceNumber; }
+
+void TransactionValue::setInvoiceNumber(const QString &nInvoiceNumber) { d->invoiceNumber = nInvoiceNumber; }
+
+
+QString TransactionValue::softDescriptor() const { return d->softDescriptor; }
+
+void TransactionValue::setSoftDescriptor(const QString &nSoftDescriptor) { d->softDescriptor = nSoftDescriptor; }
+
+
+QList<ItemValue> TransactionValue::items() const { return d->items; }
+
+void TransactionValue::setItems(const QList<ItemValue> &nItems) { d->items = nItems; }
+
+
+AddressValue TransactionValue::shippingAddress() const { return d->shippingAddress; }
+
+void TransactionValue::setShippingAddress(const AddressValue &nShippingAddress) { d->shippingAddress = nShippingAddress; }
+
+
+QString TransactionValue::shippingMethod() const { return d->shippingMethod; }
+
+void TransactionValue::setShippingMethod(const QString &nShippingMethod) { d->shippingMethod = nShippingMethod; }
+
+
+QString TransactionValue::shippingPhoneNumber() const { return d->shippingPhoneNumber; }
+
+void TransactionValue::setShippingPhoneNumber(const QString &nShippingPhoneNumber) { d->shippingPhoneNumber = nShippingPhoneNumber; }
+
+
+QUrl TransactionValue::notifyUrl() const { return d->notifyUrl; }
+
+void TransactionValue::setNotifyUrl(const QUrl &nNotifyUrl) { d->notifyUrl = nNotifyUrl; }
+
+
+QUrl TransactionValue::orderUrl() const { return d->orderUrl; }
+
+void TransactionValue::setOrderUrl(const QUrl &nOrderUrl) { d->orderUrl = nOrderUrl; }
+
+
+QList<RelatedResourceValue> TransactionValue::relatedResources() const { return d->relatedResources; }
+
+void TransactionValue::setRelatedResources(const QList<RelatedResourceValue> &nRelatedResources) { d->relatedResources = nRelatedResources; }
+
+
+QString TransactionValue::payeeEmail() const { return d->payeeEmail; }
+
+void TransactionValue::setPayeeEmail(const QString &nPayeeEmail) { d->payeeEmail = nPayeeEmail; }
+
+
+QString TransactionValue::payeeMerchantId() const { return d->payeeMerchantId; }
+
+void TransactionValue::setPayeeMerchantId(const QString &nPayeeMerchantId) { d->payeeMerchantId = nPayeeMerchantId; }
+
+
+PaymentOptions::AllowedPaymentMethodType TransactionValue::allowedPaymentMethod() const { return d->allowedPaymentMethod; }
+
+void TransactionValue::setAllowedPaymentMethod(PaymentOptions::AllowedPaymentMethodType nAllowedPaymentMethod) { d->allowedPaymentMethod = nAllowedPaymentMethod; }
+
+
+
+
+TransactionValue TransactionValue::fromJson(const QJsonObject &json)
+{
+    return fromJson(PPJsonValue(json));
+}
+
+
+TransactionValue TransactionValue::fromJson(const PPJsonValue &json)
+{
+    TransactionValue v;
+
+    if (json.isEmpty()) {
+        return v;
+    }
+
+    TransactionValueData *d = v.d.data();
+
+    d->referenceId = json.value(QLatin1String("reference_id")).toString();
+    d->description = json.value(QLatin1String("description")).toString();
+    d->noteToPayee = json.value(QLatin1String("note_to_payee")).toString();
+    d->custom = json.value(QLatin1String("custom")).toString();
+    d->invoiceNumber = json.value(QLatin1String("invoice_number")).toString();
+    d->softDescriptor = json.value(QLatin1String("soft_descriptor")).toString();
+    d->amount = PaymentAmountValue::fromJson(json.value(QLatin1String("amount")).toObject());
+
+    const PPJsonValue poo = json.value(QLatin1String("payment_options")).toObject();
+    if (!poo.isEmpty()) {
+        d->allowedPaymentMethod = static_cast<PaymentOptions::AllowedPaymentMethodType>(ppEnumTokenToValue(allowedPaymentMethodTokens, poo.value(QLatin1String("allowed_payment_method")).toString()));
+    }
+
+    const PPJsonValue ilo = json.value(QLatin1String("item_list")).toObject();
+    if (!ilo.isEmpty()) {
+        const PPJsonValue ia = ilo.value(QLatin1String("items")).toArray();
+        if (!ia.isEmpty()) {
+            d->items.reserve(ia.count());
+            for (const PPJsonValue &i : ia) {
+                d->items.append(ItemValue::fromJson(i.toObject()));
+            }
+        }
+        d->shippingAddress = AddressValue::fromJson(ilo.value(QLatin1String("shipping_address")).toObject());
+        d->shippingMethod = ilo.value(QLatin1String("shipping_method")).toString();
+        d->shippingPhoneNumber = ilo.value(QLatin1String("shipping_phone_number")).toString();
+    }
+
+    const QString nu = json.value(QLatin1String("notify_url")).toString();
+    if (!nu.isEmpty()) {
+        d->notifyUrl = QUrl(nu);
+    }
+
+    const QString ou = json.value(QLatin1String("order_url")).toString();
+    if (!ou.isEmpty()) {
+        d->orderUrl = QUrl(ou);
+    }
+
+    const PPJsonValue rs = json.value(QLatin1String("related_resources")).toArray();
+    if (!rs.isEmpty()) {
+        d->relatedResources.reserve(rs.count());
+        for (const PPJsonValue &r : rs) {
+            d->relatedResources.append(RelatedResourceValue::fromJson(r.toObject()));
+        }
+    }
+
+    const PPJsonValue pyo = json.value(QLatin1String("payee")).toObject();
+    if (!pyo.isEmpty()) {
+        d->payeeEmail = pyo.value(QLatin1String("email")).toString();
+        d->payeeMerchantId = pyo.value(QLatin1String("merchant_id")).toString();
+    }
+
+    return v;
+}
+
+
+
+QJsonObject TransactionValue::toJsonObject() const
+{
+    QJsonObject json;
+
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("reference_id"), d->referenceId);
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("amount"), d->amount.toJsonObject());
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("description"), d->description);
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("note_to_payee"), d->noteToPayee);
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("custom"), d->custom);
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("invoice_number"), d->invoiceNumber);
+    PPValuesBasePrivate::insertString(&json, QStringLiteral("soft_descriptor"), d->softDescriptor);
+
+    QJsonObject poo;
+    PPValuesBasePrivate::insertString(&poo, QStringLiteral("allowed_payment_method"), ppEnumValueToToken(allowedPaymentMethodTokens, d->allowedPaymentMethod));
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("payment_options"), poo);
+
+    QJsonObject ilo;
+    if (!d->items.isEmpty()) {
+        QJsonArray ia;
+        for (const ItemValue &i : d->items) {
+            ia.append(i.toJsonObject());
+        }
+        ilo.insert(QStringLiteral("items"), ia);
+    }
+    PPValuesBasePrivate::insertObject(&ilo, QStringLiteral("shipping_address"), d->shippingAddress.toJsonObject());
+    PPValuesBasePrivate::insertString(&ilo, QStringLiteral("shipping_method"), d->shippingMethod);
+    PPValuesBasePrivate::insertString(&ilo, QStringLiteral("shipping_phone_number"), d->shippingPhoneNumber);
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("item_list"), ilo);
+
+    PPValuesBasePrivate::insertUrl(&json, QStringLiteral("notify_url"), d->notifyUrl);
+    PPValuesBasePrivate::insertUrl(&json, QStringLiteral("order_url"), d->orderUrl);
+
+    if (!d->relatedResources.isEmpty()) {
+        QJsonArray rs;
+        for (const RelatedResourceValue &r : d->relatedResources) {
+            rs.append(r.toJsonObject());
+        }
+        json.insert(QStringLiteral("related_resources"), rs);
+    }
+
+    QJsonObject pyo;
+    PPValuesBasePrivate::insertString(&pyo, QStringLiteral("email"), d->payeeEmail);
+    PPValuesBasePrivate::insertString(&pyo, QStringLiteral("merchant_id"), d->payeeMerchantId);
+    PPValuesBasePrivate::insertObject(&json, QStringLiteral("payee"), pyo);
+
+    return json;
+}
+
+
+
+bool TransactionValue::isEmpty() const
+{
+    return (d->referenceId.isEmpty() && d->amount.isEmpty() && d->description.isEmpty() && d->noteToPayee.isEmpty()
+            && d->custom.isEmpty() && d->invoiceNumber.isEmpty() && d->softDescriptor.isEmpty() && d->items.isEmpty()
+            && d->shippingAddress.isEmpty() && d->shippingMethod.isEmpty() && d->shippingPhoneNumber.isEmpty()
+            && d->notifyUrl.isEmpty() && d->orderUrl.isEmpty() && d->relatedResources.isEmpty()
+            && d->payeeEmail.isEmpty() && d->payeeMerchantId.isEmpty()
+            && d->allowedPaymentMethod == PaymentOptions::NoAllowedPaymentMethod);
+}
+
+
+
+
+QDataStream &Geltan::PP::operator<<(QDataStream &stream, const TransactionValue &value)
+{
+    const TransactionValueData *d = value.d.constData();
+
+    stream << d->referenceId
+           << d->amount
+           << d->description
+           << d->noteToPayee
+           << d->custom
+           << d->invoiceNumber
+           << d->softDescriptor
+           << d->items
+           << d->shippingAddress
+           << d->shippingMethod
+           << d->shippingPhoneNumber
+           << d->notifyUrl
+           << d->orderUrl
+           << d->relatedResources
+           << d->payeeEmail
+           << d->payeeMerchantId
+           << static_cast<qint32>(d->allowedPaymentMethod);
+
+    return stream;
+}
+
+
+
+QDataStream &Geltan::PP::operator>>(QDataStream &stream, TransactionValue &value)
+{
+    TransactionValueData *d = value.d.data();
+
+    stream >> d->referenceId
+           >> d->amount
+           >> d->description
+           >> d->noteToPayee
+           >> d->custom
+           >> d->invoiceNumber
+           >> d->softDescriptor
+           >> d->items
+           >> d->shippingAddress
+           >> d->shippingMethod
+           >> d->shippingPhoneNumber
+           >> d->notifyUrl
+           >> d->orderUrl
+           >> d->relatedResources
+           >> d->payeeEmail
+           >> d->payeeMerchantId;
+    PPValuesBasePrivate::readInt(stream, &d->allowedPaymentMethod);
+
+    return stream;
+}
@@ -0,0 +1,163 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/transactionvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSACTIONVALUE_H
+#define TRANSACTIONVALUE_H
+
+#include <QSharedDataPointer>
+#include <QJsonObject>
+#include <QDataStream>
+#include <QMetaType>
+#include <QUrl>
+#include <QList>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+#include <Geltan/PP/Objects/paymentoptions.h>
+#include <Geltan/PP/Values/paymentamountvalue.h>
+#include <Geltan/PP/Values/itemvalue.h>
+#include <Geltan/PP/Values/addressvalue.h>
+#include <Geltan/PP/Values/relatedresourcevalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class TransactionValueData;
+
+/*!
+ * \brief Implicitly shared value type containing the data of a transaction.
+ *
+ * Other than Transaction this is not a QObject, it is cheap to copy and can be passed between threads.
+ * The members of the payment_options, item_list and payee objects are flattened into this value.
+ *
+ * \sa Transaction, PaymentOptions, ItemList, Payee
+ *
+ * \headerfile "" <Geltan/PP/Values/transactionvalue.h>
+ */
+class GELTANSHARED_EXPORT TransactionValue
+{
+public:
+    /*!
+     * \brief Constructs a new empty TransactionValue.
+     */
+    TransactionValue();
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    TransactionValue(const TransactionValue &other);
+
+    /*!
+     * \brief Deconstructs the TransactionValue.
+     */
+    ~TransactionValue();
+
+    /*!
+     * \brief Assigns \a other to this TransactionValue.
+     */
+    TransactionValue &operator=(const TransactionValue &other);
+
+    /*!
+     * \brief Creates a new TransactionValue from JSON data.
+     */
+    static TransactionValue fromJson(const QJsonObject &json);
+
+    /*!
+     * \brief Creates a new TransactionValue from a value of a PPJsonDocument.
+     * \overload
+     */
+    static TransactionValue fromJson(const PPJsonValue &json);
+
+    /*!
+     * \brief Returns a QJsonObject containing the transaction data, including the read only members.
+     *
+     * The names of the keys will be the names used by the PayPal API.
+     */
+    QJsonObject toJsonObject() const;
+
+    /*!
+     * \brief Returns true if none of the data members has been set.
+     */
+    bool isEmpty() const;
+
+    QString referenceId() const;
+    PaymentAmountValue amount() const;
+    QString description() const;
+    QString noteToPayee() const;
+    QString custom() const;
+    QString invoiceNumber() const;
+    QString softDescriptor() const;
+    QList<ItemValue> items() const;
+    AddressValue shippingAddress() const;
+    QString shippingMethod() const;
+    QString shippingPhoneNumber() const;
+    QUrl notifyUrl() const;
+    QUrl orderUrl() const;
+    QList<RelatedResourceValue> relatedResources() const;
+    QString payeeEmail() const;
+    QString payeeMerchantId() const;
+    PaymentOptions::AllowedPaymentMethodType allowedPaymentMethod() const;
+
+    void setReferenceId(const QString &nReferenceId);
+    void setAmount(const PaymentAmountValue &nAmount);
+    void setDescription(const QString &nDescription);
+    void setNoteToPayee(const QString &nNoteToPayee);
+    void setCustom(const QString &nCustom);
+    void setInvoiceNumber(const QString &nInvoiceNumber);
+    void setSoftDescriptor(const QString &nSoftDescriptor);
+    void setItems(const QList<ItemValue> &nItems);
+    void setShippingAddress(const AddressValue &nShippingAddress);
+    void setShippingMethod(const QString &nShippingMethod);
+    void setShippingPhoneNumber(const QString &nShippingPhoneNumber);
+    void setNotifyUrl(const QUrl &nNotifyUrl);
+    void setOrderUrl(const QUrl &nOrderUrl);
+    void setRelatedResources(const QList<RelatedResourceValue> &nRelatedResources);
+    void setPayeeEmail(const QString &nPayeeEmail);
+    void setPayeeMerchantId(const QString &nPayeeMerchantId);
+    void setAllowedPaymentMethod(PaymentOptions::AllowedPaymentMethodType nAllowedPaymentMethod);
+
+private:
+    friend GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const TransactionValue &value);
+    friend GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, TransactionValue &value);
+
+    QSharedDataPointer<TransactionValueData> d;
+};
+
+/*!
+ * \relates TransactionValue
+ * \brief Writes \a value to the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator<<(QDataStream &stream, const TransactionValue &value);
+
+/*!
+ * \relates TransactionValue
+ * \brief Reads \a value from the \a stream in the format of PaymentSnapshot::Version.
+ */
+GELTANSHARED_EXPORT QDataStream &operator>>(QDataStream &stream, TransactionValue &value);
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::TransactionValue, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(Geltan::PP::TransactionValue)
+
+#endif // TRANSACTIONVALUE_H
@@ -0,0 +1,83 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/Values/transactionvalue_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSACTIONVALUE_P_H
+#define TRANSACTIONVALUE_P_H
+
+#include "transactionvalue.h"
+#include <QSharedData>
+
+namespace Geltan {
+namespace PP {
+
+class TransactionValueData : public QSharedData
+{
+public:
+    TransactionValueData() :
+        allowedPaymentMethod(PaymentOptions::NoAllowedPaymentMethod)
+    {}
+
+    TransactionValueData(const TransactionValueData &other) :
+        QSharedData(other),
+        referenceId(other.referenceId),
+        amount(other.amount),
+        description(other.description),
+        noteToPayee(other.noteToPayee),
+        custom(other.custom),
+        invoiceNumber(other.invoiceNumber),
+        softDescriptor(other.softDescriptor),
+        items(other.items),
+        shippingAddress(other.shippingAddress),
+        shippingMethod(other.shippingMethod),
+        shippingPhoneNumber(other.shippingPhoneNumber),
+        notifyUrl(other.notifyUrl),
+        orderUrl(other.orderUrl),
+        relatedResources(other.relatedResources),
+        payeeEmail(other.payeeEmail),
+        payeeMerchantId(other.payeeMerchantId),
+        allowedPaymentMethod(other.allowedPaymentMethod)
+    {}
+
+    ~TransactionValueData() {}
+
+    QString referenceId;
+    PaymentAmountValue amount;
+    QString description;
+    QString noteToPayee;
+    QString custom;
+    QString invoiceNumber;
+    QString softDescriptor;
+    QList<ItemValue> items;
+    AddressValue shippingAddress;
+    QString shippingMethod;
+    QString shippingPhoneNumber;
+    QUrl notifyUrl;
+    QUrl orderUrl;
+    QList<RelatedResourceValue> relatedResources;
+    QString payeeEmail;
+    QString payeeMerchantId;
+    PaymentOptions::AllowedPaymentMethodType allowedPaymentMethod;
+};
+
+}
+}
+
+#endif // TRANSACTIONVALUE_P_H
@@ -142,20 +142,20 @@ void PPBase::extractError(QNetworkReply *reply)
         int statusCode = vStatusCode.toInt();
         if ((statusCode >= 400 && statusCode <= 404) || (statusCode >= 500 && statusCode <= 511)) {
 
-            QJsonDocument json;
-            json = QJsonDocument::fromJson(result());
+            Q_D(PPBase);
+            const PPJsonDocument json = d->backend()->parse(result());
 
-            if (json.isNull() || !json.isObject()) {
+            if (!json.isObject()) {
 
                 setError(new Error(reply, this));
 
             } else {
 
-                QJsonObject jo = json.object();
-                QJsonValue jsonMessage = jo.value(QStringLiteral("message"));
-                QJsonValue jsonDetails = jo.value(QStringLiteral("details"));
+                const PPJsonValue jo = json.root();
+                const PPJsonValue jsonMessage = jo.value(QLatin1String("message"));
+                const PPJsonValue jsonDetails = jo.value(QLatin1String("details"));
 
-                if (!jsonMessage.isNull() && jsonMessage.isString()) {
+                if (jsonMessage.isString()) {
                     setError(new Error(Error::RequestError, jsonMessage.toString(), Error::Critical, jsonDetails.toString(), this));
                 } else {
                     setError(new Error(reply, this));
@@ -178,21 +178,23 @@ bool PPBase::checkOutput()
 {
     setJsonResult();
 
-    if (jsonResult().isNull() && !(expectedType() == Empty)) {
-        setError(new Error(Error::JSONParsingError, tr("Failed to parse network reply JSON data."), Error::Critical, QString(), this));
+    Q_D(PPBase);
+
+    if (d->json.isNull() && !(expectedType() == Empty)) {
+        setError(new Error(Error::JSONParsingError, tr("Failed to parse network reply JSON data."), Error::Critical, d->jsonError, this));
         return false;
-    } else if (jsonResult().isNull() && expectedType() == Empty) {
+    } else if (d->json.isNull() && expectedType() == Empty) {
         return true;
     } else {
         if (expectedType() == Array) {
-            if (jsonResult().isArray()) {
+            if (d->json.isArray()) {
                 return true;
             } else {
                 setError(new Error(Error::OutputError, tr("It was expected to retrieve a JSON array. The result data does not contain an array."), Error::Warning, QString(), this));
                 return false;
             }
         } else {
-            if (jsonResult().isObject()) {
+            if (d->json.isObject()) {
                 return true;
             } else {
                 setError(new Error(Error::OutputError, tr("It was expected to retrieve a JSON object. The result data does not contain an object."), Error::Warning, QString(), this));
@@ -208,28 +210,47 @@ bool PPBase::checkOutput()
 QJsonDocument PPBase::jsonResult() const
 {
     Q_D(const PPBase);
+    if (!d->jsonResultValid) {
+        d->jsonResult = d->json.toJsonDocument();
+        d->jsonResultValid = true;
+    }
     return d->jsonResult;
 }
 
 
+PPJsonDocument PPBase::jsonData() const
+{
+    Q_D(const PPBase);
+    return d->json;
+}
+
+
 void PPBase::setJsonResult()
 {
-    Q_D(PPBase);
-    d->jsonResult = QJsonDocument::fromJson(result());
+    setJsonResult(result());
 }
 
 
 void PPBase::setJsonResult(const QJsonDocument &nJsonResult)
 {
     Q_D(PPBase);
+    d->json = PPJsonDocument(nJsonResult);
     d->jsonResult = nJsonResult;
+    d->jsonResultValid = true;
+    d->jsonError.clear();
 }
 
 
 void PPBase::setJsonResult(const QByteArray &nJsonResult)
 {
     Q_D(PPBase);
-    d->jsonResult = QJsonDocument::fromJson(nJsonResult);
+    d->jsonError.clear();
+    d->json = d->backend()->parse(nJsonResult, &d->jsonError);
+    d->jsonResult = QJsonDocument();
+    d->jsonResultValid = !d->json.isIndexed();
+    if (d->jsonResultValid) {
+        d->jsonResult = d->json.toJsonDocument();
+    }
 }
 
 
@@ -259,3 +280,16 @@ void PPBase::setTokenType(PayPal::TokenType nTokenType)
     qDebug() << " Set tokenType to" << d->tokenType;
 #endif
 }
+
+
+
+PPJsonBackend *PPBase::jsonBackend() const { Q_D(const PPBase); return d->backend(); }
+
+void PPBase::setJsonBackend(PPJsonBackend *backend)
+{
+    Q_D(PPBase);
+    d->jsonBackend = backend;
+#ifdef QT_DEBUG
+    qDebug() << "Set jsonBackend to" << d->jsonBackend;
+#endif
+}
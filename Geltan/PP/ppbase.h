@@ -25,6 +25,7 @@
 #include <Geltan/geltan_global.h>
 #include <Geltan/PP/ppenums.h>
 #include <Geltan/component.h>
+#include <Geltan/PP/ppjsondocument.h>
 
 
 namespace Geltan {
@@ -32,6 +33,7 @@ namespace Geltan {
 namespace PP {
 
 class PPBasePrivate;
+class PPJsonBackend;
 
 
 /*!
@@ -131,6 +133,23 @@ public:
      */
     PayPal::TokenType tokenType() const;
 
+    /*!
+     * \brief Sets the backend used to parse the reply data.
+     *
+     * The backend is not owned by this object. If no backend is set or \a backend is a \c nullptr,
+     * PPJsonBackend::defaultBackend() will be used.
+     *
+     * \sa jsonBackend()
+     */
+    void setJsonBackend(PPJsonBackend *backend);
+
+    /*!
+     * \brief Returns the backend used to parse the reply data.
+     *
+     * \sa setJsonBackend()
+     */
+    PPJsonBackend *jsonBackend() const;
+
 protected:
     /*!
      * \brief Generates the value for the authentication header.
@@ -174,13 +193,28 @@ protected:
     /*!
      * \brief Returns the current API reply data as JSON document.
      *
+     * If the jsonBackend() created an on-demand index, the QJsonDocument is created from the reply data
+     * on the first call. Use jsonData() to read the reply without that.
+     *
      * \sa setJsonResult()
      */
     QJsonDocument jsonResult() const;
 
+    /*!
+     * \brief Returns the current API reply data as parsed by the jsonBackend().
+     *
+     * The values returned by PPJsonDocument::root() can be passed to the loadFromJson() functions of
+     * the objects, they will not create a QJsonDocument.
+     *
+     * \sa setJsonResult()
+     */
+    PPJsonDocument jsonData() const;
+
     /*!
      * \brief Sets the API reply JSON document data from the return value of result().
      *
+     * The data is parsed by the jsonBackend().
+     *
      * \sa jsonResult()
      */
     void setJsonResult();
@@ -195,6 +229,8 @@ protected:
     /*!
      * \brief Sets the API reply JSON docment data from the network reply data.
      *
+     * The data is parsed by the jsonBackend().
+     *
      * \sa jsonResult()
      */
     void setJsonResult(const QByteArray &nJsonResult);
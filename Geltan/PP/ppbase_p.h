@@ -27,6 +27,7 @@
 #include <QtCore/qstring.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qjsondocument.h>
+#include "ppjsonbackend.h"
 
 namespace Geltan {
 
@@ -36,15 +37,26 @@ class PPBasePrivate : public ComponentPrivate {
 public:
     PPBasePrivate() :
         expectedType(PPBase::Empty),
-        tokenType(PayPal::NoTokenType)
+        tokenType(PayPal::NoTokenType),
+        jsonBackend(nullptr),
+        jsonResultValid(true)
     {}
 
+    PPJsonBackend *backend() const
+    {
+        return jsonBackend ? jsonBackend : PPJsonBackend::defaultBackend();
+    }
+
     QString clientID;
     QString secret;
     QString token;
-    QJsonDocument jsonResult;
+    PPJsonDocument json;
+    mutable QJsonDocument jsonResult;
+    QString jsonError;
     PPBase::ExpectedJSONType expectedType;
     PayPal::TokenType tokenType;
+    PPJsonBackend *jsonBackend;
+    mutable bool jsonResultValid;
 };
 
 }
@@ -20,6 +20,7 @@
  */
 
 #include "ppenumsmap.h"
+#include "pptokenhash_p.h"
 
 using namespace Geltan;
 using namespace PP;
@@ -31,28 +32,29 @@ PPEnumsMap::PPEnumsMap()
 
 
 
-PayPal::PaymentMethod PPEnumsMap::paymentMethodTokenToEnum(const QString &token) const
+PayPal::PaymentMethod PPEnumsMap::paymentMethodTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("credit_card")) {
-        return PayPal::CreditCard;
-    } else if (token == QLatin1String("bank")) {
-        return PayPal::Bank;
-    } else if (token == QLatin1String("paypal")) {
-        return PayPal::PayPalWallet;
-    } else if (token == QLatin1String("pay_upon_invoice")) {
-        return PayPal::PayUponInvoice;
-    } else if (token == QLatin1String("carrier")) {
-        return PayPal::Carrier;
-    } else if (token == QLatin1String("alternate_payment")) {
-        return PayPal::AlternatePayment;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("credit_card"):
+        return ppTokenCheck(token, "credit_card", PayPal::CreditCard, PayPal::NoPaymentMethod);
+    case ppTokenHash("bank"):
+        return ppTokenCheck(token, "bank", PayPal::Bank, PayPal::NoPaymentMethod);
+    case ppTokenHash("paypal"):
+        return ppTokenCheck(token, "paypal", PayPal::PayPalWallet, PayPal::NoPaymentMethod);
+    case ppTokenHash("pay_upon_invoice"):
+        return ppTokenCheck(token, "pay_upon_invoice", PayPal::PayUponInvoice, PayPal::NoPaymentMethod);
+    case ppTokenHash("carrier"):
+        return ppTokenCheck(token, "carrier", PayPal::Carrier, PayPal::NoPaymentMethod);
+    case ppTokenHash("alternate_payment"):
+        return ppTokenCheck(token, "alternate_payment", PayPal::AlternatePayment, PayPal::NoPaymentMethod);
+    default:
         return PayPal::NoPaymentMethod;
     }
 }
 
 
 
-QString PPEnumsMap::paymentMethodEnumToToken(PayPal::PaymentMethod enumeration) const
+QString PPEnumsMap::paymentMethodEnumToToken(PayPal::PaymentMethod enumeration)
 {
     switch(enumeration) {
     case PayPal::CreditCard:
@@ -74,24 +76,25 @@ QString PPEnumsMap::paymentMethodEnumToToken(PayPal::PaymentMethod enumeration)
 
 
 
-PayPal::CreditCardType PPEnumsMap::creditCardTypeTokenToEnum(const QString &token) const
+PayPal::CreditCardType PPEnumsMap::creditCardTypeTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("visa")) {
-        return PayPal::Visa;
-    } else if (token == QLatin1String("mastercard")) {
-        return PayPal::MasterCard;
-    } else if (token == QLatin1String("discover")) {
-        return PayPal::Discover;
-    } else if (token == QLatin1String("amex")) {
-        return PayPal::Amex;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("visa"):
+        return ppTokenCheck(token, "visa", PayPal::Visa, PayPal::NoCreditCardType);
+    case ppTokenHash("mastercard"):
+        return ppTokenCheck(token, "mastercard", PayPal::MasterCard, PayPal::NoCreditCardType);
+    case ppTokenHash("discover"):
+        return ppTokenCheck(token, "discover", PayPal::Discover, PayPal::NoCreditCardType);
+    case ppTokenHash("amex"):
+        return ppTokenCheck(token, "amex", PayPal::Amex, PayPal::NoCreditCardType);
+    default:
         return PayPal::NoCreditCardType;
     }
 }
 
 
 
-QString PPEnumsMap::creditCardTypeEnumToToken(PayPal::CreditCardType enumeration) const
+QString PPEnumsMap::creditCardTypeEnumToToken(PayPal::CreditCardType enumeration)
 {
     switch(enumeration) {
     case PayPal::Visa:
@@ -109,23 +112,25 @@ QString PPEnumsMap::creditCardTypeEnumToToken(PayPal::CreditCardType enumeration
 
 
 
-PayPal::PaymentModeType PPEnumsMap::paymentModeTypeTokenToEnum(const QString &token) const
+PayPal::PaymentModeType PPEnumsMap::paymentModeTypeTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("INSTANT_TRANSFER")) {
-        return PayPal::InstantTransfer;
-    } else if (token == QLatin1String("MANUAL_BANK_TRANSFER")) {
-        return PayPal::ManualBankTransfer;
-    } else if (token == QLatin1String("DELAYED_TRANSFER")) {
-        return PayPal::ManualBankTransfer;
-    } else if (token == QLatin1String("ECHECK")) {
-        return PayPal::ManualBankTransfer;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("INSTANT_TRANSFER"):
+        return ppTokenCheck(token, "INSTANT_TRANSFER", PayPal::InstantTransfer, PayPal::NoPaymentMode);
+    case ppTokenHash("MANUAL_BANK_TRANSFER"):
+        return ppTokenCheck(token, "MANUAL_BANK_TRANSFER", PayPal::ManualBankTransfer, PayPal::NoPaymentMode);
+    case ppTokenHash("DELAYED_TRANSFER"):
+        return ppTokenCheck(token, "DELAYED_TRANSFER", PayPal::DelayedTransfer, PayPal::NoPaymentMode);
+    case ppTokenHash("ECHECK"):
+        return ppTokenCheck(token, "ECHECK", PayPal::Echeck, PayPal::NoPaymentMode);
+    default:
         return PayPal::NoPaymentMode;
     }
 }
 
 
-QString PPEnumsMap::paymentModeTypeEnumToToken(PayPal::PaymentModeType enumeration) const
+
+QString PPEnumsMap::paymentModeTypeEnumToToken(PayPal::PaymentModeType enumeration)
 {
     switch(enumeration) {
     case PayPal::InstantTransfer:
@@ -143,38 +148,39 @@ QString PPEnumsMap::paymentModeTypeEnumToToken(PayPal::PaymentModeType enumerati
 
 
 
-PayPal::StateType PPEnumsMap::stateTypeTokenToEnum(const QString &token) const
+PayPal::StateType PPEnumsMap::stateTypeTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("pending")) {
-        return PayPal::Pending;
-    } else if (token == QLatin1String("authorized")) {
-        return PayPal::Authorized;
-    } else if (token == QLatin1String("partially_captured")) {
-        return PayPal::PartiallyCaptured;
-    } else if (token == QLatin1String("captured")) {
-        return PayPal::Captured;
-    } else if (token == QLatin1String("expired")) {
-        return PayPal::Expired;
-    } else if (token == QLatin1String("voided")) {
-        return PayPal::Voided;
-    } else if (token == QLatin1String("completed")) {
-        return PayPal::Completed;
-    } else if (token == QLatin1String("partially_refunded")) {
-        return PayPal::PartiallyRefunded;
-    } else if (token == QLatin1String("refunded")) {
-        return PayPal::Refunded;
-    } else if (token == QLatin1String("denied")) {
-        return PayPal::Denied;
-    } else if (token == QLatin1String("failed")) {
-        return PayPal::Failed;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("pending"):
+        return ppTokenCheck(token, "pending", PayPal::Pending, PayPal::NoState);
+    case ppTokenHash("authorized"):
+        return ppTokenCheck(token, "authorized", PayPal::Authorized, PayPal::NoState);
+    case ppTokenHash("partially_captured"):
+        return ppTokenCheck(token, "partially_captured", PayPal::PartiallyCaptured, PayPal::NoState);
+    case ppTokenHash("captured"):
+        return ppTokenCheck(token, "captured", PayPal::Captured, PayPal::NoState);
+    case ppTokenHash("expired"):
+        return ppTokenCheck(token, "expired", PayPal::Expired, PayPal::NoState);
+    case ppTokenHash("voided"):
+        return ppTokenCheck(token, "voided", PayPal::Voided, PayPal::NoState);
+    case ppTokenHash("completed"):
+        return ppTokenCheck(token, "completed", PayPal::Completed, PayPal::NoState);
+    case ppTokenHash("partially_refunded"):
+        return ppTokenCheck(token, "partially_refunded", PayPal::PartiallyRefunded, PayPal::NoState);
+    case ppTokenHash("refunded"):
+        return ppTokenCheck(token, "refunded", PayPal::Refunded, PayPal::NoState);
+    case ppTokenHash("denied"):
+        return ppTokenCheck(token, "denied", PayPal::Denied, PayPal::NoState);
+    case ppTokenHash("failed"):
+        return ppTokenCheck(token, "failed", PayPal::Failed, PayPal::NoState);
+    default:
         return PayPal::NoState;
     }
 }
 
 
 
-QString PPEnumsMap::stateTypeEnumToToken(PayPal::StateType enumeration) const
+QString PPEnumsMap::stateTypeEnumToToken(PayPal::StateType enumeration)
 {
     switch(enumeration) {
     case PayPal::Pending:
@@ -206,52 +212,53 @@ QString PPEnumsMap::stateTypeEnumToToken(PayPal::StateType enumeration) const
 
 
 
-PayPal::ReasonCode PPEnumsMap::reasonCodeTokenToEnum(const QString &token) const
+PayPal::ReasonCode PPEnumsMap::reasonCodeTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("CHARGEBACK")) {
-        return PayPal::Chargeback;
-    } else if (token == QLatin1String("GUARANTEE")) {
-        return PayPal::Guarante;
-    } else if (token == QLatin1String("BUYER_COMPLAINT")) {
-        return PayPal::BuyerComplaint;
-    } else if (token == QLatin1String("REFUND")) {
-        return PayPal::Refund;
-    } else if (token == QLatin1String("UNCONFIRMED_SHIPPING_ADDRESS")) {
-        return PayPal::UnconfirmedShippingAddress;
-    } else if (token == QLatin1String("ECHECK")) {
-        return PayPal::EcheckReason;
-    } else if (token == QLatin1String("INTERNATIONAL_WITHDRAWAL")) {
-        return PayPal::InternationalWithdrawal;
-    } else if (token == QLatin1String("RECEIVING_PREFERENCE_MANDATES_MANUAL_ACTION")) {
-        return PayPal::ReceivingPreferenceMandatesManualAction;
-    } else if (token == QLatin1String("PAYMENT_REVIEW")) {
-        return PayPal::PaymentReview;
-    } else if (token == QLatin1String("REGULATORY_REVIEW")) {
-        return PayPal::RegulatoryReview;
-    } else if (token == QLatin1String("UNILATERAL")) {
-        return PayPal::Unilateral;
-    } else if (token == QLatin1String("VERIFICATION_REQUIRED")) {
-        return PayPal::VerificationRequired;
-    } else if (token == QLatin1String("TRANSACTION_APPROVED_AWAITING_FUNDING")) {
-        return PayPal::TransactionApprovedAwaitingFunding;
-    } else if (token == QLatin1String("PAYER_SHIPPING_UNCONFIRMED")) {
-        return PayPal::PayerShippingUnconfirmed;
-    } else if (token == QLatin1String("MULTI_CURRENCY")) {
-        return PayPal::MultiCurrency;
-    } else if (token == QLatin1String("RISK_REVIEW")) {
-        return PayPal::RiskReview;
-    } else if (token == QLatin1String("ORDER")) {
-        return PayPal::Order;
-    } else if (token == QLatin1String("OTHER")) {
-        return PayPal::Other;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("CHARGEBACK"):
+        return ppTokenCheck(token, "CHARGEBACK", PayPal::Chargeback, PayPal::NoReasonCode);
+    case ppTokenHash("GUARANTEE"):
+        return ppTokenCheck(token, "GUARANTEE", PayPal::Guarante, PayPal::NoReasonCode);
+    case ppTokenHash("BUYER_COMPLAINT"):
+        return ppTokenCheck(token, "BUYER_COMPLAINT", PayPal::BuyerComplaint, PayPal::NoReasonCode);
+    case ppTokenHash("REFUND"):
+        return ppTokenCheck(token, "REFUND", PayPal::Refund, PayPal::NoReasonCode);
+    case ppTokenHash("UNCONFIRMED_SHIPPING_ADDRESS"):
+        return ppTokenCheck(token, "UNCONFIRMED_SHIPPING_ADDRESS", PayPal::UnconfirmedShippingAddress, PayPal::NoReasonCode);
+    case ppTokenHash("ECHECK"):
+        return ppTokenCheck(token, "ECHECK", PayPal::EcheckReason, PayPal::NoReasonCode);
+    case ppTokenHash("INTERNATIONAL_WITHDRAWAL"):
+        return ppTokenCheck(token, "INTERNATIONAL_WITHDRAWAL", PayPal::InternationalWithdrawal, PayPal::NoReasonCode);
+    case ppTokenHash("RECEIVING_PREFERENCE_MANDATES_MANUAL_ACTION"):
+        return ppTokenCheck(token, "RECEIVING_PREFERENCE_MANDATES_MANUAL_ACTION", PayPal::ReceivingPreferenceMandatesManualAction, PayPal::NoReasonCode);
+    case ppTokenHash("PAYMENT_REVIEW"):
+        return ppTokenCheck(token, "PAYMENT_REVIEW", PayPal::PaymentReview, PayPal::NoReasonCode);
+    case ppTokenHash("REGULATORY_REVIEW"):
+        return ppTokenCheck(token, "REGULATORY_REVIEW", PayPal::RegulatoryReview, PayPal::NoReasonCode);
+    case ppTokenHash("UNILATERAL"):
+        return ppTokenCheck(token, "UNILATERAL", PayPal::Unilateral, PayPal::NoReasonCode);
+    case ppTokenHash("VERIFICATION_REQUIRED"):
+        return ppTokenCheck(token, "VERIFICATION_REQUIRED", PayPal::VerificationRequired, PayPal::NoReasonCode);
+    case ppTokenHash("TRANSACTION_APPROVED_AWAITING_FUNDING"):
+        return ppTokenCheck(token, "TRANSACTION_APPROVED_AWAITING_FUNDING", PayPal::TransactionApprovedAwaitingFunding, PayPal::NoReasonCode);
+    case ppTokenHash("PAYER_SHIPPING_UNCONFIRMED"):
+        return ppTokenCheck(token, "PAYER_SHIPPING_UNCONFIRMED", PayPal::PayerShippingUnconfirmed, PayPal::NoReasonCode);
+    case ppTokenHash("MULTI_CURRENCY"):
+        return ppTokenCheck(token, "MULTI_CURRENCY", PayPal::MultiCurrency, PayPal::NoReasonCode);
+    case ppTokenHash("RISK_REVIEW"):
+        return ppTokenCheck(token, "RISK_REVIEW", PayPal::RiskReview, PayPal::NoReasonCode);
+    case ppTokenHash("ORDER"):
+        return ppTokenCheck(token, "ORDER", PayPal::Order, PayPal::NoReasonCode);
+    case ppTokenHash("OTHER"):
+        return ppTokenCheck(token, "OTHER", PayPal::Other, PayPal::NoReasonCode);
+    default:
         return PayPal::NoReasonCode;
     }
 }
 
 
 
-QString PPEnumsMap::reasonCodeEnumToToken(PayPal::ReasonCode enumeration) const
+QString PPEnumsMap::reasonCodeEnumToToken(PayPal::ReasonCode enumeration)
 {
     switch(enumeration) {
     case PayPal::Chargeback:
@@ -297,22 +304,23 @@ QString PPEnumsMap::reasonCodeEnumToToken(PayPal::ReasonCode enumeration) const
 
 
 
-PayPal::ProtectionEligibility PPEnumsMap::protectionEligibilityTokenToEnum(const QString &token) const
+PayPal::ProtectionEligibility PPEnumsMap::protectionEligibilityTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("ELIGIBLE")) {
-        return PayPal::Eligible;
-    } else if (token == QLatin1String("PARTIALLY_ELIGIBLE")) {
-        return PayPal::PartiallyEligible;
-    } else if (token == QLatin1String("INELIGIBLE")) {
-        return PayPal::Ineligible;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("ELIGIBLE"):
+        return ppTokenCheck(token, "ELIGIBLE", PayPal::Eligible, PayPal::NoProtectionEligibility);
+    case ppTokenHash("PARTIALLY_ELIGIBLE"):
+        return ppTokenCheck(token, "PARTIALLY_ELIGIBLE", PayPal::PartiallyEligible, PayPal::NoProtectionEligibility);
+    case ppTokenHash("INELIGIBLE"):
+        return ppTokenCheck(token, "INELIGIBLE", PayPal::Ineligible, PayPal::NoProtectionEligibility);
+    default:
         return PayPal::NoProtectionEligibility;
     }
 }
 
 
 
-QString PPEnumsMap::protectionEligibilityEnumToToken(PayPal::ProtectionEligibility enumeration) const
+QString PPEnumsMap::protectionEligibilityEnumToToken(PayPal::ProtectionEligibility enumeration)
 {
     switch(enumeration) {
     case PayPal::Eligible:
@@ -328,20 +336,21 @@ QString PPEnumsMap::protectionEligibilityEnumToToken(PayPal::ProtectionEligibili
 
 
 
-PayPal::ProtectionEligibilityType PPEnumsMap::protectionEligibilityTypeTokenToEnum(const QString &token) const
+PayPal::ProtectionEligibilityType PPEnumsMap::protectionEligibilityTypeTokenToEnum(const QString &token)
 {
-    if (token == QLatin1String("ITEM_NOT_RECEIVED_ELIGIBLE")) {
-        return PayPal::ItemNotReceivedEligible;
-    } else if (token == QLatin1String("UNAUTHORIZED_PAYMENT_ELIGIBLE")) {
-        return PayPal::UnauthorizedPaymentEligible;
-    } else {
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("ITEM_NOT_RECEIVED_ELIGIBLE"):
+        return ppTokenCheck(token, "ITEM_NOT_RECEIVED_ELIGIBLE", PayPal::ItemNotReceivedEligible, PayPal::NoProtectionEligibilityType);
+    case ppTokenHash("UNAUTHORIZED_PAYMENT_ELIGIBLE"):
+        return ppTokenCheck(token, "UNAUTHORIZED_PAYMENT_ELIGIBLE", PayPal::UnauthorizedPaymentEligible, PayPal::NoProtectionEligibilityType);
+    default:
         return PayPal::NoProtectionEligibilityType;
     }
 }
 
 
 
-QString PPEnumsMap::protectionEligibilityTypeEnumToToken(PayPal::ProtectionEligibilityType enumeration) const
+QString PPEnumsMap::protectionEligibilityTypeEnumToToken(PayPal::ProtectionEligibilityType enumeration)
 {
     switch(enumeration) {
     case PayPal::ItemNotReceivedEligible:
@@ -352,3 +361,111 @@ QString PPEnumsMap::protectionEligibilityTypeEnumToToken(PayPal::ProtectionEligi
         return QString();
     }
 }
+
+
+
+Payment::Intent PPEnumsMap::paymentIntentTokenToEnum(const QString &token)
+{
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("sale"):
+        return ppTokenCheck(token, "sale", Payment::Sale, Payment::NoIntent);
+    case ppTokenHash("authorize"):
+        return ppTokenCheck(token, "authorize", Payment::Authorize, Payment::NoIntent);
+    case ppTokenHash("order"):
+        return ppTokenCheck(token, "order", Payment::Order, Payment::NoIntent);
+    default:
+        return Payment::NoIntent;
+    }
+}
+
+
+
+QString PPEnumsMap::paymentIntentEnumToToken(Payment::Intent enumeration)
+{
+    switch(enumeration) {
+    case Payment::Sale:
+        return QStringLiteral("sale");
+    case Payment::Authorize:
+        return QStringLiteral("authorize");
+    case Payment::Order:
+        return QStringLiteral("order");
+    default:
+        return QString();
+    }
+}
+
+
+
+Payment::State PPEnumsMap::paymentStateTokenToEnum(const QString &token)
+{
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("created"):
+        return ppTokenCheck(token, "created", Payment::Created, Payment::NoState);
+    case ppTokenHash("approved"):
+        return ppTokenCheck(token, "approved", Payment::Approved, Payment::NoState);
+    case ppTokenHash("failed"):
+        return ppTokenCheck(token, "failed", Payment::Failed, Payment::NoState);
+    default:
+        return Payment::NoState;
+    }
+}
+
+
+
+QString PPEnumsMap::paymentStateEnumToToken(Payment::State enumeration)
+{
+    switch(enumeration) {
+    case Payment::Created:
+        return QStringLiteral("created");
+    case Payment::Approved:
+        return QStringLiteral("approved");
+    case Payment::Failed:
+        return QStringLiteral("failed");
+    default:
+        return QString();
+    }
+}
+
+
+
+Payment::FailureReason PPEnumsMap::paymentFailureReasonTokenToEnum(const QString &token)
+{
+    switch(ppTokenHash(token)) {
+    case ppTokenHash("UNABLE_TO_COMPLETE_TRANSACTION"):
+        return ppTokenCheck(token, "UNABLE_TO_COMPLETE_TRANSACTION", Payment::UnableToCompleteTransaction, Payment::NoFailureReason);
+    case ppTokenHash("INVALID_PAYMENT_METHOD"):
+        return ppTokenCheck(token, "INVALID_PAYMENT_METHOD", Payment::InvalidPaymentMethod, Payment::NoFailureReason);
+    case ppTokenHash("PAYER_CANNOT_PAY"):
+        return ppTokenCheck(token, "PAYER_CANNOT_PAY", Payment::PayerCannotPay, Payment::NoFailureReason);
+    case ppTokenHash("CANNOT_PAY_THIS_PAYEE"):
+        return ppTokenCheck(token, "CANNOT_PAY_THIS_PAYEE", Payment::CannotPayThisPayee, Payment::NoFailureReason);
+    case ppTokenHash("REDIRECT_REQUIRED"):
+        return ppTokenCheck(token, "REDIRECT_REQUIRED", Payment::RedirectRequired, Payment::NoFailureReason);
+    case ppTokenHash("PAYEE_FILTER_RESTRICTIONS"):
+        return ppTokenCheck(token, "PAYEE_FILTER_RESTRICTIONS", Payment::PayeeFilterRestrictions, Payment::NoFailureReason);
+    default:
+        return Payment::NoFailureReason;
+    }
+}
+
+
+
+QString PPEnumsMap::paymentFailureReasonEnumToToken(Payment::FailureReason enumeration)
+{
+    switch(enumeration) {
+    case Payment::UnableToCompleteTransaction:
+        return QStringLiteral("UNABLE_TO_COMPLETE_TRANSACTION");
+    case Payment::InvalidPaymentMethod:
+        return QStringLiteral("INVALID_PAYMENT_METHOD");
+    case Payment::PayerCannotPay:
+        return QStringLiteral("PAYER_CANNOT_PAY");
+    case Payment::CannotPayThisPayee:
+        return QStringLiteral("CANNOT_PAY_THIS_PAYEE");
+    case Payment::RedirectRequired:
+        return QStringLiteral("REDIRECT_REQUIRED");
+    case Payment::PayeeFilterRestrictions:
+        return QStringLiteral("PAYEE_FILTER_RESTRICTIONS");
+    default:
+        return QString();
+    }
+}
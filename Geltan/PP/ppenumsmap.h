@@ -23,6 +23,7 @@
 #define PPENUMSMAP_H
 
 #include <Geltan/PP/ppenums.h>
+#include <Geltan/PP/Objects/payment.h>
 
 namespace Geltan {
 
@@ -30,6 +31,10 @@ namespace PP {
 
 /*!
  * \brief Helper class to convert JSON token strings into enumerations and vice versa.
+ *
+ * All conversion functions are static and do not allocate. Tokens are mapped to enumerations
+ * by switching over a compile time calculated hash of the known tokens, followed by a single
+ * verifying comparison. Tokens are case sensitive, like the value types compare them.
 
  * \headerfile "" <Geltan/PP/ppenumsmap.h>
  */
@@ -44,65 +49,92 @@ public:
     /*!
      * \brief Converts a string into PayPal::PaymentMethod.
      */
-    PayPal::PaymentMethod paymentMethodTokenToEnum(const QString &token) const;
+    static PayPal::PaymentMethod paymentMethodTokenToEnum(const QString &token);
     /*!
      * \brief Converts a PayPal::PaymentMethod into a string representation.
      */
-    QString paymentMethodEnumToToken(PayPal::PaymentMethod enumeration) const;
+    static QString paymentMethodEnumToToken(PayPal::PaymentMethod enumeration);
 
     /*!
      * \brief Converts a string into PayPal::CreditCardType.
      */
-    PayPal::CreditCardType creditCardTypeTokenToEnum(const QString &token) const;
+    static PayPal::CreditCardType creditCardTypeTokenToEnum(const QString &token);
     /*!
      * \brief Converts a PayPal::CreditCardType into a string representation.
      */
-    QString creditCardTypeEnumToToken(PayPal::CreditCardType enumeration) const;
+    static QString creditCardTypeEnumToToken(PayPal::CreditCardType enumeration);
 
     /*!
      * \brief Converts a string into PayPal::PaymentModeType.
      */
-    PayPal::PaymentModeType paymentModeTypeTokenToEnum(const QString &token) const;
+    static PayPal::PaymentModeType paymentModeTypeTokenToEnum(const QString &token);
     /*!
-     * \brief Conerts a PayPal::PaymentModeType into a string representation.
+     * \brief Converts a PayPal::PaymentModeType into a string representation.
      */
-    QString paymentModeTypeEnumToToken(PayPal::PaymentModeType enumeration) const;
+    static QString paymentModeTypeEnumToToken(PayPal::PaymentModeType enumeration);
 
     /*!
      * \brief Converts a string into PayPal::StateType.
      */
-    PayPal::StateType stateTypeTokenToEnum(const QString &token) const;
+    static PayPal::StateType stateTypeTokenToEnum(const QString &token);
     /*!
      * \brief Converts a PayPal::StateType into a string representation.
      */
-    QString stateTypeEnumToToken(PayPal::StateType enumeration) const;
+    static QString stateTypeEnumToToken(PayPal::StateType enumeration);
 
     /*!
      * \brief Converts a string into PayPal::ReasonCode.
      */
-    PayPal::ReasonCode reasonCodeTokenToEnum(const QString &token) const;
+    static PayPal::ReasonCode reasonCodeTokenToEnum(const QString &token);
     /*!
      * \brief Converts a PayPal::ReasonCode into a string representation.
      */
-    QString reasonCodeEnumToToken(PayPal::ReasonCode enumeration) const;
+    static QString reasonCodeEnumToToken(PayPal::ReasonCode enumeration);
 
     /*!
      * \brief Converts a string into PayPal::ProtectionEligibility.
      */
-    PayPal::ProtectionEligibility protectionEligibilityTokenToEnum(const QString &token) const;
+    static PayPal::ProtectionEligibility protectionEligibilityTokenToEnum(const QString &token);
     /*!
      * \brief Converts a PayPal::ProtectionEligibility into a string representation.
      */
-    QString protectionEligibilityEnumToToken(PayPal::ProtectionEligibility enumeration) const;
+    static QString protectionEligibilityEnumToToken(PayPal::ProtectionEligibility enumeration);
 
     /*!
      * \brief Converts a string into PayPal::ProtectionEligibilityType.
      */
-    PayPal::ProtectionEligibilityType protectionEligibilityTypeTokenToEnum(const QString &token) const;
+    static PayPal::ProtectionEligibilityType protectionEligibilityTypeTokenToEnum(const QString &token);
     /*!
      * \brief Converts a PayPal::ProtectionEligibilityType into a string representation.
      */
-    QString protectionEligibilityTypeEnumToToken(PayPal::ProtectionEligibilityType enumeration) const;
+    static QString protectionEligibilityTypeEnumToToken(PayPal::ProtectionEligibilityType enumeration);
+
+    /*!
+     * \brief Converts a string into Payment::Intent.
+     */
+    static Payment::Intent paymentIntentTokenToEnum(const QString &token);
+    /*!
+     * \brief Converts a Payment::Intent into a string representation.
+     */
+    static QString paymentIntentEnumToToken(Payment::Intent enumeration);
+
+    /*!
+     * \brief Converts a string into Payment::State.
+     */
+    static Payment::State paymentStateTokenToEnum(const QString &token);
+    /*!
+     * \brief Converts a Payment::State into a string representation.
+     */
+    static QString paymentStateEnumToToken(Payment::State enumeration);
+
+    /*!
+     * \brief Converts a string into Payment::FailureReason.
+     */
+    static Payment::FailureReason paymentFailureReasonTokenToEnum(const QString &token);
+    /*!
+     * \brief Converts a Payment::FailureReason into a string representation.
+     */
+    static QString paymentFailureReasonEnumToToken(Payment::FailureReason enumeration);
 };
 
 }
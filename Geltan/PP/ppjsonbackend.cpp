@@ -0,0 +1,75 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonbackend.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "ppjsonbackend.h"
+#include <QJsonDocument>
+#include <QAtomicPointer>
+
+using namespace Geltan;
+using namespace PP;
+
+static OnDemandJsonBackend builtInBackend;
+static QAtomicPointer<PPJsonBackend> customDefaultBackend;
+
+
+PPJsonBackend::~PPJsonBackend()
+{
+
+}
+
+
+
+PPJsonBackend *PPJsonBackend::defaultBackend()
+{
+    PPJsonBackend *b = customDefaultBackend.loadAcquire();
+    return b ? b : &builtInBackend;
+}
+
+
+
+void PPJsonBackend::setDefaultBackend(PPJsonBackend *backend)
+{
+    customDefaultBackend.storeRelease(backend);
+}
+
+
+
+PPJsonDocument OnDemandJsonBackend::parse(const QByteArray &data, QString *errorString) const
+{
+    return PPJsonDocument::fromJson(data, errorString);
+}
+
+
+
+PPJsonDocument QJsonBackend::parse(const QByteArray &data, QString *errorString) const
+{
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+
+    if (error.error != QJsonParseError::NoError) {
+        if (errorString) {
+            *errorString = error.errorString();
+        }
+        return PPJsonDocument();
+    }
+
+    return PPJsonDocument(doc);
+}
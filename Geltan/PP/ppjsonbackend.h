@@ -0,0 +1,145 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonbackend.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONBACKEND_H
+#define PPJSONBACKEND_H
+
+#include <QByteArray>
+#include <QString>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsondocument.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \brief Interface for the JSON parser used to read the replies of the PayPal API.
+ *
+ * PPBase passes the reply data of every request to a backend. The resulting PPJsonDocument is read
+ * by the loadFromJson() functions of the objects through PPJsonValue. By default OnDemandJsonBackend
+ * is used, which only builds a structural index over the reply data, so loading a reply does not
+ * create a QJsonDocument. QJsonBackend uses QJsonDocument::fromJson() instead.
+ *
+ * Applications that want to use a different parser, for example simdjson, can subclass PPJsonBackend
+ * and report the tokens found by their parser to a PPJsonDocument::Builder. The backend can be installed
+ * for single operations with PPBase::setJsonBackend() or for all operations with setDefaultBackend().
+ * A backend has to be thread-safe, as it might be shared by operations running in different threads.
+ *
+ * \code{.cpp}
+ * class MyBackend : public Geltan::PP::PPJsonBackend
+ * {
+ * public:
+ *     Geltan::PP::PPJsonDocument parse(const QByteArray &data, QString *errorString) const override
+ *     {
+ *         Geltan::PP::PPJsonDocument::Builder builder(data);
+ *         // parse with the parser of your choice and add the tokens to the builder
+ *         return builder.document();
+ *     }
+ * };
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/ppjsonbackend.h>
+ */
+class GELTANSHARED_EXPORT PPJsonBackend
+{
+public:
+    /*!
+     * \brief Deconstructs the PPJsonBackend.
+     */
+    virtual ~PPJsonBackend();
+
+    /*!
+     * \brief Parses \a data and returns the resulting document.
+     *
+     * Has to return a null PPJsonDocument if \a data can not be parsed. In that case \a errorString,
+     * if it is not a \c nullptr, should contain a description of the error.
+     */
+    virtual PPJsonDocument parse(const QByteArray &data, QString *errorString = nullptr) const = 0;
+
+    /*!
+     * \brief Returns the backend used by operations that have no own backend set.
+     *
+     * If no default backend has been set, the built-in OnDemandJsonBackend is returned.
+     */
+    static PPJsonBackend *defaultBackend();
+
+    /*!
+     * \brief Sets the backend used by operations that have no own backend set.
+     *
+     * The backend is not owned and has to exist as long as operations are using it. Setting a
+     * \c nullptr restores the built-in OnDemandJsonBackend.
+     */
+    static void setDefaultBackend(PPJsonBackend *backend);
+
+protected:
+    /*!
+     * \brief Constructs a new PPJsonBackend.
+     */
+    PPJsonBackend() {}
+
+private:
+    Q_DISABLE_COPY(PPJsonBackend)
+};
+
+
+/*!
+ * \brief JSON backend using the on-demand parser bundled with the library.
+ *
+ * Validates the reply and creates a structural index over it with PPJsonDocument::fromJson(). Strings
+ * and numbers are only decoded when a loader reads them. This is the default backend.
+ *
+ * \headerfile "" <Geltan/PP/ppjsonbackend.h>
+ */
+class GELTANSHARED_EXPORT OnDemandJsonBackend : public PPJsonBackend
+{
+public:
+    /*!
+     * \brief Constructs a new OnDemandJsonBackend.
+     */
+    OnDemandJsonBackend() {}
+
+    PPJsonDocument parse(const QByteArray &data, QString *errorString = nullptr) const Q_DECL_OVERRIDE;
+};
+
+
+/*!
+ * \brief JSON backend using QJsonDocument::fromJson().
+ *
+ * The loaders read the resulting QJsonDocument through PPJsonValue. Can be used as fallback if the
+ * reply data should be parsed by Qt.
+ *
+ * \headerfile "" <Geltan/PP/ppjsonbackend.h>
+ */
+class GELTANSHARED_EXPORT QJsonBackend : public PPJsonBackend
+{
+public:
+    /*!
+     * \brief Constructs a new QJsonBackend.
+     */
+    QJsonBackend() {}
+
+    PPJsonDocument parse(const QByteArray &data, QString *errorString = nullptr) const Q_DECL_OVERRIDE;
+};
+
+}
+}
+
+#endif // PPJSONBACKEND_H
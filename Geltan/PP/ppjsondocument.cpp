@@ -0,0 +1,386 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsondocument.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "ppjsondocument_p.h"
+#include "ppjsonparser_p.h"
+
+using namespace Geltan;
+using namespace PP;
+
+
+PPJsonDocument::PPJsonDocument()
+{
+}
+
+
+PPJsonDocument::PPJsonDocument(const QJsonDocument &document) :
+    d(new PPJsonDocumentData)
+{
+    d->document = document;
+}
+
+
+PPJsonDocument::PPJsonDocument(const PPJsonDocument &other) :
+    d(other.d)
+{
+}
+
+
+PPJsonDocument::~PPJsonDocument()
+{
+}
+
+
+PPJsonDocument &PPJsonDocument::operator=(const PPJsonDocument &other)
+{
+    d = other.d;
+    return *this;
+}
+
+
+
+PPJsonDocument PPJsonDocument::fromJson(const QByteArray &data, QString *errorString)
+{
+    PPJsonDocument doc;
+
+    QExplicitlySharedDataPointer<PPJsonDocumentData> index(new PPJsonDocumentData);
+    if (!ppParseJson(data, &index->tape, errorString)) {
+        return doc;
+    }
+
+    index->data = data;
+    doc.d = index;
+
+    return doc;
+}
+
+
+
+bool PPJsonDocument::isNull() const
+{
+    return !d || (!d->isIndexed() && d->document.isNull());
+}
+
+
+bool PPJsonDocument::isObject() const
+{
+    if (!d) {
+        return false;
+    }
+    return d->isIndexed() ? (d->tape.at(0).type == PPJsonTapeEntry::Object) : d->document.isObject();
+}
+
+
+bool PPJsonDocument::isArray() const
+{
+    if (!d) {
+        return false;
+    }
+    return d->isIndexed() ? (d->tape.at(0).type == PPJsonTapeEntry::Array) : d->document.isArray();
+}
+
+
+bool PPJsonDocument::isIndexed() const
+{
+    return d && d->isIndexed();
+}
+
+
+
+PPJsonValue PPJsonDocument::root() const
+{
+    if (!d) {
+        return PPJsonValue();
+    }
+
+    if (d->isIndexed()) {
+        return PPJsonValue(d.constData(), 0);
+    }
+
+    if (d->document.isObject()) {
+        return PPJsonValue(d->document.object());
+    } else if (d->document.isArray()) {
+        return PPJsonValue(d->document.array());
+    }
+
+    return PPJsonValue();
+}
+
+
+
+QByteArray PPJsonDocument::data() const
+{
+    return d ? d->data : QByteArray();
+}
+
+
+
+QJsonDocument PPJsonDocument::toJsonDocument() const
+{
+    if (!d) {
+        return QJsonDocument();
+    }
+    return d->isIndexed() ? QJsonDocument::fromJson(d->data) : d->document;
+}
+
+
+
+
+PPJsonDocument::Builder::Builder(const QByteArray &data) :
+    m_data(new PPJsonDocumentData),
+    m_writer(nullptr),
+    m_failed(false)
+{
+    m_data->data = data;
+    m_writer = new PPJsonTapeWriter(&m_data->tape);
+}
+
+
+PPJsonDocument::Builder::~Builder()
+{
+    delete m_writer;
+}
+
+
+void PPJsonDocument::Builder::beginObject(int offset)
+{
+    m_failed |= (m_writer->depth() == 0 && !m_data->tape.isEmpty()) || offset < 0 || offset >= m_data->data.size();
+    m_writer->open(PPJsonTapeEntry::Object, offset);
+}
+
+
+void PPJsonDocument::Builder::beginArray(int offset)
+{
+    m_failed |= (m_writer->depth() == 0 && !m_data->tape.isEmpty()) || offset < 0 || offset >= m_data->data.size();
+    m_writer->open(PPJsonTapeEntry::Array, offset);
+}
+
+
+void PPJsonDocument::Builder::end(int offset)
+{
+    m_failed |= offset < 0 || offset >= m_data->data.size() || !m_writer->close(offset);
+}
+
+
+void PPJsonDocument::Builder::addKey(int offset, int size, bool escaped)
+{
+    m_failed |= !m_writer->inObject() || offset < 0 || size < 0 || offset + size > m_data->data.size();
+    m_writer->add(PPJsonTapeEntry::Key, offset, size, escaped ? PPJsonTapeEntry::Escaped : 0);
+}
+
+
+void PPJsonDocument::Builder::addString(int offset, int size, bool escaped)
+{
+    m_failed |= m_writer->depth() == 0 || offset < 0 || size < 0 || offset + size > m_data->data.size();
+    m_writer->add(PPJsonTapeEntry::String, offset, size, escaped ? PPJsonTapeEntry::Escaped : 0);
+}
+
+
+void PPJsonDocument::Builder::addNumber(int offset, int size)
+{
+    m_failed |= m_writer->depth() == 0 || offset < 0 || size <= 0 || offset + size > m_data->data.size();
+    m_writer->add(PPJsonTapeEntry::Number, offset, size);
+}
+
+
+void PPJsonDocument::Builder::addBool(bool value, int offset)
+{
+    const int size = value ? 4 : 5;
+    m_failed |= m_writer->depth() == 0 || offset < 0 || offset + size > m_data->data.size();
+    m_writer->add(value ? PPJsonTapeEntry::True : PPJsonTapeEntry::False, offset, size);
+}
+
+
+void PPJsonDocument::Builder::addNull(int offset)
+{
+    m_failed |= m_writer->depth() == 0 || offset < 0 || offset + 4 > m_data->data.size();
+    m_writer->add(PPJsonTapeEntry::Null, offset, 4);
+}
+
+
+PPJsonDocument PPJsonDocument::Builder::document() const
+{
+    PPJsonDocument doc;
+
+    if (!m_failed && m_writer->depth() == 0 && !m_data->tape.isEmpty()) {
+        doc.d = m_data;
+    }
+
+    return doc;
+}
+
+
+
+
+namespace {
+
+bool hexValue(const char *p, const char *end, uint *value)
+{
+    if (end - p < 4) {
+        return false;
+    }
+
+    uint v = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') {
+            v |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            v |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            v |= c - 'A' + 10;
+        } else {
+            return false;
+        }
+    }
+
+    *value = v;
+    return true;
+}
+
+
+void appendUtf8(QByteArray *out, uint u)
+{
+    if (u < 0x80) {
+        out->append(static_cast<char>(u));
+    } else if (u < 0x800) {
+        out->append(static_cast<char>(0xC0 | (u >> 6)));
+        out->append(static_cast<char>(0x80 | (u & 0x3F)));
+    } else if (u < 0x10000) {
+        out->append(static_cast<char>(0xE0 | (u >> 12)));
+        out->append(static_cast<char>(0x80 | ((u >> 6) & 0x3F)));
+        out->append(static_cast<char>(0x80 | (u & 0x3F)));
+    } else {
+        out->append(static_cast<char>(0xF0 | (u >> 18)));
+        out->append(static_cast<char>(0x80 | ((u >> 12) & 0x3F)));
+        out->append(static_cast<char>(0x80 | ((u >> 6) & 0x3F)));
+        out->append(static_cast<char>(0x80 | (u & 0x3F)));
+    }
+}
+
+}
+
+
+QString PPJsonDocumentData::string(const PPJsonTapeEntry &e) const
+{
+    if (e.flags & PPJsonTapeEntry::Escaped) {
+        return QString::fromUtf8(unescape(at(e), e.size));
+    }
+    return QString::fromUtf8(at(e), e.size);
+}
+
+
+QByteArray PPJsonDocumentData::unescape(const char *str, int size)
+{
+    QByteArray out;
+    out.reserve(size);
+
+    const char *p = str;
+    const char *end = str + size;
+
+    while (p < end) {
+        const char *run = p;
+        while (p < end && *p != '\\') {
+            ++p;
+        }
+        out.append(run, static_cast<int>(p - run));
+
+        if (end - p < 2) {
+            break;
+        }
+
+        const char c = p[1];
+        p += 2;
+
+        switch (c) {
+        case 'b':
+            out.append('\b');
+            break;
+        case 'f':
+            out.append('\f');
+            break;
+        case 'n':
+            out.append('\n');
+            break;
+        case 'r':
+            out.append('\r');
+            break;
+        case 't':
+            out.append('\t');
+            break;
+        case 'u':
+        {
+            uint u;
+            if (!hexValue(p, end, &u)) {
+                return out;
+            }
+            p += 4;
+            if (u >= 0xD800 && u <= 0xDBFF) {
+                uint low;
+                if (end - p >= 6 && p[0] == '\\' && p[1] == 'u' && hexValue(p + 2, end, &low) && low >= 0xDC00 && low <= 0xDFFF) {
+                    u = 0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00);
+                    p += 6;
+                } else {
+                    u = 0xFFFD;
+                }
+            } else if (u >= 0xDC00 && u <= 0xDFFF) {
+                u = 0xFFFD;
+            }
+            appendUtf8(&out, u);
+            break;
+        }
+        default:
+            // '"', '\\' and '/'
+            out.append(c);
+            break;
+        }
+    }
+
+    return out;
+}
+
+
+double PPJsonDocumentData::number(const char *str, int size)
+{
+    const char *p = str;
+    const char *end = str + size;
+
+    const bool negative = (p < end && *p == '-');
+    if (negative) {
+        ++p;
+    }
+
+    // integers with up to 15 digits are exactly representable, which covers nearly all numbers in a reply
+    if (end - p > 0 && end - p <= 15) {
+        qint64 v = 0;
+        const char *c = p;
+        while (c < end && *c >= '0' && *c <= '9') {
+            v = v * 10 + (*c - '0');
+            ++c;
+        }
+        if (c == end) {
+            return negative ? -static_cast<double>(v) : static_cast<double>(v);
+        }
+    }
+
+    return QByteArray::fromRawData(str, size).toDouble();
+}
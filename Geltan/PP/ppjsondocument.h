@@ -0,0 +1,247 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsondocument.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONDOCUMENT_H
+#define PPJSONDOCUMENT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QJsonDocument>
+#include <QExplicitlySharedDataPointer>
+#include <Geltan/geltan_global.h>
+#include <Geltan/PP/ppjsonvalue.h>
+
+namespace Geltan {
+namespace PP {
+
+class PPJsonDocumentData;
+class PPJsonTapeWriter;
+
+/*!
+ * \brief Parsed JSON reply of the PayPal API, as returned by a PPJsonBackend.
+ *
+ * A PPJsonDocument either wraps a QJsonDocument or is a structural index over the raw reply data.
+ * The index has one entry per value that stores its type, its position in the data and where its
+ * children end. Building it does not decode a single string or number and does not allocate per
+ * value. The loadFromJson() functions read it through root() and only convert the members they
+ * actually use, so loading a reply does not create a QJsonDocument at all.
+ *
+ * fromJson() creates an index with the parser bundled with the library. Other parsers can create one
+ * with a Builder.
+ *
+ * PPJsonDocument is implicitly shared and never changed after it has been created, copies and the
+ * values taken from it can be read from multiple threads.
+ *
+ * \headerfile "" <Geltan/PP/ppjsondocument.h>
+ */
+class GELTANSHARED_EXPORT PPJsonDocument
+{
+public:
+    /*!
+     * \brief Constructs a new null PPJsonDocument.
+     */
+    PPJsonDocument();
+
+    /*!
+     * \brief Constructs a new PPJsonDocument wrapping \a document.
+     */
+    explicit PPJsonDocument(const QJsonDocument &document);
+
+    /*!
+     * \brief Constructs a copy of \a other.
+     *
+     * This is a cheap operation, the data is implicitly shared.
+     */
+    PPJsonDocument(const PPJsonDocument &other);
+
+    /*!
+     * \brief Deconstructs the PPJsonDocument.
+     */
+    ~PPJsonDocument();
+
+    /*!
+     * \brief Assigns \a other to this PPJsonDocument.
+     */
+    PPJsonDocument &operator=(const PPJsonDocument &other);
+
+    /*!
+     * \brief Parses \a data with the on-demand parser bundled with the library.
+     *
+     * The parser validates the complete document, including the UTF-8 encoding of the strings, and
+     * accepts the same input as QJsonDocument::fromJson(). The top level value has to be an object or
+     * an array. On SSE2 capable processors strings are scanned 16 bytes at a time.
+     *
+     * Returns a null document if \a data can not be parsed. In that case \a errorString, if it is not
+     * a \c nullptr, contains a description of the error.
+     */
+    static PPJsonDocument fromJson(const QByteArray &data, QString *errorString = nullptr);
+
+    /*!
+     * \brief Returns true if the document contains neither an object nor an array.
+     */
+    bool isNull() const;
+
+    /*!
+     * \brief Returns true if the top level value is an object.
+     */
+    bool isObject() const;
+
+    /*!
+     * \brief Returns true if the top level value is an array.
+     */
+    bool isArray() const;
+
+    /*!
+     * \brief Returns true if the document is a structural index over the reply data instead of a QJsonDocument.
+     */
+    bool isIndexed() const;
+
+    /*!
+     * \brief Returns the top level value.
+     *
+     * The returned value, and all values taken from it, are only valid as long as this document, or a
+     * copy of it, exists.
+     */
+    PPJsonValue root() const;
+
+    /*!
+     * \brief Returns the raw data an indexed document has been created from.
+     */
+    QByteArray data() const;
+
+    /*!
+     * \brief Returns the document as QJsonDocument.
+     *
+     * Indexed documents are parsed again by QJsonDocument::fromJson(), so this should only be used
+     * where a QJsonDocument is really needed.
+     */
+    QJsonDocument toJsonDocument() const;
+
+    class Builder;
+
+private:
+    QExplicitlySharedDataPointer<PPJsonDocumentData> d;
+};
+
+
+/*!
+ * \brief Creates an indexed PPJsonDocument from the tokens found by a parser.
+ *
+ * A PPJsonBackend wrapping a different parser, for example simdjson, reports every token with its
+ * byte offset in the data, in document order. Strings and member names are reported by the offset
+ * and size of their content without the quotes, containers by the offsets of their brackets.
+ *
+ * The Builder does not check the grammar, the parser has to report a valid document. It only makes
+ * sure that all containers have been closed.
+ *
+ * \code{.cpp}
+ * // {"id":"PAY-1","count":2}
+ * Geltan::PP::PPJsonDocument::Builder b(data);
+ * b.beginObject(0);
+ * b.addKey(2, 2);
+ * b.addString(7, 5);
+ * b.addKey(15, 5);
+ * b.addNumber(22, 1);
+ * b.end(23);
+ * Geltan::PP::PPJsonDocument doc = b.document();
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/ppjsondocument.h>
+ */
+class GELTANSHARED_EXPORT PPJsonDocument::Builder
+{
+public:
+    /*!
+     * \brief Constructs a new Builder for \a data.
+     */
+    explicit Builder(const QByteArray &data);
+
+    /*!
+     * \brief Deconstructs the Builder.
+     */
+    ~Builder();
+
+    /*!
+     * \brief Starts an object at \a offset.
+     */
+    void beginObject(int offset);
+
+    /*!
+     * \brief Starts an array at \a offset.
+     */
+    void beginArray(int offset);
+
+    /*!
+     * \brief Closes the innermost object or array, \a offset is the position of its closing bracket.
+     */
+    void end(int offset);
+
+    /*!
+     * \brief Adds a member name whose content starts at \a offset.
+     *
+     * If \a escaped is \c true, the content contains escape sequences.
+     */
+    void addKey(int offset, int size, bool escaped = false);
+
+    /*!
+     * \brief Adds a string whose content starts at \a offset.
+     *
+     * If \a escaped is \c true, the content contains escape sequences.
+     */
+    void addString(int offset, int size, bool escaped = false);
+
+    /*!
+     * \brief Adds a number token.
+     */
+    void addNumber(int offset, int size);
+
+    /*!
+     * \brief Adds a \c true or \c false literal.
+     */
+    void addBool(bool value, int offset);
+
+    /*!
+     * \brief Adds a \c null literal.
+     */
+    void addNull(int offset);
+
+    /*!
+     * \brief Returns the document.
+     *
+     * Has to be called after all tokens have been added. Returns a null document if there is no
+     * top level object or array, if not all containers have been closed or if a member name has
+     * been added outside of an object.
+     */
+    PPJsonDocument document() const;
+
+private:
+    Q_DISABLE_COPY(Builder)
+    QExplicitlySharedDataPointer<PPJsonDocumentData> m_data;
+    PPJsonTapeWriter *m_writer;
+    bool m_failed;
+};
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::PPJsonDocument, Q_MOVABLE_TYPE);
+
+#endif // PPJSONDOCUMENT_H
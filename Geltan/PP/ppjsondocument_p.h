@@ -0,0 +1,173 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsondocument_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONDOCUMENT_P_H
+#define PPJSONDOCUMENT_P_H
+
+#include "ppjsondocument.h"
+#include <QSharedData>
+#include <QVector>
+#include <QVarLengthArray>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Entry of the structural index of a PPJsonDocument.
+ *
+ * Every value and every object member name gets one entry, in document order. Strings and member
+ * names point to their content without the quotes, all other entries to the first byte of their
+ * token. Containers are followed by the entries of their children, \a next points behind the last
+ * of them, so a complete subtree can be skipped in a single step.
+ */
+struct PPJsonTapeEntry
+{
+    enum Type : quint8 {
+        Null,
+        False,
+        True,
+        Number,
+        String,
+        Key,
+        Array,
+        Object
+    };
+
+    enum Flag : quint8 {
+        Escaped = 0x1
+    };
+
+    quint32 offset;
+    quint32 size;
+    quint32 next;
+    quint32 count;
+    quint8 type;
+    quint8 flags;
+};
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::PPJsonTapeEntry, Q_PRIMITIVE_TYPE);
+
+namespace Geltan {
+namespace PP {
+
+class PPJsonDocumentData : public QSharedData
+{
+public:
+    PPJsonDocumentData() {}
+
+    ~PPJsonDocumentData() {}
+
+    bool isIndexed() const { return !tape.isEmpty(); }
+
+    const char *at(const PPJsonTapeEntry &e) const { return data.constData() + e.offset; }
+
+    /*!
+     * \internal
+     * \brief Returns the string of a String or Key entry, resolving escape sequences if the entry has any.
+     */
+    QString string(const PPJsonTapeEntry &e) const;
+
+    /*!
+     * \internal
+     * \brief Returns the UTF-8 encoded content of an escaped string without the escape sequences.
+     */
+    static QByteArray unescape(const char *str, int size);
+
+    /*!
+     * \internal
+     * \brief Converts the JSON number token \a str to a double.
+     */
+    static double number(const char *str, int size);
+
+    QByteArray data;
+    QVector<PPJsonTapeEntry> tape;
+    QJsonDocument document;
+};
+
+
+/*!
+ * \internal
+ * \brief Appends entries to the structural index of a PPJsonDocument.
+ *
+ * Used by the bundled parser and by PPJsonDocument::Builder. Keeps track of the open containers
+ * and their number of children, it does not validate the order of the added entries.
+ */
+class PPJsonTapeWriter
+{
+public:
+    explicit PPJsonTapeWriter(QVector<PPJsonTapeEntry> *tape) : m_tape(tape) {}
+
+    int depth() const { return m_stack.size(); }
+
+    bool inObject() const { return !m_stack.isEmpty() && m_tape->at(m_stack.last()).type == PPJsonTapeEntry::Object; }
+
+    void add(quint8 type, quint32 offset, quint32 size, quint8 flags = 0)
+    {
+        if (!m_stack.isEmpty()) {
+            PPJsonTapeEntry &parent = (*m_tape)[m_stack.last()];
+            // values inside objects are counted by their member names
+            if (type == PPJsonTapeEntry::Key || parent.type == PPJsonTapeEntry::Array) {
+                ++parent.count;
+            }
+        }
+
+        PPJsonTapeEntry e;
+        e.offset = offset;
+        e.size = size;
+        e.next = m_tape->size() + 1;
+        e.count = 0;
+        e.type = type;
+        e.flags = flags;
+        m_tape->append(e);
+    }
+
+    void open(quint8 type, quint32 offset)
+    {
+        add(type, offset, 0);
+        m_stack.append(m_tape->size() - 1);
+    }
+
+    bool close(quint32 endOffset)
+    {
+        if (m_stack.isEmpty()) {
+            return false;
+        }
+        PPJsonTapeEntry &e = (*m_tape)[m_stack.last()];
+        m_stack.removeLast();
+        e.next = m_tape->size();
+        e.size = endOffset + 1 - e.offset;
+        return true;
+    }
+
+private:
+    Q_DISABLE_COPY(PPJsonTapeWriter)
+    QVector<PPJsonTapeEntry> *m_tape;
+    QVarLengthArray<int, 32> m_stack;
+};
+
+}
+}
+
+#endif // PPJSONDOCUMENT_P_H
@@ -0,0 +1,156 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonfields_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONFIELDS_P_H
+#define PPJSONFIELDS_P_H
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <cstring>
+#include "pptokenhash_p.h"
+#include "ppjsonvalue.h"
+#include "ppjsondocument_p.h"
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Returns the length of the null-terminated \a token at compile time.
+ */
+constexpr int ppTokenSize(const char *token, int size = 0)
+{
+    return *token ? ppTokenSize(token + 1, size + 1) : size;
+}
+
+/*!
+ * \internal
+ * \brief Entry of a precomputed JSON field table.
+ *
+ * The hash and the size of the key are calculated at compile time.
+ */
+struct PPJsonField
+{
+    constexpr PPJsonField(const char *k) : hash(ppTokenHash(k)), size(ppTokenSize(k)), key(k) {}
+
+    quint32 hash;
+    int size;
+    const char *key;
+};
+
+
+/*!
+ * \internal
+ * \brief Collects the values of the fields listed in a PPJsonField table in a single pass over a JSON object.
+ *
+ * Every member of the object is hashed once and dispatched to its slot in the table, afterwards the
+ * values can be accessed by their table index without further key lookups. Fields that are not part
+ * of the object are returned as undefined PPJsonValue, the same as QJsonObject::value() does.
+ *
+ * For values from an on-demand index of a PPJsonDocument the member names are hashed and compared on
+ * the raw reply bytes, no QString is created for them.
+ *
+ * The scan through the table starts behind the last matched field. As QJsonObject iterates its keys
+ * in sorted order, tables listing their keys alphabetically are resolved with a single comparison
+ * per member.
+ *
+ * Besides PPJsonField, any table whose entries provide the same \c hash, \c size and \c key members
+ * can be used, like the PPValueField tables of the value types.
+ */
+template<int N>
+class PPJsonFields
+{
+public:
+    template<typename Field>
+    PPJsonFields(const PPJsonValue &json, const Field (&table)[N])
+    {
+        if (json.m_tape) {
+            readIndexed(json, table);
+            return;
+        }
+
+        const QJsonObject o = json.m_json.toObject();
+
+        int next = 0;
+        QJsonObject::const_iterator it = o.constBegin();
+        while (it != o.constEnd()) {
+            const QString key = it.key();
+            const quint32 hash = ppTokenHash(key);
+            for (int n = 0; n < N; ++n) {
+                const int i = (next + n) % N;
+                if (table[i].hash == hash && key == QLatin1String(table[i].key)) {
+                    m_values[i] = PPJsonValue(it.value());
+                    next = i + 1;
+                    break;
+                }
+            }
+            ++it;
+        }
+    }
+
+    /*!
+     * \brief Returns the value of the field at \a index in the table.
+     */
+    const PPJsonValue &operator[](int index) const { return m_values[index]; }
+
+private:
+    template<typename Field>
+    void readIndexed(const PPJsonValue &json, const Field (&table)[N])
+    {
+        const PPJsonDocumentData *doc = json.m_tape;
+        const PPJsonTapeEntry *tape = doc->tape.constData();
+        const PPJsonTapeEntry &o = tape[json.m_index];
+        if (o.type != PPJsonTapeEntry::Object) {
+            return;
+        }
+
+        int next = 0;
+        quint32 k = json.m_index + 1;
+        while (k < o.next) {
+            const PPJsonTapeEntry &ke = tape[k];
+            QByteArray unescaped;
+            const char *key = doc->at(ke);
+            int size = static_cast<int>(ke.size);
+            if (ke.flags & PPJsonTapeEntry::Escaped) {
+                unescaped = PPJsonDocumentData::unescape(key, size);
+                key = unescaped.constData();
+                size = unescaped.size();
+            }
+            const quint32 hash = ppTokenHash(key, size);
+            for (int n = 0; n < N; ++n) {
+                const int i = (next + n) % N;
+                if (table[i].hash == hash && table[i].size == size && memcmp(table[i].key, key, size) == 0) {
+                    m_values[i] = PPJsonValue(doc, k + 1);
+                    next = i + 1;
+                    break;
+                }
+            }
+            k = tape[k + 1].next;
+        }
+    }
+
+    PPJsonValue m_values[N];
+};
+
+}
+}
+
+#endif // PPJSONFIELDS_P_H
@@ -0,0 +1,459 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonparser.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "ppjsonparser_p.h"
+#include <QtAlgorithms>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace Geltan;
+using namespace PP;
+
+namespace {
+
+// the same limit as the QJsonDocument parser
+const int MaxDepth = 1024;
+
+/*
+ * Returns the length of the UTF-8 sequence starting with the non ASCII byte at p, or 0 if the
+ * sequence is invalid, overlong, encodes a surrogate or is out of the Unicode range.
+ */
+int utf8SequenceLength(const uchar *p, const uchar *end)
+{
+    const uchar c = p[0];
+    if (c < 0xC2) {
+        return 0;
+    }
+
+    int len = 4;
+    if (c < 0xE0) {
+        len = 2;
+    } else if (c < 0xF0) {
+        len = 3;
+    } else if (c > 0xF4) {
+        return 0;
+    }
+
+    if (end - p < len) {
+        return 0;
+    }
+
+    for (int i = 1; i < len; ++i) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+
+    if ((c == 0xE0 && p[1] < 0xA0) || (c == 0xED && p[1] >= 0xA0) || (c == 0xF0 && p[1] < 0x90) || (c == 0xF4 && p[1] >= 0x90)) {
+        return 0;
+    }
+
+    return len;
+}
+
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+
+inline bool isHexDigit(char c)
+{
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+
+class Parser
+{
+public:
+    Parser(const QByteArray &data, QVector<PPJsonTapeEntry> *tape) :
+        m_begin(data.constData()),
+        m_p(data.constData()),
+        m_end(data.constData() + data.size()),
+        m_writer(tape),
+        m_error(nullptr)
+    {
+        // a typical PayPal reply has about one token per 12 bytes
+        tape->reserve(data.size() / 12 + 16);
+    }
+
+    bool parse();
+
+    QString errorString() const
+    {
+        return QStringLiteral("%1 at offset %2").arg(QLatin1String(m_error)).arg(static_cast<qint64>(m_p - m_begin));
+    }
+
+private:
+    bool fail(const char *error)
+    {
+        m_error = error;
+        return false;
+    }
+
+    quint32 offset(const char *p) const { return static_cast<quint32>(p - m_begin); }
+
+    void skipWhitespace();
+    bool scanString(const char **start, quint32 *size, quint8 *flags);
+    bool scanName();
+    bool scanNumber();
+    bool scanLiteral(const char *literal, int size, quint8 type);
+
+    const char *m_begin;
+    const char *m_p;
+    const char *m_end;
+    PPJsonTapeWriter m_writer;
+    const char *m_error;
+};
+
+
+void Parser::skipWhitespace()
+{
+    while (m_p < m_end) {
+        const char c = *m_p;
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            return;
+        }
+#ifdef __SSE2__
+        // skip the indentation of pretty printed data 16 bytes at a time
+        if (m_end - m_p >= 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_p));
+            const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                                            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))));
+            const quint32 mask = static_cast<quint32>(_mm_movemask_epi8(ws)) ^ 0xFFFFu;
+            if (mask) {
+                m_p += qCountTrailingZeroBits(mask);
+                return;
+            }
+            m_p += 16;
+            continue;
+        }
+#endif
+        ++m_p;
+    }
+}
+
+
+/*
+ * Scans the string starting behind the opening quote at m_p and moves m_p behind the closing quote.
+ */
+bool Parser::scanString(const char **start, quint32 *size, quint8 *flags)
+{
+    *start = m_p;
+    *flags = 0;
+
+    for (;;) {
+#ifdef __SSE2__
+        // find the next quote, backslash, control character or non ASCII byte; the signed
+        // comparison catches both, control characters and bytes >= 0x80
+        while (m_end - m_p >= 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_p));
+            const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+                                                 _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)));
+            const quint32 mask = static_cast<quint32>(_mm_movemask_epi8(special));
+            if (mask) {
+                m_p += qCountTrailingZeroBits(mask);
+                break;
+            }
+            m_p += 16;
+        }
+#endif
+        if (m_p >= m_end) {
+            return fail("unterminated string");
+        }
+
+        const uchar c = static_cast<uchar>(*m_p);
+        if (c == '"') {
+            *size = static_cast<quint32>(m_p - *start);
+            ++m_p;
+            return true;
+        } else if (c == '\\') {
+            *flags |= PPJsonTapeEntry::Escaped;
+            if (m_end - m_p < 2) {
+                return fail("unterminated string");
+            }
+            switch (m_p[1]) {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                m_p += 2;
+                break;
+            case 'u':
+                if (m_end - m_p < 6 || !isHexDigit(m_p[2]) || !isHexDigit(m_p[3]) || !isHexDigit(m_p[4]) || !isHexDigit(m_p[5])) {
+                    return fail("invalid escape sequence");
+                }
+                m_p += 6;
+                break;
+            default:
+                return fail("invalid escape sequence");
+            }
+        } else if (c < 0x20) {
+            return fail("illegal value");
+        } else if (c >= 0x80) {
+            const int len = utf8SequenceLength(reinterpret_cast<const uchar*>(m_p), reinterpret_cast<const uchar*>(m_end));
+            if (!len) {
+                return fail("invalid UTF8 string");
+            }
+            m_p += len;
+        } else {
+            ++m_p;
+        }
+    }
+}
+
+
+/*
+ * Scans a member name, the name separator and the whitespace in front of the value.
+ */
+bool Parser::scanName()
+{
+    if (m_p >= m_end || *m_p != '"') {
+        return fail("object is missing after a comma");
+    }
+    ++m_p;
+
+    const char *start;
+    quint32 size;
+    quint8 flags;
+    if (!scanString(&start, &size, &flags)) {
+        return false;
+    }
+    m_writer.add(PPJsonTapeEntry::Key, offset(start), size, flags);
+
+    skipWhitespace();
+    if (m_p >= m_end || *m_p != ':') {
+        return fail("missing name separator");
+    }
+    ++m_p;
+    skipWhitespace();
+
+    return true;
+}
+
+
+bool Parser::scanNumber()
+{
+    const char *start = m_p;
+
+    if (*m_p == '-') {
+        ++m_p;
+    }
+
+    if (m_p < m_end && *m_p == '0') {
+        ++m_p;
+    } else if (m_p < m_end && *m_p >= '1' && *m_p <= '9') {
+        while (m_p < m_end && isDigit(*m_p)) {
+            ++m_p;
+        }
+    } else {
+        return fail("illegal number");
+    }
+
+    if (m_p < m_end && *m_p == '.') {
+        ++m_p;
+        if (m_p >= m_end || !isDigit(*m_p)) {
+            return fail("illegal number");
+        }
+        while (m_p < m_end && isDigit(*m_p)) {
+            ++m_p;
+        }
+    }
+
+    if (m_p < m_end && (*m_p == 'e' || *m_p == 'E')) {
+        ++m_p;
+        if (m_p < m_end && (*m_p == '+' || *m_p == '-')) {
+            ++m_p;
+        }
+        if (m_p >= m_end || !isDigit(*m_p)) {
+            return fail("illegal number");
+        }
+        while (m_p < m_end && isDigit(*m_p)) {
+            ++m_p;
+        }
+    }
+
+    m_writer.add(PPJsonTapeEntry::Number, offset(start), static_cast<quint32>(m_p - start));
+
+    return true;
+}
+
+
+bool Parser::scanLiteral(const char *literal, int size, quint8 type)
+{
+    if (m_end - m_p < size || memcmp(m_p, literal, size) != 0) {
+        return fail("illegal value");
+    }
+
+    m_writer.add(type, offset(m_p), static_cast<quint32>(size));
+    m_p += size;
+
+    return true;
+}
+
+
+bool Parser::parse()
+{
+    if (m_end - m_p >= 3 && static_cast<uchar>(m_p[0]) == 0xEF && static_cast<uchar>(m_p[1]) == 0xBB && static_cast<uchar>(m_p[2]) == 0xBF) {
+        m_p += 3;
+    }
+
+    skipWhitespace();
+
+    if (m_p >= m_end || (*m_p != '{' && *m_p != '[')) {
+        return fail("illegal value");
+    }
+
+    for (;;) {
+
+        // a value is expected at m_p
+        if (m_p >= m_end) {
+            return fail("illegal value");
+        }
+
+        switch (*m_p) {
+        case '{':
+            if (m_writer.depth() >= MaxDepth) {
+                return fail("too deeply nested document");
+            }
+            m_writer.open(PPJsonTapeEntry::Object, offset(m_p));
+            ++m_p;
+            skipWhitespace();
+            if (m_p < m_end && *m_p == '}') {
+                m_writer.close(offset(m_p));
+                ++m_p;
+                break;
+            }
+            if (!scanName()) {
+                return false;
+            }
+            continue;
+        case '[':
+            if (m_writer.depth() >= MaxDepth) {
+                return fail("too deeply nested document");
+            }
+            m_writer.open(PPJsonTapeEntry::Array, offset(m_p));
+            ++m_p;
+            skipWhitespace();
+            if (m_p < m_end && *m_p == ']') {
+                m_writer.close(offset(m_p));
+                ++m_p;
+                break;
+            }
+            continue;
+        case '"':
+        {
+            ++m_p;
+            const char *start;
+            quint32 size;
+            quint8 flags;
+            if (!scanString(&start, &size, &flags)) {
+                return false;
+            }
+            m_writer.add(PPJsonTapeEntry::String, offset(start), size, flags);
+            break;
+        }
+        case 't':
+            if (!scanLiteral("true", 4, PPJsonTapeEntry::True)) {
+                return false;
+            }
+            break;
+        case 'f':
+            if (!scanLiteral("false", 5, PPJsonTapeEntry::False)) {
+                return false;
+            }
+            break;
+        case 'n':
+            if (!scanLiteral("null", 4, PPJsonTapeEntry::Null)) {
+                return false;
+            }
+            break;
+        default:
+            if (*m_p != '-' && !isDigit(*m_p)) {
+                return fail("illegal value");
+            }
+            if (!scanNumber()) {
+                return false;
+            }
+            break;
+        }
+
+        // a value has been completed, close the containers that end behind it
+        for (;;) {
+            skipWhitespace();
+
+            if (m_writer.depth() == 0) {
+                if (m_p != m_end) {
+                    return fail("garbage at the end of the document");
+                }
+                return true;
+            }
+
+            const bool object = m_writer.inObject();
+
+            if (m_p >= m_end) {
+                return fail(object ? "unterminated object" : "unterminated array");
+            }
+
+            if (*m_p == ',') {
+                ++m_p;
+                skipWhitespace();
+                if (object && !scanName()) {
+                    return false;
+                }
+                break;
+            }
+
+            if (*m_p != (object ? '}' : ']')) {
+                return fail(object ? "unterminated object" : "unterminated array");
+            }
+
+            m_writer.close(offset(m_p));
+            ++m_p;
+        }
+    }
+}
+
+}
+
+
+bool Geltan::PP::ppParseJson(const QByteArray &data, QVector<PPJsonTapeEntry> *tape, QString *errorString)
+{
+    tape->clear();
+
+    Parser parser(data, tape);
+    if (!parser.parse()) {
+        if (errorString) {
+            *errorString = parser.errorString();
+        }
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,45 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonparser_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONPARSER_P_H
+#define PPJSONPARSER_P_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "ppjsondocument_p.h"
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Validates \a data and writes its structural index to \a tape.
+ *
+ * Returns \c false and sets \a errorString, if it is not a \c nullptr, if \a data is not a JSON
+ * object or array. The content of \a tape is undefined in that case.
+ */
+bool ppParseJson(const QByteArray &data, QVector<PPJsonTapeEntry> *tape, QString *errorString);
+
+}
+}
+
+#endif // PPJSONPARSER_P_H
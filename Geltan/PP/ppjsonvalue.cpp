@@ -0,0 +1,436 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonvalue.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "ppjsonvalue.h"
+#include "ppjsondocument_p.h"
+#include <QJsonDocument>
+#include <QLocale>
+#include <cstring>
+#include <limits>
+
+using namespace Geltan;
+using namespace PP;
+
+
+PPJsonValue::PPJsonValue() :
+    m_json(QJsonValue::Undefined), m_tape(nullptr), m_index(0)
+{
+}
+
+
+PPJsonValue::PPJsonValue(const QJsonValue &value) :
+    m_json(value), m_tape(nullptr), m_index(0)
+{
+}
+
+
+PPJsonValue::PPJsonValue(const QJsonObject &object) :
+    m_json(object), m_tape(nullptr), m_index(0)
+{
+}
+
+
+PPJsonValue::PPJsonValue(const QJsonArray &array) :
+    m_json(array), m_tape(nullptr), m_index(0)
+{
+}
+
+
+
+QJsonValue::Type PPJsonValue::type() const
+{
+    if (!m_tape) {
+        return m_json.type();
+    }
+
+    switch (m_tape->tape.at(m_index).type) {
+    case PPJsonTapeEntry::Null:
+        return QJsonValue::Null;
+    case PPJsonTapeEntry::False:
+    case PPJsonTapeEntry::True:
+        return QJsonValue::Bool;
+    case PPJsonTapeEntry::Number:
+        return QJsonValue::Double;
+    case PPJsonTapeEntry::String:
+        return QJsonValue::String;
+    case PPJsonTapeEntry::Array:
+        return QJsonValue::Array;
+    case PPJsonTapeEntry::Object:
+        return QJsonValue::Object;
+    default:
+        return QJsonValue::Undefined;
+    }
+}
+
+
+
+bool PPJsonValue::toBool(bool defaultValue) const
+{
+    if (!m_tape) {
+        return m_json.toBool(defaultValue);
+    }
+
+    const quint8 t = m_tape->tape.at(m_index).type;
+    if (t == PPJsonTapeEntry::True) {
+        return true;
+    } else if (t == PPJsonTapeEntry::False) {
+        return false;
+    }
+
+    return defaultValue;
+}
+
+
+
+int PPJsonValue::toInt(int defaultValue) const
+{
+    if (!m_tape) {
+        return m_json.toInt(defaultValue);
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type != PPJsonTapeEntry::Number) {
+        return defaultValue;
+    }
+
+    const double v = PPJsonDocumentData::number(m_tape->at(e), e.size);
+    if (v >= std::numeric_limits<int>::min() && v <= std::numeric_limits<int>::max() && static_cast<int>(v) == v) {
+        return static_cast<int>(v);
+    }
+
+    return defaultValue;
+}
+
+
+
+double PPJsonValue::toDouble(double defaultValue) const
+{
+    if (!m_tape) {
+        return m_json.toDouble(defaultValue);
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type != PPJsonTapeEntry::Number) {
+        return defaultValue;
+    }
+
+    return PPJsonDocumentData::number(m_tape->at(e), e.size);
+}
+
+
+
+QString PPJsonValue::toString(const QString &defaultValue) const
+{
+    if (!m_tape) {
+        return m_json.toString(defaultValue);
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type != PPJsonTapeEntry::String) {
+        return defaultValue;
+    }
+
+    return m_tape->string(e);
+}
+
+
+
+QByteArray PPJsonValue::toUtf8() const
+{
+    if (!m_tape) {
+        if (m_json.isString()) {
+            return m_json.toString().toUtf8();
+        } else if (m_json.isDouble()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+            return QByteArray::number(m_json.toDouble(), 'g', QLocale::FloatingPointShortest);
+#else
+            return QByteArray::number(m_json.toDouble(), 'g', 17);
+#endif
+        }
+        return QByteArray();
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type == PPJsonTapeEntry::String) {
+        if (e.flags & PPJsonTapeEntry::Escaped) {
+            return PPJsonDocumentData::unescape(m_tape->at(e), e.size);
+        }
+        return QByteArray(m_tape->at(e), e.size);
+    } else if (e.type == PPJsonTapeEntry::Number) {
+        return QByteArray(m_tape->at(e), e.size);
+    }
+
+    return QByteArray();
+}
+
+
+
+PPJsonValue PPJsonValue::toObject() const
+{
+    return isObject() ? *this : PPJsonValue();
+}
+
+
+
+PPJsonValue PPJsonValue::toArray() const
+{
+    return isArray() ? *this : PPJsonValue();
+}
+
+
+
+int PPJsonValue::count() const
+{
+    if (!m_tape) {
+        if (m_json.isObject()) {
+            return m_json.toObject().count();
+        } else if (m_json.isArray()) {
+            return m_json.toArray().count();
+        }
+        return 0;
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    return (e.type == PPJsonTapeEntry::Object || e.type == PPJsonTapeEntry::Array) ? static_cast<int>(e.count) : 0;
+}
+
+
+
+PPJsonValue PPJsonValue::value(QLatin1String key) const
+{
+    if (!m_tape) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+        return m_json.isObject() ? PPJsonValue(m_json.toObject().value(key)) : PPJsonValue();
+#else
+        return m_json.isObject() ? PPJsonValue(m_json.toObject().value(QString(key))) : PPJsonValue();
+#endif
+    }
+
+    const PPJsonTapeEntry *tape = m_tape->tape.constData();
+    const PPJsonTapeEntry &e = tape[m_index];
+    if (e.type != PPJsonTapeEntry::Object) {
+        return PPJsonValue();
+    }
+
+    const QByteArray k = QByteArray::fromRawData(key.data(), key.size());
+
+    quint32 i = m_index + 1;
+    while (i < e.next) {
+        const PPJsonTapeEntry &ke = tape[i];
+        if (ke.flags & PPJsonTapeEntry::Escaped) {
+            if (PPJsonDocumentData::unescape(m_tape->at(ke), ke.size) == k) {
+                return PPJsonValue(m_tape, i + 1);
+            }
+        } else if (ke.size == static_cast<quint32>(key.size()) && memcmp(m_tape->at(ke), key.data(), ke.size) == 0) {
+            return PPJsonValue(m_tape, i + 1);
+        }
+        i = tape[i + 1].next;
+    }
+
+    return PPJsonValue();
+}
+
+
+
+PPJsonValue PPJsonValue::at(int i) const
+{
+    if (!m_tape) {
+        return m_json.isArray() ? PPJsonValue(m_json.toArray().at(i)) : PPJsonValue();
+    }
+
+    const PPJsonTapeEntry *tape = m_tape->tape.constData();
+    const PPJsonTapeEntry &e = tape[m_index];
+    if (e.type != PPJsonTapeEntry::Array || i < 0 || i >= static_cast<int>(e.count)) {
+        return PPJsonValue();
+    }
+
+    quint32 j = m_index + 1;
+    while (i-- > 0) {
+        j = tape[j].next;
+    }
+
+    return PPJsonValue(m_tape, j);
+}
+
+
+
+QJsonValue PPJsonValue::toJsonValue() const
+{
+    if (!m_tape) {
+        return m_json;
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    switch (e.type) {
+    case PPJsonTapeEntry::Null:
+        return QJsonValue(QJsonValue::Null);
+    case PPJsonTapeEntry::False:
+        return QJsonValue(false);
+    case PPJsonTapeEntry::True:
+        return QJsonValue(true);
+    case PPJsonTapeEntry::Number:
+        return QJsonValue(PPJsonDocumentData::number(m_tape->at(e), e.size));
+    case PPJsonTapeEntry::String:
+        return QJsonValue(m_tape->string(e));
+    case PPJsonTapeEntry::Array:
+        return QJsonValue(QJsonDocument::fromJson(QByteArray::fromRawData(m_tape->at(e), e.size)).array());
+    case PPJsonTapeEntry::Object:
+        return QJsonValue(QJsonDocument::fromJson(QByteArray::fromRawData(m_tape->at(e), e.size)).object());
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+
+
+QByteArray PPJsonValue::toJson() const
+{
+    if (!m_tape) {
+        if (m_json.isObject()) {
+            return QJsonDocument(m_json.toObject()).toJson(QJsonDocument::Compact);
+        } else if (m_json.isArray()) {
+            return QJsonDocument(m_json.toArray()).toJson(QJsonDocument::Compact);
+        } else if (m_json.isUndefined()) {
+            return QByteArray();
+        }
+        // QJsonDocument can only write objects and arrays, so write the value as single array element
+        const QByteArray a = QJsonDocument(QJsonArray({m_json})).toJson(QJsonDocument::Compact);
+        return a.mid(1, a.size() - 2);
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type == PPJsonTapeEntry::String) {
+        return QByteArray(m_tape->at(e) - 1, e.size + 2);
+    }
+
+    return QByteArray(m_tape->at(e), e.size);
+}
+
+
+
+PPJsonValue::const_iterator PPJsonValue::constBegin() const
+{
+    if (!m_tape) {
+        return const_iterator(*this, 0);
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type != PPJsonTapeEntry::Object && e.type != PPJsonTapeEntry::Array) {
+        return const_iterator(*this, 0);
+    }
+
+    return const_iterator(*this, m_index + 1);
+}
+
+
+
+PPJsonValue::const_iterator PPJsonValue::constEnd() const
+{
+    if (!m_tape) {
+        return const_iterator(*this, count());
+    }
+
+    const PPJsonTapeEntry &e = m_tape->tape.at(m_index);
+    if (e.type != PPJsonTapeEntry::Object && e.type != PPJsonTapeEntry::Array) {
+        return const_iterator(*this, 0);
+    }
+
+    return const_iterator(*this, e.next);
+}
+
+
+
+PPJsonValue::const_iterator::const_iterator(const PPJsonValue &container, int pos) :
+    m_container(container), m_pos(pos)
+{
+    load();
+}
+
+
+void PPJsonValue::const_iterator::load()
+{
+    const PPJsonValue &c = m_container;
+
+    if (!c.m_tape) {
+        if (c.m_json.isObject()) {
+            const QJsonObject o = c.m_json.toObject();
+            m_value = (m_pos < o.count()) ? PPJsonValue((o.constBegin() + m_pos).value()) : PPJsonValue();
+        } else if (c.m_json.isArray()) {
+            m_value = PPJsonValue(c.m_json.toArray().at(m_pos));
+        } else {
+            m_value = PPJsonValue();
+        }
+        return;
+    }
+
+    const PPJsonTapeEntry &e = c.m_tape->tape.at(c.m_index);
+    if (m_pos <= c.m_index || static_cast<quint32>(m_pos) >= e.next) {
+        m_value = PPJsonValue();
+    } else if (e.type == PPJsonTapeEntry::Object) {
+        m_value = PPJsonValue(c.m_tape, m_pos + 1);
+    } else {
+        m_value = PPJsonValue(c.m_tape, m_pos);
+    }
+}
+
+
+QString PPJsonValue::const_iterator::key() const
+{
+    const PPJsonValue &c = m_container;
+
+    if (!c.m_tape) {
+        if (c.m_json.isObject()) {
+            const QJsonObject o = c.m_json.toObject();
+            if (m_pos < o.count()) {
+                return (o.constBegin() + m_pos).key();
+            }
+        }
+        return QString();
+    }
+
+    const PPJsonTapeEntry &e = c.m_tape->tape.at(c.m_index);
+    if (e.type != PPJsonTapeEntry::Object || m_pos <= c.m_index || static_cast<quint32>(m_pos) >= e.next) {
+        return QString();
+    }
+
+    return c.m_tape->string(c.m_tape->tape.at(m_pos));
+}
+
+
+PPJsonValue::const_iterator &PPJsonValue::const_iterator::operator++()
+{
+    const PPJsonValue &c = m_container;
+
+    if (!c.m_tape) {
+        ++m_pos;
+    } else {
+        const PPJsonTapeEntry *tape = c.m_tape->tape.constData();
+        if (tape[c.m_index].type == PPJsonTapeEntry::Object) {
+            m_pos = tape[m_pos + 1].next;
+        } else {
+            m_pos = tape[m_pos].next;
+        }
+    }
+
+    load();
+
+    return *this;
+}
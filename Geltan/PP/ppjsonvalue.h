@@ -0,0 +1,237 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonvalue.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONVALUE_H
+#define PPJSONVALUE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QLatin1String>
+#include <QJsonValue>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <Geltan/geltan_global.h>
+
+namespace Geltan {
+namespace PP {
+
+class PPJsonDocumentData;
+template<int N> class PPJsonFields;
+
+/*!
+ * \brief Read-only reference to a value in a parsed JSON reply.
+ *
+ * PPJsonValue is what the loadFromJson() functions of the objects read. It either wraps a QJsonValue
+ * or points into the structural index of a PPJsonDocument created by an on-demand parser. In the
+ * latter case nothing is decoded up front: strings and numbers are converted from the reply data
+ * when they are requested and member names are compared on their raw bytes.
+ *
+ * The interface follows QJsonValue, QJsonObject and QJsonArray. Converting a value to a type it does
+ * not have returns the default value, toObject() and toArray() return an undefined PPJsonValue that
+ * is empty.
+ *
+ * A PPJsonValue taken from a PPJsonDocument is only valid as long as that document exists. Use
+ * toJsonValue() to keep a copy that is independent of the document.
+ *
+ * \headerfile "" <Geltan/PP/ppjsonvalue.h>
+ */
+class GELTANSHARED_EXPORT PPJsonValue
+{
+public:
+    /*!
+     * \brief Constructs a new undefined PPJsonValue.
+     */
+    PPJsonValue();
+
+    /*!
+     * \brief Constructs a new PPJsonValue wrapping \a value.
+     */
+    explicit PPJsonValue(const QJsonValue &value);
+
+    /*!
+     * \brief Constructs a new PPJsonValue wrapping \a object.
+     */
+    explicit PPJsonValue(const QJsonObject &object);
+
+    /*!
+     * \brief Constructs a new PPJsonValue wrapping \a array.
+     */
+    explicit PPJsonValue(const QJsonArray &array);
+
+    /*!
+     * \brief Returns the type of the value, using the types of QJsonValue.
+     */
+    QJsonValue::Type type() const;
+
+    bool isUndefined() const { return type() == QJsonValue::Undefined; }
+    bool isNull() const { return type() == QJsonValue::Null; }
+    bool isBool() const { return type() == QJsonValue::Bool; }
+    bool isDouble() const { return type() == QJsonValue::Double; }
+    bool isString() const { return type() == QJsonValue::String; }
+    bool isArray() const { return type() == QJsonValue::Array; }
+    bool isObject() const { return type() == QJsonValue::Object; }
+
+    /*!
+     * \brief Returns the boolean value or \a defaultValue if the value is not a boolean.
+     */
+    bool toBool(bool defaultValue = false) const;
+
+    /*!
+     * \brief Returns the number converted to int or \a defaultValue if the value is not an integral number.
+     */
+    int toInt(int defaultValue = 0) const;
+
+    /*!
+     * \brief Returns the number or \a defaultValue if the value is not a number.
+     */
+    double toDouble(double defaultValue = 0) const;
+
+    /*!
+     * \brief Returns the string or \a defaultValue if the value is not a string.
+     */
+    QString toString(const QString &defaultValue = QString()) const;
+
+    /*!
+     * \brief Returns the UTF-8 encoded string or number token without decoding it into a QString.
+     *
+     * Escape sequences in strings are resolved. Returns an empty QByteArray for all other types.
+     */
+    QByteArray toUtf8() const;
+
+    /*!
+     * \brief Returns this value if it is an object, otherwise an undefined value.
+     */
+    PPJsonValue toObject() const;
+
+    /*!
+     * \brief Returns this value if it is an array, otherwise an undefined value.
+     */
+    PPJsonValue toArray() const;
+
+    /*!
+     * \brief Returns the number of members of an object or elements of an array, 0 for all other types.
+     */
+    int count() const;
+
+    /*!
+     * \brief Returns true if count() is 0.
+     */
+    bool isEmpty() const { return count() == 0; }
+
+    /*!
+     * \brief Returns the member \a key of an object, or an undefined value if there is no such member.
+     *
+     * Members are searched linearly, use PPJsonFields to read many members of an object in one pass.
+     */
+    PPJsonValue value(QLatin1String key) const;
+
+    /*!
+     * \brief Returns the element at position \a i of an array, or an undefined value if there is no such element.
+     */
+    PPJsonValue at(int i) const;
+
+    /*!
+     * \brief Returns a QJsonValue copy of the value that is independent of the document.
+     */
+    QJsonValue toJsonValue() const;
+
+    /*!
+     * \brief Returns a QJsonObject copy of the value, or an empty QJsonObject if the value is not an object.
+     */
+    QJsonObject toJsonObject() const { return toJsonValue().toObject(); }
+
+    /*!
+     * \brief Returns a QJsonArray copy of the value, or an empty QJsonArray if the value is not an array.
+     */
+    QJsonArray toJsonArray() const { return toJsonValue().toArray(); }
+
+    /*!
+     * \brief Returns the compact JSON text of the value.
+     *
+     * For values from an on-demand index this is the unmodified text of the reply data.
+     */
+    QByteArray toJson() const;
+
+    class const_iterator;
+
+    const_iterator constBegin() const;
+    const_iterator constEnd() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    friend class PPJsonDocument;
+    template<int N> friend class PPJsonFields;
+
+    PPJsonValue(const PPJsonDocumentData *tape, int index) : m_tape(tape), m_index(index) {}
+
+    QJsonValue m_json;
+    const PPJsonDocumentData *m_tape;
+    int m_index;
+};
+
+
+/*!
+ * \brief Iterates over the elements of an array or the members of an object.
+ */
+class GELTANSHARED_EXPORT PPJsonValue::const_iterator
+{
+public:
+    /*!
+     * \brief Constructs an invalid iterator.
+     */
+    const_iterator() : m_pos(0) {}
+
+    /*!
+     * \brief Returns the current element or member value.
+     */
+    const PPJsonValue &operator*() const { return m_value; }
+    const PPJsonValue *operator->() const { return &m_value; }
+
+    /*!
+     * \brief Returns the name of the current member when iterating over an object.
+     */
+    QString key() const;
+
+    const_iterator &operator++();
+    bool operator==(const const_iterator &other) const { return m_pos == other.m_pos; }
+    bool operator!=(const const_iterator &other) const { return m_pos != other.m_pos; }
+
+private:
+    friend class PPJsonValue;
+    const_iterator(const PPJsonValue &container, int pos);
+    void load();
+
+    PPJsonValue m_container;
+    int m_pos;
+    PPJsonValue m_value;
+};
+
+
+inline PPJsonValue::const_iterator PPJsonValue::begin() const { return constBegin(); }
+inline PPJsonValue::const_iterator PPJsonValue::end() const { return constEnd(); }
+
+}
+}
+
+Q_DECLARE_TYPEINFO(Geltan::PP::PPJsonValue, Q_MOVABLE_TYPE);
+
+#endif // PPJSONVALUE_H
@@ -0,0 +1,294 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonwriter.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "ppjsonwriter.h"
+
+using namespace Geltan;
+using namespace PP;
+
+PPJsonWriter::PPJsonWriter(int reserve)
+{
+    m_buffer.reserve(reserve);
+    m_frames.reserve(8);
+}
+
+
+
+
+void PPJsonWriter::beginObject(QLatin1String name)
+{
+    begin(name, '{');
+}
+
+
+
+void PPJsonWriter::endObject()
+{
+    end('}');
+}
+
+
+
+void PPJsonWriter::beginArray(QLatin1String name)
+{
+    begin(name, '[');
+}
+
+
+
+void PPJsonWriter::endArray()
+{
+    end(']');
+}
+
+
+
+
+void PPJsonWriter::writeString(QLatin1String name, const QString &value)
+{
+    separate();
+    writeName(name);
+    appendString(&m_buffer, value);
+}
+
+
+
+void PPJsonWriter::writeString(const QString &value)
+{
+    separate();
+    appendString(&m_buffer, value);
+}
+
+
+
+void PPJsonWriter::writeInt(QLatin1String name, qint64 value)
+{
+    separate();
+    writeName(name);
+
+    char buf[21];
+    int pos = sizeof(buf);
+    quint64 u = (value < 0) ? (0 - static_cast<quint64>(value)) : static_cast<quint64>(value);
+    do {
+        buf[--pos] = static_cast<char>('0' + (u % 10));
+        u /= 10;
+    } while (u != 0);
+    if (value < 0) {
+        buf[--pos] = '-';
+    }
+
+    m_buffer.append(buf + pos, static_cast<int>(sizeof(buf)) - pos);
+}
+
+
+
+void PPJsonWriter::writeInt(qint64 value)
+{
+    writeInt(QLatin1String(), value);
+}
+
+
+
+void PPJsonWriter::writeBool(QLatin1String name, bool value)
+{
+    separate();
+    writeName(name);
+    if (value) {
+        m_buffer.append("true", 4);
+    } else {
+        m_buffer.append("false", 5);
+    }
+}
+
+
+
+void PPJsonWriter::writeBool(bool value)
+{
+    writeBool(QLatin1String(), value);
+}
+
+
+
+
+bool PPJsonWriter::isComplete() const
+{
+    return m_frames.isEmpty() && !m_buffer.isEmpty();
+}
+
+
+
+QByteArray PPJsonWriter::data() const
+{
+    return m_buffer;
+}
+
+
+
+int PPJsonWriter::size() const
+{
+    return m_buffer.size();
+}
+
+
+
+void PPJsonWriter::clear()
+{
+    // truncate() keeps the reserved capacity, clear() would free it
+    m_buffer.truncate(0);
+    m_frames.clear();
+}
+
+
+
+
+void PPJsonWriter::separate()
+{
+    if (!m_frames.isEmpty()) {
+        Frame &f = m_frames.last();
+        if (f.count > 0) {
+            m_buffer.append(',');
+        }
+        ++f.count;
+    }
+}
+
+
+
+void PPJsonWriter::writeName(QLatin1String name)
+{
+    if (name.data()) {
+        m_buffer.append('"');
+        m_buffer.append(name.data(), name.size());
+        m_buffer.append("\":", 2);
+    }
+}
+
+
+
+void PPJsonWriter::begin(QLatin1String name, char open)
+{
+    Frame f;
+    f.start = m_buffer.size();
+    f.count = 0;
+    f.named = (name.data() != nullptr);
+
+    if (!m_frames.isEmpty() && m_frames.last().count > 0) {
+        m_buffer.append(',');
+    }
+    writeName(name);
+    m_buffer.append(open);
+
+    m_frames.append(f);
+}
+
+
+
+void PPJsonWriter::end(char close)
+{
+    if (m_frames.isEmpty()) {
+        return;
+    }
+
+    const Frame f = m_frames.takeLast();
+
+    if (f.named && f.count == 0) {
+        // drop empty named containers together with their name and separator
+        m_buffer.truncate(f.start);
+        return;
+    }
+
+    m_buffer.append(close);
+
+    if (!m_frames.isEmpty()) {
+        ++m_frames.last().count;
+    }
+}
+
+
+
+void PPJsonWriter::appendString(QByteArray *out, const QString &value)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    out->append('"');
+
+    const QChar *c = value.constData();
+    const QChar *e = c + value.size();
+
+    for (; c != e; ++c) {
+        const ushort u = c->unicode();
+
+        if (u < 0x80) {
+            if (u >= 0x20 && u != '"' && u != '\\') {
+                out->append(static_cast<char>(u));
+                continue;
+            }
+            out->append('\\');
+            switch (u) {
+            case '"':
+                out->append('"');
+                break;
+            case '\\':
+                out->append('\\');
+                break;
+            case '\b':
+                out->append('b');
+                break;
+            case '\f':
+                out->append('f');
+                break;
+            case '\n':
+                out->append('n');
+                break;
+            case '\r':
+                out->append('r');
+                break;
+            case '\t':
+                out->append('t');
+                break;
+            default:
+                out->append("u00", 3);
+                out->append(hex[u >> 4]);
+                out->append(hex[u & 0xf]);
+                break;
+            }
+        } else if (u < 0x800) {
+            out->append(static_cast<char>(0xc0 | (u >> 6)));
+            out->append(static_cast<char>(0x80 | (u & 0x3f)));
+        } else if (QChar::isHighSurrogate(u) && (c + 1) != e && (c + 1)->isLowSurrogate()) {
+            ++c;
+            const uint ucs4 = QChar::surrogateToUcs4(u, c->unicode());
+            out->append(static_cast<char>(0xf0 | (ucs4 >> 18)));
+            out->append(static_cast<char>(0x80 | ((ucs4 >> 12) & 0x3f)));
+            out->append(static_cast<char>(0x80 | ((ucs4 >> 6) & 0x3f)));
+            out->append(static_cast<char>(0x80 | (ucs4 & 0x3f)));
+        } else if (QChar::isSurrogate(u)) {
+            // unpaired surrogates are not valid UTF-16, replace them like QString::toUtf8() does
+            out->append("\xef\xbf\xbd", 3);
+        } else {
+            out->append(static_cast<char>(0xe0 | (u >> 12)));
+            out->append(static_cast<char>(0x80 | ((u >> 6) & 0x3f)));
+            out->append(static_cast<char>(0x80 | (u & 0x3f)));
+        }
+    }
+
+    out->append('"');
+}
@@ -0,0 +1,164 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppjsonwriter.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPJSONWRITER_H
+#define PPJSONWRITER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <Geltan/geltan_global.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \brief Writes compact UTF-8 encoded JSON directly into a single QByteArray.
+ *
+ * PPJsonWriter is used by the writeJson() functions of the payment objects to serialize request payloads
+ * without building intermediate QVariantMap, QJsonObject and QJsonDocument trees. The output contains no
+ * whitespace and the buffer is reserved up front, so a typical payload is written with a single allocation.
+ *
+ * Objects and arrays that have a \a name are omitted completely if nothing has been written into them,
+ * the same way as the toVariant() functions omit empty maps and lists. Unnamed objects and arrays, like
+ * the root object or array elements, are always written. Names have to be plain ASCII, they are not escaped.
+ *
+ * \code{.cpp}
+ * Geltan::PP::PPJsonWriter writer;
+ * writer.beginObject();
+ * writer.writeString(QLatin1String("intent"), QStringLiteral("sale"));
+ * writer.beginObject(QLatin1String("payer"));
+ * writer.writeString(QLatin1String("payment_method"), QStringLiteral("paypal"));
+ * writer.endObject();
+ * writer.endObject();
+ * writer.data(); // {"intent":"sale","payer":{"payment_method":"paypal"}}
+ * \endcode
+ *
+ * \headerfile "" <Geltan/PP/ppjsonwriter.h>
+ */
+class GELTANSHARED_EXPORT PPJsonWriter
+{
+public:
+    /*!
+     * \brief Constructs a new PPJsonWriter and reserves \a reserve bytes for the output.
+     */
+    explicit PPJsonWriter(int reserve = 1024);
+
+    /*!
+     * \brief Starts a new object. If \a name is not null, the object is written as member \a name of the current object.
+     */
+    void beginObject(QLatin1String name = QLatin1String());
+
+    /*!
+     * \brief Closes the current object.
+     */
+    void endObject();
+
+    /*!
+     * \brief Starts a new array. If \a name is not null, the array is written as member \a name of the current object.
+     */
+    void beginArray(QLatin1String name = QLatin1String());
+
+    /*!
+     * \brief Closes the current array.
+     */
+    void endArray();
+
+    /*!
+     * \brief Writes the string \a value as member \a name of the current object.
+     */
+    void writeString(QLatin1String name, const QString &value);
+
+    /*!
+     * \brief Writes the string \a value as element of the current array.
+     * \overload
+     */
+    void writeString(const QString &value);
+
+    /*!
+     * \brief Writes the integer \a value as member \a name of the current object.
+     */
+    void writeInt(QLatin1String name, qint64 value);
+
+    /*!
+     * \brief Writes the integer \a value as element of the current array.
+     * \overload
+     */
+    void writeInt(qint64 value);
+
+    /*!
+     * \brief Writes the boolean \a value as member \a name of the current object.
+     */
+    void writeBool(QLatin1String name, bool value);
+
+    /*!
+     * \brief Writes the boolean \a value as element of the current array.
+     * \overload
+     */
+    void writeBool(bool value);
+
+    /*!
+     * \brief Returns true if all objects and arrays have been closed.
+     */
+    bool isComplete() const;
+
+    /*!
+     * \brief Returns the JSON written so far.
+     *
+     * The returned QByteArray shares the data with the writer, it is not copied as long as the writer is not used anymore.
+     */
+    QByteArray data() const;
+
+    /*!
+     * \brief Returns the number of bytes written so far.
+     */
+    int size() const;
+
+    /*!
+     * \brief Clears the written data but keeps the reserved memory.
+     */
+    void clear();
+
+    /*!
+     * \brief Appends \a value as quoted and escaped UTF-8 encoded JSON string to \a out.
+     */
+    static void appendString(QByteArray *out, const QString &value);
+
+private:
+    struct Frame {
+        int start;      // output position before the separator and the name
+        int count;      // number of members or elements written into the frame
+        bool named;
+    };
+
+    void separate();
+    void writeName(QLatin1String name);
+    void begin(QLatin1String name, char open);
+    void end(char close);
+
+    QByteArray m_buffer;
+    QVector<Frame> m_frames;
+};
+
+}
+}
+
+#endif // PPJSONWRITER_H
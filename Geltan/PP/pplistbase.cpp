@@ -20,6 +20,10 @@
  */
 
 #include "pplistbase_p.h"
+#include <QJsonDocument>
+#ifdef QT_DEBUG
+#include <QtDebug>
+#endif
 
 using namespace Geltan;
 using namespace PP;
@@ -34,3 +38,86 @@ PPListBase::PPListBase(PPListBasePrivate &dd, QObject *parent) : PPBase(dd, pare
 {
 
 }
+
+
+
+void PPListBase::paginate(const PageConsumer &consumer)
+{
+    Q_D(PPListBase);
+
+    if (!consumer || d->paginating || inOperation()) {
+        return;
+    }
+
+    d->pageConsumer = consumer;
+    d->paginating = true;
+    d->pagesConsumed = 0;
+    Q_EMIT pagesConsumedChanged(0);
+    Q_EMIT paginatingChanged(true);
+
+    requestPage(QString());
+}
+
+
+
+bool PPListBase::consumePage()
+{
+    Q_D(PPListBase);
+
+    if (!d->paginating) {
+        return false;
+    }
+
+    // take the page out of the reply data, only the page that is currently consumed stays in memory
+    const PPJsonDocument doc = jsonData();
+    const PPJsonValue page = doc.root();
+    setJsonResult(QJsonDocument());
+    d->result.clear();
+
+    const QString nextId = page.value(QLatin1String("next_id")).toString();
+    const PageConsumer consumer = d->pageConsumer;
+
+    if (!nextId.isEmpty()) {
+        requestPage(nextId);
+    }
+
+    const bool proceed = consumer(page);
+
+    ++d->pagesConsumed;
+    Q_EMIT pagesConsumedChanged(d->pagesConsumed);
+
+#ifdef QT_DEBUG
+    qDebug() << "Consumed page" << d->pagesConsumed << "with next ID" << nextId;
+#endif
+
+    if (d->paginating) {
+        if (nextId.isEmpty()) {
+            finishPagination();
+        } else if (!proceed) {
+            // the prefetched page is not needed anymore, drop the request before it is sent
+            abortRequest();
+            finishPagination();
+        }
+    }
+
+    return true;
+}
+
+
+
+void PPListBase::finishPagination()
+{
+    Q_D(PPListBase);
+
+    if (d->paginating) {
+        d->pageConsumer = PageConsumer();
+        d->paginating = false;
+        Q_EMIT paginatingChanged(false);
+    }
+}
+
+
+
+bool PPListBase::paginating() const { Q_D(const PPListBase); return d->paginating; }
+
+int PPListBase::pagesConsumed() const { Q_D(const PPListBase); return d->pagesConsumed; }
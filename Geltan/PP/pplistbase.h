@@ -23,22 +23,107 @@
 #define PPLISTBASE_H
 
 #include "ppbase.h"
+#include <functional>
+
+class QJsonObject;
 
 namespace Geltan {
 namespace PP {
 
 class PPListBasePrivate;
 
+/*!
+ * \brief Base class for PayPal API list operations.
+ *
+ * Provides a paginator that follows the \c next_id of the returned pages and hands the
+ * pages one by one to a consumer function. While a page is consumed, the next page is already
+ * requested, so the network transfer and the processing of the data overlap. If the consumer
+ * stops the pagination, the request for the prefetched page is aborted. A consumed page
+ * is released before the next one is processed, so the memory usage does not depend on the
+ * number of pages.
+ *
+ * Subclasses have to implement requestPage() and have to call consumePage() in their success
+ * callback.
+ *
+ * \headerfile "" <Geltan/PP/pplistbase.h>
+ */
 class GELTANSHARED_EXPORT PPListBase : public PPBase
 {
     Q_OBJECT
+    /*!
+     * \brief Returns true while a pagination started by paginate() is running.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>bool</TD><TD>paginating() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>paginatingChanged(bool paginating)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(bool paginating READ paginating NOTIFY paginatingChanged)
+    /*!
+     * \brief Number of pages that have been consumed by the current or last pagination.
+     *
+     * \par Access functions:
+     * <TABLE><TR><TD>int</TD><TD>pagesConsumed() const</TD></TR></TABLE>
+     * \par Notifier signal:
+     * <TABLE><TR><TD>void</TD><TD>pagesConsumedChanged(int pagesConsumed)</TD></TR></TABLE>
+     */
+    Q_PROPERTY(int pagesConsumed READ pagesConsumed NOTIFY pagesConsumedChanged)
 public:
     /*!
      * \brief Constructs a new PPListBase object.
      */
     PPListBase(QObject *parent = nullptr);
 
+    /*!
+     * \brief Function that gets the returned pages.
+     *
+     * Gets the complete JSON object of a single page. The page and all values taken from it are only
+     * valid during the call. Has to return false to stop the pagination.
+     */
+    typedef std::function<bool(const PPJsonValue &page)> PageConsumer;
+
+    /*!
+     * \brief Requests all pages and hands them to the \a consumer.
+     *
+     * The first page is requested with the current settings of the operation, the following
+     * pages start at the \c next_id of their previous page. The pagination ends when a page
+     * has no \c next_id, when the \a consumer returns false or when a request fails.
+     *
+     * Does nothing if the operation is currently in operation.
+     */
+    void paginate(const PageConsumer &consumer);
+
+    bool paginating() const;
+    int pagesConsumed() const;
+
+Q_SIGNALS:
+    void paginatingChanged(bool paginating);
+    void pagesConsumedChanged(int pagesConsumed);
+
 protected:
+    /*!
+     * \brief Requests the page starting at \a startId.
+     *
+     * If \a startId is empty, the first page has to be requested with the current settings.
+     */
+    virtual void requestPage(const QString &startId) = 0;
+
+    /*!
+     * \brief Hands the current result to the page consumer if a pagination is running.
+     *
+     * Requests the next page before the current one is consumed and aborts that request if the
+     * consumer returns false. The result data is released before the consumer is called. Returns false if no pagination is running, in that case
+     * the result data has not been touched.
+     */
+    bool consumePage();
+
+    /*!
+     * \brief Stops a running pagination.
+     *
+     * Should be called from the error callback.
+     */
+    void finishPagination();
+
     PPListBase(PPListBasePrivate &dd, QObject *parent = nullptr);
 
 private:
@@ -30,9 +30,14 @@ namespace PP {
 
 class PPListBasePrivate : public PPBasePrivate {
 public:
-    PPListBasePrivate()
+    PPListBasePrivate() :
+        pagesConsumed(0),
+        paginating(false)
     {}
 
+    PPListBase::PageConsumer pageConsumer;
+    int pagesConsumed;
+    bool paginating;
 
 };
 
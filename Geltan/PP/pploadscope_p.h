@@ -0,0 +1,128 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/pploadscope_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPLOADSCOPE_P_H
+#define PPLOADSCOPE_P_H
+
+#include <QObject>
+#include <QMetaObject>
+#include <QMetaProperty>
+#include <QMetaMethod>
+#include <QVariant>
+#include <QVarLengthArray>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Suppresses the property notifications of an object while it is loading data.
+ *
+ * While the scope exists, the signals of the object are blocked. On construction the values of all
+ * properties whose notifier signal is connected are recorded, on destruction the signals are unblocked
+ * again and the notifier signals of those properties whose value actually changed are emitted once.
+ * Properties without connected notifier signals are neither recorded nor compared, so loading an object
+ * that nobody listens to costs no signal emission at all.
+ *
+ * The \a isConnected functor has to return true if the signal given as QMetaMethod is connected.
+ * As QObject::isSignalConnected() is protected, it is called from within the loading member function:
+ *
+ * \code
+ * PPLoadScope scope(this, [this](const QMetaMethod &s) { return isSignalConnected(s); });
+ * \endcode
+ *
+ * Item models have to use Unblocked around the code that inserts or removes rows, views rely on
+ * receiving these signals immediately.
+ */
+class PPLoadScope
+{
+public:
+    template<typename IsConnected>
+    PPLoadScope(QObject *object, IsConnected isConnected) :
+        m_object(object),
+        m_wasBlocked(object->signalsBlocked())
+    {
+        const QMetaObject *mo = object->metaObject();
+        for (int i = QObject::staticMetaObject.propertyCount(); i < mo->propertyCount(); ++i) {
+            const QMetaProperty prop = mo->property(i);
+            if (prop.hasNotifySignal() && isConnected(prop.notifySignal())) {
+                m_snapshot.append(Entry(prop, prop.read(object)));
+            }
+        }
+        m_object->blockSignals(true);
+    }
+
+    ~PPLoadScope()
+    {
+        m_object->blockSignals(m_wasBlocked);
+
+        if (m_wasBlocked) {
+            return;
+        }
+
+        for (const Entry &e : m_snapshot) {
+            const QVariant value = e.property.read(m_object);
+            if (value != e.value) {
+                const QMetaMethod signal = e.property.notifySignal();
+                if (signal.parameterCount() > 0) {
+                    signal.invoke(m_object, Qt::DirectConnection, QGenericArgument(value.typeName(), value.constData()));
+                } else {
+                    signal.invoke(m_object, Qt::DirectConnection);
+                }
+            }
+        }
+    }
+
+    /*!
+     * \internal
+     * \brief Temporarily restores the original signal blocking state of the object of a PPLoadScope.
+     */
+    class Unblocked
+    {
+    public:
+        explicit Unblocked(const PPLoadScope *scope) : m_scope(scope) { m_scope->m_object->blockSignals(m_scope->m_wasBlocked); }
+        ~Unblocked() { m_scope->m_object->blockSignals(true); }
+
+    private:
+        Q_DISABLE_COPY(Unblocked)
+        const PPLoadScope *m_scope;
+    };
+
+private:
+    Q_DISABLE_COPY(PPLoadScope)
+
+    struct Entry
+    {
+        Entry() {}
+        Entry(const QMetaProperty &p, const QVariant &v) : property(p), value(v) {}
+        QMetaProperty property;
+        QVariant value;
+    };
+
+    QObject *m_object;
+    bool m_wasBlocked;
+    QVarLengthArray<Entry, 8> m_snapshot;
+};
+
+}
+}
+
+#endif // PPLOADSCOPE_P_H
@@ -0,0 +1,128 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppstringpool.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "ppstringpool.h"
+#include <QSet>
+#include <QMutex>
+#include <QMutexLocker>
+
+using namespace Geltan;
+using namespace PP;
+
+namespace {
+
+struct StringPoolData
+{
+    QMutex mutex;
+    QSet<QString> strings;
+    quint64 hits = 0;
+    quint64 savedBytes = 0;
+};
+
+}
+
+Q_GLOBAL_STATIC(StringPoolData, ppStringPool)
+
+
+QString PPStringPool::intern(const QString &str)
+{
+    if (str.isEmpty() || str.size() > maxLength()) {
+        return str;
+    }
+
+    StringPoolData *p = ppStringPool();
+    if (!p) {
+        // pool already destroyed during application exit
+        return str;
+    }
+
+    QMutexLocker locker(&p->mutex);
+
+    QSet<QString>::const_iterator it = p->strings.constFind(str);
+    if (it != p->strings.constEnd()) {
+        if (it->constData() != str.constData()) {
+            ++p->hits;
+            p->savedBytes += static_cast<quint64>(sizeof(QArrayData)) + static_cast<quint64>(str.size() + 1) * sizeof(QChar);
+        }
+        return *it;
+    }
+
+    p->strings.insert(str);
+
+    return str;
+}
+
+
+
+int PPStringPool::maxLength()
+{
+    return 32;
+}
+
+
+
+int PPStringPool::size()
+{
+    StringPoolData *p = ppStringPool();
+    if (!p) {
+        return 0;
+    }
+    QMutexLocker locker(&p->mutex);
+    return p->strings.size();
+}
+
+
+
+quint64 PPStringPool::hits()
+{
+    StringPoolData *p = ppStringPool();
+    if (!p) {
+        return 0;
+    }
+    QMutexLocker locker(&p->mutex);
+    return p->hits;
+}
+
+
+
+quint64 PPStringPool::savedBytes()
+{
+    StringPoolData *p = ppStringPool();
+    if (!p) {
+        return 0;
+    }
+    QMutexLocker locker(&p->mutex);
+    return p->savedBytes;
+}
+
+
+
+void PPStringPool::clear()
+{
+    StringPoolData *p = ppStringPool();
+    if (!p) {
+        return;
+    }
+    QMutexLocker locker(&p->mutex);
+    p->strings.clear();
+    p->hits = 0;
+    p->savedBytes = 0;
+}
@@ -0,0 +1,95 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/ppstringpool.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPSTRINGPOOL_H
+#define PPSTRINGPOOL_H
+
+#include <QString>
+#include <Geltan/geltan_global.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \brief Process wide pool of shared strings for values that repeat across many payments.
+ *
+ * Pages of payments repeat the same short values over and over: currency and country codes, link
+ * relations and methods or address types. Every QString read from a JSON document allocates its own
+ * buffer, even if the same value has been read a thousand times before. The loadFromJson() functions
+ * pass such low cardinality values through intern(), so all equal values share a single implicitly
+ * shared buffer and the buffers read from the JSON document are freed immediately.
+ *
+ * Values with more than maxLength() characters are returned unchanged, they are unlikely to repeat and
+ * would let the pool grow without bounds. All functions are thread-safe.
+ *
+ * savedBytes() returns the number of bytes that have not been kept in memory because a value has been
+ * found in the pool, which allows to verify the effect on large data sets.
+ *
+ * \headerfile "" <Geltan/PP/ppstringpool.h>
+ */
+class GELTANSHARED_EXPORT PPStringPool
+{
+public:
+    /*!
+     * \brief Returns a string equal to \a str that shares its data with all other interned equal strings.
+     *
+     * If the value is not yet part of the pool, \a str itself is added.
+     */
+    static QString intern(const QString &str);
+
+    /*!
+     * \brief Returns the maximum number of characters a string can have to be interned.
+     */
+    static int maxLength();
+
+    /*!
+     * \brief Returns the number of distinct strings in the pool.
+     */
+    static int size();
+
+    /*!
+     * \brief Returns the number of intern() calls that have been answered from the pool.
+     */
+    static quint64 hits();
+
+    /*!
+     * \brief Returns the estimated number of bytes saved by answering intern() calls from the pool.
+     *
+     * Every hit saves the string data of the passed value together with its allocation header.
+     */
+    static quint64 savedBytes();
+
+    /*!
+     * \brief Removes all strings from the pool and resets the counters.
+     *
+     * Strings that have already been returned by intern() stay valid, they only stop sharing
+     * their data with values interned afterwards.
+     */
+    static void clear();
+
+private:
+    PPStringPool() {}
+};
+
+}
+}
+
+#endif // PPSTRINGPOOL_H
@@ -0,0 +1,288 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/pptimestamp.cpp
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "pptimestamp.h"
+#include <QHash>
+#include <limits>
+
+using namespace Geltan;
+using namespace PP;
+
+const qint64 PPTimestamp::Invalid = std::numeric_limits<qint64>::min();
+
+namespace {
+
+/*
+ * Small direct mapped cache of parse results. Each thread has its own, so no locking is needed.
+ * Timestamps within a page of payments often repeat, for example create and update time of
+ * unchanged payments or the times of the related resources.
+ */
+struct CacheEntry
+{
+    QString str;
+    qint64 msecs;
+};
+
+const int CacheSize = 64;
+
+thread_local CacheEntry cache[CacheSize];
+
+
+inline int digits(const QChar *c, int count, bool *ok)
+{
+    int v = 0;
+    for (int i = 0; i < count; ++i) {
+        const ushort u = c[i].unicode();
+        if (u < '0' || u > '9') {
+            *ok = false;
+            return 0;
+        }
+        v = v * 10 + (u - '0');
+    }
+    return v;
+}
+
+
+// days since 1970-01-01 of a date in the proleptic Gregorian calendar
+inline qint64 daysFromCivil(int y, int m, int d)
+{
+    y -= (m <= 2) ? 1 : 0;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era * 400;
+    const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast<qint64>(era) * 146097 + doe - 719468;
+}
+
+
+inline int daysInMonth(int y, int m)
+{
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (m == 2 && ((y % 4 == 0 && y % 100 != 0) || y % 400 == 0)) {
+        return 29;
+    }
+    return days[m - 1];
+}
+
+
+/*
+ * Parses YYYY-MM-DDTHH:MM:SS[.fraction][Z|+HH:MM|-HH:MM], returns false for anything else.
+ */
+bool parseRfc3339(const QString &str, qint64 *msecs)
+{
+    const int len = str.size();
+    if (len < 19) {
+        return false;
+    }
+
+    const QChar *c = str.constData();
+
+    if (c[4] != QLatin1Char('-') || c[7] != QLatin1Char('-') || c[13] != QLatin1Char(':') || c[16] != QLatin1Char(':')) {
+        return false;
+    }
+
+    const ushort sep = c[10].unicode();
+    if (sep != 'T' && sep != 't' && sep != ' ') {
+        return false;
+    }
+
+    bool ok = true;
+    const int year = digits(c, 4, &ok);
+    const int month = digits(c + 5, 2, &ok);
+    const int day = digits(c + 8, 2, &ok);
+    const int hour = digits(c + 11, 2, &ok);
+    const int minute = digits(c + 14, 2, &ok);
+    const int second = digits(c + 17, 2, &ok);
+
+    if (!ok || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    int pos = 19;
+    int millis = 0;
+
+    if (pos < len && c[pos] == QLatin1Char('.')) {
+        ++pos;
+        const int start = pos;
+        int scale = 100;
+        while (pos < len && c[pos].unicode() >= '0' && c[pos].unicode() <= '9') {
+            millis += (c[pos].unicode() - '0') * scale;
+            scale /= 10;
+            ++pos;
+        }
+        if (pos == start) {
+            return false;
+        }
+    }
+
+    // without an offset Qt takes the time as local time, leave that to the fallback
+    if (pos == len) {
+        return false;
+    }
+
+    int offset = 0;
+
+    const ushort z = c[pos].unicode();
+    if (z == 'Z' || z == 'z') {
+        ++pos;
+    } else if (z == '+' || z == '-') {
+        ++pos;
+        if (len - pos == 5 && c[pos + 2] == QLatin1Char(':')) {
+            offset = digits(c + pos, 2, &ok) * 60 + digits(c + pos + 3, 2, &ok);
+        } else if (len - pos == 4) {
+            offset = digits(c + pos, 2, &ok) * 60 + digits(c + pos + 2, 2, &ok);
+        } else {
+            return false;
+        }
+        if (!ok) {
+            return false;
+        }
+        if (z == '+') {
+            offset = -offset;
+        }
+        pos = len;
+    } else {
+        return false;
+    }
+
+    if (pos != len) {
+        return false;
+    }
+
+    const qint64 secs = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second + offset * 60;
+    *msecs = secs * 1000 + millis;
+
+    return true;
+}
+
+}
+
+
+qint64 PPTimestamp::parse(const QString &str, bool *ok)
+{
+    if (str.isEmpty()) {
+        if (ok) {
+            *ok = false;
+        }
+        return Invalid;
+    }
+
+    CacheEntry &e = cache[qHash(str) % CacheSize];
+    if (e.str == str) {
+        if (ok) {
+            *ok = (e.msecs != Invalid);
+        }
+        return e.msecs;
+    }
+
+    qint64 msecs = Invalid;
+    if (!parseRfc3339(str, &msecs)) {
+        // fall back to Qt for everything that is not a plain RFC 3339 timestamp
+        const QDateTime dt = QDateTime::fromString(str, Qt::ISODate);
+        msecs = dt.isValid() ? dt.toMSecsSinceEpoch() : Invalid;
+    }
+
+    e.str = str;
+    e.msecs = msecs;
+
+    if (ok) {
+        *ok = (msecs != Invalid);
+    }
+
+    return msecs;
+}
+
+
+
+QString PPTimestamp::format(qint64 msecs)
+{
+    if (msecs == Invalid) {
+        return QString();
+    }
+
+    qint64 secs = msecs / 1000;
+    if (msecs % 1000 < 0) {
+        --secs;
+    }
+    qint64 days = secs / 86400;
+    int rem = static_cast<int>(secs % 86400);
+    if (rem < 0) {
+        rem += 86400;
+        --days;
+    }
+
+    // civil date from days since 1970-01-01
+    const qint64 z = days + 719468;
+    const qint64 era = (z >= 0 ? z : z - 146096) / 146097;
+    const int doe = static_cast<int>(z - era * 146097);
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int mp = (5 * doy + 2) / 153;
+    const int day = doy - (153 * mp + 2) / 5 + 1;
+    const int month = mp + (mp < 10 ? 3 : -9);
+    const qint64 year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+    if (year < 0 || year > 9999) {
+        return QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC).toString(Qt::ISODate);
+    }
+
+    char buf[20];
+    const int fields[] = {static_cast<int>(year) / 100, static_cast<int>(year) % 100, month, day, rem / 3600, (rem / 60) % 60, rem % 60};
+    const char seps[] = {0, '-', '-', 'T', ':', ':', 'Z'};
+    int pos = 0;
+    for (int i = 0; i < 7; ++i) {
+        buf[pos++] = static_cast<char>('0' + fields[i] / 10);
+        buf[pos++] = static_cast<char>('0' + fields[i] % 10);
+        if (seps[i]) {
+            buf[pos++] = seps[i];
+        }
+    }
+
+    return QString::fromLatin1(buf, pos);
+}
+
+
+
+QString PPTimestamp::format(const QDateTime &dateTime)
+{
+    return format(toMSecs(dateTime));
+}
+
+
+
+QDateTime PPTimestamp::toDateTime(qint64 msecs)
+{
+    return (msecs == Invalid) ? QDateTime() : QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+}
+
+
+
+QDateTime PPTimestamp::toDateTime(const QString &str)
+{
+    return toDateTime(parse(str));
+}
+
+
+
+qint64 PPTimestamp::toMSecs(const QDateTime &dateTime)
+{
+    return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : Invalid;
+}
@@ -0,0 +1,97 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/pptimestamp.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPTIMESTAMP_H
+#define PPTIMESTAMP_H
+
+#include <QString>
+#include <QDateTime>
+#include <Geltan/geltan_global.h>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \brief Parses and formats the RFC 3339 timestamps used by the PayPal API.
+ *
+ * The API returns all times like \c create_time or \c update_time as RFC 3339 strings like
+ * \c 2016-03-21T14:02:33Z. Parsing them with QDateTime::fromString() is one of the most expensive
+ * per-field operations when loading a list of payments. parse() converts such a string directly
+ * into milliseconds since the epoch in UTC, without creating a QDateTime, and keeps the last
+ * results in a small per thread cache, as times often repeat within a page of payments.
+ *
+ * Strings that are not in the expected format are passed to QDateTime::fromString() with Qt::ISODate,
+ * so the results are the same as before for all input. This includes times without an offset or \c Z,
+ * which Qt takes as local time.
+ *
+ * \headerfile "" <Geltan/PP/pptimestamp.h>
+ */
+class GELTANSHARED_EXPORT PPTimestamp
+{
+public:
+    /*!
+     * \brief Value returned for invalid or empty times.
+     */
+    static const qint64 Invalid;
+
+    /*!
+     * \brief Returns the milliseconds since the epoch in UTC for the RFC 3339 timestamp \a str.
+     *
+     * Returns Invalid if \a str is empty or can not be parsed. If \a ok is not a \c nullptr, it is
+     * set to false in that case.
+     */
+    static qint64 parse(const QString &str, bool *ok = nullptr);
+
+    /*!
+     * \brief Returns \a msecs formatted as RFC 3339 timestamp in UTC, like QDateTime::toString() with Qt::ISODate.
+     *
+     * Milliseconds are omitted. Returns an empty string if \a msecs is Invalid.
+     */
+    static QString format(qint64 msecs);
+
+    /*!
+     * \overload
+     */
+    static QString format(const QDateTime &dateTime);
+
+    /*!
+     * \brief Returns \a msecs as QDateTime in UTC, or an invalid QDateTime if \a msecs is Invalid.
+     */
+    static QDateTime toDateTime(qint64 msecs);
+
+    /*!
+     * \brief Parses \a str and returns it as QDateTime in UTC, or an invalid QDateTime if \a str can not be parsed.
+     */
+    static QDateTime toDateTime(const QString &str);
+
+    /*!
+     * \brief Returns \a dateTime as milliseconds since the epoch, or Invalid if \a dateTime is not valid.
+     */
+    static qint64 toMSecs(const QDateTime &dateTime);
+
+private:
+    PPTimestamp() {}
+};
+
+}
+}
+
+#endif // PPTIMESTAMP_H
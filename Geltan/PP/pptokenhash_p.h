@@ -0,0 +1,95 @@
+/* libgeltan - Qt based payment service library
+ * Copyright (C) 2016 Buschtrommel / Matthias Fehring
+ * Contact: https://www.buschmann23.de
+ *
+ * Geltan/PP/pptokenhash_p.h
+ *
+ * This library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPTOKENHASH_P_H
+#define PPTOKENHASH_P_H
+
+#include <QString>
+#include <QLatin1String>
+
+namespace Geltan {
+namespace PP {
+
+/*!
+ * \internal
+ * \brief Calculates the 32bit FNV-1a hash of \a token at compile time.
+ *
+ * Used for the case labels of switch statements that map API tokens to enumerations. As the
+ * compiler rejects duplicate case labels, every switch is verified to be free of collisions
+ * and therefore a perfect hash for its token set.
+ */
+constexpr quint32 ppTokenHash(const char *token, quint32 hash = 2166136261u)
+{
+    return *token ? ppTokenHash(token + 1, (hash ^ static_cast<unsigned char>(*token)) * 16777619u) : hash;
+}
+
+/*!
+ * \internal
+ * \brief Calculates the 32bit FNV-1a hash of \a token at runtime.
+ *
+ * Returns the same value as the constexpr overload for ASCII tokens.
+ */
+inline quint32 ppTokenHash(const QString &token)
+{
+    quint32 hash = 2166136261u;
+    const QChar *c = token.constData();
+    const QChar *end = c + token.size();
+    while (c != end) {
+        hash = (hash ^ c->unicode()) * 16777619u;
+        ++c;
+    }
+    return hash;
+}
+
+/*!
+ * \internal
+ * \brief Calculates the 32bit FNV-1a hash of the \a size bytes at \a token at runtime.
+ *
+ * Returns the same value as the constexpr overload for ASCII tokens.
+ */
+inline quint32 ppTokenHash(const char *token, int size)
+{
+    quint32 hash = 2166136261u;
+    const char *end = token + size;
+    while (token != end) {
+        hash = (hash ^ static_cast<unsigned char>(*token)) * 16777619u;
+        ++token;
+    }
+    return hash;
+}
+
+/*!
+ * \internal
+ * \brief Returns \a value if \a token matches \a expected, otherwise \a fallback.
+ *
+ * The hash only selects the candidate, this verifies that the token really is the expected one
+ * and not an unknown token that happens to have the same hash.
+ */
+template<typename T>
+inline T ppTokenCheck(const QString &token, const char *expected, T value, T fallback)
+{
+    return (token == QLatin1String(expected)) ? value : fallback;
+}
+
+}
+}
+
+#endif // PPTOKENHASH_P_H
@@ -113,6 +113,22 @@ void Component::setNetworkOperation(QNetworkAccessManager::Operation operation)
 
 
 
+QByteArray Component::customVerb() const
+{
+    Q_D(const Component);
+    return d->customVerb;
+}
+
+
+
+void Component::setCustomVerb(const QByteArray &verb)
+{
+    Q_D(Component);
+    d->customVerb = verb;
+}
+
+
+
 
 QUrl Component::apiUrl() const
 {
@@ -374,7 +390,7 @@ void Component::sendRequest()
         return;
     }
 
-    if ((d->namOperation == QNetworkAccessManager::PostOperation || d->namOperation == QNetworkAccessManager::PutOperation) && d->payload.isEmpty()) {
+    if ((d->namOperation == QNetworkAccessManager::PostOperation || d->namOperation == QNetworkAccessManager::PutOperation || d->namOperation == QNetworkAccessManager::CustomOperation) && d->payload.isEmpty()) {
         setError(new Error(Error::InputError, tr("Empty payload when trying to perform a POST network operation."), Error::Critical, QString(), this));
         errorCallBack();
         return;
@@ -445,6 +461,31 @@ void Component::sendRequest(const QUrl &url, const QString &path, const QHash<QB
 
 
 
+bool Component::abortRequest()
+{
+    Q_D(Component);
+
+    if (!d->networkReply) {
+        return false;
+    }
+
+    if (d->timeoutTimer && d->timeoutTimer->isActive()) {
+        d->timeoutTimer->stop();
+    }
+
+    QNetworkReply *nr = d->networkReply;
+    d->networkReply = nullptr;
+
+    // abort() emits finished() synchronously, it must not reach the callbacks
+    disconnect(nr, nullptr, this, nullptr);
+    nr->abort();
+    nr->deleteLater();
+
+    return true;
+}
+
+
+
 void Component::_q_requestFinished()
 {
     Q_D(Component);
@@ -453,13 +494,17 @@ void Component::_q_requestFinished()
         d->timeoutTimer->stop();
     }
 
-    d->result = d->networkReply->readAll();
+    // the callbacks might already start a new request that replaces the network reply
+    QNetworkReply *reply = d->networkReply;
+    d->networkReply = nullptr;
+
+    d->result = reply->readAll();
 
 #ifdef QT_DEBUG
         qDebug("Request result: %s", d->result.constData());
 #endif
 
-    if (d->networkReply->error() == QNetworkReply::NoError) {
+    if (reply->error() == QNetworkReply::NoError) {
 
         if (checkOutput()) {
             successCallBack();
@@ -469,13 +514,12 @@ void Component::_q_requestFinished()
 
     } else {
 
-        extractError(d->networkReply);
+        extractError(reply);
 
         errorCallBack();
     }
 
-    d->networkReply->deleteLater();
-    d->networkReply = nullptr;
+    reply->deleteLater();
 }
 
 
@@ -124,6 +124,13 @@ public:
      */
     QNetworkAccessManager::Operation networkOperation() const;
 
+    /*!
+     * \brief Returns the HTTP verb used for a QNetworkAccessManager::CustomOperation.
+     *
+     * \sa setCustomVerb()
+     */
+    QByteArray customVerb() const;
+
 
     /*!
      * \brief Returns the currently set API URL.
@@ -184,6 +191,15 @@ protected:
      */
     void setNetworkOperation(QNetworkAccessManager::Operation operation);
 
+    /*!
+     * \brief Sets the HTTP \a verb to use if the network operation is QNetworkAccessManager::CustomOperation, like \c PATCH.
+     *
+     * The payload will be sent with the request.
+     *
+     * \sa customVerb()
+     */
+    void setCustomVerb(const QByteArray &verb);
+
     /*!
      * \brief Part of the \link Component::inOperation inOperation \endlink property.
      */
@@ -325,6 +341,15 @@ protected:
     void sendRequest(const QUrl &url, const QString &path, const QHash<QByteArray, QByteArray> &headers, const QUrlQuery &query = QUrlQuery(), const QByteArray &payLoad = QByteArray());
 
 
+    /*!
+     * \brief Aborts the request that is currently running.
+     *
+     * Neither successCallBack() nor errorCallBack() will be called for the aborted request.
+     * Returns false if there is no running request.
+     */
+    bool abortRequest();
+
+
     /*!
      * \brief successCallBack
      */
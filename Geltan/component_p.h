@@ -25,6 +25,9 @@
 #include "component.h"
 #include <QUrlQuery>
 #include <QTimer>
+#if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
+#include <QBuffer>
+#endif
 
 namespace Geltan {
 
@@ -59,6 +62,18 @@ public:
         case QNetworkAccessManager::DeleteOperation:
             networkReply = nam->deleteResource(request);
             break;
+        case QNetworkAccessManager::CustomOperation:
+        {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+            networkReply = nam->sendCustomRequest(request, customVerb, payload);
+#else
+            QBuffer *buffer = new QBuffer;
+            buffer->setData(payload);
+            networkReply = nam->sendCustomRequest(request, customVerb, buffer);
+            buffer->setParent(networkReply);
+#endif
+        }
+            break;
         default:
             networkReply = nam->get(request);
             break;
@@ -71,6 +86,7 @@ public:
     int requestTimeout;
     Error *error;
     QNetworkAccessManager::Operation namOperation;
+    QByteArray customVerb;
     QUrl apiUrl;
     QString apiPath;
     QHash<QByteArray,QByteArray> requestHeaders;
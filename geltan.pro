@@ -2,6 +2,8 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
         Geltan \
-        Test
+        Test \
+        Benchmarks
 
 Test.depends = Geltan
+Benchmarks.depends = Geltan